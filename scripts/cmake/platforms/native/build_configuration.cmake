@@ -71,6 +71,7 @@ function(platform_custom_post_build)
 
         set(TEST_RESOURCES_INCLUDE
                 "${TEST_SRCS}/utils/"
+                "${TEST_SRCS}/eval/common/"
                 "${TEST_SRC_USE_CASE}/${use_case}/include/"
                 )
 
@@ -80,6 +81,7 @@ function(platform_custom_post_build)
                 "${TEST_SRCS}/common/*.cc"
                 "${TEST_SRCS}/utils/*.cc"
                 "${TEST_SRCS}/utils/*.cpp"
+                "${TEST_SRCS}/eval/common/*.cc"
                 "${TEST_SRC_USE_CASE}/${use_case}/*.cpp"
                 "${TEST_SRC_USE_CASE}/${use_case}/*.cc"
                 "${TEST_SRC_USE_CASE}/${use_case}/*.c"
@@ -118,4 +120,17 @@ function(platform_custom_post_build)
                 TESTS)
         add_test(NAME "${use_case}-tests" COMMAND ${TEST_TARGET_NAME} -r junit -o ${TEST_TARGET_NAME}.xml)
     endif ()
+
+    # Accuracy and latency evaluation over a data pack, if the use case has one.
+    if (EXISTS ${TEST_SRCS}/eval/${use_case})
+        file(GLOB EVAL_SOURCES
+                "${TEST_SRCS}/eval/common/*.cc"
+                "${TEST_SRCS}/eval/${use_case}/*.cc"
+                )
+
+        set(EVAL_TARGET_NAME "${use_case}_eval")
+        add_executable(${EVAL_TARGET_NAME} ${EVAL_SOURCES})
+        target_include_directories(${EVAL_TARGET_NAME} PRIVATE "${TEST_SRCS}/eval/common/")
+        target_link_libraries(${EVAL_TARGET_NAME} PRIVATE ${UC_LIB_NAME})
+    endif ()
 endfunction()
\ No newline at end of file
@@ -141,6 +141,92 @@ function(generate_tflite_code)
 endfunction()
 
 
+##############################################################################
+# This function packs a tflite NN model file into a model container that the
+# application loads at runtime instead of compiling it in.
+# @param[in]    MODEL_PATH      path to a tflite file
+# @param[in]    OUTPUT_PATH     path of the container file to write
+# @param[in]    ARENA_HINT      optional tensor arena size hint in bytes
+# NOTE: Uses python
+##############################################################################
+function(generate_model_container)
+
+    set(oneValueArgs MODEL_PATH OUTPUT_PATH ARENA_HINT)
+    cmake_parse_arguments(PARSED "" "${oneValueArgs}" "" ${ARGN} )
+
+    # Absolute paths for passing into python script
+    get_filename_component(ABS_MODEL_PATH ${PARSED_MODEL_PATH} ABSOLUTE)
+    get_filename_component(ABS_OUTPUT_PATH ${PARSED_OUTPUT_PATH} ABSOLUTE)
+
+    if (EXISTS ${ABS_MODEL_PATH})
+        message(STATUS "Using ${ABS_MODEL_PATH}")
+    else ()
+        message(FATAL_ERROR "${ABS_MODEL_PATH} not found!")
+    endif ()
+
+    if (NOT DEFINED PARSED_ARENA_HINT)
+        set(PARSED_ARENA_HINT 0)
+    endif ()
+
+    execute_process(
+        COMMAND ${PYTHON} ${SCRIPTS_DIR}/py/gen_model_container.py
+        --tflite_path ${ABS_MODEL_PATH}
+        --output_path ${ABS_OUTPUT_PATH}
+        --arena_hint ${PARSED_ARENA_HINT}
+        RESULT_VARIABLE return_code
+    )
+    if (NOT return_code EQUAL "0")
+        message(FATAL_ERROR "Failed to generate model container.")
+    endif ()
+endfunction()
+
+
+##############################################################################
+# This function packs the audio clips or images located in the directory it is
+# pointed at into a single data pack that the application maps at runtime,
+# instead of generating a C++ array per file.
+# @param[in]    INPUT_DIR       directory with the input files
+# @param[in]    OUTPUT_PATH     path of the pack file to write
+# @param[in]    TYPE            AUDIO or IMAGE
+# @param[in]    IMAGE_SIZE      width and height of the packed images (IMAGE only)
+# @param[in]    LABELS          optional: "dir" to label files with their folder
+#                               name, or a CSV file of "file name,label" lines
+# NOTE: Uses python
+##############################################################################
+function(generate_data_pack)
+
+    set(oneValueArgs INPUT_DIR OUTPUT_PATH TYPE LABELS)
+    set(multiValueArgs IMAGE_SIZE)
+    cmake_parse_arguments(PARSED "" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+
+    # Absolute paths for passing into python script
+    get_filename_component(ABS_INPUT_DIR ${PARSED_INPUT_DIR} ABSOLUTE)
+    get_filename_component(ABS_OUTPUT_PATH ${PARSED_OUTPUT_PATH} ABSOLUTE)
+
+    if (PARSED_TYPE STREQUAL "AUDIO")
+        set(PACK_INPUT_ARGS --audio_path ${ABS_INPUT_DIR})
+    elseif (PARSED_TYPE STREQUAL "IMAGE")
+        set(PACK_INPUT_ARGS --image_path ${ABS_INPUT_DIR} --image_size ${PARSED_IMAGE_SIZE})
+    else ()
+        message(FATAL_ERROR "Unknown data pack type ${PARSED_TYPE}")
+    endif ()
+
+    if (DEFINED PARSED_LABELS)
+        list(APPEND PACK_INPUT_ARGS --labels ${PARSED_LABELS})
+    endif ()
+
+    execute_process(
+        COMMAND ${PYTHON} ${SCRIPTS_DIR}/py/gen_data_pack.py
+        ${PACK_INPUT_ARGS}
+        --output_path ${ABS_OUTPUT_PATH}
+        RESULT_VARIABLE return_code
+    )
+    if (NOT return_code EQUAL "0")
+        message(FATAL_ERROR "Failed to generate data pack.")
+    endif ()
+endfunction()
+
+
 ##############################################################################
 # This function generates C++ file for a given labels' text file.
 # @param[in]    INPUT          Path to the label text file
@@ -0,0 +1,80 @@
+#  SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+#  SPDX-License-Identifier: Apache-2.0
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+
+"""
+Utility script to compare two JSON summaries written by the <use_case>_eval
+harnesses, eg before and after a change. Metric and latency changes are
+listed; the script fails if a metric dropped by more than --max_accuracy_drop
+or if a stage's median latency grew by more than --max_latency_increase.
+"""
+import json
+import sys
+from argparse import ArgumentParser
+
+parser = ArgumentParser()
+parser.add_argument("baseline", type=str, help="summary to compare against.")
+parser.add_argument("current", type=str, help="summary to check.")
+parser.add_argument("--max_accuracy_drop", type=float, default=0.0,
+                    help="largest drop allowed for any metric (absolute).")
+parser.add_argument("--max_latency_increase", type=float, default=None,
+                    help="largest median latency increase allowed for any stage (relative, eg 0.1 for 10%%).")
+args = parser.parse_args()
+
+
+def compare(baseline: dict, current: dict) -> bool:
+    ok = True
+
+    for name in sorted(set(baseline["metrics"]) | set(current["metrics"])):
+        before = baseline["metrics"].get(name)
+        after = current["metrics"].get(name)
+        if before is None or after is None:
+            print(f"{name}: {before} -> {after}")
+            continue
+        regressed = before - after > args.max_accuracy_drop
+        ok = ok and not regressed
+        print(f"{name}: {before:.6f} -> {after:.6f} ({after - before:+.6f}){' REGRESSED' if regressed else ''}")
+
+    unit = current["latency"]["unit"]
+    base_stages = baseline["latency"]["stages"]
+    for stage, stats in sorted(current["latency"]["stages"].items()):
+        if stage not in base_stages:
+            print(f"{stage}: p50 {stats['p50']} {unit} (new)")
+            continue
+        before = base_stages[stage]["p50"]
+        after = stats["p50"]
+        change = (after - before) / before if before else 0
+        regressed = args.max_latency_increase is not None and change > args.max_latency_increase
+        ok = ok and not regressed
+        print(f"{stage}: p50 {before} -> {after} {unit} ({change:+.1%}), "
+              f"p99 {base_stages[stage]['p99']} -> {stats['p99']}{' REGRESSED' if regressed else ''}")
+
+    return ok
+
+
+def main(args):
+    with open(args.baseline) as baseline_file, open(args.current) as current_file:
+        baseline = json.load(baseline_file)
+        current = json.load(current_file)
+
+    if baseline["use_case"] != current["use_case"] or baseline["data"] != current["data"]:
+        print("++ Warning: the summaries are for different use cases or data sets")
+
+    if not compare(baseline, current):
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main(args)
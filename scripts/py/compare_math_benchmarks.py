@@ -0,0 +1,69 @@
+#  SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+#  SPDX-License-Identifier: Apache-2.0
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+
+"""
+Utility script to compare two outputs of the math_benchmarks application, eg
+before and after a change. Outputs can be the JSON alone or a whole log (eg
+captured from a board's UART) containing it. The per call minimum of every
+benchmark is compared; the script fails if any grew by more than --max_increase.
+"""
+import json
+import sys
+from argparse import ArgumentParser
+
+parser = ArgumentParser()
+parser.add_argument("baseline", type=str, help="output to compare against.")
+parser.add_argument("current", type=str, help="output to check.")
+parser.add_argument("--max_increase", type=float, default=0.1,
+                    help="largest increase allowed for any benchmark (relative, eg 0.1 for 10%%).")
+args = parser.parse_args()
+
+
+def load(path: str) -> tuple:
+    """Loads the benchmarks of a math_benchmarks output, by name and size, and their unit."""
+    with open(path) as output_file:
+        lines = output_file.read().splitlines()
+    start = lines.index("{")
+    end = lines.index("}", start)
+    results = json.loads("\n".join(lines[start:end + 1]))
+    return {(bench["name"], bench["size"]): bench for bench in results["benchmarks"]}, results["unit"]
+
+
+def main(args):
+    baseline, base_unit = load(args.baseline)
+    current, unit = load(args.current)
+    if base_unit != unit:
+        print(f"++ Warning: comparing {base_unit} against {unit}")
+
+    ok = True
+    for key in sorted(current):
+        name, size = key
+        after = current[key]["min"]
+        if key not in baseline:
+            print(f"{name}[{size}]: {after} {unit} (new)")
+            continue
+        before = baseline[key]["min"]
+        change = (after - before) / before if before else 0
+        regressed = change > args.max_increase
+        ok = ok and not regressed
+        print(f"{name}[{size}]: {before} -> {after} {unit} ({change:+.1%}){' REGRESSED' if regressed else ''}")
+
+    if not ok:
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main(args)
@@ -0,0 +1,256 @@
+#  SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+#  SPDX-License-Identifier: Apache-2.0
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+"""
+Utility script to convert a set of audio clips, images or IFM/OFM npy files
+into a single indexed binary pack (see DataPack.hpp), instead of one C array
+per file. The pack is mapped at runtime, so it can hold large labelled data
+sets without affecting build time or binary size.
+
+Layout (little endian):
+    header (32 bytes):
+        uint32  magic           "APAK"
+        uint16  version         1
+        uint16  header size     32
+        uint32  entry count
+        uint32  entry size      40
+        uint32  string table offset
+        uint32  string table size
+        uint32  payload alignment
+        uint32  reserved
+    entry table, one entry (40 bytes) per sample:
+        uint64  payload offset
+        uint32  payload size in bytes
+        uint32  name offset in the string table
+        uint32  label offset in the string table (empty string if none)
+        uint32  element type    0: uint8, 1: int8, 2: int16, 3: float32
+        uint32  dims[3]         {samples, 1, 1} or {height, width, channels}
+        uint32  reserved
+    string table, NUL terminated strings
+    payloads, each starting at a multiple of the alignment.
+
+Labels can be taken from the name of the folder holding each file
+(--labels dir), eg a data set laid out as <label>/<file>.wav, or from a CSV
+file with one "file name,label" line per file (--labels path/to/file.csv).
+"""
+import csv
+import glob
+import struct
+from argparse import ArgumentParser
+from pathlib import Path
+
+import numpy as np
+
+MAGIC = 0x4B415041
+VERSION = 1
+HEADER_FORMAT = "<IHHIIIIII"
+ENTRY_FORMAT = "<QIIIIIIII"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+ENTRY_SIZE = struct.calcsize(ENTRY_FORMAT)
+
+TYPE_CODES = {
+    np.dtype(np.uint8): 0,
+    np.dtype(np.int8): 1,
+    np.dtype(np.int16): 2,
+    np.dtype(np.float32): 3,
+}
+
+parser = ArgumentParser()
+source = parser.add_mutually_exclusive_group(required=True)
+source.add_argument("--audio_path", type=str, help="path to audio folder or file to convert.")
+source.add_argument("--image_path", type=str, help="path to images folder or image file to convert.")
+source.add_argument("--data_folder_path", type=str, help="path to ifm-ofm npy folder to convert.")
+parser.add_argument("--output_path", type=str, help="pack file to write.", required=True)
+parser.add_argument("--labels", type=str, default=None,
+                    help="'dir' to label each file with its folder name, or a CSV file of 'file name,label' lines.")
+parser.add_argument("--alignment", type=int, default=16, help="payload alignment in bytes.")
+parser.add_argument("--sampling_rate", type=int, help="target sampling rate.", default=16000)
+parser.add_argument("--mono", type=bool, help="convert signal to mono.", default=True)
+parser.add_argument("--offset", type=float, help="start reading after this time (in seconds).", default=0)
+parser.add_argument("--duration", type=float, help="only load up to this much audio (in seconds).", default=0)
+parser.add_argument("--res_type", type=str, help="Resample type: kaiser_best or kaiser_fast.", default='kaiser_best')
+parser.add_argument("--min_samples", type=int, help="Minimum sample number.", default=16000)
+parser.add_argument("--image_size", type=int, nargs=2, help="Size (width and height) of the converted images.")
+parser.add_argument("-v", "--verbosity", action="store_true")
+args = parser.parse_args()
+
+
+class PackEntry:
+    def __init__(self, name: str, label: str, data: np.ndarray, dims: tuple):
+        self.name = name
+        self.label = label
+        self.data = np.ascontiguousarray(data)
+        self.dims = tuple(dims) + (1,) * (3 - len(dims))
+
+
+def list_files(path: str, pattern: str) -> list:
+    if Path(path).is_dir():
+        return sorted(glob.glob(str(Path(path) / '**' / pattern), recursive=True))
+    if Path(path).is_file():
+        return [path]
+    raise OSError("Directory or file does not exist.")
+
+
+def get_labeller(labels: str):
+    """
+    Returns a function giving the label of a file path.
+    """
+    if labels is None:
+        return lambda filepath: ""
+    if labels == "dir":
+        return lambda filepath: Path(filepath).parent.name
+    with open(labels, newline='') as csv_file:
+        table = {row[0].strip(): row[1].strip() for row in csv.reader(csv_file) if len(row) >= 2}
+    return lambda filepath: table.get(Path(filepath).name, "")
+
+
+def load_audio(filepaths: list, labeller) -> list:
+    from gen_utils import AudioUtils
+
+    entries = []
+    for filepath in filepaths:
+        try:
+            clip_data, _ = AudioUtils.load_resample_audio_clip(filepath, args.sampling_rate, args.mono,
+                                                               args.offset, args.duration,
+                                                               args.res_type, args.min_samples)
+        except Exception:
+            if args.verbosity:
+                print(f"Failed to open {filepath} as an audio.")
+            continue
+
+        # Change from [-1, 1] fp32 range to int16 range.
+        clip_data = np.clip((clip_data * (1 << 15)),
+                            np.iinfo(np.int16).min,
+                            np.iinfo(np.int16).max).flatten().astype(np.int16)
+        entries.append(PackEntry(Path(filepath).name, labeller(filepath), clip_data, (len(clip_data),)))
+    return entries
+
+
+def load_images(filepaths: list, labeller) -> list:
+    from PIL import Image, UnidentifiedImageError
+
+    if not args.image_size:
+        raise ValueError("--image_size is needed to convert images.")
+    ifm_width, ifm_height = args.image_size
+
+    entries = []
+    for filepath in filepaths:
+        try:
+            original_image = Image.open(filepath).convert("RGB")
+        except UnidentifiedImageError:
+            print(f"-- Skipping file {filepath} due to unsupported image format.")
+            continue
+
+        # Aspect ratio resize and centre crop, as gen_rgb_cpp.py.
+        scale_ratio = float(max(ifm_width, ifm_height)) / float(min(original_image.size[0], original_image.size[1]))
+        resized_width = int(original_image.size[0] * scale_ratio)
+        resized_height = int(original_image.size[1] * scale_ratio)
+        resized_image = original_image.resize([resized_width, resized_height], Image.BILINEAR)
+        resized_image = resized_image.crop((
+            (resized_width - ifm_width) / 2,
+            (resized_height - ifm_height) / 2,
+            (resized_width + ifm_width) / 2,
+            (resized_height + ifm_height) / 2))
+
+        rgb_data = np.array(resized_image, dtype=np.uint8)
+        entries.append(PackEntry(Path(filepath).name, labeller(filepath), rgb_data, rgb_data.shape))
+    return entries
+
+
+def load_iofms(folder: str) -> list:
+    # ifm0.npy-ofm0.npy, ifm1.npy-ofm1.npy, ... stored as ifm0, ofm0, ifm1, ofm1, ...
+    entries = []
+    ifms_count = len(list(Path(folder).glob('ifm*.npy')))
+    for idx in range(ifms_count):
+        for prefix in ("ifm", "ofm"):
+            filepath = Path(folder) / f"{prefix}{idx}.npy"
+            if not filepath.is_file():
+                continue
+            data = np.load(filepath)
+            dims = data.shape[-3:] if data.ndim else (1,)
+            entries.append(PackEntry(filepath.name, "", data.flatten(), dims))
+    return entries
+
+
+def align(value: int, alignment: int) -> int:
+    return (value + alignment - 1) // alignment * alignment
+
+
+def write_pack(entries: list, output_path: Path, alignment: int):
+    """
+    Writes the entries as a data pack.
+    """
+    if alignment <= 0 or alignment & (alignment - 1):
+        raise ValueError(f"Alignment must be a power of two, got {alignment}")
+
+    # String table; offset 0 is the empty string used for missing labels.
+    strings = bytearray(b"\0")
+    string_offsets = {"": 0}
+
+    def add_string(text: str) -> int:
+        if text not in string_offsets:
+            string_offsets[text] = len(strings)
+            strings.extend(text.encode("utf-8") + b"\0")
+        return string_offsets[text]
+
+    name_label_offsets = [(add_string(e.name), add_string(e.label)) for e in entries]
+
+    strings_offset = HEADER_SIZE + ENTRY_SIZE * len(entries)
+    payload_offset = align(strings_offset + len(strings), alignment)
+
+    table = bytearray()
+    payloads = bytearray()
+    for entry, (name_offset, label_offset) in zip(entries, name_label_offsets):
+        if entry.data.dtype not in TYPE_CODES:
+            raise ValueError(f"Unsupported element type {entry.data.dtype} for {entry.name}")
+        data = entry.data.astype(entry.data.dtype.newbyteorder('<'), copy=False).tobytes()
+        offset = align(payload_offset + len(payloads), alignment)
+        payloads.extend(bytes(offset - payload_offset - len(payloads)))
+        table.extend(struct.pack(ENTRY_FORMAT, offset, len(data), name_offset, label_offset,
+                                 TYPE_CODES[entry.data.dtype], *entry.dims, 0))
+        payloads.extend(data)
+
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, HEADER_SIZE, len(entries), ENTRY_SIZE,
+                         strings_offset, len(strings), alignment, 0)
+
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(output_path, "wb") as pack:
+        pack.write(header)
+        pack.write(table)
+        pack.write(strings)
+        pack.write(bytes(payload_offset - strings_offset - len(strings)))
+        pack.write(payloads)
+
+
+def main(args):
+    labeller = get_labeller(args.labels)
+
+    if args.audio_path:
+        entries = load_audio(list_files(args.audio_path, '*.wav'), labeller)
+    elif args.image_path:
+        entries = load_images(list_files(args.image_path, '*.*'), labeller)
+    else:
+        entries = load_iofms(args.data_folder_path)
+
+    if not entries:
+        raise FileNotFoundError("No valid files found.")
+
+    output_path = Path(args.output_path).resolve()
+    print(f"++ Packing {len(entries)} entries into {output_path.name}")
+    write_pack(entries, output_path, args.alignment)
+
+
+if __name__ == '__main__':
+    main(args)
@@ -0,0 +1,92 @@
+#  SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+#  SPDX-License-Identifier: Apache-2.0
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+"""
+Utility script to wrap a .tflite model in a binary container that the
+application finds at runtime (see ModelLoader.hpp), instead of compiling the
+model in as a C array. The container can be written to a flash partition or,
+on native, mapped straight from disk.
+
+Layout (little endian):
+    uint32  magic           "AMDL"
+    uint16  version         1
+    uint16  header size     32
+    uint32  model offset    from the start of the header, multiple of the alignment
+    uint32  model size
+    uint32  model CRC-32    IEEE 802.3, as zlib
+    uint32  alignment
+    uint32  arena hint      tensor arena size in bytes, 0 if unknown
+    uint32  reserved
+    padding up to the model offset, then the model.
+"""
+import struct
+import zlib
+from argparse import ArgumentParser
+from pathlib import Path
+
+MAGIC = 0x4C444D41
+VERSION = 1
+HEADER_FORMAT = "<IHHIIIIII"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+
+parser = ArgumentParser()
+
+parser.add_argument("--tflite_path", help="Model (.tflite) path", required=True)
+parser.add_argument("--output_path", help="Container file to write", required=True)
+parser.add_argument("--alignment", type=int, default=16,
+                    help="Alignment of the model within the container in bytes")
+parser.add_argument("--arena_hint", type=lambda x: int(x, 0), default=0,
+                    help="Tensor arena size the model needs, in bytes")
+args = parser.parse_args()
+
+
+def make_container(model: bytes, alignment: int, arena_hint: int) -> bytes:
+    """
+    Builds the container for a model.
+
+    Arguments:
+        model:      model data.
+        alignment:  alignment of the model in bytes, a power of two.
+        arena_hint: tensor arena size hint in bytes.
+
+    Returns:
+        container bytes
+    """
+    if alignment <= 0 or alignment & (alignment - 1):
+        raise ValueError(f"Alignment must be a power of two, got {alignment}")
+
+    offset = (HEADER_SIZE + alignment - 1) // alignment * alignment
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, HEADER_SIZE, offset, len(model),
+                         zlib.crc32(model) & 0xFFFFFFFF, alignment, arena_hint, 0)
+    return header + bytes(offset - HEADER_SIZE) + model
+
+
+def main(args):
+    tflite_path = Path(args.tflite_path)
+    if not tflite_path.is_file():
+        raise Exception(f"{args.tflite_path} not found")
+
+    model = tflite_path.read_bytes()
+    if model[4:8] != b"TFL3":
+        raise Exception(f"{args.tflite_path} is not a TensorFlow Lite model")
+
+    output_path = Path(args.output_path).resolve()
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+    print(f"++ Packing {tflite_path.name} into {output_path.name}")
+    output_path.write_bytes(make_container(model, args.alignment, args.arena_hint))
+
+
+if __name__ == '__main__':
+    main(args)
@@ -0,0 +1,211 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AUDIO_FRONT_END_HPP
+#define AUDIO_FRONT_END_HPP
+
+#include "PlatformMath.hpp"
+
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    /**
+     * @brief   Stages of an audio feature extraction pipeline, in the only
+     *          order they can be chained in. Stages from deltas onwards
+     *          work over a block of frames (see AudioFrontEnd::ComputeBlock),
+     *          the others over one frame.
+     */
+    enum class FeatureStage : uint8_t {
+        frame,          /* int16 samples to [-1, 1), zero padded to the FFT length. Required. */
+        window,         /* Hann window. */
+        fft,            /* Real FFT. Required. */
+        power,          /* Power spectrum. One of power or magnitude is required. */
+        magnitude,      /* Magnitude spectrum. */
+        mel,            /* Triangular mel filter bank. */
+        log,            /* Natural logarithm. */
+        decibel,        /* 10 * log10, clamped to m_topDb below the frame's maximum if set. */
+        dct,            /* DCT-II, keeping the first m_numDctCoeffs coefficients. */
+        normalise,      /* Subtracts m_mean from each feature of a frame. */
+        deltas,         /* First and second order deltas over the block (9 frame kernels). */
+        standardise,    /* Zero mean, unit variance over the block, for each of the features and deltas. */
+        quantise        /* Affine quantisation with m_quantScale and m_quantOffset. */
+    };
+
+    /** @brief  Parameters of the stages of an AudioFrontEnd; stages left out ignore theirs. */
+    struct AudioFrontEndParams {
+        float       m_samplingFreq{16000};
+        uint32_t    m_frameLen{0};              /* Samples per frame. */
+        uint32_t    m_frameStride{0};           /* Samples between frames of a block. */
+        uint32_t    m_numFrames{0};             /* Frames per block, 0 if only computing frames. */
+        uint32_t    m_numMelBins{0};
+        float       m_melLoFreq{0};
+        float       m_melHiFreq{0};
+        bool        m_useHtkMethod{true};       /* HTK mel scale, Slaney's otherwise. */
+        bool        m_slaneyNorm{false};        /* Normalises the mel filters to constant energy. */
+        float       m_melFloor{FLT_MIN};        /* Added to mel energies to avoid log of zero. */
+        float       m_topDb{0};                 /* Dynamic range kept by the decibel stage, 0 for all. */
+        uint32_t    m_numDctCoeffs{0};
+        bool        m_orthonormalDct{false};    /* Orthonormal DCT-II scaling. */
+        float       m_mean{0};
+        float       m_quantScale{1};
+        int         m_quantOffset{0};
+    };
+
+    /**
+     * @brief   Audio feature extraction pipeline built from a table of stages,
+     *          so that use cases can share one implementation of windowing,
+     *          FFT, mel filter banks, logarithms and DCT instead of each
+     *          having their own. Adjacent stages are executed fused:
+     *          normalisation and windowing, the magnitude with the mel filter
+     *          bank, the decibel scaling with the search of the maximum, and
+     *          clamping, normalisation and quantisation with the DCT or the
+     *          final copy. Every buffer and table is allocated when the
+     *          pipeline is built: computing features allocates nothing.
+     *          The arithmetic is that of the MFCC and MelSpectrogram classes,
+     *          the results are bit exact with them.
+     */
+    class AudioFrontEnd {
+    public:
+        /**
+         * @brief       Builds the pipeline. If the table is invalid, the
+         *              error is logged and IsValid() returns false.
+         * @param[in]   stages   Stages, in order.
+         * @param[in]   params   Parameters of the stages.
+         **/
+        AudioFrontEnd(const std::vector<FeatureStage>& stages, const AudioFrontEndParams& params);
+
+        /**
+         * @brief       Parses a table of stages from a comma separated list of
+         *              their names, eg "frame,window,fft,power,mel,log", as
+         *              could come from the build configuration or model metadata.
+         * @param[in]   list     List to parse.
+         * @param[out]  stages   Stages parsed.
+         * @return      true if every name is a stage, false otherwise.
+         **/
+        static bool ParseStages(const char* list, std::vector<FeatureStage>& stages);
+
+        /** @brief  Gets whether the pipeline was built. */
+        bool IsValid() const;
+
+        /** @brief  Gets whether the pipeline has a given stage. */
+        bool HasStage(FeatureStage stage) const;
+
+        /** @brief  Gets the number of features of a frame: coefficients, mel bins or FFT bins. */
+        size_t GetNumFeatures() const;
+
+        /** @brief  Gets the number of features of a block frame: three times as many with deltas. */
+        size_t GetNumBlockFeatures() const;
+
+        /**
+         * @brief       Computes the features of a frame, up to the last frame
+         *              stage, leaving quantisation out.
+         * @param[in]   audio      Samples.
+         * @param[in]   audioLen   Number of samples, the frame is zero padded if fewer
+         *                         than the frame length.
+         * @param[out]  features   GetNumFeatures() features.
+         * @return      true if successful, false otherwise.
+         **/
+        bool ComputeFrame(const int16_t* audio, size_t audioLen, float* features);
+
+        /** @brief  As above, quantised to int8. Needs a quantise stage and no block stages. */
+        bool ComputeFrame(const int16_t* audio, size_t audioLen, int8_t* features);
+
+        /** @brief  As above, quantised to uint8. */
+        bool ComputeFrame(const int16_t* audio, size_t audioLen, uint8_t* features);
+
+        /**
+         * @brief       Computes the features of a block of m_numFrames frames,
+         *              m_frameStride samples apart. Frames past the end of the
+         *              audio are computed from silence. The features are
+         *              written frame after frame, each frame being its
+         *              features followed by their deltas if any. Float
+         *              features leave quantisation out.
+         * @param[in]   audio         Samples.
+         * @param[in]   audioLen      Number of samples.
+         * @param[out]  features      Features.
+         * @param[in]   featuresLen   Capacity of features, at least
+         *                            m_numFrames * GetNumBlockFeatures().
+         * @return      true if successful, false otherwise.
+         **/
+        bool ComputeBlock(const int16_t* audio, size_t audioLen, float* features, size_t featuresLen);
+
+        /** @brief  As above, quantised to int8. Needs a quantise stage. */
+        bool ComputeBlock(const int16_t* audio, size_t audioLen, int8_t* features, size_t featuresLen);
+
+        /** @brief  As above, quantised to uint8. */
+        bool ComputeBlock(const int16_t* audio, size_t audioLen, uint8_t* features, size_t featuresLen);
+
+    private:
+        /** @brief  Checks the table of stages against their parameters. */
+        bool Validate() const;
+
+        /** @brief  Builds the window, mel filter bank and DCT tables. */
+        void BuildTables();
+
+        /**
+         * @brief       Runs the stages up to the logarithm over a frame.
+         * @param[in]   audio        Samples, nullptr for silence.
+         * @param[in]   audioLen     Number of samples.
+         * @param[out]  clampLevel   Decibel level the final pass has to clamp to.
+         * @return      The features left for the final pass.
+         **/
+        const float* ComputeSpectrum(const int16_t* audio, size_t audioLen, float& clampLevel);
+
+        /** @brief  Runs the frame stages, with the final pass storing T. */
+        template<typename T>
+        bool ComputeFrameT(const int16_t* audio, size_t audioLen, T* features, bool quantise);
+
+        /** @brief  Runs all the stages over a block, the final pass storing T. */
+        template<typename T>
+        bool ComputeBlockT(const int16_t* audio, size_t audioLen, T* features, size_t featuresLen);
+
+        /** @brief  Computes the deltas of the block's first plane into the next two. */
+        void ComputeDeltas();
+
+        AudioFrontEndParams     m_params;
+        uint32_t                m_stages{0};            /* Bit mask of the stages. */
+        bool                    m_valid{false};
+        uint32_t                m_frameLenPadded{0};    /* FFT length. */
+        uint32_t                m_numSpectrumBins{0};   /* FFT bins kept without a mel stage. */
+        uint32_t                m_numFeatures{0};
+        uint32_t                m_numPlanes{1};         /* Features, and deltas if any, of a block. */
+
+        /* Every float buffer and table lives in m_arena, sized once when built. */
+        std::vector<float>      m_arena;
+        float*                  m_window{nullptr};      /* [m_frameLen] */
+        float*                  m_frame{nullptr};       /* [m_frameLenPadded] */
+        float*                  m_spectrum{nullptr};    /* [m_frameLenPadded] */
+        float*                  m_melWeights{nullptr};  /* Non zero weights of each filter, back to back. */
+        float*                  m_melEnergies{nullptr}; /* [m_numMelBins] */
+        float*                  m_dctMatrix{nullptr};   /* [m_numDctCoeffs][m_numMelBins] */
+        float*                  m_frameFeatures{nullptr};   /* [m_numFeatures] of a block frame. */
+        float*                  m_planes{nullptr};      /* [m_numPlanes][m_numFeatures][m_numFrames] */
+        std::vector<uint32_t>   m_melFirst;             /* First FFT bin of each filter. */
+        std::vector<uint32_t>   m_melLen;               /* Number of FFT bins of each filter. */
+        math::FftInstance       m_fftInstance;
+    };
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* AUDIO_FRONT_END_HPP */
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AUDIO_RING_BUFFER_HPP
+#define AUDIO_RING_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    /**
+     * @brief   Fixed capacity FIFO of audio samples, used to hand a stream
+     *          from one stage (eg noise reduction) to the next (eg KWS or
+     *          ASR). The storage is allocated once, in the constructor.
+     *          When the consumer falls behind, the oldest samples are
+     *          overwritten so that it always gets the most recent audio;
+     *          the samples lost are counted.
+     *          Not thread safe: the producer and consumer are expected to
+     *          run from the same loop.
+     */
+    class AudioRingBuffer {
+    public:
+        /**
+         * @brief       Constructor.
+         * @param[in]   capacity   Maximum number of samples held.
+         **/
+        explicit AudioRingBuffer(size_t capacity);
+
+        /**
+         * @brief       Appends samples, overwriting the oldest ones if full.
+         * @param[in]   data   Samples to append.
+         * @param[in]   len    Number of samples.
+         * @return      true if nothing was overwritten, false otherwise.
+         **/
+        bool Write(const int16_t* data, size_t len);
+
+        /**
+         * @brief       Removes the oldest samples.
+         * @param[out]  data   Buffer for the samples.
+         * @param[in]   len    Maximum number of samples to read.
+         * @return      Number of samples read.
+         **/
+        size_t Read(int16_t* data, size_t len);
+
+        /** @brief  Gets the number of samples that can be read. */
+        size_t Available() const;
+
+        /** @brief  Gets the maximum number of samples held. */
+        size_t Capacity() const;
+
+        /** @brief  Gets the number of samples overwritten before they were read. */
+        uint64_t GetOverrunCount() const;
+
+        /** @brief  Drops all the samples and clears the overrun count. */
+        void Clear();
+
+    private:
+        std::vector<int16_t>    m_buffer;       /* Sample storage. */
+        size_t                  m_readIdx{0};   /* Index of the oldest sample. */
+        size_t                  m_size{0};      /* Number of samples held. */
+        uint64_t                m_overrun{0};   /* Samples overwritten unread. */
+    };
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* AUDIO_RING_BUFFER_HPP */
@@ -165,6 +165,21 @@ namespace audio {
     };
 
 
+    /**
+     * @brief       Computes the energy of each band of a spectrum. The energy of
+     *              every FFT bin is shared linearly between the two neighbouring
+     *              band edges (triangular bands), as done by RNNoise.
+     * @param[in]   fft         Spectrum as interleaved real and imaginary pairs.
+     *                          Only the first half of the spectrum is needed.
+     * @param[in]   bandEdges   Starting bin of each band, in units of
+     *                          (1 << shift) FFT bins.
+     * @param[in]   numBands    Number of bands.
+     * @param[in]   shift       Scaling (left shift) applied to the band edges.
+     * @param[out]  bandE       Output buffer for numBands band energies.
+     **/
+    void ComputeBandEnergy(const float* fft, const uint32_t* bandEdges,
+                           size_t numBands, uint32_t shift, float* bandE);
+
 } /* namespace audio */
 } /* namespace app */
 } /* namespace arm */
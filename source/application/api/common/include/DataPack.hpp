@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATA_PACK_HPP
+#define DATA_PACK_HPP
+
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace arm {
+namespace app {
+
+    /** @brief  Element type of a data pack entry. */
+    enum class DataPackType : uint32_t {
+        Uint8 = 0,
+        Int8 = 1,
+        Int16 = 2,
+        Float32 = 3
+    };
+
+    /**
+     * @brief   Header of a data pack, as written by scripts/py/gen_data_pack.py.
+     *          All fields are little endian. The entry table follows the
+     *          header; names and labels are NUL terminated strings in the
+     *          string table; each payload starts at a multiple of m_alignment.
+     */
+    struct DataPackHeader {
+        uint32_t m_magic;           /* ms_dataPackMagic. */
+        uint16_t m_version;         /* ms_dataPackVersion. */
+        uint16_t m_headerSize;      /* Size of this header in bytes. */
+        uint32_t m_count;           /* Number of entries. */
+        uint32_t m_entrySize;       /* Size of an entry in bytes. */
+        uint32_t m_stringsOffset;   /* Offset of the string table from the start of the pack. */
+        uint32_t m_stringsSize;     /* Size of the string table in bytes. */
+        uint32_t m_alignment;       /* Payload alignment in bytes, a power of two. */
+        uint32_t m_reserved;
+    };
+
+    /** @brief  Entry of a data pack. */
+    struct DataPackEntry {
+        uint64_t m_offset;          /* Offset of the payload from the start of the pack. */
+        uint32_t m_size;            /* Size of the payload in bytes. */
+        uint32_t m_nameOffset;      /* Offset of the name in the string table. */
+        uint32_t m_labelOffset;     /* Offset of the label in the string table, empty if unlabelled. */
+        DataPackType m_type;        /* Element type. */
+        uint32_t m_dims[3];         /* Shape, eg {samples, 1, 1} or {height, width, channels}. */
+        uint32_t m_reserved;
+    };
+
+    static_assert(sizeof(DataPackHeader) == 32, "Unexpected data pack header size");
+    static_assert(sizeof(DataPackEntry) == 40, "Unexpected data pack entry size");
+
+    constexpr uint32_t ms_dataPackMagic = 0x4B415041; /* "APAK" */
+    constexpr uint16_t ms_dataPackVersion = 1;
+
+    /**
+     * @brief   Indexed pack of test inputs (audio clips, images or IFM/OFM
+     *          tensors) with their names and labels. The accessors return
+     *          pointers into the pack, nothing is copied, so the pack can
+     *          hold far more samples than could be compiled in as arrays.
+     */
+    class DataPack {
+    public:
+        DataPack() = default;
+        ~DataPack() = default;
+
+        DataPack(const DataPack&) = delete;
+        DataPack& operator=(const DataPack&) = delete;
+
+        /**
+         * @brief       Maps a pack file (native platform only).
+         * @param[in]   path    Path to the pack.
+         * @return      true if the file was mapped and holds a valid pack.
+         **/
+        bool Open(const char* path);
+
+        /**
+         * @brief       Uses a pack already in memory, eg in flash.
+         * @param[in]   base    Start of the pack; must outlive this object.
+         * @param[in]   len     Bytes available from base.
+         * @return      true if a valid pack was found.
+         **/
+        bool Attach(const uint8_t* base, size_t len);
+
+        /** @brief  Releases the pack. */
+        void Close();
+
+        /** @brief  Gets the number of entries. */
+        uint32_t GetCount() const;
+
+        /** @brief  Gets the name of an entry (eg the source file name), nullptr if out of range. */
+        const char* GetFilename(uint32_t idx) const;
+
+        /** @brief  Gets the label of an entry, empty if unlabelled, nullptr if out of range. */
+        const char* GetLabel(uint32_t idx) const;
+
+        /** @brief  Gets an entry's description, nullptr if out of range. */
+        const DataPackEntry* GetEntry(uint32_t idx) const;
+
+        /** @brief  Gets an entry's payload, nullptr if out of range. */
+        const void* GetData(uint32_t idx) const;
+
+        /** @brief  Gets an audio clip, nullptr if out of range or not int16 samples. */
+        const int16_t* GetAudioArray(uint32_t idx) const;
+
+        /** @brief  Gets the number of samples in an audio clip, 0 if not audio. */
+        uint32_t GetAudioArraySize(uint32_t idx) const;
+
+        /** @brief  Gets an image as uint8 pixels, nullptr if out of range or not uint8. */
+        const uint8_t* GetImgArray(uint32_t idx) const;
+
+    private:
+        MappedFile              m_file;                 /* Mapped pack, if opened from a file. */
+        const uint8_t*          m_base{nullptr};        /* Start of the pack. */
+        const uint8_t*          m_entries{nullptr};     /* Entry table. */
+        const char*             m_strings{nullptr};     /* String table. */
+        uint32_t                m_count{0};             /* Number of entries. */
+        uint32_t                m_entrySize{0};         /* Entry stride, newer versions may add fields. */
+    };
+
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* DATA_PACK_HPP */
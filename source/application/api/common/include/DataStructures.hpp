@@ -17,14 +17,59 @@
 #ifndef DATA_STRUCTURES_HPP
 #define DATA_STRUCTURES_HPP
 
+#include "log_macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <iterator>
+#include <memory>
+#include <type_traits>
 
 namespace arm {
 namespace app {
 
+    /** @brief  Memory layouts of an Array2d. */
+    enum class Array2dLayout {
+        rowMajor,   /* Elements of a row are contiguous. */
+        colMajor    /* Elements of a column are contiguous. */
+    };
+
+    /**
+     * Class StridedSpan is a view over a row or a column of an Array2d: size
+     * elements, stride elements apart. It doesn't own the elements, which
+     * have to outlive it.
+     */
+    template<typename T>
+    class StridedSpan {
+    public:
+        StridedSpan(T* data, size_t size, size_t stride):
+            m_data(data), m_size(size), m_stride(stride)
+        {}
+
+        T& operator[] (size_t idx) const { return m_data[idx * m_stride]; }
+
+        /** @brief  Gets the first element, eg to hand a contiguous span to a kernel. */
+        T* data() const { return m_data; }
+
+        /** @brief  Gets the number of elements. */
+        size_t size() const { return m_size; }
+
+        /** @brief  Gets the distance between elements, in elements. */
+        size_t stride() const { return m_stride; }
+
+        /** @brief  Gets whether the elements are contiguous. */
+        bool IsContiguous() const { return m_stride == 1; }
+
+    private:
+        T*      m_data;
+        size_t  m_size;
+        size_t  m_stride;
+    };
+
     /**
      * Class Array2d is a data structure that represents a two dimensional array.
-     * The data is allocated in contiguous memory, arranged row-wise
+     * The data is allocated in contiguous memory, arranged row-wise by default
      * and individual elements can be accessed with the () operator.
      * For example a two dimensional array D of size (M, N) can be accessed:
      *
@@ -36,10 +81,20 @@ namespace app {
      *               |  ...
      *               _  D(r=M, c=0) D(r=M, c=1)... D(r=M, c=N)
      *
+     * With the column-major layout, elements are accessed the same way but
+     * columns are contiguous instead: the layout is chosen so that the
+     * innermost loops over the array walk contiguous memory.
+     * The data is aligned to ms_alignment bytes. Arrays can be moved but
+     * not copied.
      */
-    template<typename T>
+    template<typename T, Array2dLayout Layout = Array2dLayout::rowMajor>
     class Array2d {
+        static_assert(std::is_trivial<T>::value, "Array2d only holds plain data");
+
     public:
+        /* Data cache line of the Cortex-M55 and M85, which also suits 128-bit vector loads. */
+        static constexpr size_t ms_alignment = 32;
+
         /**
          * @brief     Creates the array2d with the given sizes.
          * @param[in] rows   Number of rows.
@@ -49,17 +104,45 @@ namespace app {
         {
             if (rows == 0 || cols == 0) {
                 printf("Array2d constructor has 0 size.\n");
-                m_data = nullptr;
                 return;
             }
-            m_data = new T[rows * cols];
+
+            size_t space = rows * cols * sizeof(T) + ms_alignment;
+            m_alloc.reset(new uint8_t[space]);
+            void* aligned = m_alloc.get();
+            m_data = static_cast<T*>(std::align(ms_alignment, rows * cols * sizeof(T), aligned, space));
+        }
+
+        Array2d(const Array2d&) = delete;
+        Array2d& operator=(const Array2d&) = delete;
+
+        Array2d(Array2d&& other) noexcept:
+            m_rows(other.m_rows),
+            m_cols(other.m_cols),
+            m_alloc(std::move(other.m_alloc)),
+            m_data(other.m_data)
+        {
+            other.m_rows = 0;
+            other.m_cols = 0;
+            other.m_data = nullptr;
         }
 
-        ~Array2d()
+        Array2d& operator=(Array2d&& other) noexcept
         {
-            delete[] m_data;
+            if (this != &other) {
+                m_rows = other.m_rows;
+                m_cols = other.m_cols;
+                m_alloc = std::move(other.m_alloc);
+                m_data = other.m_data;
+                other.m_rows = 0;
+                other.m_cols = 0;
+                other.m_data = nullptr;
+            }
+            return *this;
         }
 
+        ~Array2d() = default;
+
         T& operator() (unsigned int row, unsigned int col)
         {
 #if defined(DEBUG)
@@ -67,7 +150,7 @@ namespace app {
                 printf_err("Array2d subscript out of bounds.\n");
             }
 #endif /* defined(DEBUG) */
-            return m_data[m_cols * row + col];
+            return m_data[Index(row, col)];
         }
 
         T operator() (unsigned int row, unsigned int col) const
@@ -77,14 +160,14 @@ namespace app {
                 printf_err("const Array2d subscript out of bounds.\n");
             }
 #endif /* defined(DEBUG) */
-            return m_data[m_cols * row + col];
+            return m_data[Index(row, col)];
         }
 
         /**
          * @brief  Gets rows number of the current array2d.
          * @return Number of rows.
          */
-        size_t size(size_t dim)
+        size_t size(size_t dim) const
         {
             switch (dim)
             {
@@ -100,13 +183,41 @@ namespace app {
         /**
          * @brief Gets the array2d total size.
          */
-        size_t totalSize()
+        size_t totalSize() const
         {
             return m_rows * m_cols;
         }
 
         /**
-         * array2d iterator.
+         * @brief   Gets a view of a row, contiguous with the row-major layout.
+         * @param[in] row   Row index.
+         */
+        StridedSpan<T> row(size_t row)
+        {
+            return StridedSpan<T>(m_data + Index(row, 0), m_cols, Index(0, 1));
+        }
+
+        StridedSpan<const T> row(size_t row) const
+        {
+            return StridedSpan<const T>(m_data + Index(row, 0), m_cols, Index(0, 1));
+        }
+
+        /**
+         * @brief   Gets a view of a column, contiguous with the column-major layout.
+         * @param[in] col   Column index.
+         */
+        StridedSpan<T> col(size_t col)
+        {
+            return StridedSpan<T>(m_data + Index(0, col), m_rows, Index(1, 0));
+        }
+
+        StridedSpan<const T> col(size_t col) const
+        {
+            return StridedSpan<const T>(m_data + Index(0, col), m_rows, Index(1, 0));
+        }
+
+        /**
+         * array2d iterator, over the elements in memory order.
          */
         using iterator=T*;
         using const_iterator=T const*;
@@ -116,10 +227,19 @@ namespace app {
         const_iterator begin() const { return m_data; }
         const_iterator end() const { return m_data + totalSize(); };
 
+        T* data() { return m_data; }
+        const T* data() const { return m_data; }
+
     private:
+        size_t Index(size_t row, size_t col) const
+        {
+            return Layout == Array2dLayout::rowMajor ? m_cols * row + col : m_rows * col + row;
+        }
+
         size_t m_rows;
         size_t m_cols;
-        T* m_data;
+        std::unique_ptr<uint8_t[]> m_alloc;
+        T* m_data{nullptr};
     };
 
 } /* namespace app */
@@ -109,6 +109,83 @@ namespace image {
      **/
     void RgbToGrayscale(const uint8_t* srcPtr, uint8_t* dstPtr, size_t dstImgSz);
 
+    /**
+     * @brief       Computes the sum of absolute differences between two
+     *              UINT8 buffers.
+     * @param[in]   srcA   Pointer to the first buffer.
+     * @param[in]   srcB   Pointer to the second buffer.
+     * @param[in]   len    Number of elements in each buffer.
+     * @return      Sum of absolute differences.
+     **/
+    uint32_t SumAbsDiffU8(const uint8_t* srcA, const uint8_t* srcB, size_t len);
+
+    /**
+     * @brief   Low-cost scene change detector for always-on vision use cases.
+     *          Each frame is reduced to a grid of block means (taken over all
+     *          channels) and compared, using the mean absolute difference per
+     *          block, against the grid of the last frame that was reported as
+     *          changed. Handlers can use it to skip inference and reuse the
+     *          previous results while the scene is static.
+     */
+    class FrameChangeDetector {
+    public:
+        /**
+         * @brief       Constructor.
+         * @param[in]   width           Frame width in pixels.
+         * @param[in]   height          Frame height in pixels.
+         * @param[in]   channels        Number of interleaved channels per pixel.
+         * @param[in]   threshold       Mean absolute block difference (0-255 scale)
+         *                              above which the frame is deemed changed.
+         *                              A value <= 0 reports every frame as changed.
+         * @param[in]   maxSkipFrames   Maximum number of consecutive frames that can
+         *                              be reported as unchanged. 0 means no limit.
+         * @param[in]   blockSize       Side of the square block, in pixels, averaged
+         *                              into one grid element.
+         **/
+        FrameChangeDetector(uint32_t width, uint32_t height, uint32_t channels,
+                            float threshold, uint32_t maxSkipFrames,
+                            uint32_t blockSize = 8);
+
+        /**
+         * @brief       Checks the frame against the last changed frame.
+         * @param[in]   frame   Pointer to the frame data (width x height x channels).
+         * @return      true if the scene changed (or the skip interval expired)
+         *              and inference should run, false if the previous results
+         *              can be reused.
+         **/
+        bool HasChanged(const uint8_t* frame);
+
+        /** @brief  Forgets the reference frame; the next frame is reported as changed. */
+        void Reset();
+
+        /** @brief  Gets the mean absolute block difference computed for the last frame. */
+        float GetLastDifference() const;
+
+        /** @brief  Gets the number of consecutive frames reported as unchanged. */
+        uint32_t GetSkippedFrames() const;
+
+    private:
+        /**
+         * @brief       Reduces the frame to a grid of block means.
+         * @param[in]   frame       Pointer to the frame data.
+         * @param[out]  signature   Grid of block means to populate.
+         **/
+        void ComputeSignature(const uint8_t* frame, std::vector<uint8_t>& signature) const;
+
+        uint32_t                m_width;
+        uint32_t                m_channels;
+        uint32_t                m_blockSize;
+        uint32_t                m_gridCols;
+        uint32_t                m_gridRows;
+        float                   m_threshold;
+        uint32_t                m_maxSkipFrames;
+        uint32_t                m_skippedFrames{0};
+        float                   m_lastDifference{0.f};
+        bool                    m_hasReference{false};
+        std::vector<uint8_t>    m_reference;    /* Grid of the last changed frame. */
+        std::vector<uint8_t>    m_current;      /* Grid of the frame being checked. */
+    };
+
 } /* namespace image */
 } /* namespace app */
 } /* namespace arm */
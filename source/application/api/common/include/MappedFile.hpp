@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace arm {
+namespace app {
+
+    /**
+     * @brief   Read-only memory mapping of a whole file: pages are loaded on
+     *          demand and nothing is copied. Only supported where the host
+     *          provides mmap (the native platform); elsewhere Open() fails.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief       Maps a file; any previous mapping is released.
+         * @param[in]   path    Path to the file.
+         * @return      true if the file was mapped, false otherwise.
+         **/
+        bool Open(const char* path);
+
+        /** @brief  Releases the mapping. */
+        void Close();
+
+        /** @brief  Gets the start of the mapping, nullptr if none. */
+        const uint8_t* Data() const;
+
+        /** @brief  Gets the size of the mapping in bytes. */
+        size_t Size() const;
+
+    private:
+        void*   m_mapping{nullptr};     /* Start of the mapping. */
+        size_t  m_size{0};              /* Size of the mapping. */
+    };
+
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* MAPPED_FILE_HPP */
@@ -95,6 +95,27 @@ namespace audio {
         **/
         std::vector<float> MfccCompute(const std::vector<int16_t>& audioData);
 
+        /**
+        * @brief        Extract MFCC features for one single small frame of
+        *               audio data, eg straight from an audio buffer.
+        * @param[in]    audioData      Audio samples to calculate features for.
+        * @param[in]    audioDataLen   Number of samples; the frame is zero
+        *                              padded if fewer than the frame length.
+        * @return       Vector of extracted MFCC features.
+        **/
+        std::vector<float> MfccCompute(const int16_t* audioData, size_t audioDataLen);
+
+        /**
+        * @brief        Extract MFCC features for one single small frame of
+        *               audio data into a caller provided buffer, so that
+        *               nothing is allocated per frame.
+        * @param[in]    audioData      Audio samples to calculate features for.
+        * @param[in]    audioDataLen   Number of samples; the frame is zero
+        *                              padded if fewer than the frame length.
+        * @param[out]   mfccOut        Buffer of m_numMfccFeatures features.
+        **/
+        void MfccCompute(const int16_t* audioData, size_t audioDataLen, float* mfccOut);
+
         /** @brief  Initialise. */
         void Init();
 
@@ -112,15 +133,54 @@ namespace audio {
                                         const float quantScale,
                                         const int quantOffset)
         {
-            this->MfccComputePreFeature(audioData);
+            return this->MfccComputeQuant<T>(audioData.data(), audioData.size(), quantScale, quantOffset);
+        }
+
+       /**
+        * @brief        Extract MFCC features and quantise for one single small
+        *               frame of audio data, eg straight from an audio buffer.
+        * @param[in]    audioData      Audio samples to calculate features for.
+        * @param[in]    audioDataLen   Number of samples.
+        * @param[in]    quantScale     Quantisation scale.
+        * @param[in]    quantOffset    Quantisation offset.
+        * @return       Vector of extracted quantised MFCC features.
+        **/
+        template<typename T>
+        std::vector<T> MfccComputeQuant(const int16_t* audioData,
+                                        const size_t audioDataLen,
+                                        const float quantScale,
+                                        const int quantOffset)
+        {
+            std::vector<T> mfccOut(this->m_params.m_numMfccFeatures);
+            this->MfccComputeQuant<T>(audioData, audioDataLen, quantScale, quantOffset, mfccOut.data());
+            return mfccOut;
+        }
+
+       /**
+        * @brief        Extract MFCC features and quantise for one single small
+        *               frame of audio data into a caller provided buffer, so
+        *               that nothing is allocated per frame.
+        * @param[in]    audioData      Audio samples to calculate features for.
+        * @param[in]    audioDataLen   Number of samples.
+        * @param[in]    quantScale     Quantisation scale.
+        * @param[in]    quantOffset    Quantisation offset.
+        * @param[out]   mfccOut        Buffer of m_numMfccFeatures features.
+        **/
+        template<typename T>
+        void MfccComputeQuant(const int16_t* audioData,
+                              const size_t audioDataLen,
+                              const float quantScale,
+                              const int quantOffset,
+                              T* mfccOut)
+        {
+            this->MfccComputePreFeature(audioData, audioDataLen);
             float minVal = std::numeric_limits<T>::min();
             float maxVal = std::numeric_limits<T>::max();
 
-            std::vector<T> mfccOut(this->m_params.m_numMfccFeatures);
             const size_t numFbankBins = this->m_params.m_numFbankBins;
 
             /* Take DCT. Uses matrix mul. */
-            for (size_t i = 0, j = 0; i < mfccOut.size(); ++i, j += numFbankBins) {
+            for (size_t i = 0, j = 0; i < this->m_params.m_numMfccFeatures; ++i, j += numFbankBins) {
 
                 float sum = math::MathUtils::DotProductF32(this->m_dctMatrix.data() + j, this->m_melEnergies.data(), numFbankBins);
 
@@ -128,8 +188,6 @@ namespace audio {
                 sum = std::round((sum / quantScale) + quantOffset);
                 mfccOut[i] = static_cast<T>(std::min<float>(std::max<float>(sum, minVal), maxVal));
             }
-
-            return mfccOut;
         }
 
         /* Constants */
@@ -138,7 +196,6 @@ namespace audio {
         static constexpr float ms_minLogHz = 1000.0;
         static constexpr float ms_minLogMel = ms_minLogHz / ms_freqStep;
 
-    protected:
         /**
          * @brief       Project input frequency to Mel Scale.
          * @param[in]   freq           Input frequency in floating point.
@@ -160,6 +217,7 @@ namespace audio {
         static float InverseMelScale(float melFreq,
                                      bool  useHTKMethod = true);
 
+    protected:
         /**
          * @brief       Populates MEL energies after applying the MEL filter
          *              bank weights and adding them up to be placed into
@@ -250,9 +308,10 @@ namespace audio {
         /**
          * @brief       Computes and populates internal memeber buffers used
          *              in MFCC feature calculation
-         * @param[in]   audioData   1D vector of 16-bit audio data.
+         * @param[in]   audioData      16-bit audio data.
+         * @param[in]   audioDataLen   Number of samples.
          */
-        void MfccComputePreFeature(const std::vector<int16_t>& audioData);
+        void MfccComputePreFeature(const int16_t* audioData, size_t audioDataLen);
 
         /** @brief       Computes the magnitude from an interleaved complex array. */
         void ConvertToPowerSpectrum();
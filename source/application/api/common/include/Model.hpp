@@ -20,10 +20,20 @@
 #include "TensorFlowLiteMicro.hpp"
 
 #include <cstdint>
+#include <vector>
 
 namespace arm {
 namespace app {
 
+    /**
+     * @brief   Recurrent state of a streaming model: an output tensor of one
+     *          inference that is fed back as an input tensor of the next.
+     */
+    struct StateBinding {
+        size_t m_outputIndex;   /* Output tensor the state is read from. */
+        size_t m_inputIndex;    /* Input tensor the state is fed back to. */
+    };
+
     /**
      * @brief   NN model class wrapping the underlying TensorFlow-Lite-Micro API.
      */
@@ -97,6 +107,64 @@ namespace app {
         /** @brief  Runs the inference (invokes the interpreter). */
         virtual bool RunInference();
 
+        /**
+         * @brief       Declares a recurrent state, so that the model can be run
+         *              frame by frame on a stream. States can be bound before
+         *              Init, which then checks them, or after it.
+         *              The states are carried in the model's tensors:
+         *              CarryStates copies each output state into its input
+         *              tensor, where the next inference reads it. The arena
+         *              may reuse the memory of inputs and outputs for other
+         *              tensors, so states must be carried (or saved) before
+         *              the other inputs are written, and nothing else written
+         *              to an input, such as features to reuse, outlives an
+         *              inference.
+         * @param[in]   outputIndex   Output tensor holding the new state.
+         * @param[in]   inputIndex    Input tensor taking the state back.
+         * @return      true if the tensors match in type and size (or the
+         *              model is not initialised yet), false otherwise.
+         **/
+        bool BindState(size_t outputIndex, size_t inputIndex);
+
+        /** @brief  Gets the states bound. */
+        const std::vector<StateBinding>& GetStateBindings() const;
+
+        /** @brief  Sets the input states to zero, as quantised, to start a new stream. */
+        void ResetStates();
+
+        /**
+         * @brief   Feeds the output states of the last inference back to the
+         *          input states. States the arena already holds in place are
+         *          not copied; others are copied straight over, unless an
+         *          input state shares memory with another output state, when
+         *          they are staged in a buffer allocated by Init. Nothing is
+         *          allocated here.
+         * @return  true if successful, false otherwise.
+         **/
+        bool CarryStates();
+
+        /** @brief  Gets the size in bytes of a snapshot of the states. */
+        size_t GetStateSize() const;
+
+        /**
+         * @brief       Saves the output states of the last inference, so that
+         *              several streams can share the model: call it before any
+         *              input is written (see BindState).
+         * @param[out]  snapshot   Buffer of at least GetStateSize() bytes.
+         * @param[in]   size       Size of the buffer in bytes.
+         * @return      true if successful, false otherwise.
+         **/
+        bool SaveStates(uint8_t* snapshot, size_t size) const;
+
+        /**
+         * @brief       Feeds states saved by SaveStates to the input states,
+         *              in place of CarryStates, to resume a stream.
+         * @param[in]   snapshot   States saved.
+         * @param[in]   size       Size of the snapshot in bytes.
+         * @return      true if successful, false otherwise.
+         **/
+        bool RestoreStates(const uint8_t* snapshot, size_t size);
+
         /** @brief   Model information handler common to all models.
          *  @return  true or false based on execution success.
          **/
@@ -133,6 +201,8 @@ namespace app {
         size_t GetActivationBufferSize();
 
     private:
+        /** @brief   Checks the states bound against the tensors and sizes the staging buffer. */
+        bool CheckStates();
         const tflite::Model* m_pModel{nullptr};            /* Tflite model pointer. */
         tflite::MicroInterpreter* m_pInterpreter{nullptr}; /* Tflite interpreter. */
         tflite::MicroAllocator* m_pAllocator{nullptr};     /* Tflite micro allocator. */
@@ -143,6 +213,9 @@ namespace app {
         std::vector<TfLiteTensor*> m_input{};              /* Model's input tensor pointers. */
         std::vector<TfLiteTensor*> m_output{};             /* Model's output tensor pointers. */
         TfLiteType m_type{kTfLiteNoType};                  /* Model's data type. */
+
+        std::vector<StateBinding> m_states{};              /* Recurrent states. */
+        std::vector<uint8_t> m_stateStaging{};             /* Output states staged when they overlap input states. */
     };
 
 } /* namespace app */
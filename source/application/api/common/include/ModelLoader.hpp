@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MODEL_LOADER_HPP
+#define MODEL_LOADER_HPP
+
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace arm {
+namespace app {
+
+    /**
+     * @brief   Header of a model container, as written by
+     *          scripts/py/gen_model_container.py. All fields are little endian.
+     *          The model itself follows at m_modelOffset from the start of the
+     *          header, which is a multiple of m_alignment.
+     */
+    struct ModelContainerHeader {
+        uint32_t m_magic;       /* ms_modelContainerMagic. */
+        uint16_t m_version;     /* ms_modelContainerVersion. */
+        uint16_t m_headerSize;  /* Size of this header in bytes. */
+        uint32_t m_modelOffset; /* Offset of the model from the start of the header. */
+        uint32_t m_modelSize;   /* Size of the model in bytes. */
+        uint32_t m_modelCrc32;  /* CRC-32 (IEEE 802.3) of the model. */
+        uint32_t m_alignment;   /* Alignment of the model in bytes, a power of two. */
+        uint32_t m_arenaHint;   /* Tensor arena size the model needs, 0 if unknown. */
+        uint32_t m_reserved;
+    };
+
+    static_assert(sizeof(ModelContainerHeader) == 32, "Unexpected model container header size");
+
+    constexpr uint32_t ms_modelContainerMagic = 0x4C444D41; /* "AMDL" */
+    constexpr uint16_t ms_modelContainerVersion = 1;
+
+    /** @brief  Model found at runtime; points into the mapped or flashed image, nothing is copied. */
+    struct LoadedModel {
+        const uint8_t*  m_data{nullptr};    /* Model flatbuffer. */
+        size_t          m_size{0};          /* Model size in bytes. */
+        uint32_t        m_arenaHint{0};     /* Tensor arena size hint, 0 if unknown. */
+    };
+
+    /**
+     * @brief       Computes the CRC-32 (IEEE 802.3, as zlib) of a buffer.
+     * @param[in]   data   Pointer to the data.
+     * @param[in]   len    Length of the data in bytes.
+     * @return      CRC value.
+     **/
+    uint32_t Crc32(const uint8_t* data, size_t len);
+
+    /**
+     * @brief       Checks if a buffer holds a TensorFlow Lite flatbuffer.
+     * @param[in]   data   Pointer to the data.
+     * @param[in]   len    Length of the data in bytes.
+     * @return      true if the flatbuffer identifier matches.
+     **/
+    bool IsTfliteModel(const uint8_t* data, size_t len);
+
+    /**
+     * @brief       Finds the model in a model container, eg a flash partition.
+     *              The header, alignment and CRC are checked.
+     * @param[in]   base    Start of the container.
+     * @param[in]   len     Bytes available from base (eg the partition size).
+     * @param[out]  model   Model found.
+     * @return      true if a valid model was found, false otherwise.
+     **/
+    bool LoadModelFromContainer(const uint8_t* base, size_t len, LoadedModel& model);
+
+    /**
+     * @brief       Checks the tensor arena against the model's arena hint.
+     * @param[in]   model       Model found.
+     * @param[in]   arenaSize   Size of the tensor arena in bytes.
+     * @return      true if the hint is unknown (0) or fits the arena,
+     *              false otherwise.
+     **/
+    bool ModelFitsArena(const LoadedModel& model, size_t arenaSize);
+
+    /**
+     * @brief   Model file mapped into memory. The file can either be a plain
+     *          .tflite file or a model container. Only supported where the
+     *          host provides mmap (the native platform).
+     */
+    class ModelFile {
+    public:
+        ModelFile() = default;
+        ~ModelFile() = default;
+
+        ModelFile(const ModelFile&) = delete;
+        ModelFile& operator=(const ModelFile&) = delete;
+
+        /**
+         * @brief       Maps a model file; any previous mapping is released.
+         * @param[in]   path    Path to the .tflite or container file.
+         * @return      true if the file was mapped and holds a valid model.
+         **/
+        bool Open(const char* path);
+
+        /** @brief  Releases the mapping. */
+        void Close();
+
+        /** @brief  Gets the model found in the file. */
+        const LoadedModel& GetModel() const;
+
+    private:
+        MappedFile  m_file;     /* Mapped model file. */
+        LoadedModel m_model;    /* Model within the mapping. */
+    };
+
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* MODEL_LOADER_HPP */
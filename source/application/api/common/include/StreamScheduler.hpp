@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef STREAM_SCHEDULER_HPP
+#define STREAM_SCHEDULER_HPP
+
+#include "Model.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace arm {
+namespace app {
+
+    /**
+     * @brief   Recurrent state of one stream of a model shared between
+     *          several streams. The state is kept in a snapshot outside the
+     *          tensor arena and swapped in and out around each inference.
+     */
+    class StreamState {
+    public:
+        /**
+         * @brief       Constructor.
+         * @param[in]   model   Initialised model, with its states bound.
+         **/
+        explicit StreamState(const Model& model);
+
+        /** @brief  Starts the stream over: the next inference starts from reset states. */
+        void Reset();
+
+        /**
+         * @brief           Runs an inference of this stream: its states are
+         *                  swapped in, the model invoked and the new states
+         *                  swapped out. The other inputs must be populated.
+         * @param[in,out]   model   Model the state belongs to.
+         * @return          true if successful, false otherwise.
+         **/
+        bool RunInference(Model& model);
+
+    private:
+        std::vector<uint8_t>    m_snapshot;         /* States after the last inference. */
+        bool                    m_started{false};   /* Whether m_snapshot is valid. */
+    };
+
+    /** @brief  Latency of the frames of a stream, in microseconds. */
+    struct StreamLatency {
+        uint32_t    m_frames{0};
+        uint32_t    m_misses{0};        /* Frames done later than the frame period. */
+        uint64_t    m_totalUs{0};
+        uint64_t    m_maxUs{0};
+
+        /** @brief  Gets the mean latency, 0 if there are no frames. */
+        double MeanUs() const;
+    };
+
+    /**
+     * @brief   Serves several streams with one core, round robin: every frame
+     *          period, one frame of each stream is processed in turn. The
+     *          latency of a frame runs from the start of its round, when all
+     *          the frames are available, to the end of its processing; it
+     *          misses its deadline if longer than the frame period. The
+     *          first stream served rotates from one round to the next so that
+     *          none is always last.
+     */
+    class StreamScheduler {
+    public:
+        /* Current time, in microseconds. */
+        using Clock = std::function<uint64_t()>;
+
+        /* Processes the next frame of a stream, returns false on error. */
+        using FrameFn = std::function<bool(size_t stream)>;
+
+        /**
+         * @brief       Constructor.
+         * @param[in]   numStreams      Number of streams.
+         * @param[in]   framePeriodUs   Duration of a frame, the deadline of each round.
+         * @param[in]   clock           Platform clock.
+         **/
+        StreamScheduler(size_t numStreams, uint64_t framePeriodUs, Clock clock);
+
+        /**
+         * @brief       Processes one frame of each stream.
+         * @param[in]   processFrame   Function processing a frame of a stream.
+         * @return      false if a frame failed to be processed, true otherwise.
+         **/
+        bool RunRound(const FrameFn& processFrame);
+
+        /** @brief  Gets the number of streams. */
+        size_t GetNumStreams() const;
+
+        /** @brief  Gets the latency of a stream. */
+        const StreamLatency& GetLatency(size_t stream) const;
+
+        /** @brief  Gets the number of rounds run. */
+        uint32_t GetRounds() const;
+
+        /** @brief  Gets the number of rounds that took longer than the frame period. */
+        uint32_t GetRoundMisses() const;
+
+        /** @brief  Logs the latency of each stream. */
+        void PrintReport() const;
+
+    private:
+        std::vector<StreamLatency>  m_latency;
+        uint64_t                    m_framePeriodUs;
+        Clock                       m_clock;
+        size_t                      m_first{0};         /* Stream served first in the next round. */
+        uint32_t                    m_rounds{0};
+        uint32_t                    m_roundMisses{0};
+    };
+
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* STREAM_SCHEDULER_HPP */
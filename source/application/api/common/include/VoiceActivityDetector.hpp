@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef VOICE_ACTIVITY_DETECTOR_HPP
+#define VOICE_ACTIVITY_DETECTOR_HPP
+
+#include "PlatformMath.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    /* Voice activity detector parameters. */
+    struct VadParams {
+        float       m_samplingFreq{16000.f};    /* Audio sampling frequency in Hz. */
+        uint32_t    m_frameLen{256};            /* Analysis frame length in samples (FFT length). */
+        float       m_minEnergyDb{-55.f};       /* Absolute frame energy floor in dBFS. */
+        float       m_energyMarginDb{9.f};      /* Frame energy needed above the noise floor in dB. */
+        float       m_noiseFloorRise{0.005f};   /* Per-frame smoothing used when the noise floor rises. */
+        float       m_minZcr{0.02f};            /* Zero crossings per sample accepted as voiced speech */
+        float       m_maxZcr{0.25f};            /* without running the spectral check. */
+        float       m_minSpeechBandRatio{0.6f}; /* Minimum share of energy in the 300-4000 Hz bands. */
+        uint32_t    m_hangoverFrames{63};       /* Frames to stay active after the last active frame. */
+    };
+
+    /**
+     * @brief   Cheap voice activity detector meant to gate keyword spotting.
+     *          Each frame goes through a cascade of checks, each more expensive
+     *          than the previous one:
+     *          - frame energy against an absolute floor and an adaptive noise floor,
+     *          - zero crossing rate within the range typical of voiced speech,
+     *          - otherwise, share of spectral energy in the speech bands, using
+     *            the RNNoise band energy computation.
+     *          Activity is held for a configurable hangover after the last
+     *          active frame so that trailing parts of words are not cut.
+     */
+    class VoiceActivityDetector {
+    public:
+        /**
+         * @brief       Constructor.
+         * @param[in]   params   Detector parameters.
+         **/
+        explicit VoiceActivityDetector(const VadParams& params);
+
+        VoiceActivityDetector() = delete;
+
+        ~VoiceActivityDetector() = default;
+
+        /**
+         * @brief       Runs the detector over a block of audio, frame by frame.
+         *              Trailing samples that do not fill a frame are kept and
+         *              start the first frame of the next call, so blocks need
+         *              not be a multiple of the frame length.
+         * @param[in]   data   Pointer to the audio samples.
+         * @param[in]   len    Number of audio samples.
+         * @return      true if any frame completed by the block is active
+         *              (including hangover), false if they are all silent.
+         *              If the block completes no frame, the state of the
+         *              last frame.
+         **/
+        bool IsVoiceActive(const int16_t* data, size_t len);
+
+        /**
+         * @brief       Runs the detector over a single frame.
+         * @param[in]   frame   Pointer to m_frameLen audio samples.
+         * @return      true if the frame is active (including hangover).
+         **/
+        bool ProcessFrame(const int16_t* frame);
+
+        /** @brief  Resets the noise floor estimate, the hangover and the samples kept. */
+        void Reset();
+
+        /** @brief  Gets the number of samples kept for the next frame. */
+        size_t GetNumPendingSamples() const;
+
+        /** @brief  Gets the current noise floor estimate in dBFS. */
+        float GetNoiseFloorDb() const;
+
+    private:
+        /**
+         * @brief       Computes the share of the frame energy in the speech bands.
+         * @param[in]   frame   Pointer to m_frameLen audio samples.
+         * @return      Speech band energy ratio in [0, 1].
+         **/
+        float SpeechBandRatio(const int16_t* frame);
+
+        VadParams               m_params;
+        math::FftInstance       m_fftInstance;
+        std::vector<float>      m_frameBuf;         /* Frame converted to float. */
+        std::vector<float>      m_fftBuf;           /* Interleaved spectrum. */
+        std::vector<uint32_t>   m_bandEdges;        /* Band starting bins. */
+        std::vector<float>      m_bandEnergy;       /* Energy of each band. */
+        std::vector<int16_t>    m_pending;          /* Samples of a frame not yet complete. */
+        size_t                  m_pendingLen{0};    /* Number of samples in m_pending. */
+        bool                    m_lastActive{false}; /* State of the last frame. */
+        float                   m_noiseFloorDb;     /* Adaptive noise floor estimate. */
+        uint32_t                m_hangoverLeft{0};  /* Frames of hangover left. */
+    };
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* VOICE_ACTIVITY_DETECTOR_HPP */
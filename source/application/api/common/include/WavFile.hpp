@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef WAV_FILE_HPP
+#define WAV_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    /**
+     * @brief       Reads a 16-bit PCM WAV file. Multi-channel audio is mixed
+     *              down to mono; no resampling is done.
+     * @param[in]   path         Path to the file.
+     * @param[out]  samples      Samples read.
+     * @param[out]  sampleRate   Sample rate of the file, in Hz.
+     * @return      true if the file was read, false otherwise.
+     **/
+    bool ReadWav(const char* path, std::vector<int16_t>& samples, uint32_t& sampleRate);
+
+    /**
+     * @brief       Writes mono 16-bit PCM samples to a WAV file.
+     * @param[in]   path         Path to the file, overwritten if it exists.
+     * @param[in]   samples      Samples to write.
+     * @param[in]   numSamples   Number of samples.
+     * @param[in]   sampleRate   Sample rate, in Hz.
+     * @return      true if the file was written, false otherwise.
+     **/
+    bool WriteWav(const char* path, const int16_t* samples, size_t numSamples, uint32_t sampleRate);
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* WAV_FILE_HPP */
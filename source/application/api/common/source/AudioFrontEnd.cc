@@ -0,0 +1,577 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AudioFrontEnd.hpp"
+
+#include "AudioUtils.hpp"
+#include "Mfcc.hpp"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    /* Names of the stages, in FeatureStage order. */
+    static const char* const ms_stageNames[] = {
+        "frame", "window", "fft", "power", "magnitude", "mel", "log",
+        "decibel", "dct", "normalise", "deltas", "standardise", "quantise"
+    };
+
+    static constexpr size_t ms_numStages = sizeof(ms_stageNames) / sizeof(ms_stageNames[0]);
+
+    /* Kernels of the deltas, as used to train the Wav2Letter model. */
+    static const float ms_delta1Coeffs[] = {
+         6.66666667e-02,  5.00000000e-02,  3.33333333e-02,
+         1.66666667e-02, -3.46944695e-18, -1.66666667e-02,
+        -3.33333333e-02, -5.00000000e-02, -6.66666667e-02};
+
+    static const float ms_delta2Coeffs[] = {
+         0.06060606,      0.01515152,     -0.01731602,
+        -0.03679654,     -0.04329004,     -0.03679654,
+        -0.01731602,      0.01515152,      0.06060606};
+
+    static constexpr uint32_t ms_deltaKernelLen = sizeof(ms_delta1Coeffs) / sizeof(ms_delta1Coeffs[0]);
+
+    static constexpr uint32_t StageBit(FeatureStage stage)
+    {
+        return 1u << static_cast<uint32_t>(stage);
+    }
+
+    /* Quantises the way MFCC::MfccComputeQuant does. */
+    template<typename T>
+    static T Quantise(float value, float quantScale, int quantOffset)
+    {
+        constexpr float minVal = std::numeric_limits<T>::min();
+        constexpr float maxVal = std::numeric_limits<T>::max();
+        value = std::round((value / quantScale) + quantOffset);
+        return static_cast<T>(std::min<float>(std::max<float>(value, minVal), maxVal));
+    }
+
+    template<typename T>
+    static T Store(float value, bool quantise, float quantScale, int quantOffset)
+    {
+        return quantise ? Quantise<T>(value, quantScale, quantOffset) : static_cast<T>(value);
+    }
+
+    AudioFrontEnd::AudioFrontEnd(const std::vector<FeatureStage>& stages, const AudioFrontEndParams& params):
+        m_params(params)
+    {
+        int previous = -1;
+        for (const auto stage : stages) {
+            /* Strictly increasing: in order, and no stage twice. */
+            if (static_cast<int>(stage) <= previous) {
+                printf_err("Audio front end stage %s out of order\n",
+                           ms_stageNames[static_cast<size_t>(stage)]);
+                return;
+            }
+            previous = static_cast<int>(stage);
+            this->m_stages |= StageBit(stage);
+        }
+
+        if (!this->Validate()) {
+            return;
+        }
+
+        /* Smallest power of 2 >= frame length. */
+        this->m_frameLenPadded = pow(2, ceil((log(this->m_params.m_frameLen)/log(2))));
+        this->m_numSpectrumBins = this->m_frameLenPadded / 2 + 1;
+
+        if (this->HasStage(FeatureStage::dct)) {
+            this->m_numFeatures = this->m_params.m_numDctCoeffs;
+        } else if (this->HasStage(FeatureStage::mel)) {
+            this->m_numFeatures = this->m_params.m_numMelBins;
+        } else {
+            this->m_numFeatures = this->m_numSpectrumBins;
+        }
+        this->m_numPlanes = this->HasStage(FeatureStage::deltas) ? 3 : 1;
+
+        this->BuildTables();
+        math::MathUtils::FftInitF32(this->m_frameLenPadded, this->m_fftInstance);
+        this->m_valid = true;
+    }
+
+    bool AudioFrontEnd::ParseStages(const char* list, std::vector<FeatureStage>& stages)
+    {
+        stages.clear();
+        if (!list) {
+            return false;
+        }
+
+        while (*list) {
+            const char* end = std::strchr(list, ',');
+            const size_t len = end ? static_cast<size_t>(end - list) : std::strlen(list);
+
+            size_t idx = 0;
+            while (idx < ms_numStages &&
+                    !(std::strlen(ms_stageNames[idx]) == len && 0 == std::strncmp(ms_stageNames[idx], list, len))) {
+                ++idx;
+            }
+            if (idx == ms_numStages) {
+                printf_err("Unknown audio front end stage in %s\n", list);
+                stages.clear();
+                return false;
+            }
+            stages.push_back(static_cast<FeatureStage>(idx));
+            list += end ? len + 1 : len;
+        }
+        return true;
+    }
+
+    bool AudioFrontEnd::IsValid() const
+    {
+        return this->m_valid;
+    }
+
+    bool AudioFrontEnd::HasStage(FeatureStage stage) const
+    {
+        return 0 != (this->m_stages & StageBit(stage));
+    }
+
+    size_t AudioFrontEnd::GetNumFeatures() const
+    {
+        return this->m_numFeatures;
+    }
+
+    size_t AudioFrontEnd::GetNumBlockFeatures() const
+    {
+        return this->m_numFeatures * this->m_numPlanes;
+    }
+
+    bool AudioFrontEnd::Validate() const
+    {
+        const AudioFrontEndParams& params = this->m_params;
+        const bool hasBlockStages = this->HasStage(FeatureStage::deltas) ||
+                                    this->HasStage(FeatureStage::standardise);
+
+        if (!this->HasStage(FeatureStage::frame) || !this->HasStage(FeatureStage::fft)) {
+            printf_err("Audio front end needs frame and fft stages\n");
+        } else if (this->HasStage(FeatureStage::power) == this->HasStage(FeatureStage::magnitude)) {
+            printf_err("Audio front end needs one of power or magnitude stages\n");
+        } else if (this->HasStage(FeatureStage::log) && this->HasStage(FeatureStage::decibel)) {
+            printf_err("Audio front end can't have both log and decibel stages\n");
+        } else if (params.m_frameLen == 0 || params.m_frameLen > std::numeric_limits<uint16_t>::max() / 2) {
+            printf_err("Invalid audio front end frame length %" PRIu32 "\n", params.m_frameLen);
+        } else if (this->HasStage(FeatureStage::mel) &&
+                (params.m_numMelBins == 0 || params.m_melHiFreq <= params.m_melLoFreq)) {
+            printf_err("Invalid audio front end mel filter bank\n");
+        } else if (this->HasStage(FeatureStage::dct) && (!this->HasStage(FeatureStage::mel) ||
+                params.m_numDctCoeffs == 0 || params.m_numDctCoeffs > params.m_numMelBins)) {
+            printf_err("Audio front end DCT needs a mel stage and at most as many coefficients as bins\n");
+        } else if (hasBlockStages && params.m_numFrames == 0) {
+            printf_err("Audio front end block stages need a number of frames\n");
+        } else if (params.m_numFrames != 0 && params.m_frameStride == 0) {
+            printf_err("Audio front end blocks need a frame stride\n");
+        } else if (this->HasStage(FeatureStage::deltas) && params.m_numFrames < ms_deltaKernelLen) {
+            printf_err("Audio front end deltas need at least %" PRIu32 " frames\n", ms_deltaKernelLen);
+        } else if (this->HasStage(FeatureStage::quantise) && params.m_quantScale == 0) {
+            printf_err("Quantisation scale can't be 0\n");
+        } else {
+            return true;
+        }
+        return false;
+    }
+
+    void AudioFrontEnd::BuildTables()
+    {
+        const AudioFrontEndParams& params = this->m_params;
+        const bool hasMel = this->HasStage(FeatureStage::mel);
+        const uint32_t numMelBins = hasMel ? params.m_numMelBins : 0;
+
+        /* Mel filter bank, as MFCC::CreateMelFilterBank builds it. */
+        std::vector<float> melWeights;
+        this->m_melFirst.assign(numMelBins, 0);
+        this->m_melLen.assign(numMelBins, 0);
+        if (hasMel) {
+            const size_t numFftBins = this->m_frameLenPadded / 2;
+            const float fftBinWidth = static_cast<float>(params.m_samplingFreq) / this->m_frameLenPadded;
+            const float melLowFreq = MFCC::MelScale(params.m_melLoFreq, params.m_useHtkMethod);
+            const float melHighFreq = MFCC::MelScale(params.m_melHiFreq, params.m_useHtkMethod);
+            const float melFreqDelta = (melHighFreq - melLowFreq) / (numMelBins + 1);
+            std::vector<float> thisBin(numFftBins);
+
+            for (size_t bin = 0; bin < numMelBins; ++bin) {
+                const float leftMel = melLowFreq + bin * melFreqDelta;
+                const float centerMel = melLowFreq + (bin + 1) * melFreqDelta;
+                const float rightMel = melLowFreq + (bin + 2) * melFreqDelta;
+                const float normaliser = params.m_slaneyNorm ?
+                    (2.0f / (MFCC::InverseMelScale(rightMel, params.m_useHtkMethod) -
+                             MFCC::InverseMelScale(leftMel, params.m_useHtkMethod))) : 1.f;
+
+                uint32_t firstIndex = 0;
+                uint32_t lastIndex = 0;
+                bool firstIndexFound = false;
+                for (size_t i = 0; i < numFftBins; ++i) {
+                    const float freq = (fftBinWidth * i);
+                    const float mel = MFCC::MelScale(freq, params.m_useHtkMethod);
+                    thisBin[i] = 0.0;
+
+                    if (mel > leftMel && mel < rightMel) {
+                        float weight;
+                        if (mel <= centerMel) {
+                            weight = (mel - leftMel) / (centerMel - leftMel);
+                        } else {
+                            weight = (rightMel - mel) / (rightMel - centerMel);
+                        }
+
+                        thisBin[i] = weight * normaliser;
+                        if (!firstIndexFound) {
+                            firstIndex = i;
+                            firstIndexFound = true;
+                        }
+                        lastIndex = i;
+                    }
+                }
+
+                this->m_melFirst[bin] = firstIndex;
+                this->m_melLen[bin] = lastIndex - firstIndex + 1;
+                melWeights.insert(melWeights.end(), thisBin.begin() + firstIndex, thisBin.begin() + lastIndex + 1);
+            }
+        }
+
+        const uint32_t numDct = this->HasStage(FeatureStage::dct) ? params.m_numDctCoeffs * numMelBins : 0;
+        const uint32_t numBlock = params.m_numFrames ?
+                                  this->m_numFeatures + params.m_numFrames * this->m_numFeatures * this->m_numPlanes : 0;
+
+        this->m_arena.assign(params.m_frameLen + 2 * this->m_frameLenPadded + melWeights.size() +
+                             numMelBins + numDct + numBlock, 0.f);
+        this->m_window = this->m_arena.data();
+        this->m_frame = this->m_window + params.m_frameLen;
+        this->m_spectrum = this->m_frame + this->m_frameLenPadded;
+        this->m_melWeights = this->m_spectrum + this->m_frameLenPadded;
+        this->m_melEnergies = this->m_melWeights + melWeights.size();
+        this->m_dctMatrix = this->m_melEnergies + numMelBins;
+        this->m_frameFeatures = this->m_dctMatrix + numDct;
+        this->m_planes = this->m_frameFeatures + this->m_numFeatures;
+
+        std::copy(melWeights.begin(), melWeights.end(), this->m_melWeights);
+
+        /* Hann window. */
+        if (this->HasStage(FeatureStage::window)) {
+            const auto multiplier = static_cast<float>(2 * M_PI / params.m_frameLen);
+            for (size_t i = 0; i < params.m_frameLen; ++i) {
+                this->m_window[i] = (0.5 - (0.5 *
+                    math::MathUtils::CosineF32(static_cast<float>(i) * multiplier)));
+            }
+        }
+
+        /* DCT-II, as MFCC::CreateDCTMatrix or, orthonormal, as Wav2LetterMFCC's. */
+        if (numDct) {
+            const int32_t inputLength = numMelBins;
+            const float angleIncr = M_PI / inputLength;
+            float angle = 0;
+            float normalizer = math::MathUtils::SqrtF32(2.0f / inputLength);
+            float normalizerK0 = normalizer;
+            if (params.m_orthonormalDct) {
+                normalizerK0 = 2 * math::MathUtils::SqrtF32(1.0f / static_cast<float>(4 * inputLength));
+                normalizer = 2 * math::MathUtils::SqrtF32(1.0f / static_cast<float>(2 * inputLength));
+            }
+
+            /* First row, cos(0) = 1, done apart as it may use its own normalizer. */
+            for (int32_t n = 0; n < inputLength; ++n) {
+                this->m_dctMatrix[n] = params.m_orthonormalDct ? normalizerK0 :
+                    normalizer * math::MathUtils::CosineF32((n + 0.5f) * angle);
+            }
+            angle += angleIncr;
+
+            for (int32_t k = 1, m = inputLength; k < static_cast<int32_t>(params.m_numDctCoeffs);
+                    ++k, m += inputLength) {
+                for (int32_t n = 0; n < inputLength; ++n) {
+                    this->m_dctMatrix[m + n] = normalizer *
+                        math::MathUtils::CosineF32((n + 0.5f) * angle);
+                }
+                angle += angleIncr;
+            }
+        }
+    }
+
+    const float* AudioFrontEnd::ComputeSpectrum(const int16_t* audio, size_t audioLen, float& clampLevel)
+    {
+        const AudioFrontEndParams& params = this->m_params;
+
+        /* Frame and window, fused. TensorFlow way of normalizing .wav data to (-1, 1). */
+        constexpr float normaliser = 1.0/(1u<<15u);
+        const size_t numSamples = audio ? std::min<size_t>(audioLen, params.m_frameLen) : 0;
+        if (this->HasStage(FeatureStage::window)) {
+            for (size_t i = 0; i < numSamples; ++i) {
+                this->m_frame[i] = static_cast<float>(audio[i]) * normaliser * this->m_window[i];
+            }
+        } else {
+            for (size_t i = 0; i < numSamples; ++i) {
+                this->m_frame[i] = static_cast<float>(audio[i]) * normaliser;
+            }
+        }
+        std::fill(this->m_frame + numSamples, this->m_frame + this->m_frameLenPadded, 0.f);
+
+        math::MathUtils::FftF32(this->m_frame, this->m_frameLenPadded,
+                                this->m_spectrum, this->m_frameLenPadded,
+                                this->m_fftInstance);
+
+        /* Power spectrum; the real parts of DC and Nyquist are packed first. */
+        const uint32_t halfDim = this->m_frameLenPadded / 2;
+        const float firstEnergy = this->m_spectrum[0] * this->m_spectrum[0];
+        const float lastEnergy = this->m_spectrum[1] * this->m_spectrum[1];
+        math::MathUtils::ComplexMagnitudeSquaredF32(this->m_spectrum, this->m_frameLenPadded,
+                                                    this->m_spectrum, halfDim);
+        this->m_spectrum[0] = firstEnergy;
+        this->m_spectrum[halfDim] = lastEnergy;
+
+        const bool magnitude = this->HasStage(FeatureStage::magnitude);
+        float* features = this->m_spectrum;
+        uint32_t numFeatures = this->m_numSpectrumBins;
+
+        if (this->HasStage(FeatureStage::mel)) {
+            /* Mel filter bank, the magnitude fused into it. */
+            const float* weights = this->m_melWeights;
+            for (size_t bin = 0; bin < params.m_numMelBins; ++bin) {
+                const float* power = this->m_spectrum + this->m_melFirst[bin];
+                const uint32_t len = this->m_melLen[bin];
+                float melEnergy = params.m_melFloor;
+                if (magnitude) {
+                    for (uint32_t i = 0; i < len; ++i) {
+                        float energyRep = math::MathUtils::SqrtF32(power[i]);
+                        melEnergy += (weights[i] * energyRep);
+                    }
+                } else {
+                    for (uint32_t i = 0; i < len; ++i) {
+                        melEnergy += (weights[i] * power[i]);
+                    }
+                }
+                weights += len;
+                this->m_melEnergies[bin] = melEnergy;
+            }
+            features = this->m_melEnergies;
+            numFeatures = params.m_numMelBins;
+        } else if (magnitude) {
+            for (uint32_t i = 0; i < numFeatures; ++i) {
+                features[i] = math::MathUtils::SqrtF32(features[i]);
+            }
+        }
+
+        if (this->HasStage(FeatureStage::log)) {
+            math::MathUtils::VecLogarithmF32(features, features, numFeatures);
+        } else if (this->HasStage(FeatureStage::decibel)) {
+            /* Because we are taking natural logs, we need to multiply by log10(e), and by 10 for dB. */
+            constexpr float multiplier = 10.0 * 0.4342944819032518;
+            math::MathUtils::VecLogarithmF32(features, features, numFeatures);
+
+            /* Scaling and search of the maximum, fused. */
+            float maxEnergy = -FLT_MAX;
+            for (uint32_t i = 0; i < numFeatures; ++i) {
+                features[i] *= multiplier;
+                if (features[i] > maxEnergy) {
+                    maxEnergy = features[i];
+                }
+            }
+
+            /* The DCT needs every bin clamped, otherwise the clamp is fused into the final pass. */
+            if (params.m_topDb > 0 && this->HasStage(FeatureStage::dct)) {
+                const float clampLevelLowdB = maxEnergy - params.m_topDb;
+                for (uint32_t i = 0; i < numFeatures; ++i) {
+                    features[i] = std::max(features[i], clampLevelLowdB);
+                }
+            } else if (params.m_topDb > 0) {
+                clampLevel = maxEnergy - params.m_topDb;
+            }
+        }
+        return features;
+    }
+
+    template<typename T>
+    bool AudioFrontEnd::ComputeFrameT(const int16_t* audio, size_t audioLen, T* features, bool quantise)
+    {
+        if (!this->m_valid || !features) {
+            printf_err("Invalid audio front end or output\n");
+            return false;
+        }
+
+        const AudioFrontEndParams& params = this->m_params;
+        float clampLevel = -FLT_MAX;
+        const float* spectrum = this->ComputeSpectrum(audio, audioLen, clampLevel);
+        const bool normalise = this->HasStage(FeatureStage::normalise);
+
+        /* Final pass: DCT or copy, fused with clamping, normalisation and quantisation. */
+        if (this->HasStage(FeatureStage::dct)) {
+            for (size_t i = 0, j = 0; i < this->m_numFeatures; ++i, j += params.m_numMelBins) {
+                float sum = math::MathUtils::DotProductF32(this->m_dctMatrix + j, spectrum, params.m_numMelBins);
+                if (normalise) {
+                    sum -= params.m_mean;
+                }
+                features[i] = Store<T>(sum, quantise, params.m_quantScale, params.m_quantOffset);
+            }
+        } else {
+            for (size_t i = 0; i < this->m_numFeatures; ++i) {
+                float value = std::max(spectrum[i], clampLevel);
+                if (normalise) {
+                    value -= params.m_mean;
+                }
+                features[i] = Store<T>(value, quantise, params.m_quantScale, params.m_quantOffset);
+            }
+        }
+        return true;
+    }
+
+    bool AudioFrontEnd::ComputeFrame(const int16_t* audio, size_t audioLen, float* features)
+    {
+        return this->ComputeFrameT<float>(audio, audioLen, features, false);
+    }
+
+    bool AudioFrontEnd::ComputeFrame(const int16_t* audio, size_t audioLen, int8_t* features)
+    {
+        if (!this->HasStage(FeatureStage::quantise) ||
+                this->HasStage(FeatureStage::deltas) || this->HasStage(FeatureStage::standardise)) {
+            printf_err("Audio front end frames can't be quantised\n");
+            return false;
+        }
+        return this->ComputeFrameT<int8_t>(audio, audioLen, features, true);
+    }
+
+    bool AudioFrontEnd::ComputeFrame(const int16_t* audio, size_t audioLen, uint8_t* features)
+    {
+        if (!this->HasStage(FeatureStage::quantise) ||
+                this->HasStage(FeatureStage::deltas) || this->HasStage(FeatureStage::standardise)) {
+            printf_err("Audio front end frames can't be quantised\n");
+            return false;
+        }
+        return this->ComputeFrameT<uint8_t>(audio, audioLen, features, true);
+    }
+
+    void AudioFrontEnd::ComputeDeltas()
+    {
+        /* As AsrPreProcess::ComputeDeltas: valid convolution along time, zero padded. */
+        const size_t numFrames = this->m_params.m_numFrames;
+        const size_t planeSize = this->m_numFeatures * numFrames;
+        const size_t fMidIdx = (ms_deltaKernelLen - 1) / 2;
+        const float* mfcc = this->m_planes;
+        float* delta1 = this->m_planes + planeSize;
+        float* delta2 = delta1 + planeSize;
+
+        std::fill(delta1, delta1 + 2 * planeSize, 0.f);
+        for (size_t i = 0; i < this->m_numFeatures; ++i) {
+            for (size_t j = fMidIdx; j < numFrames - fMidIdx; ++j) {
+                float d1 = 0;
+                float d2 = 0;
+                const float* window = mfcc + i * numFrames + j - fMidIdx;
+
+                for (size_t k = 0, m = ms_deltaKernelLen - 1; k < ms_deltaKernelLen; ++k, --m) {
+                    d1 += window[k] * ms_delta1Coeffs[m];
+                    d2 += window[k] * ms_delta2Coeffs[m];
+                }
+
+                delta1[i * numFrames + j] = d1;
+                delta2[i * numFrames + j] = d2;
+            }
+        }
+    }
+
+    template<typename T>
+    bool AudioFrontEnd::ComputeBlockT(const int16_t* audio, size_t audioLen, T* features, size_t featuresLen)
+    {
+        const AudioFrontEndParams& params = this->m_params;
+        const size_t numFrames = params.m_numFrames;
+        const size_t numFeatures = this->m_numFeatures;
+        const size_t planeSize = numFeatures * numFrames;
+        const size_t numBlockFeatures = this->GetNumBlockFeatures();
+
+        if (!this->m_valid || numFrames == 0 || !features) {
+            printf_err("Invalid audio front end or output\n");
+            return false;
+        }
+        if (featuresLen < numFrames * numBlockFeatures) {
+            printf_err("Output too small for the audio front end block\n");
+            return false;
+        }
+
+        /* Frame features go to the first plane, time along its rows; missing frames are silent. */
+        auto slider = SlidingWindow<const int16_t>(audio, audio ? audioLen : 0,
+                                                   params.m_frameLen, params.m_frameStride);
+        for (size_t j = 0; j < numFrames; ++j) {
+            const int16_t* frame = slider.HasNext() ? slider.Next() : nullptr;
+            this->ComputeFrameT<float>(frame, params.m_frameLen, this->m_frameFeatures, false);
+            for (size_t i = 0; i < numFeatures; ++i) {
+                this->m_planes[i * numFrames + j] = this->m_frameFeatures[i];
+            }
+        }
+
+        if (this->HasStage(FeatureStage::deltas)) {
+            this->ComputeDeltas();
+        }
+
+        /* As AsrPreProcess::StandardizeVecF32, for each plane. */
+        if (this->HasStage(FeatureStage::standardise)) {
+            for (size_t p = 0; p < this->m_numPlanes; ++p) {
+                float* plane = this->m_planes + p * planeSize;
+                const float mean = math::MathUtils::MeanF32(plane, planeSize);
+                const float stddev = math::MathUtils::StdDevF32(plane, planeSize, mean);
+                if (stddev == 0) {
+                    std::fill(plane, plane + planeSize, 0.f);
+                } else {
+                    const float stddevInv = 1.f/stddev;
+                    const float normalisedMean = mean/stddev;
+                    for (size_t i = 0; i < planeSize; ++i) {
+                        plane[i] = plane[i] * stddevInv - normalisedMean;
+                    }
+                }
+            }
+        }
+
+        /* Transposed back to time major, the planes of a frame back to back. */
+        const bool quantise = !std::is_floating_point<T>::value;
+        for (size_t j = 0; j < numFrames; ++j) {
+            T* out = features + j * numBlockFeatures;
+            for (size_t p = 0; p < this->m_numPlanes; ++p) {
+                const float* plane = this->m_planes + p * planeSize;
+                for (size_t i = 0; i < numFeatures; ++i) {
+                    *out++ = Store<T>(plane[i * numFrames + j], quantise,
+                                      params.m_quantScale, params.m_quantOffset);
+                }
+            }
+        }
+        return true;
+    }
+
+    bool AudioFrontEnd::ComputeBlock(const int16_t* audio, size_t audioLen, float* features, size_t featuresLen)
+    {
+        return this->ComputeBlockT<float>(audio, audioLen, features, featuresLen);
+    }
+
+    bool AudioFrontEnd::ComputeBlock(const int16_t* audio, size_t audioLen, int8_t* features, size_t featuresLen)
+    {
+        if (!this->HasStage(FeatureStage::quantise)) {
+            printf_err("Audio front end has no quantise stage\n");
+            return false;
+        }
+        return this->ComputeBlockT<int8_t>(audio, audioLen, features, featuresLen);
+    }
+
+    bool AudioFrontEnd::ComputeBlock(const int16_t* audio, size_t audioLen, uint8_t* features, size_t featuresLen)
+    {
+        if (!this->HasStage(FeatureStage::quantise)) {
+            printf_err("Audio front end has no quantise stage\n");
+            return false;
+        }
+        return this->ComputeBlockT<uint8_t>(audio, audioLen, features, featuresLen);
+    }
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AudioRingBuffer.hpp"
+
+#include <algorithm>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    AudioRingBuffer::AudioRingBuffer(size_t capacity)
+    :   m_buffer(capacity)
+    {}
+
+    bool AudioRingBuffer::Write(const int16_t* data, size_t len)
+    {
+        const size_t capacity = this->m_buffer.size();
+        if (capacity == 0) {
+            this->m_overrun += len;
+            return len == 0;
+        }
+
+        /* Only the last capacity samples can be kept. */
+        size_t dropped = 0;
+        if (len > capacity) {
+            dropped = len - capacity;
+            data += dropped;
+            len = capacity;
+        }
+
+        /* Make room by dropping the oldest samples. */
+        const size_t free = capacity - this->m_size;
+        if (len > free) {
+            const size_t evict = len - free;
+            this->m_readIdx = (this->m_readIdx + evict) % capacity;
+            this->m_size -= evict;
+            dropped += evict;
+        }
+
+        size_t writeIdx = (this->m_readIdx + this->m_size) % capacity;
+        const size_t first = std::min(len, capacity - writeIdx);
+        std::copy(data, data + first, this->m_buffer.begin() + writeIdx);
+        std::copy(data + first, data + len, this->m_buffer.begin());
+        this->m_size += len;
+
+        this->m_overrun += dropped;
+        return dropped == 0;
+    }
+
+    size_t AudioRingBuffer::Read(int16_t* data, size_t len)
+    {
+        const size_t capacity = this->m_buffer.size();
+        len = std::min(len, this->m_size);
+        if (len == 0) {
+            return 0;
+        }
+
+        const size_t first = std::min(len, capacity - this->m_readIdx);
+        const auto start = this->m_buffer.begin() + this->m_readIdx;
+        std::copy(start, start + first, data);
+        std::copy(this->m_buffer.begin(), this->m_buffer.begin() + (len - first), data + first);
+
+        this->m_readIdx = (this->m_readIdx + len) % capacity;
+        this->m_size -= len;
+        return len;
+    }
+
+    size_t AudioRingBuffer::Available() const
+    {
+        return this->m_size;
+    }
+
+    size_t AudioRingBuffer::Capacity() const
+    {
+        return this->m_buffer.size();
+    }
+
+    uint64_t AudioRingBuffer::GetOverrunCount() const
+    {
+        return this->m_overrun;
+    }
+
+    void AudioRingBuffer::Clear()
+    {
+        this->m_readIdx = 0;
+        this->m_size = 0;
+        this->m_overrun = 0;
+    }
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AudioUtils.hpp"
+
+#include <algorithm>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    void ComputeBandEnergy(const float* fft, const uint32_t* bandEdges,
+                           const size_t numBands, const uint32_t shift, float* bandE)
+    {
+        if (numBands == 0) {
+            return;
+        }
+
+        std::fill(bandE, bandE + numBands, 0.f);
+
+        for (size_t i = 0; i < numBands - 1; i++) {
+            const auto bandSize = (bandEdges[i + 1] - bandEdges[i]) << shift;
+
+            for (uint32_t j = 0; j < bandSize; j++) {
+                const auto frac = static_cast<float>(j) / bandSize;
+                const auto idx = (bandEdges[i] << shift) + j;
+
+                auto tmp = fft[2 * idx] * fft[2 * idx]; /* Real part */
+                tmp += fft[2 * idx + 1] * fft[2 * idx + 1]; /* Imaginary part */
+
+                bandE[i] += (1 - frac) * tmp;
+                bandE[i + 1] += frac * tmp;
+            }
+        }
+        bandE[0] *= 2;
+        bandE[numBands - 1] *= 2;
+    }
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
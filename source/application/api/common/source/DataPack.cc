@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DataPack.hpp"
+#include "log_macros.h"
+
+#include <cinttypes>
+#include <cstring>
+
+namespace arm {
+namespace app {
+
+    bool DataPack::Open(const char* path)
+    {
+        this->Close();
+        if (!this->m_file.Open(path)) {
+            return false;
+        }
+        if (!this->Attach(this->m_file.Data(), this->m_file.Size())) {
+            printf_err("%s is not a valid data pack\n", path);
+            this->m_file.Close();
+            return false;
+        }
+        info("Mapped data pack %s (%" PRIu32 " entries)\n", path, this->m_count);
+        return true;
+    }
+
+    bool DataPack::Attach(const uint8_t* base, size_t len)
+    {
+        this->m_base = nullptr;
+        this->m_entries = nullptr;
+        this->m_strings = nullptr;
+        this->m_count = 0;
+        this->m_entrySize = 0;
+
+        if (!base || len < sizeof(DataPackHeader)) {
+            printf_err("No room for a data pack header\n");
+            return false;
+        }
+
+        /* The entry table is used in place, so the pack must be aligned for it. */
+        if ((reinterpret_cast<uintptr_t>(base) % alignof(DataPackEntry)) != 0) {
+            printf_err("Data pack at 0x%p is not aligned\n", base);
+            return false;
+        }
+
+        DataPackHeader header;
+        std::memcpy(&header, base, sizeof(header));
+
+        if (header.m_magic != ms_dataPackMagic) {
+            printf_err("No data pack at 0x%p\n", base);
+            return false;
+        }
+        if (header.m_version != ms_dataPackVersion ||
+                header.m_headerSize < sizeof(DataPackHeader) ||
+                header.m_entrySize < sizeof(DataPackEntry) ||
+                (header.m_entrySize % alignof(DataPackEntry)) != 0 ||
+                (header.m_headerSize % alignof(DataPackEntry)) != 0) {
+            printf_err("Unsupported data pack version %" PRIu16 "\n", header.m_version);
+            return false;
+        }
+
+        const uint64_t tableEnd = header.m_headerSize +
+                static_cast<uint64_t>(header.m_count) * header.m_entrySize;
+        const uint64_t stringsEnd = static_cast<uint64_t>(header.m_stringsOffset) + header.m_stringsSize;
+        if (tableEnd > len || stringsEnd > len || header.m_stringsSize == 0 ||
+                base[stringsEnd - 1] != '\0') {
+            printf_err("Data pack tables exceed the %zu bytes available\n", len);
+            return false;
+        }
+
+        const uint32_t alignment = header.m_alignment ? header.m_alignment : 1;
+        if ((alignment & (alignment - 1)) != 0) {
+            printf_err("Invalid data pack alignment %" PRIu32 "\n", alignment);
+            return false;
+        }
+
+        /* Check every entry once so that the accessors need not. */
+        const uint8_t* entries = base + header.m_headerSize;
+        for (uint32_t i = 0; i < header.m_count; ++i) {
+            const auto* entry = reinterpret_cast<const DataPackEntry*>(entries + i * header.m_entrySize);
+            if (entry->m_offset > len || entry->m_size > len - entry->m_offset ||
+                    entry->m_nameOffset >= header.m_stringsSize ||
+                    entry->m_labelOffset >= header.m_stringsSize ||
+                    ((reinterpret_cast<uintptr_t>(base) + entry->m_offset) & (alignment - 1)) != 0) {
+                printf_err("Invalid data pack entry %" PRIu32 "\n", i);
+                return false;
+            }
+        }
+
+        this->m_base = base;
+        this->m_entries = entries;
+        this->m_strings = reinterpret_cast<const char*>(base + header.m_stringsOffset);
+        this->m_count = header.m_count;
+        this->m_entrySize = header.m_entrySize;
+        return true;
+    }
+
+    void DataPack::Close()
+    {
+        this->m_file.Close();
+        this->m_base = nullptr;
+        this->m_entries = nullptr;
+        this->m_strings = nullptr;
+        this->m_count = 0;
+        this->m_entrySize = 0;
+    }
+
+    uint32_t DataPack::GetCount() const
+    {
+        return this->m_count;
+    }
+
+    const DataPackEntry* DataPack::GetEntry(uint32_t idx) const
+    {
+        if (idx < this->m_count) {
+            return reinterpret_cast<const DataPackEntry*>(this->m_entries + idx * this->m_entrySize);
+        }
+        return nullptr;
+    }
+
+    const char* DataPack::GetFilename(uint32_t idx) const
+    {
+        const DataPackEntry* entry = this->GetEntry(idx);
+        return entry ? this->m_strings + entry->m_nameOffset : nullptr;
+    }
+
+    const char* DataPack::GetLabel(uint32_t idx) const
+    {
+        const DataPackEntry* entry = this->GetEntry(idx);
+        return entry ? this->m_strings + entry->m_labelOffset : nullptr;
+    }
+
+    const void* DataPack::GetData(uint32_t idx) const
+    {
+        const DataPackEntry* entry = this->GetEntry(idx);
+        return entry ? this->m_base + entry->m_offset : nullptr;
+    }
+
+    const int16_t* DataPack::GetAudioArray(uint32_t idx) const
+    {
+        const DataPackEntry* entry = this->GetEntry(idx);
+        if (entry && entry->m_type == DataPackType::Int16) {
+            return reinterpret_cast<const int16_t*>(this->m_base + entry->m_offset);
+        }
+        return nullptr;
+    }
+
+    uint32_t DataPack::GetAudioArraySize(uint32_t idx) const
+    {
+        const DataPackEntry* entry = this->GetEntry(idx);
+        if (entry && entry->m_type == DataPackType::Int16) {
+            return entry->m_size / sizeof(int16_t);
+        }
+        return 0;
+    }
+
+    const uint8_t* DataPack::GetImgArray(uint32_t idx) const
+    {
+        const DataPackEntry* entry = this->GetEntry(idx);
+        if (entry && entry->m_type == DataPackType::Uint8) {
+            return this->m_base + entry->m_offset;
+        }
+        return nullptr;
+    }
+
+} /* namespace app */
+} /* namespace arm */
@@ -16,8 +16,14 @@
  */
 #include "ImageUtils.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <limits>
 
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#endif /* defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1) */
+
 namespace arm {
 namespace app {
 namespace image {
@@ -121,6 +127,116 @@ namespace image {
         }
     }
 
+    uint32_t SumAbsDiffU8(const uint8_t* srcA, const uint8_t* srcB, const size_t len)
+    {
+        uint32_t sad = 0;
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+        int32_t remaining = static_cast<int32_t>(len);
+        while (remaining > 0) {
+            mve_pred16_t p = vctp8q(remaining);
+            uint8x16_t a = vldrbq_z_u8(srcA, p);
+            uint8x16_t b = vldrbq_z_u8(srcB, p);
+            sad = vabavq_p_u8(sad, a, b, p);
+            srcA += 16;
+            srcB += 16;
+            remaining -= 16;
+        }
+#else /* defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1) */
+        for (size_t i = 0; i < len; ++i) {
+            sad += std::abs(static_cast<int32_t>(srcA[i]) - static_cast<int32_t>(srcB[i]));
+        }
+#endif /* defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1) */
+        return sad;
+    }
+
+    FrameChangeDetector::FrameChangeDetector(const uint32_t width, const uint32_t height,
+                                             const uint32_t channels, const float threshold,
+                                             const uint32_t maxSkipFrames, const uint32_t blockSize)
+    :   m_width{width},
+        m_channels{channels},
+        m_blockSize{std::max<uint32_t>(blockSize, 1)},
+        m_gridCols{width / m_blockSize},
+        m_gridRows{height / m_blockSize},
+        m_threshold{threshold},
+        m_maxSkipFrames{maxSkipFrames},
+        m_reference(m_gridCols * m_gridRows),
+        m_current(m_gridCols * m_gridRows)
+    {}
+
+    bool FrameChangeDetector::HasChanged(const uint8_t* frame)
+    {
+        if (!frame || this->m_current.empty()) {
+            return true;
+        }
+
+        this->ComputeSignature(frame, this->m_current);
+
+        if (this->m_hasReference) {
+            const uint32_t sad = SumAbsDiffU8(this->m_current.data(),
+                                              this->m_reference.data(),
+                                              this->m_current.size());
+            this->m_lastDifference = static_cast<float>(sad) / this->m_current.size();
+        } else {
+            this->m_lastDifference = std::numeric_limits<uint8_t>::max();
+        }
+
+        const bool skipExpired = this->m_maxSkipFrames != 0 &&
+                                 this->m_skippedFrames >= this->m_maxSkipFrames;
+
+        if (!this->m_hasReference || skipExpired || this->m_threshold <= 0 ||
+            this->m_lastDifference > this->m_threshold) {
+            /* The frame that triggers inference becomes the new reference. */
+            std::swap(this->m_reference, this->m_current);
+            this->m_hasReference = true;
+            this->m_skippedFrames = 0;
+            return true;
+        }
+
+        ++this->m_skippedFrames;
+        return false;
+    }
+
+    void FrameChangeDetector::Reset()
+    {
+        this->m_hasReference = false;
+        this->m_skippedFrames = 0;
+        this->m_lastDifference = 0.f;
+    }
+
+    float FrameChangeDetector::GetLastDifference() const
+    {
+        return this->m_lastDifference;
+    }
+
+    uint32_t FrameChangeDetector::GetSkippedFrames() const
+    {
+        return this->m_skippedFrames;
+    }
+
+    void FrameChangeDetector::ComputeSignature(const uint8_t* frame,
+                                               std::vector<uint8_t>& signature) const
+    {
+        const uint32_t stride = this->m_width * this->m_channels;
+        const uint32_t blockStride = this->m_blockSize * this->m_channels;
+        const uint32_t valuesPerBlock = this->m_blockSize * blockStride;
+        uint8_t* out = signature.data();
+
+        for (uint32_t gy = 0; gy < this->m_gridRows; ++gy) {
+            const uint8_t* blockRow = frame + gy * this->m_blockSize * stride;
+            for (uint32_t gx = 0; gx < this->m_gridCols; ++gx) {
+                const uint8_t* block = blockRow + gx * blockStride;
+                uint32_t sum = 0;
+                for (uint32_t y = 0; y < this->m_blockSize; ++y) {
+                    const uint8_t* px = block + y * stride;
+                    for (uint32_t x = 0; x < blockStride; ++x) {
+                        sum += px[x];
+                    }
+                }
+                *out++ = static_cast<uint8_t>(sum / valuesPerBlock);
+            }
+        }
+    }
+
 } /* namespace image */
 } /* namespace app */
 } /* namespace arm */
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "MappedFile.hpp"
+#include "log_macros.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_SUPPORTED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* defined(__unix__) || defined(__APPLE__) */
+
+namespace arm {
+namespace app {
+
+    MappedFile::~MappedFile()
+    {
+        this->Close();
+    }
+
+#if defined(MAPPED_FILE_SUPPORTED)
+
+    bool MappedFile::Open(const char* path)
+    {
+        this->Close();
+
+        const int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            printf_err("Failed to open %s\n", path);
+            return false;
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            printf_err("Failed to get the size of %s\n", path);
+            close(fd);
+            return false;
+        }
+
+        const size_t size = static_cast<size_t>(st.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            printf_err("Failed to map %s\n", path);
+            return false;
+        }
+
+        this->m_mapping = mapping;
+        this->m_size = size;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (this->m_mapping) {
+            munmap(this->m_mapping, this->m_size);
+        }
+        this->m_mapping = nullptr;
+        this->m_size = 0;
+    }
+
+#else /* defined(MAPPED_FILE_SUPPORTED) */
+
+    bool MappedFile::Open(const char* path)
+    {
+        printf_err("Cannot map %s: files are only supported on the native platform\n", path);
+        return false;
+    }
+
+    void MappedFile::Close()
+    {
+        this->m_mapping = nullptr;
+        this->m_size = 0;
+    }
+
+#endif /* defined(MAPPED_FILE_SUPPORTED) */
+
+    const uint8_t* MappedFile::Data() const
+    {
+        return static_cast<const uint8_t*>(this->m_mapping);
+    }
+
+    size_t MappedFile::Size() const
+    {
+        return this->m_size;
+    }
+
+} /* namespace app */
+} /* namespace arm */
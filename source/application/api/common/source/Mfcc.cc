@@ -18,6 +18,7 @@
 #include "PlatformMath.hpp"
 #include "log_macros.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 
@@ -154,7 +155,7 @@ namespace audio {
 
     void MFCC::ConvertToLogarithmicScale(std::vector<float>& melEnergies)
     {
-        math::MathUtils::VecLogarithmF32(melEnergies, melEnergies);
+        math::MathUtils::VecLogarithmF32(melEnergies.data(), melEnergies.data(), melEnergies.size());
     }
 
     void MFCC::ConvertToPowerSpectrum()
@@ -225,26 +226,29 @@ namespace audio {
         return this->m_filterBankInitialised;
     }
 
-    void MFCC::MfccComputePreFeature(const std::vector<int16_t>& audioData)
+    void MFCC::MfccComputePreFeature(const int16_t* audioData, const size_t audioDataLen)
     {
         this->InitMelFilterBank();
 
         /* TensorFlow way of normalizing .wav data to (-1, 1). */
         constexpr float normaliser = 1.0/(1u<<15u);
-        for (size_t i = 0; i < this->m_params.m_frameLen; i++) {
+        const size_t numSamples = std::min<size_t>(audioDataLen, this->m_params.m_frameLen);
+        for (size_t i = 0; i < numSamples; i++) {
             this->m_frame[i] = static_cast<float>(audioData[i]) * normaliser;
         }
 
         /* Apply window function to input frame. */
-        for(size_t i = 0; i < this->m_params.m_frameLen; i++) {
+        for(size_t i = 0; i < numSamples; i++) {
             this->m_frame[i] *= this->m_windowFunc[i];
         }
 
         /* Set remaining frame values to 0. */
-        std::fill(this->m_frame.begin() + this->m_params.m_frameLen,this->m_frame.end(), 0);
+        std::fill(this->m_frame.begin() + numSamples, this->m_frame.end(), 0);
 
         /* Compute FFT. */
-        math::MathUtils::FftF32(this->m_frame, this->m_buffer, this->m_fftInstance);
+        math::MathUtils::FftF32(this->m_frame.data(), this->m_frame.size(),
+                                this->m_buffer.data(), this->m_buffer.size(),
+                                this->m_fftInstance);
 
         /* Convert to power spectrum. */
         this->ConvertToPowerSpectrum();
@@ -264,23 +268,32 @@ namespace audio {
 
     std::vector<float> MFCC::MfccCompute(const std::vector<int16_t>& audioData)
     {
-        this->MfccComputePreFeature(audioData);
+        return this->MfccCompute(audioData.data(), audioData.size());
+    }
 
+    std::vector<float> MFCC::MfccCompute(const int16_t* audioData, const size_t audioDataLen)
+    {
         std::vector<float> mfccOut(this->m_params.m_numMfccFeatures);
+        this->MfccCompute(audioData, audioDataLen, mfccOut.data());
+        return mfccOut;
+    }
+
+    void MFCC::MfccCompute(const int16_t* audioData, const size_t audioDataLen, float* mfccOut)
+    {
+        this->MfccComputePreFeature(audioData, audioDataLen);
 
         float * ptrMel = this->m_melEnergies.data();
         float * ptrDct = this->m_dctMatrix.data();
-        float * ptrMfcc = mfccOut.data();
+        float * ptrMfcc = mfccOut;
 
         /* Take DCT. Uses matrix mul. */
-        for (size_t i = 0, j = 0; i < mfccOut.size();
+        for (size_t i = 0, j = 0; i < this->m_params.m_numMfccFeatures;
                     ++i, j += this->m_params.m_numFbankBins) {
             *ptrMfcc++ = math::MathUtils::DotProductF32(
                                             ptrDct + j,
                                             ptrMel,
                                             this->m_params.m_numFbankBins);
         }
-        return mfccOut;
     }
 
     std::vector<std::vector<float>> MFCC::CreateMelFilterBank()
@@ -17,7 +17,9 @@
 #include "Model.hpp"
 #include "log_macros.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 /* Initialise the model */
 arm::app::Model::~Model()
@@ -127,6 +129,10 @@ bool arm::app::Model::Init(uint8_t* tensorArenaAddr,
         this->LogInterpreterInfo();
     }
 
+    if (!this->CheckStates()) {
+        return false;
+    }
+
     this->m_inited = true;
     return true;
 }
@@ -263,6 +269,134 @@ bool arm::app::Model::RunInference()
     return inference_state;
 }
 
+bool arm::app::Model::BindState(size_t outputIndex, size_t inputIndex)
+{
+    this->m_states.push_back({outputIndex, inputIndex});
+    if (this->m_inited && !this->CheckStates()) {
+        this->m_states.pop_back();
+        return false;
+    }
+    return true;
+}
+
+const std::vector<arm::app::StateBinding>& arm::app::Model::GetStateBindings() const
+{
+    return this->m_states;
+}
+
+bool arm::app::Model::CheckStates()
+{
+    size_t stateSize = 0;
+    for (const auto& state : this->m_states) {
+        const TfLiteTensor* output = this->GetOutputTensor(state.m_outputIndex);
+        const TfLiteTensor* input = this->GetInputTensor(state.m_inputIndex);
+        if (!output || !input || output->type != input->type || output->bytes != input->bytes) {
+            printf_err("Output %zu can't be bound as the state of input %zu\n",
+                       state.m_outputIndex, state.m_inputIndex);
+            return false;
+        }
+        stateSize += input->bytes;
+    }
+    this->m_stateStaging.resize(stateSize);
+    return true;
+}
+
+void arm::app::Model::ResetStates()
+{
+    for (const auto& state : this->m_states) {
+        TfLiteTensor* input = this->GetInputTensor(state.m_inputIndex);
+        const int zeroPoint = GetTensorQuantParams(input).offset;
+        switch (input->type) {
+            case kTfLiteInt8:
+            case kTfLiteUInt8:
+                std::memset(input->data.data, zeroPoint, input->bytes);
+                break;
+            case kTfLiteInt16:
+                std::fill_n(tflite::GetTensorData<int16_t>(input), input->bytes / sizeof(int16_t),
+                            static_cast<int16_t>(zeroPoint));
+                break;
+            default:
+                std::memset(input->data.data, 0, input->bytes);
+                break;
+        }
+    }
+}
+
+/* Whether [a, a + aLen) and [b, b + bLen) share any byte. */
+static bool Overlaps(const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen)
+{
+    return a < b + bLen && b < a + aLen;
+}
+
+bool arm::app::Model::CarryStates()
+{
+    if (!this->m_inited) {
+        printf_err("Model is not initialised\n");
+        return false;
+    }
+
+    /* TFLu can place an input state in the memory of another output state. */
+    bool staged = false;
+    for (const auto& state : this->m_states) {
+        const TfLiteTensor* input = this->GetInputTensor(state.m_inputIndex);
+        for (const auto& other : this->m_states) {
+            const TfLiteTensor* output = this->GetOutputTensor(other.m_outputIndex);
+            const bool inPlace = &other == &state && output->data.data == input->data.data;
+            if (!inPlace && Overlaps(input->data.uint8, input->bytes, output->data.uint8, output->bytes)) {
+                staged = true;
+            }
+        }
+    }
+
+    if (!staged) {
+        for (const auto& state : this->m_states) {
+            const TfLiteTensor* output = this->GetOutputTensor(state.m_outputIndex);
+            TfLiteTensor* input = this->GetInputTensor(state.m_inputIndex);
+            if (input->data.data != output->data.data) {
+                std::memcpy(input->data.data, output->data.data, input->bytes);
+            }
+        }
+        return true;
+    }
+
+    return this->SaveStates(this->m_stateStaging.data(), this->m_stateStaging.size()) &&
+           this->RestoreStates(this->m_stateStaging.data(), this->m_stateStaging.size());
+}
+
+size_t arm::app::Model::GetStateSize() const
+{
+    /* The staging buffer holds all the states. */
+    return this->m_stateStaging.size();
+}
+
+bool arm::app::Model::SaveStates(uint8_t* snapshot, size_t size) const
+{
+    if (!this->m_inited || !snapshot || size < this->GetStateSize()) {
+        printf_err("No room to save the model states\n");
+        return false;
+    }
+    for (const auto& state : this->m_states) {
+        const TfLiteTensor* output = this->GetOutputTensor(state.m_outputIndex);
+        std::memcpy(snapshot, output->data.data, output->bytes);
+        snapshot += output->bytes;
+    }
+    return true;
+}
+
+bool arm::app::Model::RestoreStates(const uint8_t* snapshot, size_t size)
+{
+    if (!this->m_inited || !snapshot || size < this->GetStateSize()) {
+        printf_err("Invalid model states snapshot\n");
+        return false;
+    }
+    for (const auto& state : this->m_states) {
+        TfLiteTensor* input = this->GetInputTensor(state.m_inputIndex);
+        std::memcpy(input->data.data, snapshot, input->bytes);
+        snapshot += input->bytes;
+    }
+    return true;
+}
+
 TfLiteTensor* arm::app::Model::GetInputTensor(size_t index) const
 {
     if (index < this->GetNumInputs()) {
@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ModelLoader.hpp"
+#include "log_macros.h"
+
+#include <cinttypes>
+#include <cstring>
+
+namespace arm {
+namespace app {
+
+    /* Flatbuffers place the file identifier after the root table offset. */
+    static constexpr size_t ms_tfliteIdentifierOffset = 4;
+    static const char ms_tfliteIdentifier[] = "TFL3";
+
+    uint32_t Crc32(const uint8_t* data, size_t len)
+    {
+        /* Nibble-wise table: small enough for flash, fast enough to check a model once. */
+        static const uint32_t table[16] = {
+            0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+            0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+            0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+            0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+        };
+
+        uint32_t crc = 0xFFFFFFFF;
+        for (size_t i = 0; i < len; ++i) {
+            crc ^= data[i];
+            crc = (crc >> 4) ^ table[crc & 0xF];
+            crc = (crc >> 4) ^ table[crc & 0xF];
+        }
+        return ~crc;
+    }
+
+    bool IsTfliteModel(const uint8_t* data, size_t len)
+    {
+        const size_t idLen = sizeof(ms_tfliteIdentifier) - 1;
+        return data && len >= ms_tfliteIdentifierOffset + idLen &&
+               0 == std::memcmp(data + ms_tfliteIdentifierOffset, ms_tfliteIdentifier, idLen);
+    }
+
+    bool LoadModelFromContainer(const uint8_t* base, size_t len, LoadedModel& model)
+    {
+        if (!base || len < sizeof(ModelContainerHeader)) {
+            printf_err("No room for a model container header\n");
+            return false;
+        }
+
+        /* The container may sit anywhere in flash: read the header without alignment assumptions. */
+        ModelContainerHeader header;
+        std::memcpy(&header, base, sizeof(header));
+
+        if (header.m_magic != ms_modelContainerMagic) {
+            printf_err("No model container at 0x%p\n", base);
+            return false;
+        }
+        if (header.m_version != ms_modelContainerVersion ||
+                header.m_headerSize < sizeof(ModelContainerHeader)) {
+            printf_err("Unsupported model container version %" PRIu16 "\n", header.m_version);
+            return false;
+        }
+        if (header.m_modelOffset < header.m_headerSize ||
+                header.m_modelOffset > len ||
+                header.m_modelSize > len - header.m_modelOffset) {
+            printf_err("Model (%" PRIu32 " bytes at offset %" PRIu32 ") exceeds the %zu bytes available\n",
+                       header.m_modelSize, header.m_modelOffset, len);
+            return false;
+        }
+
+        const uint8_t* data = base + header.m_modelOffset;
+        const uint32_t alignment = header.m_alignment ? header.m_alignment : 1;
+        if ((alignment & (alignment - 1)) != 0 ||
+                (reinterpret_cast<uintptr_t>(data) & (alignment - 1)) != 0) {
+            printf_err("Model at 0x%p is not aligned to %" PRIu32 " bytes\n", data, alignment);
+            return false;
+        }
+
+        const uint32_t crc = Crc32(data, header.m_modelSize);
+        if (crc != header.m_modelCrc32) {
+            printf_err("Model CRC mismatch: 0x%08" PRIx32 ", expected 0x%08" PRIx32 "\n",
+                       crc, header.m_modelCrc32);
+            return false;
+        }
+
+        if (!IsTfliteModel(data, header.m_modelSize)) {
+            printf_err("Model container does not hold a TensorFlow Lite model\n");
+            return false;
+        }
+
+        model.m_data = data;
+        model.m_size = header.m_modelSize;
+        model.m_arenaHint = header.m_arenaHint;
+        debug("Model container: %zu bytes at 0x%p, arena hint %" PRIu32 " bytes\n",
+              model.m_size, model.m_data, model.m_arenaHint);
+        return true;
+    }
+
+    bool ModelFitsArena(const LoadedModel& model, size_t arenaSize)
+    {
+        if (model.m_arenaHint > arenaSize) {
+            printf_err("Model needs a %" PRIu32 " byte tensor arena, only %zu bytes available\n",
+                       model.m_arenaHint, arenaSize);
+            return false;
+        }
+        return true;
+    }
+
+    bool ModelFile::Open(const char* path)
+    {
+        this->Close();
+        if (!this->m_file.Open(path)) {
+            return false;
+        }
+
+        const uint8_t* data = this->m_file.Data();
+        const size_t size = this->m_file.Size();
+        bool loaded = false;
+        if (IsTfliteModel(data, size)) {
+            this->m_model.m_data = data;
+            this->m_model.m_size = size;
+            this->m_model.m_arenaHint = 0;
+            loaded = true;
+        } else {
+            loaded = LoadModelFromContainer(data, size, this->m_model);
+        }
+
+        if (!loaded) {
+            printf_err("%s does not hold a valid model\n", path);
+            this->Close();
+            return false;
+        }
+        info("Mapped model %s (%zu bytes)\n", path, this->m_model.m_size);
+        return true;
+    }
+
+    void ModelFile::Close()
+    {
+        this->m_file.Close();
+        this->m_model = LoadedModel{};
+    }
+
+    const LoadedModel& ModelFile::GetModel() const
+    {
+        return this->m_model;
+    }
+
+} /* namespace app */
+} /* namespace arm */
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "StreamScheduler.hpp"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace arm {
+namespace app {
+
+    StreamState::StreamState(const Model& model)
+    :   m_snapshot(model.GetStateSize())
+    {}
+
+    void StreamState::Reset()
+    {
+        this->m_started = false;
+    }
+
+    bool StreamState::RunInference(Model& model)
+    {
+        if (!this->m_started) {
+            model.ResetStates();
+        } else if (!model.RestoreStates(this->m_snapshot.data(), this->m_snapshot.size())) {
+            return false;
+        }
+
+        if (!model.RunInference()) {
+            return false;
+        }
+
+        /* Saved straight away, before the next inputs are written (see Model::BindState). */
+        this->m_started = model.SaveStates(this->m_snapshot.data(), this->m_snapshot.size());
+        return this->m_started;
+    }
+
+    double StreamLatency::MeanUs() const
+    {
+        return this->m_frames ? static_cast<double>(this->m_totalUs) / this->m_frames : 0;
+    }
+
+    StreamScheduler::StreamScheduler(size_t numStreams, uint64_t framePeriodUs, Clock clock)
+    :   m_latency(numStreams),
+        m_framePeriodUs{framePeriodUs},
+        m_clock{std::move(clock)}
+    {}
+
+    bool StreamScheduler::RunRound(const FrameFn& processFrame)
+    {
+        const size_t numStreams = this->m_latency.size();
+        const uint64_t roundStart = this->m_clock();
+        uint64_t latency = 0;
+
+        for (size_t i = 0; i < numStreams; ++i) {
+            const size_t stream = (this->m_first + i) % numStreams;
+            if (!processFrame(stream)) {
+                printf_err("Failed to process a frame of stream %zu\n", stream);
+                return false;
+            }
+
+            latency = this->m_clock() - roundStart;
+            StreamLatency& stats = this->m_latency[stream];
+            ++stats.m_frames;
+            stats.m_totalUs += latency;
+            stats.m_maxUs = std::max(stats.m_maxUs, latency);
+            if (latency > this->m_framePeriodUs) {
+                ++stats.m_misses;
+                debug("Stream %zu missed its deadline by %" PRIu64 " us\n",
+                      stream, latency - this->m_framePeriodUs);
+            }
+        }
+
+        ++this->m_rounds;
+        if (latency > this->m_framePeriodUs) {
+            ++this->m_roundMisses;
+        }
+        this->m_first = numStreams ? (this->m_first + 1) % numStreams : 0;
+        return true;
+    }
+
+    size_t StreamScheduler::GetNumStreams() const
+    {
+        return this->m_latency.size();
+    }
+
+    const StreamLatency& StreamScheduler::GetLatency(size_t stream) const
+    {
+        return this->m_latency.at(stream);
+    }
+
+    uint32_t StreamScheduler::GetRounds() const
+    {
+        return this->m_rounds;
+    }
+
+    uint32_t StreamScheduler::GetRoundMisses() const
+    {
+        return this->m_roundMisses;
+    }
+
+    void StreamScheduler::PrintReport() const
+    {
+        info("Rounds: %" PRIu32 ", over the %" PRIu64 " us frame period: %" PRIu32 "\n",
+             this->m_rounds, this->m_framePeriodUs, this->m_roundMisses);
+        for (size_t i = 0; i < this->m_latency.size(); ++i) {
+            const StreamLatency& stats = this->m_latency[i];
+            info("Stream %zu: %" PRIu32 " frames, latency mean %.0f us, max %" PRIu64
+                 " us, deadline misses: %" PRIu32 "\n",
+                 i, stats.m_frames, stats.MeanUs(), stats.m_maxUs, stats.m_misses);
+        }
+    }
+
+} /* namespace app */
+} /* namespace arm */
@@ -0,0 +1,178 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "VoiceActivityDetector.hpp"
+#include "AudioUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    /* Band edges (Hz) used for the spectral check; the speech range is 300-4000 Hz. */
+    static constexpr float ms_bandEdgesHz[] = {0.f, 300.f, 600.f, 1000.f, 2000.f, 4000.f};
+    static constexpr size_t ms_speechBandFirst = 1;
+    static constexpr size_t ms_speechBandLast = 5;
+
+    VoiceActivityDetector::VoiceActivityDetector(const VadParams& params)
+    :   m_params{params},
+        m_frameBuf(params.m_frameLen),
+        m_fftBuf(params.m_frameLen + 2),
+        m_pending(params.m_frameLen),
+        m_noiseFloorDb{params.m_minEnergyDb}
+    {
+        math::MathUtils::FftInitF32(this->m_params.m_frameLen, this->m_fftInstance);
+
+        /* Convert the band edges to FFT bins; the last band ends at Nyquist. */
+        const float binsPerHz = this->m_params.m_frameLen / this->m_params.m_samplingFreq;
+        const uint32_t nyquistBin = this->m_params.m_frameLen / 2;
+        for (float edgeHz : ms_bandEdgesHz) {
+            const auto bin = static_cast<uint32_t>(edgeHz * binsPerHz + 0.5f);
+            this->m_bandEdges.emplace_back(std::min(bin, nyquistBin));
+        }
+        this->m_bandEdges.emplace_back(nyquistBin);
+        this->m_bandEnergy = std::vector<float>(this->m_bandEdges.size());
+    }
+
+    bool VoiceActivityDetector::IsVoiceActive(const int16_t* data, const size_t len)
+    {
+        bool active = false;
+        bool processed = false;
+        const size_t frameLen = this->m_params.m_frameLen;
+        size_t i = 0;
+
+        /* Complete the frame started by the previous block first. */
+        if (this->m_pendingLen > 0) {
+            i = std::min(frameLen - this->m_pendingLen, len);
+            std::copy(data, data + i, this->m_pending.begin() + this->m_pendingLen);
+            this->m_pendingLen += i;
+            if (this->m_pendingLen < frameLen) {
+                return this->m_lastActive;
+            }
+            active = this->ProcessFrame(this->m_pending.data());
+            processed = true;
+            this->m_pendingLen = 0;
+        }
+
+        /* Every frame is processed, even after activity is found, to keep the
+         * noise floor and hangover up to date. */
+        for (; i + frameLen <= len; i += frameLen) {
+            active |= this->ProcessFrame(data + i);
+            processed = true;
+        }
+
+        /* Keep the rest for the next block. */
+        std::copy(data + i, data + len, this->m_pending.begin());
+        this->m_pendingLen = len - i;
+
+        return processed ? active : this->m_lastActive;
+    }
+
+    bool VoiceActivityDetector::ProcessFrame(const int16_t* frame)
+    {
+        const size_t frameLen = this->m_params.m_frameLen;
+        constexpr float normaliser = 1.f / (1 << 15);
+
+        float sumSq = 0.f;
+        uint32_t crossings = 0;
+        for (size_t i = 0; i < frameLen; ++i) {
+            const float sample = frame[i] * normaliser;
+            sumSq += sample * sample;
+            if (i > 0) {
+                crossings += (frame[i] < 0) != (frame[i - 1] < 0);
+            }
+        }
+
+        const float energyDb = 10.f * log10f(sumSq / frameLen + 1e-10f);
+
+        bool active = false;
+        if (energyDb >= this->m_params.m_minEnergyDb &&
+            energyDb >= this->m_noiseFloorDb + this->m_params.m_energyMarginDb) {
+
+            const float zcr = static_cast<float>(crossings) / frameLen;
+            if (zcr >= this->m_params.m_minZcr && zcr <= this->m_params.m_maxZcr) {
+                active = true;
+            } else {
+                active = this->SpeechBandRatio(frame) >= this->m_params.m_minSpeechBandRatio;
+            }
+        }
+
+        /* Minimum tracking: follow drops immediately, rises slowly. */
+        if (energyDb < this->m_noiseFloorDb) {
+            this->m_noiseFloorDb = energyDb;
+        } else {
+            this->m_noiseFloorDb += this->m_params.m_noiseFloorRise * (energyDb - this->m_noiseFloorDb);
+        }
+
+        if (active) {
+            this->m_hangoverLeft = this->m_params.m_hangoverFrames;
+        } else if (this->m_hangoverLeft > 0) {
+            --this->m_hangoverLeft;
+            active = true;
+        }
+
+        this->m_lastActive = active;
+        return active;
+    }
+
+    void VoiceActivityDetector::Reset()
+    {
+        this->m_noiseFloorDb = this->m_params.m_minEnergyDb;
+        this->m_hangoverLeft = 0;
+        this->m_pendingLen = 0;
+        this->m_lastActive = false;
+    }
+
+    size_t VoiceActivityDetector::GetNumPendingSamples() const
+    {
+        return this->m_pendingLen;
+    }
+
+    float VoiceActivityDetector::GetNoiseFloorDb() const
+    {
+        return this->m_noiseFloorDb;
+    }
+
+    float VoiceActivityDetector::SpeechBandRatio(const int16_t* frame)
+    {
+        std::copy(frame, frame + this->m_params.m_frameLen, this->m_frameBuf.begin());
+        math::MathUtils::FftF32(this->m_frameBuf, this->m_fftBuf, this->m_fftInstance);
+
+        /* Place the Nyquist element as its own real and imaginary pair. */
+        this->m_fftBuf[this->m_fftBuf.size() - 2] = this->m_fftBuf[1];
+        this->m_fftBuf[this->m_fftBuf.size() - 1] = 0;
+        this->m_fftBuf[1] = 0;
+
+        ComputeBandEnergy(this->m_fftBuf.data(), this->m_bandEdges.data(),
+                          this->m_bandEdges.size(), 0, this->m_bandEnergy.data());
+
+        float total = 0.f;
+        float speech = 0.f;
+        for (size_t i = 0; i < this->m_bandEnergy.size(); ++i) {
+            total += this->m_bandEnergy[i];
+            if (i >= ms_speechBandFirst && i <= ms_speechBandLast) {
+                speech += this->m_bandEnergy[i];
+            }
+        }
+
+        return total > 0.f ? speech / total : 0.f;
+    }
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "WavFile.hpp"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+namespace arm {
+namespace app {
+namespace audio {
+
+    /* WAV fields are little endian, whatever the host is. */
+    static uint16_t GetU16(const uint8_t* p)
+    {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    static uint32_t GetU32(const uint8_t* p)
+    {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    static void PutU16(uint8_t* p, uint16_t value)
+    {
+        p[0] = static_cast<uint8_t>(value);
+        p[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    static void PutU32(uint8_t* p, uint32_t value)
+    {
+        PutU16(p, static_cast<uint16_t>(value));
+        PutU16(p + 2, static_cast<uint16_t>(value >> 16));
+    }
+
+    using FilePtr = std::unique_ptr<FILE, int (*)(FILE*)>;
+
+    bool ReadWav(const char* path, std::vector<int16_t>& samples, uint32_t& sampleRate)
+    {
+        constexpr uint16_t formatPcm = 1;
+        constexpr uint16_t formatExtensible = 0xFFFE;
+
+        samples.clear();
+        FilePtr file(std::fopen(path, "rb"), &std::fclose);
+        if (!file) {
+            printf_err("Failed to open %s\n", path);
+            return false;
+        }
+
+        uint8_t riff[12];
+        if (std::fread(riff, 1, sizeof(riff), file.get()) != sizeof(riff) ||
+                0 != std::memcmp(riff, "RIFF", 4) || 0 != std::memcmp(riff + 8, "WAVE", 4)) {
+            printf_err("%s is not a WAV file\n", path);
+            return false;
+        }
+
+        uint16_t numChannels = 0;
+        uint8_t chunk[8];
+        while (std::fread(chunk, 1, sizeof(chunk), file.get()) == sizeof(chunk)) {
+            const uint32_t chunkSize = GetU32(chunk + 4);
+
+            if (0 == std::memcmp(chunk, "fmt ", 4)) {
+                uint8_t fmt[16];
+                if (chunkSize < sizeof(fmt) ||
+                        std::fread(fmt, 1, sizeof(fmt), file.get()) != sizeof(fmt)) {
+                    break;
+                }
+                const uint16_t format = GetU16(fmt);
+                numChannels = GetU16(fmt + 2);
+                sampleRate = GetU32(fmt + 4);
+                if ((format != formatPcm && format != formatExtensible) ||
+                        GetU16(fmt + 14) != 16 || numChannels == 0) {
+                    printf_err("%s is not 16-bit PCM\n", path);
+                    return false;
+                }
+                std::fseek(file.get(), (chunkSize - sizeof(fmt)) + (chunkSize & 1), SEEK_CUR);
+            } else if (0 == std::memcmp(chunk, "data", 4)) {
+                if (numChannels == 0) {
+                    break;
+                }
+                const size_t numFrames = chunkSize / (2 * numChannels);
+                std::vector<uint8_t> data(numFrames * 2 * numChannels);
+                const size_t bytesRead = std::fread(data.data(), 1, data.size(), file.get());
+                const size_t framesRead = bytesRead / (2 * numChannels);
+
+                samples.resize(framesRead);
+                for (size_t i = 0; i < framesRead; ++i) {
+                    int32_t sum = 0;
+                    for (size_t ch = 0; ch < numChannels; ++ch) {
+                        sum += static_cast<int16_t>(GetU16(&data[(i * numChannels + ch) * 2]));
+                    }
+                    samples[i] = static_cast<int16_t>(sum / numChannels);
+                }
+                if (framesRead != numFrames) {
+                    warn("%s is truncated, %zu of %zu samples read\n", path, framesRead, numFrames);
+                }
+                return true;
+            } else {
+                /* Chunks are padded to an even size. */
+                std::fseek(file.get(), chunkSize + (chunkSize & 1), SEEK_CUR);
+            }
+        }
+
+        printf_err("No PCM data found in %s\n", path);
+        return false;
+    }
+
+    bool WriteWav(const char* path, const int16_t* samples, size_t numSamples, uint32_t sampleRate)
+    {
+        constexpr size_t headerSize = 44;
+        const uint32_t dataSize = static_cast<uint32_t>(numSamples * sizeof(int16_t));
+
+        uint8_t header[headerSize];
+        std::memcpy(header, "RIFF", 4);
+        PutU32(header + 4, dataSize + headerSize - 8);
+        std::memcpy(header + 8, "WAVEfmt ", 8);
+        PutU32(header + 16, 16);                /* fmt chunk size. */
+        PutU16(header + 20, 1);                 /* PCM. */
+        PutU16(header + 22, 1);                 /* Mono. */
+        PutU32(header + 24, sampleRate);
+        PutU32(header + 28, sampleRate * sizeof(int16_t));
+        PutU16(header + 32, sizeof(int16_t));   /* Block alignment. */
+        PutU16(header + 34, 16);                /* Bits per sample. */
+        std::memcpy(header + 36, "data", 4);
+        PutU32(header + 40, dataSize);
+
+        FilePtr file(std::fopen(path, "wb"), &std::fclose);
+        if (!file) {
+            printf_err("Failed to open %s\n", path);
+            return false;
+        }
+
+        bool ok = std::fwrite(header, 1, headerSize, file.get()) == headerSize;
+        uint8_t block[512];
+        for (size_t i = 0; ok && i < numSamples;) {
+            const size_t count = std::min(numSamples - i, sizeof(block) / sizeof(int16_t));
+            for (size_t j = 0; j < count; ++j) {
+                PutU16(block + 2 * j, static_cast<uint16_t>(samples[i + j]));
+            }
+            ok = std::fwrite(block, sizeof(int16_t), count, file.get()) == count;
+            i += count;
+        }
+        ok = (0 == std::fclose(file.release())) && ok;
+
+        if (!ok) {
+            printf_err("Failed to write %s\n", path);
+        }
+        return ok;
+    }
+
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
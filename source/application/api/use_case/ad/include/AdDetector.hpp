@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AD_DETECTOR_HPP
+#define AD_DETECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arm {
+namespace app {
+namespace ad {
+
+    /* Anomaly detection decision engine parameters. */
+    struct AdDetectorParams {
+        float       m_threshold{-0.8f};     /* Smoothed anomaly score above which a machine is anomalous. */
+        float       m_smoothing{0.3f};      /* Weight of the newest window in the smoothed score, in (0, 1]. */
+        float       m_margin{0.1f};         /* Distance to the threshold from which the score is conclusive. */
+        uint32_t    m_minWindows{3};        /* Windows needed before the score can be conclusive. */
+        size_t      m_eventHistoryLen{8};   /* Number of recent events kept. */
+        uint32_t    m_meanWindowLen{0};     /* Windows the mean score is taken over before it restarts,
+                                             * 0 for all the windows since the last reset. */
+    };
+
+    /* State of the machine according to the smoothed anomaly score. */
+    enum class AdDecision {
+        undecided,  /* Too few windows, or the score is too close to the threshold. */
+        normal,     /* Conclusively below the threshold. */
+        anomalous   /* Conclusively above the threshold. */
+    };
+
+    /* Change of state of the machine. */
+    struct AdEvent {
+        bool        m_anomalous;        /* Whether an anomaly started, rather than ended. */
+        float       m_score;            /* Smoothed score at the change. */
+        float       m_timeStamp;        /* Audio timestamp of the change in seconds. */
+        uint32_t    m_windowNumber;     /* Update the event was raised at. */
+    };
+
+    /**
+     * @brief   Streaming anomaly detection decision engine.
+     *          The anomaly scores of successive windows are smoothed with an
+     *          exponentially weighted moving average. Once enough windows are
+     *          in, the score is conclusive when it is at least the margin away
+     *          from the threshold: a recording can then be classified early,
+     *          skipping its remaining windows. When monitoring continuously,
+     *          an event is raised as the machine conclusively becomes
+     *          anomalous, then again once it is conclusively back to normal;
+     *          the mean score should then be bounded to a number of windows.
+     *          No memory is allocated after construction.
+     */
+    class AdDetector {
+    public:
+        /**
+         * @brief       Constructor.
+         * @param[in]   params   Decision engine parameters.
+         **/
+        explicit AdDetector(const AdDetectorParams& params);
+
+        AdDetector() = delete;
+
+        ~AdDetector() = default;
+
+        /**
+         * @brief       Adds the anomaly score of one window and runs the decision.
+         * @param[in]   score       Anomaly score of the window, higher being more anomalous.
+         * @param[in]   timeStamp   Audio timestamp of the end of the window in seconds.
+         * @return      true if an event was raised, false otherwise.
+         **/
+        bool Update(float score, float timeStamp);
+
+        /** @brief  Clears the scores, state and events, eg for a new recording. */
+        void Reset();
+
+        /** @brief  Gets the decision after the last update. */
+        AdDecision GetDecision() const;
+
+        /** @brief  Gets the smoothed score after the last update. */
+        float GetSmoothedScore() const;
+
+        /**
+         * @brief   Gets the mean score over the windows since the last reset,
+         *          or over the current mean window if one is set.
+         **/
+        float GetMeanScore() const;
+
+        /** @brief  Gets the number of windows since the last reset, saturating. */
+        uint32_t GetWindowCount() const;
+
+        /** @brief  Gets the number of events kept in the history. */
+        size_t GetEventCount() const;
+
+        /**
+         * @brief       Gets an event from the history.
+         * @param[in]   i   Event index, 0 being the oldest kept event.
+         * @return      Reference to the event.
+         **/
+        const AdEvent& GetEvent(size_t i) const;
+
+        /** @brief  Gets the most recent event; only valid if GetEventCount() > 0. */
+        const AdEvent& GetLastEvent() const;
+
+    private:
+        AdDetectorParams        m_params;
+        std::vector<AdEvent>    m_events;               /* Event history ring. */
+        size_t                  m_eventHead{0};         /* Next event slot to write. */
+        size_t                  m_eventCount{0};        /* Number of valid events. */
+        float                   m_smoothed{0.f};        /* Smoothed score. */
+        float                   m_sum{0.f};             /* Sum of the scores of the mean window. */
+        uint32_t                m_meanCount{0};         /* Number of scores in m_sum. */
+        uint32_t                m_windowCount{0};       /* Number of updates so far, saturating. */
+        AdDecision              m_decision{AdDecision::undecided};
+        bool                    m_anomalous{false};     /* Whether an anomaly was reported and not ended. */
+    };
+
+} /* namespace ad */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* AD_DETECTOR_HPP */
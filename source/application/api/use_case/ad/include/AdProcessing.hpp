@@ -79,6 +79,7 @@ namespace app {
 
     private:
         bool        m_validInstance{false}; /**< Indicates the current object is valid. */
+        TfLiteTensor* m_inputTensor{}; /**< Model input tensor. */
         uint32_t    m_melSpectrogramFrameLen{}; /**< MEL spectrogram's window frame length */
         uint32_t    m_melSpectrogramFrameStride{}; /**< MEL spectrogram's window frame stride */
         uint8_t     m_inputResizeScale{}; /**< Downscaling factor for the MEL energy matrix. */
@@ -87,11 +88,34 @@ namespace app {
         uint32_t    m_audioDataStride{}; /**< Audio window stride computed. */
         uint32_t    m_numReusedFeatureVectors{}; /**< Number of MEL vectors that can be re-used */
         uint32_t    m_audioWindowIndex{}; /**< Current audio window index (from audio's sliding window) */
+        float       m_trainingMean{}; /**< Training mean subtracted from the features. */
+        float       m_quantScale{}; /**< Input tensor quantisation scale, if quantised. */
+        int         m_quantOffset{}; /**< Input tensor quantisation offset, if quantised. */
+        uint32_t    m_numFeatures{}; /**< Downsampled MEL bins in a feature vector. */
+        uint32_t    m_numFeatureVectors{}; /**< Feature vectors (time steps) in an input. */
 
         audio::SlidingWindow<const int16_t> m_melWindowSlider; /**< Internal MEL spectrogram window slider */
         audio::AdMelSpectrogram m_melSpec; /**< MEL spectrogram computation object */
-        std::function<void
-            (std::vector<int16_t>&, int, bool, size_t, size_t)> m_featureCalc; /**< Feature calculator object */
+        std::vector<uint8_t> m_featureRing; /**< Features of the current window, one row per feature vector;
+                                             *   not kept in the input tensor (see Model::BindState). */
+        size_t      m_featureRowSize{}; /**< Size of one row of m_featureRing in bytes. */
+        size_t      m_featureRingStart{}; /**< Row of m_featureRing holding the oldest feature vector. */
+
+        /**
+         * @brief Computes the MEL spectrogram of a frame and writes it, downsampled,
+         *        mean subtracted and quantised as the input tensor is, to a feature row.
+         * @param[in]  melSpecWindow  Audio frame.
+         * @param[out] row            Destination row of m_featureRing.
+         */
+        void ComputeFeatureRow(const int16_t* melSpecWindow, uint8_t* row);
+
+        /**
+         * @brief Copies the feature ring to the input tensor, oldest vector first,
+         *        transposed to the tensor's one row per MEL bin layout.
+         * @tparam T  Input tensor data type.
+         */
+        template<typename T>
+        void CopyFeaturesToTensor();
     };
 
     class AdPostProcess : public BasePostProcess {
@@ -144,7 +168,7 @@ namespace app {
             /* For getting the floating point values, we need quantization parameters */
             QuantParams quantParams = GetTensorQuantParams(tensor);
 
-            this->m_dequantizedOutputVec = std::vector<float>(totalOutputSize, 0);
+            this->m_dequantizedOutputVec.resize(totalOutputSize);
 
             for (size_t i = 0; i < totalOutputSize; ++i) {
                 this->m_dequantizedOutputVec[i] = quantParams.scale * (tensorData[i] - quantParams.offset);
@@ -157,74 +181,6 @@ namespace app {
     /* Templated instances available: */
     template bool AdPostProcess::Dequantize<int8_t>();
 
-    /**
-     * @brief Generic feature calculator factory.
-     *
-     * Returns lambda function to compute features using features cache.
-     * Real features math is done by a lambda function provided as a parameter.
-     * Features are written to input tensor memory.
-     *
-     * @tparam T            feature vector type.
-     * @param inputTensor   model input tensor pointer.
-     * @param cacheSize     number of feature vectors to cache. Defined by the sliding window overlap.
-     * @param compute       features calculator function.
-     * @return              lambda function to compute features.
-     */
-    template<class T>
-    std::function<void (std::vector<int16_t>&, size_t, bool, size_t, size_t)>
-    FeatureCalc(TfLiteTensor* inputTensor, size_t cacheSize,
-                std::function<std::vector<T> (std::vector<int16_t>& )> compute)
-    {
-        /* Feature cache to be captured by lambda function*/
-        static std::vector<std::vector<T>> featureCache = std::vector<std::vector<T>>(cacheSize);
-
-        return [=](std::vector<int16_t>& audioDataWindow,
-                   size_t index,
-                   bool useCache,
-                   size_t featuresOverlapIndex,
-                   size_t resizeScale)
-        {
-            T* tensorData = tflite::GetTensorData<T>(inputTensor);
-            std::vector<T> features;
-
-            /* Reuse features from cache if cache is ready and sliding windows overlap.
-             * Overlap is in the beginning of sliding window with a size of a feature cache. */
-            if (useCache && index < featureCache.size()) {
-                features = std::move(featureCache[index]);
-            } else {
-                features = std::move(compute(audioDataWindow));
-            }
-            auto size = features.size() / resizeScale;
-            auto sizeBytes = sizeof(T);
-
-            /* Input should be transposed and "resized" by skipping elements. */
-            for (size_t outIndex = 0; outIndex < size; outIndex++) {
-                std::memcpy(tensorData + (outIndex*size) + index, &features[outIndex*resizeScale], sizeBytes);
-            }
-
-            /* Start renewing cache as soon iteration goes out of the windows overlap. */
-            if (index >= featuresOverlapIndex / resizeScale) {
-                featureCache[index - featuresOverlapIndex / resizeScale] = std::move(features);
-            }
-        };
-    }
-
-    template std::function<void (std::vector<int16_t>&, size_t , bool, size_t, size_t)>
-    FeatureCalc<int8_t>(TfLiteTensor* inputTensor,
-                        size_t cacheSize,
-                        std::function<std::vector<int8_t> (std::vector<int16_t>&)> compute);
-
-    template std::function<void(std::vector<int16_t>&, size_t, bool, size_t, size_t)>
-    FeatureCalc<float>(TfLiteTensor *inputTensor,
-                       size_t cacheSize,
-                       std::function<std::vector<float>(std::vector<int16_t>&)> compute);
-
-    std::function<void (std::vector<int16_t>&, int, bool, size_t, size_t)>
-    GetFeatureCalculator(audio::AdMelSpectrogram& melSpec,
-                         TfLiteTensor* inputTensor,
-                         size_t cacheSize,
-                         float trainingMean);
-
 } /* namespace app */
 } /* namespace arm */
 
@@ -72,6 +72,30 @@ namespace audio {
         **/
         std::vector<float> ComputeMelSpec(const std::vector<int16_t>& audioData, float trainingMean = 0);
 
+        /**
+        * @brief        Extract Mel Spectrogram for one single small frame of
+        *               audio data, eg straight from an audio buffer.
+        * @param[in]    audioData       Audio samples to calculate features for.
+        * @param[in]    audioDataLen    Number of samples; the frame is zero
+        *                               padded if fewer than the frame length.
+        * @param[in]    trainingMean    Value to subtract from the the computed mel spectrogram, default 0.
+        * @return       Vector of extracted Mel Spectrogram features.
+        **/
+        std::vector<float> ComputeMelSpec(const int16_t* audioData, size_t audioDataLen,
+                                          float trainingMean = 0);
+
+        /**
+        * @brief        Extract Mel Spectrogram for one single small frame of
+        *               audio data, without allocating.
+        * @param[in]    audioData       Audio samples to calculate features for.
+        * @param[in]    audioDataLen    Number of samples; the frame is zero
+        *                               padded if fewer than the frame length.
+        * @param[in]    trainingMean    Value to subtract from the the computed mel spectrogram, default 0.
+        * @return       Extracted Mel Spectrogram features, valid until the next computation.
+        **/
+        const std::vector<float>& ComputeMelEnergies(const int16_t* audioData, size_t audioDataLen,
+                                                     float trainingMean = 0);
+
         /**
          * @brief       Constructor
          * @param[in]   params   Mel Spectrogram parameters
@@ -100,7 +124,28 @@ namespace audio {
                                            const int quantOffset,
                                            float trainingMean = 0)
         {
-            this->ComputeMelSpec(audioData, trainingMean);
+            return this->MelSpecComputeQuant<T>(audioData.data(), audioData.size(),
+                                                quantScale, quantOffset, trainingMean);
+        }
+
+        /**
+         * @brief        Extract Mel Spectrogram features and quantise for one single small
+         *               frame of audio data, eg straight from an audio buffer.
+         * @param[in]    audioData      Audio samples to calculate features for.
+         * @param[in]    audioDataLen   Number of samples.
+         * @param[in]    quantScale     quantisation scale.
+         * @param[in]    quantOffset    quantisation offset.
+         * @param[in]    trainingMean   training mean.
+         * @return       Vector of extracted quantised Mel Spectrogram features.
+         **/
+        template<typename T>
+        std::vector<T> MelSpecComputeQuant(const int16_t* audioData,
+                                           const size_t audioDataLen,
+                                           const float quantScale,
+                                           const int quantOffset,
+                                           float trainingMean = 0)
+        {
+            this->ComputeMelEnergies(audioData, audioDataLen, trainingMean);
             float minVal = std::numeric_limits<T>::min();
             float maxVal = std::numeric_limits<T>::max();
 
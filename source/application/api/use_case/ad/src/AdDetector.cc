@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AdDetector.hpp"
+
+#include "log_macros.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace arm {
+namespace app {
+namespace ad {
+
+    AdDetector::AdDetector(const AdDetectorParams& params)
+    :   m_params{params}
+    {
+        this->m_params.m_smoothing = std::min(std::max(params.m_smoothing, 1e-3f), 1.f);
+        this->m_params.m_eventHistoryLen = std::max<size_t>(1, params.m_eventHistoryLen);
+        this->m_events = std::vector<AdEvent>(this->m_params.m_eventHistoryLen);
+    }
+
+    bool AdDetector::Update(const float score, const float timeStamp)
+    {
+        /* The first window starts the average, so that it is not biased towards 0. */
+        this->m_smoothed = this->m_windowCount == 0 ? score :
+            this->m_smoothed + this->m_params.m_smoothing * (score - this->m_smoothed);
+        if (this->m_params.m_meanWindowLen && this->m_meanCount == this->m_params.m_meanWindowLen) {
+            this->m_sum = 0.f;
+            this->m_meanCount = 0;
+        }
+        this->m_sum += score;
+        ++this->m_meanCount;
+        if (this->m_windowCount < std::numeric_limits<uint32_t>::max()) {
+            ++this->m_windowCount;
+        }
+
+        this->m_decision = AdDecision::undecided;
+        if (this->m_windowCount >= this->m_params.m_minWindows) {
+            if (this->m_smoothed >= this->m_params.m_threshold + this->m_params.m_margin) {
+                this->m_decision = AdDecision::anomalous;
+            } else if (this->m_smoothed <= this->m_params.m_threshold - this->m_params.m_margin) {
+                this->m_decision = AdDecision::normal;
+            }
+        }
+
+        /* Within the margin, the state is kept: a score hovering around the threshold gives no events. */
+        const bool anomalous = this->m_decision == AdDecision::anomalous ||
+                               (this->m_decision == AdDecision::undecided && this->m_anomalous);
+        if (anomalous == this->m_anomalous) {
+            return false;
+        }
+        this->m_anomalous = anomalous;
+
+        AdEvent& event = this->m_events[this->m_eventHead];
+        event.m_anomalous = anomalous;
+        event.m_score = this->m_smoothed;
+        event.m_timeStamp = timeStamp;
+        event.m_windowNumber = this->m_windowCount - 1;
+        this->m_eventHead = (this->m_eventHead + 1) % this->m_events.size();
+        this->m_eventCount = std::min(this->m_eventCount + 1, this->m_events.size());
+
+        debug("Anomaly %s at %.2f s, score %f\n", anomalous ? "started" : "ended",
+              timeStamp, this->m_smoothed);
+        return true;
+    }
+
+    void AdDetector::Reset()
+    {
+        this->m_smoothed = 0.f;
+        this->m_sum = 0.f;
+        this->m_meanCount = 0;
+        this->m_windowCount = 0;
+        this->m_decision = AdDecision::undecided;
+        this->m_anomalous = false;
+        this->m_eventHead = 0;
+        this->m_eventCount = 0;
+    }
+
+    AdDecision AdDetector::GetDecision() const
+    {
+        return this->m_decision;
+    }
+
+    float AdDetector::GetSmoothedScore() const
+    {
+        return this->m_smoothed;
+    }
+
+    float AdDetector::GetMeanScore() const
+    {
+        return this->m_meanCount ? this->m_sum / this->m_meanCount : 0.f;
+    }
+
+    uint32_t AdDetector::GetWindowCount() const
+    {
+        return this->m_windowCount;
+    }
+
+    size_t AdDetector::GetEventCount() const
+    {
+        return this->m_eventCount;
+    }
+
+    const AdEvent& AdDetector::GetEvent(const size_t i) const
+    {
+        const size_t capacity = this->m_events.size();
+        return this->m_events[(this->m_eventHead + capacity - this->m_eventCount + i) % capacity];
+    }
+
+    const AdEvent& AdDetector::GetLastEvent() const
+    {
+        return this->GetEvent(this->m_eventCount - 1);
+    }
+
+} /* namespace ad */
+} /* namespace app */
+} /* namespace arm */
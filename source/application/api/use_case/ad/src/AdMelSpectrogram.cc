@@ -59,22 +59,17 @@ namespace audio {
     void AdMelSpectrogram::ConvertToLogarithmicScale(
             std::vector<float>& melEnergies)
     {
-        /* Container for natural logarithms of mel energies */
-        std::vector <float> vecLogEnergies(melEnergies.size(), 0.f);
-
         /* Because we are taking natural logs, we need to multiply by log10(e).
          * Also, for wav2letter model, we scale our log10 values by 10 */
         constexpr float multiplier = 10.0 * /* default scalar */
                                      0.4342944819032518; /* log10f(std::exp(1.0))*/
 
-        /* Take log of the whole vector */
-        math::MathUtils::VecLogarithmF32(melEnergies, vecLogEnergies);
+        /* Take log of the whole vector, in place */
+        math::MathUtils::VecLogarithmF32(melEnergies.data(), melEnergies.data(), melEnergies.size());
 
         /* Scale the log values. */
-        for (auto iterM = melEnergies.begin(), iterL = vecLogEnergies.begin();
-             iterM != melEnergies.end() && iterL != vecLogEnergies.end(); ++iterM, ++iterL) {
-
-            *iterM = *iterL * multiplier;
+        for (float& melEnergy : melEnergies) {
+            melEnergy *= multiplier;
         }
     }
 
@@ -18,6 +18,10 @@
 
 #include "AdModel.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace arm {
 namespace app {
 
@@ -26,6 +30,7 @@ AdPreProcess::AdPreProcess(TfLiteTensor* inputTensor,
                            uint32_t melSpectrogramFrameStride,
                            float adModelTrainingMean):
        m_validInstance{false},
+       m_inputTensor{inputTensor},
        m_melSpectrogramFrameLen{melSpectrogramFrameLen},
        m_melSpectrogramFrameStride{melSpectrogramFrameStride},
         /**< Model is trained on features downsampled 2x */
@@ -33,6 +38,7 @@ AdPreProcess::AdPreProcess(TfLiteTensor* inputTensor,
         /**< We are choosing to move by 20 frames across the audio for each inference. */
        m_numMelSpecVectorsInAudioStride{20},
        m_audioDataStride{m_numMelSpecVectorsInAudioStride * melSpectrogramFrameStride},
+       m_trainingMean{adModelTrainingMean},
        m_melSpec{melSpectrogramFrameLen}
 {
     UNUSED(this->m_melSpectrogramFrameStride);
@@ -49,14 +55,36 @@ AdPreProcess::AdPreProcess(TfLiteTensor* inputTensor,
         return;
     }
 
+    /* One row per (downsampled) MEL bin, one column per feature vector. */
     const uint32_t kNumRows = inputShape->data[AdModel::ms_inputRowsIdx];
     const uint32_t kNumCols = inputShape->data[AdModel::ms_inputColsIdx];
+    this->m_numFeatures = kNumRows;
+    this->m_numFeatureVectors = kNumCols;
+
+    if (kNumRows * this->m_inputResizeScale > audio::AdMelSpectrogram::ms_defaultNumFbankBins) {
+        printf_err("Input tensor has more rows than MEL bins\n");
+        return;
+    }
+
+    TfLiteQuantization quant = inputTensor->quantization;
+    if (kTfLiteAffineQuantization == quant.type) {
+        if (inputTensor->type != kTfLiteInt8) {
+            printf_err("Tensor type %s not supported\n", TfLiteTypeGetName(inputTensor->type));
+            return;
+        }
+        auto* quantParams = static_cast<TfLiteAffineQuantization*>(quant.params);
+        this->m_quantScale = quantParams->scale->data[0];
+        this->m_quantOffset = quantParams->zero_point->data[0];
+    } else if (inputTensor->type != kTfLiteFloat32) {
+        printf_err("Tensor type %s not supported\n", TfLiteTypeGetName(inputTensor->type));
+        return;
+    }
 
     /* Deduce the data length required for 1 inference from the network parameters. */
     this->m_audioDataWindowSize = (((this->m_inputResizeScale * kNumCols) - 1) *
                                     melSpectrogramFrameStride) +
                                     melSpectrogramFrameLen;
-    this->m_numReusedFeatureVectors = kNumRows -
+    this->m_numReusedFeatureVectors = kNumCols -
                                       (this->m_numMelSpecVectorsInAudioStride /
                                        this->m_inputResizeScale);
     this->m_melSpec.Init();
@@ -69,10 +97,9 @@ AdPreProcess::AdPreProcess(TfLiteTensor* inputTensor,
             melSpectrogramFrameLen,
             melSpectrogramFrameStride * this->m_inputResizeScale);
 
-    /* Construct feature calculation function. */
-    this->m_featureCalc = GetFeatureCalculator(this->m_melSpec, inputTensor,
-                                               this->m_numReusedFeatureVectors,
-                                               adModelTrainingMean);
+    /* Features are kept between windows to be reused: the feature ring is allocated once. */
+    this->m_featureRing.resize(inputTensor->bytes);
+    this->m_featureRowSize = inputTensor->bytes / kNumCols;
     this->m_validInstance = true;
 }
 
@@ -97,24 +124,73 @@ bool AdPreProcess::DoPreProcess(const void* input, size_t inputSize)
     /* The first window does not have cache ready. */
     const bool useCache = this->m_audioWindowIndex > 0 && this->m_numReusedFeatureVectors > 0;
 
+    /* The feature ring holds the feature vectors of the previous window starting at
+     * m_featureRingStart. Moving the start by one stride drops the oldest vectors,
+     * whose rows are then overwritten by the vectors of the new stride: each MEL
+     * frame of the clip is only computed once. */
+    if (useCache) {
+        this->m_featureRingStart = (this->m_featureRingStart + this->m_numFeatureVectors -
+                                    this->m_numReusedFeatureVectors) % this->m_numFeatureVectors;
+        this->m_melWindowSlider.FastForward(this->m_numReusedFeatureVectors);
+    } else {
+        this->m_featureRingStart = 0;
+    }
+
     /* Start calculating features inside one audio sliding window. */
     while (this->m_melWindowSlider.HasNext()) {
         const int16_t* melSpecWindow = this->m_melWindowSlider.Next();
-        std::vector<int16_t> melSpecAudioData = std::vector<int16_t>(
-                melSpecWindow,
-                melSpecWindow + this->m_melSpectrogramFrameLen);
-
-        /* Compute features for this window and write them to input tensor. */
-        this->m_featureCalc(melSpecAudioData,
-                            this->m_melWindowSlider.Index(),
-                            useCache,
-                            this->m_numMelSpecVectorsInAudioStride,
-                            this->m_inputResizeScale);
+        const size_t row = (this->m_featureRingStart + this->m_melWindowSlider.Index()) %
+                           this->m_numFeatureVectors;
+        this->ComputeFeatureRow(melSpecWindow, this->m_featureRing.data() + row * this->m_featureRowSize);
+    }
+
+    if (this->m_inputTensor->type == kTfLiteInt8) {
+        this->CopyFeaturesToTensor<int8_t>();
+    } else {
+        this->CopyFeaturesToTensor<float>();
     }
 
     return true;
 }
 
+void AdPreProcess::ComputeFeatureRow(const int16_t* melSpecWindow, uint8_t* row)
+{
+    const std::vector<float>& melEnergies = this->m_melSpec.ComputeMelEnergies(
+            melSpecWindow, this->m_melSpectrogramFrameLen, this->m_trainingMean);
+
+    /* Downsampled by keeping every m_inputResizeScale-th bin. */
+    if (this->m_inputTensor->type == kTfLiteInt8) {
+        constexpr float minVal = std::numeric_limits<int8_t>::min();
+        constexpr float maxVal = std::numeric_limits<int8_t>::max();
+        auto* features = reinterpret_cast<int8_t*>(row);
+        for (size_t k = 0; k < this->m_numFeatures; ++k) {
+            const float quantizedEnergy = std::round(
+                    (melEnergies[k * this->m_inputResizeScale] / this->m_quantScale) + this->m_quantOffset);
+            features[k] = static_cast<int8_t>(std::min<float>(std::max<float>(quantizedEnergy, minVal), maxVal));
+        }
+    } else {
+        auto* features = reinterpret_cast<float*>(row);
+        for (size_t k = 0; k < this->m_numFeatures; ++k) {
+            features[k] = melEnergies[k * this->m_inputResizeScale];
+        }
+    }
+}
+
+template<typename T>
+void AdPreProcess::CopyFeaturesToTensor()
+{
+    T* tensorData = tflite::GetTensorData<T>(this->m_inputTensor);
+    const size_t numVectors = this->m_numFeatureVectors;
+
+    for (size_t vec = 0; vec < numVectors; ++vec) {
+        const size_t row = (this->m_featureRingStart + vec) % numVectors;
+        const T* features = reinterpret_cast<const T*>(this->m_featureRing.data() + row * this->m_featureRowSize);
+        for (size_t k = 0; k < this->m_numFeatures; ++k) {
+            tensorData[k * numVectors + vec] = features[k];
+        }
+    }
+}
+
 uint32_t AdPreProcess::GetAudioWindowSize()
 {
     return this->m_audioDataWindowSize;
@@ -145,7 +221,7 @@ bool AdPostProcess::DoPostProcess()
             return false;
     }
 
-    math::MathUtils::SoftmaxF32(this->m_dequantizedOutputVec);
+    math::MathUtils::SoftmaxF32(this->m_dequantizedOutputVec.data(), this->m_dequantizedOutputVec.size());
     return true;
 }
 
@@ -158,53 +234,5 @@ float AdPostProcess::GetOutputValue(uint32_t index)
     return 0.0;
 }
 
-std::function<void (std::vector<int16_t>&, int, bool, size_t, size_t)>
-GetFeatureCalculator(audio::AdMelSpectrogram& melSpec,
-                     TfLiteTensor* inputTensor,
-                     size_t cacheSize,
-                     float trainingMean)
-{
-    std::function<void (std::vector<int16_t>&, size_t, bool, size_t, size_t)> melSpecFeatureCalc = nullptr;
-
-    TfLiteQuantization quant = inputTensor->quantization;
-
-    if (kTfLiteAffineQuantization == quant.type) {
-
-        auto* quantParams = static_cast<TfLiteAffineQuantization*>(quant.params);
-        const float quantScale = quantParams->scale->data[0];
-        const int quantOffset = quantParams->zero_point->data[0];
-
-        switch (inputTensor->type) {
-            case kTfLiteInt8: {
-                melSpecFeatureCalc = FeatureCalc<int8_t>(
-                        inputTensor,
-                        cacheSize,
-                        [=, &melSpec](std::vector<int16_t>& audioDataWindow) {
-                            return melSpec.MelSpecComputeQuant<int8_t>(
-                                    audioDataWindow,
-                                    quantScale,
-                                    quantOffset,
-                                    trainingMean);
-                        }
-                );
-                break;
-            }
-            default:
-            printf_err("Tensor type %s not supported\n", TfLiteTypeGetName(inputTensor->type));
-        }
-    } else {
-        melSpecFeatureCalc = FeatureCalc<float>(
-                inputTensor,
-                cacheSize,
-                [=, &melSpec](
-                        std::vector<int16_t>& audioDataWindow) {
-                    return melSpec.ComputeMelSpec(
-                            audioDataWindow,
-                            trainingMean);
-                });
-    }
-    return melSpecFeatureCalc;
-}
-
 } /* namespace app */
 } /* namespace arm */
@@ -19,6 +19,7 @@
 #include "PlatformMath.hpp"
 #include "log_macros.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 
@@ -155,7 +156,7 @@ namespace audio {
 
     void MelSpectrogram::ConvertToLogarithmicScale(std::vector<float>& melEnergies)
     {
-        math::MathUtils::VecLogarithmF32(melEnergies, melEnergies);
+        math::MathUtils::VecLogarithmF32(melEnergies.data(), melEnergies.data(), melEnergies.size());
     }
 
     void MelSpectrogram::ConvertToPowerSpectrum()
@@ -203,25 +204,40 @@ namespace audio {
     }
 
     std::vector<float> MelSpectrogram::ComputeMelSpec(const std::vector<int16_t>& audioData, float trainingMean)
+    {
+        return this->ComputeMelSpec(audioData.data(), audioData.size(), trainingMean);
+    }
+
+    std::vector<float> MelSpectrogram::ComputeMelSpec(const int16_t* audioData, size_t audioDataLen,
+                                                      float trainingMean)
+    {
+        return this->ComputeMelEnergies(audioData, audioDataLen, trainingMean);
+    }
+
+    const std::vector<float>& MelSpectrogram::ComputeMelEnergies(const int16_t* audioData, size_t audioDataLen,
+                                                                 float trainingMean)
     {
         this->InitMelFilterBank();
 
         /* TensorFlow way of normalizing .wav data to (-1, 1). */
         constexpr float normaliser = 1.0/(1<<15);
-        for (size_t i = 0; i < this->m_params.m_frameLen; ++i) {
+        const size_t numSamples = std::min<size_t>(audioDataLen, this->m_params.m_frameLen);
+        for (size_t i = 0; i < numSamples; ++i) {
             this->m_frame[i] = static_cast<float>(audioData[i]) * normaliser;
         }
 
         /* Apply window function to input frame. */
-        for(size_t i = 0; i < this->m_params.m_frameLen; ++i) {
+        for(size_t i = 0; i < numSamples; ++i) {
             this->m_frame[i] *= this->m_windowFunc[i];
         }
 
         /* Set remaining frame values to 0. */
-        std::fill(this->m_frame.begin() + this->m_params.m_frameLen,this->m_frame.end(), 0);
+        std::fill(this->m_frame.begin() + numSamples, this->m_frame.end(), 0);
 
         /* Compute FFT. */
-        math::MathUtils::FftF32(this->m_frame, this->m_buffer, this->m_fftInstance);
+        math::MathUtils::FftF32(this->m_frame.data(), this->m_frame.size(),
+                                this->m_buffer.data(), this->m_buffer.size(),
+                                this->m_fftInstance);
 
         /* Convert to power spectrum. */
         this->ConvertToPowerSpectrum();
@@ -55,6 +55,8 @@ namespace app {
         bool GetTopResults(TfLiteTensor* tensor,
                            std::vector<ClassificationResult>& vecResults,
                            const std::vector<std::string>& labels, double scale, double zeroPoint);
+
+        std::vector<uint32_t> m_topIndices;  /* Top label of each row. */
     };
 
 } /* namespace app */
@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ASR_CTC_DECODER_HPP
+#define ASR_CTC_DECODER_HPP
+
+#include "TensorFlowLiteMicro.hpp"
+
+#include <string>
+#include <vector>
+
+namespace arm {
+namespace app {
+namespace audio {
+namespace asr {
+
+    /**
+     * @brief   Streaming CTC decoder for Wav2Letter output.
+     *          Output rows are consumed window by window, as soon as each
+     *          inference completes. Two modes are supported:
+     *          - greedy (beam width 1): per row argmax, repeated labels
+     *            collapsed and blanks dropped, on the quantised data,
+     *          - prefix beam search with a small beam, with an optional
+     *            score boost for words found in a lexicon.
+     *          Text that all the beams agree on is committed and can be read
+     *          with GetStableText() while decoding goes on.
+     */
+    class CtcDecoder {
+    public:
+        /**
+         * @brief       Constructor.
+         * @param[in]   labels          Vector of single character labels, one per output column.
+         * @param[in]   blankTokenIdx   Index of the CTC blank label.
+         * @param[in]   beamWidth       Number of beams kept; 1 selects greedy decoding.
+         **/
+        CtcDecoder(const std::vector<std::string>& labels, uint32_t blankTokenIdx, uint32_t beamWidth = 1);
+
+        /**
+         * @brief       Sets the lexicon used to boost hypotheses. Only used by beam search.
+         * @param[in]   words   Words to boost.
+         * @param[in]   boost   Log-probability bonus added each time a word of the lexicon is completed.
+         **/
+        void SetLexicon(const std::vector<std::string>& words, float boost);
+
+        /**
+         * @brief       Decodes the output rows of one inference window. Rows in the
+         *              left context (except for the first window) and in the right
+         *              context (except for the last window) are skipped, which is
+         *              the same section AsrPostProcess erases to blank.
+         * @param[in]   outputTensor    Wav2Letter output tensor.
+         * @param[in]   outputCtxLen    Left/right context length of the output, in rows.
+         * @param[in]   firstWindow     Whether this is the first window of the audio.
+         * @param[in]   lastWindow      Whether this is the last window of the audio.
+         * @return      true if successful, false otherwise.
+         **/
+        bool DecodeWindow(TfLiteTensor* outputTensor, uint32_t outputCtxLen,
+                          bool firstWindow, bool lastWindow);
+
+        /**
+         * @brief       Decodes a range of rows of the output tensor.
+         * @param[in]   outputTensor    Wav2Letter output tensor.
+         * @param[in]   firstRow        First row to decode.
+         * @param[in]   endRow          One past the last row to decode.
+         * @return      true if successful, false otherwise.
+         **/
+        bool DecodeRows(TfLiteTensor* outputTensor, uint32_t firstRow, uint32_t endRow);
+
+        /**
+         * @brief       Decodes a single time step.
+         * @param[in]   logProbs   Log-probabilities of each label.
+         **/
+        void DecodeStep(const float* logProbs);
+
+        /** @brief  Commits the best hypothesis; call once the last window is decoded. */
+        void Flush();
+
+        /** @brief  Clears the decoder state and the transcript. */
+        void Reset();
+
+        /** @brief  Gets the text committed so far. It only ever grows until Reset(). */
+        const std::string& GetStableText() const;
+
+        /** @brief  Gets the committed text followed by the current best hypothesis. */
+        std::string GetBestText() const;
+
+    private:
+        /* One prefix beam search hypothesis; the prefix excludes the committed text. */
+        struct Beam {
+            std::string m_prefix;
+            float       m_logProbBlank;     /* Log-probability of the paths ending in blank. */
+            float       m_logProbNonBlank;  /* Log-probability of the paths ending in a label. */
+            float       m_bonus;            /* Accumulated lexicon bonus. */
+        };
+
+        /**
+         * @brief       Greedy decoding of a quantised row.
+         * @param[in]   row   Pointer to the row data.
+         **/
+        template<typename T>
+        void GreedyStep(const T* row);
+
+        /**
+         * @brief       Adds paths to a candidate beam, merging with an existing
+         *              candidate of the same prefix.
+         **/
+        void AddCandidate(const std::string& prefix, float logProbBlank,
+                          float logProbNonBlank, float bonus);
+
+        /** @brief  Gets the lexicon bonus earned by appending ch to prefix. */
+        float WordBonus(const std::string& prefix, char ch) const;
+
+        /** @brief  Moves the prefix shared by all the beams to the stable text. */
+        void CommitCommonPrefix();
+
+        /** @brief  Appends text to the stable text. */
+        void Commit(const std::string& text);
+
+        static float Score(const Beam& beam);
+
+        const std::vector<std::string>& m_labels;
+        uint32_t                        m_blankTokenIdx;
+        uint32_t                        m_beamWidth;
+        std::vector<std::string>        m_lexicon;
+        float                           m_lexiconBoost{0.f};
+        std::vector<Beam>               m_beams;
+        std::vector<Beam>               m_candidates;
+        std::vector<uint32_t>           m_topLabels;    /* Labels extended at the current step. */
+        std::vector<float>              m_logProbs;     /* Dequantised row. */
+        std::string                     m_stableText;
+        std::string                     m_wordTail;     /* Stable text after its last space. */
+        uint32_t                        m_prevLabel;    /* Greedy: label of the previous row. */
+    };
+
+} /* namespace asr */
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* ASR_CTC_DECODER_HPP */
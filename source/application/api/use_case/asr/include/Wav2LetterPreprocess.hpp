@@ -81,31 +81,39 @@ namespace app {
          */
         static void StandardizeVecF32(Array2d<float>& vec);
 
-        /**
-         * @brief   Standardizes all the MFCC and delta buffers to have mean 0 and std. dev 1.
-         */
-        void Standarize();
-
         /**
          * @brief       Given the quantisation and data type limits, computes
-         *              the quantised values of a floating point input data.
+         *              the quantised value of a floating point input, as
+         *              std::round and clamping would. Written with a
+         *              conversion and compares instead, so that loops of it
+         *              vectorise.
          * @param[in]   elem          Element to be quantised.
          * @param[in]   quantScale    Scale.
          * @param[in]   quantOffset   Offset.
-         * @param[in]   minVal        Numerical limit - minimum.
-         * @param[in]   maxVal        Numerical limit - maximum.
-         * @return      Floating point quantised value.
+         * @return      Quantised value.
          */
-        static float GetQuantElem(
-                float     elem,
-                float     quantScale,
-                int       quantOffset,
-                float     minVal,
-                float     maxVal);
+        template <typename T>
+        static T GetQuantElem(const float elem, const float quantScale, const int quantOffset)
+        {
+            constexpr float minVal = std::numeric_limits<T>::min();
+            constexpr float maxVal = std::numeric_limits<T>::max();
+
+            /* Clamping to integers first doesn't change the rounding, and keeps the conversion in range. */
+            const float val = std::min<float>(std::max<float>((elem / quantScale) + quantOffset, minVal), maxVal);
+
+            /* Round half away from zero: the fraction left by truncation is exact. */
+            const int32_t truncated = static_cast<int32_t>(val);
+            const float fraction = val - static_cast<float>(truncated);
+            return static_cast<T>(truncated + (fraction >= 0.5f) - (fraction <= -0.5f));
+        }
 
         /**
-         * @brief       Quantises the MFCC and delta buffers, and places them
-         *              in the output buffer. While doing so, it transposes
+         * @brief       Standardises the MFCC and delta buffers to have mean 0
+         *              and standard deviation 1, quantises them, and places
+         *              them in the output buffer. The statistics of the three
+         *              buffers are computed in one pass, and the output is
+         *              then written in a second one, standardising and
+         *              quantising on the fly. While doing so, it transposes
          *              the data. Reason: Buffers in this class are arranged
          *              for "time" axis to be row major. Primary reason for
          *              this being the convolution speed up (as we can use
@@ -117,43 +125,55 @@ namespace app {
          * @param[in]   quantOffset   Quantisation offset.
          */
         template <typename T>
-        bool Quantise(
+        bool StandardiseQuantise(
                 T*              outputBuf,
                 const uint32_t  outputBufSz,
                 const float     quantScale,
                 const int       quantOffset)
         {
             /* Check the output size will fit everything. */
-            if (outputBufSz < (this->m_mfccBuf.size(0) * 3 * sizeof(T))) {
+            if (outputBufSz < (this->m_mfccBuf.totalSize() * 3 * sizeof(T))) {
                 printf_err("Tensor size too small for features\n");
                 return false;
             }
 
-            /* Populate. */
-            T* outputBufMfcc = outputBuf;
-            T* outputBufD1 = outputBuf + this->m_numMfccFeats;
-            T* outputBufD2 = outputBufD1 + this->m_numMfccFeats;
-            const uint32_t ptrIncr = this->m_numMfccFeats * 2;  /* (3 vectors - 1 vector) */
+            const float* bufs[] = {this->m_mfccBuf.data(), this->m_delta1Buf.data(), this->m_delta2Buf.data()};
+            constexpr uint32_t numBufs = sizeof(bufs) / sizeof(bufs[0]);
+            const uint32_t bufSize = this->m_mfccBuf.totalSize();
+
+            /* Feature i of frame j of buffer b goes to outputBuf[j * frameLen + b * numMfccFeats + i]. */
+            const uint32_t numFrames = this->m_numFeatureFrames;
+            const uint32_t frameLen = this->m_numMfccFeats * numBufs;
 
-            const float minVal = std::numeric_limits<T>::min();
-            const float maxVal = std::numeric_limits<T>::max();
+            for (uint32_t b = 0; b < numBufs; ++b) {
+                /* Same statistics and arithmetic as StandardizeVecF32, so the output is bit exact
+                 * with standardising in place first. A buffer with no deviation standardises to zeros. */
+                const float mean = math::MathUtils::MeanF32(bufs[b], bufSize);
+                const float stddev = math::MathUtils::StdDevF32(bufs[b], bufSize, mean);
+                const float stddevInv = stddev == 0 ? 0.f : 1.f/stddev;
+                const float normalisedMean = stddev == 0 ? 0.f : mean/stddev;
+                debug("Mean: %f, Stddev: %f\n", mean, stddev);
 
-            /* Need to transpose while copying and concatenating the tensor. */
-            for (uint32_t j = 0; j < this->m_numFeatureFrames; ++j) {
                 for (uint32_t i = 0; i < this->m_numMfccFeats; ++i) {
-                    *outputBufMfcc++ = static_cast<T>(AsrPreProcess::GetQuantElem(
-                            this->m_mfccBuf(i, j), quantScale,
-                            quantOffset, minVal, maxVal));
-                    *outputBufD1++ = static_cast<T>(AsrPreProcess::GetQuantElem(
-                            this->m_delta1Buf(i, j), quantScale,
-                            quantOffset, minVal, maxVal));
-                    *outputBufD2++ = static_cast<T>(AsrPreProcess::GetQuantElem(
-                            this->m_delta2Buf(i, j), quantScale,
-                            quantOffset, minVal, maxVal));
+                    const float* row = bufs[b] + i * numFrames;
+                    T* out = outputBuf + b * this->m_numMfccFeats + i;
+
+                    /* Quantised in chunks of contiguous frames, which vectorises
+                     * (with -fno-trapping-math, see CMakeLists.txt), and only
+                     * then scattered to the strided output. */
+                    constexpr uint32_t maxChunkLen = 64;
+                    for (uint32_t j0 = 0; j0 < numFrames; j0 += maxChunkLen) {
+                        const uint32_t chunkLen = std::min(maxChunkLen, numFrames - j0);
+                        T chunk[maxChunkLen];
+                        for (uint32_t j = 0; j < chunkLen; ++j) {
+                            chunk[j] = AsrPreProcess::GetQuantElem<T>(
+                                    row[j0 + j] * stddevInv - normalisedMean, quantScale, quantOffset);
+                        }
+                        for (uint32_t j = 0; j < chunkLen; ++j) {
+                            out[(j0 + j) * frameLen] = chunk[j];
+                        }
+                    }
                 }
-                outputBufMfcc += ptrIncr;
-                outputBufD1 += ptrIncr;
-                outputBufD2 += ptrIncr;
             }
 
             return true;
@@ -163,7 +183,8 @@ namespace app {
         audio::Wav2LetterMFCC   m_mfcc;          /* MFCC instance. */
         TfLiteTensor*           m_inputTensor;   /* Model input tensor. */
 
-        /* Actual buffers to be populated. */
+        /* Actual buffers to be populated: features (rows) by frames (columns),
+         * row-major so that the deltas convolve contiguous memory. */
         Array2d<float>   m_mfccBuf;              /* Contiguous buffer 1D: MFCC */
         Array2d<float>   m_delta1Buf;            /* Contiguous buffer 1D: Delta 1 */
         Array2d<float>   m_delta2Buf;            /* Contiguous buffer 1D: Delta 2 */
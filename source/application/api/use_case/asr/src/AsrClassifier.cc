@@ -17,12 +17,23 @@
 #include "AsrClassifier.hpp"
 
 #include "log_macros.h"
+#include "PlatformMath.hpp"
 #include "TensorFlowLiteMicro.hpp"
 #include "Wav2LetterModel.hpp"
 
 namespace arm {
 namespace app {
 
+    static void RowArgMax(const uint8_t* src, uint32_t numRows, uint32_t rowLen, uint32_t* dst)
+    {
+        math::MathUtils::RowArgMaxU8(src, numRows, rowLen, dst);
+    }
+
+    static void RowArgMax(const int8_t* src, uint32_t numRows, uint32_t rowLen, uint32_t* dst)
+    {
+        math::MathUtils::RowArgMaxS8(src, numRows, rowLen, dst);
+    }
+
     template<typename T>
     bool AsrClassifier::GetTopResults(TfLiteTensor* tensor,
                                       std::vector<ClassificationResult>& vecResults,
@@ -43,25 +54,21 @@ namespace app {
         }
 
         /* Final results' container. */
-        vecResults = std::vector<ClassificationResult>(nElems);
+        vecResults.resize(nElems);
 
-        T* tensorData = tflite::GetTensorData<T>(tensor);
+        const T* tensorData = tflite::GetTensorData<T>(tensor);
 
         /* Get the top 1 results. */
-        for (uint32_t i = 0, row = 0; i < nElems; ++i, row+=nLetters) {
-            std::pair<T, uint32_t> top_1 = std::make_pair(tensorData[row + 0], 0);
+        this->m_topIndices.resize(nElems);
+        RowArgMax(tensorData, nElems, nLetters, this->m_topIndices.data());
 
-            for (uint32_t j = 1; j < nLetters; ++j) {
-                if (top_1.first < tensorData[row + j]) {
-                    top_1.first = tensorData[row + j];
-                    top_1.second = j;
-                }
-            }
+        for (uint32_t i = 0, row = 0; i < nElems; ++i, row+=nLetters) {
+            const uint32_t topIdx = this->m_topIndices[i];
 
-            double score = static_cast<int> (top_1.first);
+            double score = static_cast<int> (tensorData[row + topIdx]);
             vecResults[i].m_normalisedVal = scale * (score - zeroPoint);
-            vecResults[i].m_label = labels[top_1.second];
-            vecResults[i].m_labelIdx = top_1.second;
+            vecResults[i].m_label = labels[topIdx];
+            vecResults[i].m_labelIdx = topIdx;
         }
 
         return true;
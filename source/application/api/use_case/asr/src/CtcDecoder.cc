@@ -0,0 +1,358 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CtcDecoder.hpp"
+
+#include "PlatformMath.hpp"
+#include "Wav2LetterModel.hpp"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace arm {
+namespace app {
+namespace audio {
+namespace asr {
+
+    /* Stands for log(0) while keeping the arithmetic finite. */
+    static constexpr float ms_logZero = -1e30f;
+
+    /* Hypotheses this far below the best one are dropped, so unlikely
+     * alternatives do not hold back the stable text. */
+    static constexpr float ms_pruneLogProb = 10.f;
+
+    static float LogAdd(const float a, const float b)
+    {
+        const float hi = std::max(a, b);
+        const float lo = std::min(a, b);
+        if (lo <= ms_logZero) {
+            return hi;
+        }
+        return hi + std::log1p(std::exp(lo - hi));
+    }
+
+    /* Index of the first largest element of a row. */
+    static uint32_t ArgMax(const int8_t* row, const uint32_t len)
+    {
+        uint32_t top;
+        math::MathUtils::RowArgMaxS8(row, 1, len, &top);
+        return top;
+    }
+
+    static uint32_t ArgMax(const uint8_t* row, const uint32_t len)
+    {
+        uint32_t top;
+        math::MathUtils::RowArgMaxU8(row, 1, len, &top);
+        return top;
+    }
+
+    static uint32_t ArgMax(const float* row, const uint32_t len)
+    {
+        return std::max_element(row, row + len) - row;
+    }
+
+    CtcDecoder::CtcDecoder(const std::vector<std::string>& labels, const uint32_t blankTokenIdx,
+                           const uint32_t beamWidth)
+    :   m_labels{labels},
+        m_blankTokenIdx{blankTokenIdx},
+        m_beamWidth{std::max<uint32_t>(1, beamWidth)},
+        m_logProbs(labels.size())
+    {
+        /* Each beam extends into itself, a blank, and the top labels. */
+        this->m_beams.reserve(this->m_beamWidth);
+        this->m_candidates.reserve(this->m_beamWidth * (this->m_beamWidth + 2));
+        this->m_topLabels.reserve(this->m_beamWidth);
+        this->Reset();
+    }
+
+    void CtcDecoder::SetLexicon(const std::vector<std::string>& words, const float boost)
+    {
+        this->m_lexicon = words;
+        this->m_lexiconBoost = boost;
+    }
+
+    bool CtcDecoder::DecodeWindow(TfLiteTensor* outputTensor, const uint32_t outputCtxLen,
+                                  const bool firstWindow, const bool lastWindow)
+    {
+        if (outputTensor == nullptr) {
+            printf_err("Output vector is null pointer.\n");
+            return false;
+        }
+
+        const uint32_t rows = outputTensor->dims->data[Wav2LetterModel::ms_outputRowsIdx];
+        if (rows <= 2 * outputCtxLen) {
+            printf_err("Output rows not compatible with ctx of %" PRIu32 "\n", outputCtxLen);
+            return false;
+        }
+
+        const uint32_t firstRow = firstWindow ? 0 : outputCtxLen;
+        const uint32_t endRow = lastWindow ? rows : rows - outputCtxLen;
+        return this->DecodeRows(outputTensor, firstRow, endRow);
+    }
+
+    bool CtcDecoder::DecodeRows(TfLiteTensor* outputTensor, const uint32_t firstRow, const uint32_t endRow)
+    {
+        const uint32_t rows = outputTensor->dims->data[Wav2LetterModel::ms_outputRowsIdx];
+        const uint32_t cols = outputTensor->dims->data[Wav2LetterModel::ms_outputColsIdx];
+
+        if (cols != this->m_labels.size()) {
+            printf_err("Output size doesn't match the labels' size\n");
+            return false;
+        } else if (firstRow > endRow || endRow > rows) {
+            printf_err("Invalid row range\n");
+            return false;
+        }
+
+        QuantParams quantParams = GetTensorQuantParams(outputTensor);
+
+        for (uint32_t r = firstRow; r < endRow; ++r) {
+            switch (outputTensor->type) {
+                case kTfLiteInt8: {
+                    const int8_t* row = tflite::GetTensorData<int8_t>(outputTensor) + r * cols;
+                    if (this->m_beamWidth == 1) {
+                        this->GreedyStep(row);
+                        continue;
+                    }
+                    for (uint32_t c = 0; c < cols; ++c) {
+                        this->m_logProbs[c] = quantParams.scale * (row[c] - quantParams.offset);
+                    }
+                    break;
+                }
+                case kTfLiteUInt8: {
+                    const uint8_t* row = tflite::GetTensorData<uint8_t>(outputTensor) + r * cols;
+                    if (this->m_beamWidth == 1) {
+                        this->GreedyStep(row);
+                        continue;
+                    }
+                    for (uint32_t c = 0; c < cols; ++c) {
+                        this->m_logProbs[c] = quantParams.scale * (row[c] - quantParams.offset);
+                    }
+                    break;
+                }
+                case kTfLiteFloat32: {
+                    const float* row = tflite::GetTensorData<float>(outputTensor) + r * cols;
+                    if (this->m_beamWidth == 1) {
+                        this->GreedyStep(row);
+                        continue;
+                    }
+                    std::copy(row, row + cols, this->m_logProbs.begin());
+                    break;
+                }
+                default:
+                    printf_err("Tensor type %s not supported by decoder\n",
+                        TfLiteTypeGetName(outputTensor->type));
+                    return false;
+            }
+
+            /* Logits to log-probabilities. */
+            const float maxLogit = *std::max_element(this->m_logProbs.begin(), this->m_logProbs.end());
+            float sum = 0.f;
+            for (float logit : this->m_logProbs) {
+                sum += std::exp(logit - maxLogit);
+            }
+            const float logNorm = maxLogit + std::log(sum);
+            for (float& logProb : this->m_logProbs) {
+                logProb -= logNorm;
+            }
+
+            this->DecodeStep(this->m_logProbs.data());
+        }
+
+        return true;
+    }
+
+    template<typename T>
+    void CtcDecoder::GreedyStep(const T* row)
+    {
+        const uint32_t top = ArgMax(row, this->m_labels.size());
+
+        if (top != this->m_prevLabel && top != this->m_blankTokenIdx) {
+            this->Commit(this->m_labels[top]);
+        }
+        this->m_prevLabel = top;
+    }
+
+    void CtcDecoder::DecodeStep(const float* logProbs)
+    {
+        /* Only the most likely labels are used to extend the beams. */
+        this->m_topLabels.clear();
+        for (uint32_t c = 0; c < this->m_labels.size(); ++c) {
+            if (c == this->m_blankTokenIdx) {
+                continue;
+            }
+            auto pos = std::find_if(this->m_topLabels.begin(), this->m_topLabels.end(),
+                                    [&](uint32_t other) { return logProbs[c] > logProbs[other]; });
+            if (pos != this->m_topLabels.end() || this->m_topLabels.size() < this->m_beamWidth) {
+                this->m_topLabels.insert(pos, c);
+                if (this->m_topLabels.size() > this->m_beamWidth) {
+                    this->m_topLabels.pop_back();
+                }
+            }
+        }
+
+        this->m_candidates.clear();
+        for (const Beam& beam : this->m_beams) {
+            const float total = LogAdd(beam.m_logProbBlank, beam.m_logProbNonBlank);
+
+            /* Blank keeps the prefix. */
+            this->AddCandidate(beam.m_prefix, total + logProbs[this->m_blankTokenIdx], ms_logZero, beam.m_bonus);
+
+            const char last = !beam.m_prefix.empty() ? beam.m_prefix.back() :
+                              (!this->m_stableText.empty() ? this->m_stableText.back() : '\0');
+
+            for (uint32_t c : this->m_topLabels) {
+                const char ch = this->m_labels[c][0];
+                const float bonus = beam.m_bonus + this->WordBonus(beam.m_prefix, ch);
+                std::string extended = beam.m_prefix + ch;
+
+                if (ch == last) {
+                    /* A repeated label collapses unless separated by a blank. */
+                    this->AddCandidate(beam.m_prefix, ms_logZero, beam.m_logProbNonBlank + logProbs[c], beam.m_bonus);
+                    this->AddCandidate(extended, ms_logZero, beam.m_logProbBlank + logProbs[c], bonus);
+                } else {
+                    this->AddCandidate(extended, ms_logZero, total + logProbs[c], bonus);
+                }
+            }
+        }
+
+        std::sort(this->m_candidates.begin(), this->m_candidates.end(),
+                  [](const Beam& a, const Beam& b) { return Score(a) > Score(b); });
+        const float minScore = Score(this->m_candidates[0]) - ms_pruneLogProb;
+        auto last = std::find_if(this->m_candidates.begin(), this->m_candidates.end(),
+                                 [minScore](const Beam& beam) { return Score(beam) < minScore; });
+        this->m_candidates.erase(last, this->m_candidates.end());
+        if (this->m_candidates.size() > this->m_beamWidth) {
+            this->m_candidates.resize(this->m_beamWidth);
+        }
+        std::swap(this->m_beams, this->m_candidates);
+
+        this->CommitCommonPrefix();
+    }
+
+    void CtcDecoder::Flush()
+    {
+        if (this->m_beamWidth == 1) {
+            this->m_prevLabel = this->m_blankTokenIdx;
+            return;
+        }
+
+        /* The last word has no trailing space; give it its lexicon bonus before choosing. */
+        auto best = std::max_element(this->m_beams.begin(), this->m_beams.end(),
+            [this](const Beam& a, const Beam& b) {
+                return Score(a) + this->WordBonus(a.m_prefix, ' ') <
+                       Score(b) + this->WordBonus(b.m_prefix, ' ');
+            });
+        this->Commit(best->m_prefix);
+
+        this->m_beams.clear();
+        this->m_beams.emplace_back(Beam{std::string{}, 0.f, ms_logZero, 0.f});
+    }
+
+    void CtcDecoder::Reset()
+    {
+        this->m_stableText.clear();
+        this->m_wordTail.clear();
+        this->m_prevLabel = this->m_blankTokenIdx;
+        this->m_beams.clear();
+        this->m_beams.emplace_back(Beam{std::string{}, 0.f, ms_logZero, 0.f});
+    }
+
+    const std::string& CtcDecoder::GetStableText() const
+    {
+        return this->m_stableText;
+    }
+
+    std::string CtcDecoder::GetBestText() const
+    {
+        auto best = std::max_element(this->m_beams.begin(), this->m_beams.end(),
+            [](const Beam& a, const Beam& b) { return Score(a) < Score(b); });
+        return this->m_stableText + best->m_prefix;
+    }
+
+    void CtcDecoder::AddCandidate(const std::string& prefix, const float logProbBlank,
+                                  const float logProbNonBlank, const float bonus)
+    {
+        for (Beam& candidate : this->m_candidates) {
+            if (candidate.m_prefix == prefix) {
+                candidate.m_logProbBlank = LogAdd(candidate.m_logProbBlank, logProbBlank);
+                candidate.m_logProbNonBlank = LogAdd(candidate.m_logProbNonBlank, logProbNonBlank);
+                return;
+            }
+        }
+        this->m_candidates.emplace_back(Beam{prefix, logProbBlank, logProbNonBlank, bonus});
+    }
+
+    float CtcDecoder::WordBonus(const std::string& prefix, const char ch) const
+    {
+        if (ch != ' ' || this->m_lexicon.empty()) {
+            return 0.f;
+        }
+
+        /* The completed word may start in the stable text. */
+        const size_t space = prefix.rfind(' ');
+        const std::string word = (space == std::string::npos) ?
+                                 this->m_wordTail + prefix : prefix.substr(space + 1);
+        if (word.empty()) {
+            return 0.f;
+        }
+        return std::find(this->m_lexicon.begin(), this->m_lexicon.end(), word) != this->m_lexicon.end() ?
+               this->m_lexiconBoost : 0.f;
+    }
+
+    void CtcDecoder::CommitCommonPrefix()
+    {
+        size_t common = this->m_beams[0].m_prefix.size();
+        for (const Beam& beam : this->m_beams) {
+            common = std::min(common, beam.m_prefix.size());
+            for (size_t i = 0; i < common; ++i) {
+                if (beam.m_prefix[i] != this->m_beams[0].m_prefix[i]) {
+                    common = i;
+                    break;
+                }
+            }
+        }
+
+        if (common == 0) {
+            return;
+        }
+
+        this->Commit(this->m_beams[0].m_prefix.substr(0, common));
+        for (Beam& beam : this->m_beams) {
+            beam.m_prefix.erase(0, common);
+        }
+    }
+
+    void CtcDecoder::Commit(const std::string& text)
+    {
+        this->m_stableText += text;
+        const size_t space = text.rfind(' ');
+        if (space == std::string::npos) {
+            this->m_wordTail += text;
+        } else {
+            this->m_wordTail = text.substr(space + 1);
+        }
+    }
+
+    float CtcDecoder::Score(const Beam& beam)
+    {
+        return LogAdd(beam.m_logProbBlank, beam.m_logProbNonBlank) + beam.m_bonus;
+    }
+
+} /* namespace asr */
+} /* namespace audio */
+} /* namespace app */
+} /* namespace arm */
@@ -56,15 +56,14 @@ namespace app {
         std::fill(m_delta1Buf.begin(), m_delta1Buf.end(), 0.f);
         std::fill(m_delta2Buf.begin(), m_delta2Buf.end(), 0.f);
 
-        /* While we can slide over the audio. */
-        while (this->m_mfccSlidingWindow.HasNext()) {
+        /* While we can slide over the audio. Frames are columns of the buffer,
+         * strided in memory, as it keeps each feature's evolution contiguous. */
+        while (this->m_mfccSlidingWindow.HasNext() && mfccBufIdx != this->m_numFeatureFrames) {
             const int16_t* mfccWindow = this->m_mfccSlidingWindow.Next();
-            auto mfccAudioData = std::vector<int16_t>(
-                                        mfccWindow,
-                                        mfccWindow + this->m_mfccWindowLen);
-            auto mfcc = this->m_mfcc.MfccCompute(mfccAudioData);
-            for (size_t i = 0; i < this->m_mfccBuf.size(0); ++i) {
-                this->m_mfccBuf(i, mfccBufIdx) = mfcc[i];
+            auto mfcc = this->m_mfcc.MfccCompute(mfccWindow, this->m_mfccWindowLen);
+            auto frame = this->m_mfccBuf.col(mfccBufIdx);
+            for (size_t i = 0; i < frame.size(); ++i) {
+                frame[i] = mfcc[i];
             }
             ++mfccBufIdx;
         }
@@ -75,8 +74,10 @@ namespace app {
             std::vector<float> mfccZeros = this->m_mfcc.MfccCompute(zerosWindow);
 
             while (mfccBufIdx != this->m_numFeatureFrames) {
-                memcpy(&this->m_mfccBuf(0, mfccBufIdx),
-                       mfccZeros.data(), sizeof(float) * m_numMfccFeats);
+                auto frame = this->m_mfccBuf.col(mfccBufIdx);
+                for (size_t i = 0; i < frame.size(); ++i) {
+                    frame[i] = mfccZeros[i];
+                }
                 ++mfccBufIdx;
             }
         }
@@ -84,10 +85,7 @@ namespace app {
         /* Compute first and second order deltas from MFCCs. */
         AsrPreProcess::ComputeDeltas(this->m_mfccBuf, this->m_delta1Buf, this->m_delta2Buf);
 
-        /* Standardize calculated features. */
-        this->Standarize();
-
-        /* Quantise. */
+        /* Standardise and quantise calculated features. */
         QuantParams quantParams = GetTensorQuantParams(this->m_inputTensor);
 
         if (0 == quantParams.scale) {
@@ -97,11 +95,11 @@ namespace app {
 
         switch(this->m_inputTensor->type) {
             case kTfLiteUInt8:
-                return this->Quantise<uint8_t>(
+                return this->StandardiseQuantise<uint8_t>(
                         tflite::GetTensorData<uint8_t>(this->m_inputTensor), this->m_inputTensor->bytes,
                         quantParams.scale, quantParams.offset);
             case kTfLiteInt8:
-                return this->Quantise<int8_t>(
+                return this->StandardiseQuantise<int8_t>(
                         tflite::GetTensorData<int8_t>(this->m_inputTensor), this->m_inputTensor->bytes,
                         quantParams.scale, quantParams.offset);
             default:
@@ -116,12 +114,12 @@ namespace app {
                                       Array2d<float>& delta1,
                                       Array2d<float>& delta2)
     {
-        const std::vector <float> delta1Coeffs =
+        static const float delta1Coeffs[] =
             {6.66666667e-02,  5.00000000e-02,  3.33333333e-02,
              1.66666667e-02, -3.46944695e-18, -1.66666667e-02,
             -3.33333333e-02, -5.00000000e-02, -6.66666667e-02};
 
-        const std::vector <float> delta2Coeffs =
+        static const float delta2Coeffs[] =
             {0.06060606,      0.01515152,     -0.01731602,
             -0.03679654,     -0.04329004,     -0.03679654,
             -0.01731602,      0.01515152,      0.06060606};
@@ -132,7 +130,7 @@ namespace app {
         }
 
         /* Get the middle index; coeff vec len should always be odd. */
-        const size_t coeffLen = delta1Coeffs.size();
+        const size_t coeffLen = sizeof(delta1Coeffs) / sizeof(delta1Coeffs[0]);
         const size_t fMidIdx = (coeffLen - 1)/2;
         const size_t numFeatures = mfcc.size(0);
         const size_t numFeatVectors = mfcc.size(1);
@@ -146,7 +144,12 @@ namespace app {
              *
              * For the small filter, conv1D implementation as a simple loop is efficient enough.
              * Filters of a greater size would need CMSIS-DSP functions to be used, like arm_fir_f32.
+             * The time samples of a feature are contiguous: going through plain pointers
+             * to them lets the compiler vectorise this loop across output times.
              */
+            const float* mfccRow = mfcc.row(i).data();
+            float* delta1Row = delta1.row(i).data();
+            float* delta2Row = delta2.row(i).data();
 
             for (size_t j = fMidIdx; j < numFeatVectors - fMidIdx; ++j) {
                 float d1 = 0;
@@ -155,12 +158,12 @@ namespace app {
 
                 for (size_t k = 0, m = coeffLen - 1; k < coeffLen; ++k, --m) {
 
-                    d1 +=  mfcc(i,mfccStIdx + k) * delta1Coeffs[m];
-                    d2 +=  mfcc(i,mfccStIdx + k) * delta2Coeffs[m];
+                    d1 +=  mfccRow[mfccStIdx + k] * delta1Coeffs[m];
+                    d2 +=  mfccRow[mfccStIdx + k] * delta2Coeffs[m];
                 }
 
-                delta1(i,j) = d1;
-                delta2(i,j) = d2;
+                delta1Row[j] = d1;
+                delta2Row[j] = d2;
             }
         }
 
@@ -186,23 +189,5 @@ namespace app {
         }
     }
 
-    void AsrPreProcess::Standarize()
-    {
-        AsrPreProcess::StandardizeVecF32(this->m_mfccBuf);
-        AsrPreProcess::StandardizeVecF32(this->m_delta1Buf);
-        AsrPreProcess::StandardizeVecF32(this->m_delta2Buf);
-    }
-
-    float AsrPreProcess::GetQuantElem(
-                const float     elem,
-                const float     quantScale,
-                const int       quantOffset,
-                const float     minVal,
-                const float     maxVal)
-    {
-        float val = std::round((elem/quantScale) + quantOffset);
-        return std::min<float>(std::max<float>(val, minVal), maxVal);
-    }
-
 } /* namespace app */
 } /* namespace arm */
\ No newline at end of file
@@ -58,6 +58,29 @@ namespace app {
          **/
          static void AveragResults(const std::vector<std::vector<float>>& resultHistory,
                  std::vector<float>& averageResult);
+
+    private:
+        /**
+         * @brief       Gets the top N classification results straight from
+         *              quantised output, only dequantising the picked ones
+         *              (and, for the softmax, computing the exponentials
+         *              of all). Ties list the lowest index first.
+         * @param[in]   data          Quantised output.
+         * @param[in]   dataLen       Number of outputs.
+         * @param[out]  vecResults    A vector of classification results.
+         * @param[in]   topNCount     Number of top classifications to pick.
+         * @param[in]   useSoftmax    Whether Softmax normalisation should be applied to output.
+         * @param[in]   labels        Labels vector to match classified classes.
+         * @param[in]   quantParams   Quantisation parameters of the output, of a positive scale.
+         * @return      true if successful, false otherwise.
+         **/
+        template<typename T>
+        bool GetQuantisedTopNResults(const T* data, uint32_t dataLen,
+                std::vector<ClassificationResult>& vecResults, uint32_t topNCount,
+                bool useSoftmax, const std::vector <std::string>& labels, const QuantParams& quantParams);
+
+        std::vector<uint32_t>   m_topIndices;   /* Indices of the top N outputs. */
+        std::vector<float>      m_scores;       /* Softmax exponentials of the outputs. */
     };
 
 } /* namespace app */
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef KWS_DETECTOR_HPP
+#define KWS_DETECTOR_HPP
+
+#include "TensorFlowLiteMicro.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arm {
+namespace app {
+namespace kws {
+
+    /* Keyword spotting decision engine parameters. */
+    struct KwsDetectorParams {
+        size_t      m_smoothingWindowLen{2};    /* Number of posteriors averaged per decision. */
+        uint32_t    m_refractoryStrides{1};     /* Updates after an event during which no event is raised. */
+        float       m_defaultThreshold{0.7f};   /* Smoothed score needed to raise an event. */
+        size_t      m_eventHistoryLen{8};       /* Number of recent events kept. */
+    };
+
+    /* Keyword detected by the decision engine. */
+    struct KwsEvent {
+        uint32_t    m_labelIdx;         /* Index of the detected label. */
+        float       m_score;            /* Smoothed score at detection. */
+        float       m_timeStamp;        /* Audio timestamp of the detection in seconds. */
+        uint32_t    m_inferenceNumber;  /* Update the event was raised at. */
+    };
+
+    /**
+     * @brief   Streaming keyword spotting decision engine.
+     *          Posteriors of each inference are kept in a fixed-size ring and
+     *          averaged. A keyword is reported when its smoothed score reaches
+     *          its threshold, after which:
+     *          - no keyword is reported for the refractory window,
+     *          - the same keyword is not reported again until its smoothed
+     *            score drops below its threshold, so one utterance spanning
+     *            several overlapping windows gives one event.
+     *          Works on label indices only; no memory is allocated after
+     *          construction.
+     */
+    class KwsDetector {
+    public:
+        /**
+         * @brief       Constructor.
+         * @param[in]   numClasses   Number of model output classes.
+         * @param[in]   params       Decision engine parameters.
+         **/
+        KwsDetector(size_t numClasses, const KwsDetectorParams& params);
+
+        KwsDetector() = delete;
+
+        ~KwsDetector() = default;
+
+        /**
+         * @brief       Sets the threshold of one class. A threshold above 1
+         *              disables the class, e.g. for silence or unknown labels.
+         * @param[in]   labelIdx    Class index.
+         * @param[in]   threshold   Smoothed score needed to raise an event.
+         **/
+        void SetThreshold(uint32_t labelIdx, float threshold);
+
+        /**
+         * @brief       Adds the posteriors of one inference and runs the decision.
+         * @param[in]   posteriors   Pointer to one score per class.
+         * @param[in]   timeStamp    Audio timestamp of the inference in seconds.
+         * @return      true if a keyword event was raised, false otherwise.
+         **/
+        bool Update(const float* posteriors, float timeStamp);
+
+        /**
+         * @brief       Dequantises the output tensor, optionally applies softmax
+         *              and adds the result as the posteriors of one inference.
+         * @param[in]   outputTensor   Inference output tensor.
+         * @param[in]   timeStamp      Audio timestamp of the inference in seconds.
+         * @param[in]   useSoftmax     Whether softmax should be applied to the output.
+         * @param[out]  event          Set to true if a keyword event was raised.
+         * @return      true if successful, false otherwise.
+         **/
+        bool Update(TfLiteTensor* outputTensor, float timeStamp, bool useSoftmax, bool& event);
+
+        /** @brief  Clears the posterior ring, refractory state and events. */
+        void Reset();
+
+        /** @brief  Gets the smoothed score of a class from the last update. */
+        float GetSmoothedScore(uint32_t labelIdx) const;
+
+        /** @brief  Gets the number of events kept in the history. */
+        size_t GetEventCount() const;
+
+        /**
+         * @brief       Gets an event from the history.
+         * @param[in]   i   Event index, 0 being the oldest kept event.
+         * @return      Reference to the event.
+         **/
+        const KwsEvent& GetEvent(size_t i) const;
+
+        /** @brief  Gets the most recent event; only valid if GetEventCount() > 0. */
+        const KwsEvent& GetLastEvent() const;
+
+    private:
+        KwsDetectorParams       m_params;
+        size_t                  m_numClasses;
+        std::vector<float>      m_thresholds;       /* Per class thresholds. */
+        std::vector<float>      m_ring;             /* Posterior ring, m_smoothingWindowLen x m_numClasses. */
+        std::vector<float>      m_smoothed;         /* Smoothed scores of the last update. */
+        std::vector<float>      m_scratch;          /* Dequantised output tensor. */
+        std::vector<bool>       m_armed;            /* Class can raise an event. */
+        std::vector<KwsEvent>   m_events;           /* Event history ring. */
+        size_t                  m_ringHead{0};      /* Next posterior slot to write. */
+        size_t                  m_ringCount{0};     /* Number of valid posterior slots. */
+        size_t                  m_eventHead{0};     /* Next event slot to write. */
+        size_t                  m_eventCount{0};    /* Number of valid events. */
+        uint32_t                m_refractoryLeft{0}; /* Updates left in the refractory window. */
+        uint32_t                m_updateCount{0};   /* Number of updates so far. */
+    };
+
+} /* namespace kws */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* KWS_DETECTOR_HPP */
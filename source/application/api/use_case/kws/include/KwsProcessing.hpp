@@ -44,15 +44,22 @@ namespace app {
          * @param[in]   mfccFrameLength    Number of audio samples used to calculate one set of MFCC values when
          *                                 sliding a window through the audio sample.
          * @param[in]   mfccFrameStride    Number of audio samples between consecutive windows.
+         * @param[in]   audioDataStride    Number of audio samples between consecutive inferences.
+         *                                 Rounded down to a multiple of mfccFrameStride, with a
+         *                                 minimum of one mfccFrameStride. 0 means half the
+         *                                 audio window.
          **/
         explicit KwsPreProcess(TfLiteTensor* inputTensor, size_t numFeatures, size_t numFeatureFrames,
-                               int mfccFrameLength, int mfccFrameStride);
+                               int mfccFrameLength, int mfccFrameStride, size_t audioDataStride = 0);
 
         /**
          * @brief       Should perform pre-processing of 'raw' input audio data and load it into
          *              TFLite Micro input tensors ready for inference.
-         * @param[in]   input      Pointer to the data that pre-processing will work on.
-         * @param[in]   inputSize  Size of the input data.
+         *              For inferenceIndex > 0 the previous call must have been given the audio
+         *              window one stride earlier; only the MFCC vectors of the new stride are
+         *              then computed.
+         * @param[in]   input           Pointer to the data that pre-processing will work on.
+         * @param[in]   inferenceIndex  Index of the audio window, in strides.
          * @return      true if successful, false otherwise.
          **/
         bool DoPreProcess(const void* input, size_t inferenceIndex = 0) override;
@@ -70,11 +77,15 @@ namespace app {
         audio::SlidingWindow<const int16_t> m_mfccSlidingWindow;
         size_t m_numMfccVectorsInAudioStride;
         size_t m_numReusedMfccVectors;
-        std::function<void (std::vector<int16_t>&, int, bool, size_t)> m_mfccFeatureCalculator;
+        std::vector<uint8_t> m_featureRing;         /* Features of the current window, one row per MFCC vector;
+                                                     * not kept in the input tensor (see Model::BindState). */
+        size_t m_featureRowSize;                    /* Size of one row of m_featureRing in bytes. */
+        size_t m_featureRingStart{0};               /* Row of m_featureRing holding the oldest MFCC vector. */
+        std::function<void (const int16_t*, uint8_t*)> m_mfccFeatureCalculator;
 
         /**
-         * @brief Returns a function to perform feature calculation and populates input tensor data with
-         * MFCC data.
+         * @brief Returns a function to perform feature calculation and write one row of
+         * MFCC data to the given destination.
          *
          * Input tensor data type check is performed to choose correct MFCC feature data type.
          * If tensor has an integer data type then original features are quantised.
@@ -82,19 +93,16 @@ namespace app {
          * Warning: MFCC calculator provided as input must have the same life scope as returned function.
          *
          * @param[in]       mfcc          MFCC feature calculator.
-         * @param[in,out]   inputTensor   Input tensor pointer to store calculated features.
-         * @param[in]       cacheSize     Size of the feature vectors cache (number of feature vectors).
-         * @return          Function to be called providing audio sample and sliding window index.
+         * @param[in]       inputTensor   Input tensor pointer, used for the data type and quantisation.
+         * @return          Function to be called providing the MFCC frame's audio and destination row.
          */
-        std::function<void (std::vector<int16_t>&, int, bool, size_t)>
+        std::function<void (const int16_t*, uint8_t*)>
         GetFeatureCalculator(audio::MicroNetKwsMFCC&  mfcc,
-                             TfLiteTensor*            inputTensor,
-                             size_t                   cacheSize);
+                             TfLiteTensor*            inputTensor);
 
         template<class T>
-        std::function<void (std::vector<int16_t>&, size_t, bool, size_t)>
-        FeatureCalc(TfLiteTensor* inputTensor, size_t cacheSize,
-                    std::function<std::vector<T> (std::vector<int16_t>& )> compute);
+        std::function<void (const int16_t*, uint8_t*)>
+        FeatureCalc(std::function<void (const int16_t*, T*)> compute);
     };
 
     /**
@@ -110,6 +118,7 @@ namespace app {
         const std::vector<std::string>& m_labels;          /* KWS Labels. */
         std::vector<ClassificationResult>& m_results;      /* Results vector for a single inference. */
         std::vector<std::vector<float>> m_resultHistory;   /* Store previous results so they can be averaged. */
+        uint32_t m_topN;                                   /* Number of results to keep per inference. */
     public:
         /**
          * @brief           Constructor
@@ -117,10 +126,13 @@ namespace app {
          * @param[in]       classifier     Classifier object used to get top N results from classification.
          * @param[in]       labels         Vector of string labels to identify each output of the model.
          * @param[in/out]   results        Vector of classification results to store decoded outputs.
+         * @param[in]       averagingWindowLen   Number of inferences the scores are averaged over.
+         * @param[in]       topN           Number of top results to store, highest first.
          **/
         KwsPostProcess(TfLiteTensor* outputTensor, KwsClassifier& classifier,
                        const std::vector<std::string>& labels,
-                       std::vector<ClassificationResult>& results, size_t averagingWindowLen = 1);
+                       std::vector<ClassificationResult>& results, size_t averagingWindowLen = 1,
+                       uint32_t topN = 1);
 
         /**
          * @brief    Should perform post-processing of the result of inference then
@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <numeric>
 #include <string>
 #include <set>
 #include <cstdint>
@@ -65,6 +66,20 @@ namespace app {
         /* De-Quantize Output Tensor */
         QuantParams quantParams = GetTensorQuantParams(outputTensor);
 
+        /* Without averaging, the top N can be picked from the quantised output. */
+        if (resultHistory.size() <= 1 && quantParams.scale > 0) {
+            switch (outputTensor->type) {
+                case kTfLiteUInt8:
+                    return this->GetQuantisedTopNResults(tflite::GetTensorData<uint8_t>(outputTensor),
+                            totalOutputSize, vecResults, topNCount, useSoftmax, labels, quantParams);
+                case kTfLiteInt8:
+                    return this->GetQuantisedTopNResults(tflite::GetTensorData<int8_t>(outputTensor),
+                            totalOutputSize, vecResults, topNCount, useSoftmax, labels, quantParams);
+                default:
+                    break;
+            }
+        }
+
         /* Floating point tensor data to be populated
          * NOTE: The assumption here is that the output tensor size isn't too
          * big and therefore, there's neglibible impact on heap usage. */
@@ -124,6 +139,54 @@ namespace app {
         return true;
     }
 
+    static uint32_t TopK(const uint8_t* src, uint32_t srcLen, uint32_t k, uint32_t* dst)
+    {
+        return math::MathUtils::TopKU8(src, srcLen, k, dst);
+    }
+
+    static uint32_t TopK(const int8_t* src, uint32_t srcLen, uint32_t k, uint32_t* dst)
+    {
+        return math::MathUtils::TopKS8(src, srcLen, k, dst);
+    }
+
+    template<typename T>
+    bool KwsClassifier::GetQuantisedTopNResults(const T* data, const uint32_t dataLen,
+            std::vector<ClassificationResult>& vecResults, const uint32_t topNCount,
+            const bool useSoftmax, const std::vector <std::string>& labels, const QuantParams& quantParams)
+    {
+        this->m_topIndices.resize(topNCount);
+        const uint32_t numResults = TopK(data, dataLen, topNCount, this->m_topIndices.data());
+
+        /* The softmax needs the exponentials of all the outputs for its sum. They are
+         * computed as SoftmaxF32 does, so that the scores are the same as with it. */
+        float sumExp = 1.f;
+        if (useSoftmax) {
+            const float maxValue = quantParams.scale *
+                (static_cast<float>(data[this->m_topIndices[0]]) - quantParams.offset);
+            this->m_scores.resize(dataLen);
+            for (uint32_t i = 0; i < dataLen; ++i) {
+                this->m_scores[i] = quantParams.scale *
+                    (static_cast<float>(data[i]) - quantParams.offset);
+            }
+            for (uint32_t i = 0; i < dataLen; ++i) {
+                this->m_scores[i] -= maxValue;
+            }
+            math::MathUtils::VecExpF32(this->m_scores.data(), this->m_scores.data(), dataLen);
+            sumExp = std::accumulate(this->m_scores.begin(), this->m_scores.end(), 0.0f);
+        }
+
+        vecResults.resize(numResults);
+        for (uint32_t i = 0; i < numResults; ++i) {
+            const uint32_t idx = this->m_topIndices[i];
+            vecResults[i].m_normalisedVal = useSoftmax ? this->m_scores[idx] / sumExp :
+                quantParams.scale * (static_cast<float>(data[idx]) - quantParams.offset);
+            vecResults[i].m_label = labels[idx];
+            vecResults[i].m_labelIdx = idx;
+        }
+
+        return true;
+    }
+
     void app::KwsClassifier::AveragResults(const std::vector<std::vector<float>>& resultHistory,
             std::vector<float>& averageResult)
     {
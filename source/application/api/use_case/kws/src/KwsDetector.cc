@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "KwsDetector.hpp"
+
+#include "PlatformMath.hpp"
+#include "log_macros.h"
+
+#include <algorithm>
+
+namespace arm {
+namespace app {
+namespace kws {
+
+    KwsDetector::KwsDetector(const size_t numClasses, const KwsDetectorParams& params)
+    :   m_params{params},
+        m_numClasses{numClasses},
+        m_thresholds(numClasses, params.m_defaultThreshold),
+        m_smoothed(numClasses, 0.f),
+        m_scratch(numClasses, 0.f),
+        m_armed(numClasses, true)
+    {
+        this->m_params.m_smoothingWindowLen = std::max<size_t>(1, params.m_smoothingWindowLen);
+        this->m_params.m_eventHistoryLen = std::max<size_t>(1, params.m_eventHistoryLen);
+        this->m_ring = std::vector<float>(this->m_params.m_smoothingWindowLen * numClasses, 0.f);
+        this->m_events = std::vector<KwsEvent>(this->m_params.m_eventHistoryLen);
+    }
+
+    void KwsDetector::SetThreshold(const uint32_t labelIdx, const float threshold)
+    {
+        if (labelIdx < this->m_numClasses) {
+            this->m_thresholds[labelIdx] = threshold;
+        }
+    }
+
+    bool KwsDetector::Update(const float* posteriors, const float timeStamp)
+    {
+        const size_t windowLen = this->m_params.m_smoothingWindowLen;
+
+        std::copy(posteriors, posteriors + this->m_numClasses,
+                  this->m_ring.begin() + this->m_ringHead * this->m_numClasses);
+        this->m_ringHead = (this->m_ringHead + 1) % windowLen;
+        this->m_ringCount = std::min(this->m_ringCount + 1, windowLen);
+
+        /* Average over the valid slots only, so the first updates are not diluted. */
+        std::fill(this->m_smoothed.begin(), this->m_smoothed.end(), 0.f);
+        for (size_t slot = 0; slot < this->m_ringCount; ++slot) {
+            const float* row = this->m_ring.data() + slot * this->m_numClasses;
+            for (size_t c = 0; c < this->m_numClasses; ++c) {
+                this->m_smoothed[c] += row[c];
+            }
+        }
+        const float norm = 1.f / this->m_ringCount;
+
+        bool suppressed = this->m_refractoryLeft > 0;
+        if (suppressed) {
+            --this->m_refractoryLeft;
+        }
+
+        uint32_t best = 0;
+        float bestScore = -1.f;
+        for (size_t c = 0; c < this->m_numClasses; ++c) {
+            this->m_smoothed[c] *= norm;
+            if (this->m_smoothed[c] < this->m_thresholds[c]) {
+                this->m_armed[c] = true;
+            } else if (this->m_armed[c] && this->m_smoothed[c] > bestScore) {
+                best = c;
+                bestScore = this->m_smoothed[c];
+            }
+        }
+
+        const uint32_t updateNumber = this->m_updateCount++;
+        if (suppressed || bestScore < 0.f) {
+            return false;
+        }
+
+        this->m_armed[best] = false;
+        this->m_refractoryLeft = this->m_params.m_refractoryStrides;
+
+        this->m_events[this->m_eventHead] = KwsEvent{best, bestScore, timeStamp, updateNumber};
+        this->m_eventHead = (this->m_eventHead + 1) % this->m_events.size();
+        this->m_eventCount = std::min(this->m_eventCount + 1, this->m_events.size());
+        return true;
+    }
+
+    bool KwsDetector::Update(TfLiteTensor* outputTensor, const float timeStamp,
+                             const bool useSoftmax, bool& event)
+    {
+        event = false;
+        if (outputTensor == nullptr) {
+            printf_err("Output vector is null pointer.\n");
+            return false;
+        }
+
+        size_t totalOutputSize = 1;
+        for (int inputDim = 0; inputDim < outputTensor->dims->size; inputDim++) {
+            totalOutputSize *= outputTensor->dims->data[inputDim];
+        }
+
+        if (totalOutputSize != this->m_numClasses) {
+            printf_err("Output size doesn't match the number of classes\n");
+            return false;
+        }
+
+        QuantParams quantParams = GetTensorQuantParams(outputTensor);
+
+        switch (outputTensor->type) {
+            case kTfLiteUInt8: {
+                const uint8_t* tensorBuffer = tflite::GetTensorData<uint8_t>(outputTensor);
+                for (size_t i = 0; i < this->m_numClasses; ++i) {
+                    this->m_scratch[i] = quantParams.scale *
+                        (static_cast<float>(tensorBuffer[i]) - quantParams.offset);
+                }
+                break;
+            }
+            case kTfLiteInt8: {
+                const int8_t* tensorBuffer = tflite::GetTensorData<int8_t>(outputTensor);
+                for (size_t i = 0; i < this->m_numClasses; ++i) {
+                    this->m_scratch[i] = quantParams.scale *
+                        (static_cast<float>(tensorBuffer[i]) - quantParams.offset);
+                }
+                break;
+            }
+            case kTfLiteFloat32: {
+                const float* tensorBuffer = tflite::GetTensorData<float>(outputTensor);
+                std::copy(tensorBuffer, tensorBuffer + this->m_numClasses, this->m_scratch.begin());
+                break;
+            }
+            default:
+                printf_err("Tensor type %s not supported by detector\n",
+                    TfLiteTypeGetName(outputTensor->type));
+                return false;
+        }
+
+        if (useSoftmax) {
+            math::MathUtils::SoftmaxF32(this->m_scratch);
+        }
+
+        event = this->Update(this->m_scratch.data(), timeStamp);
+        return true;
+    }
+
+    void KwsDetector::Reset()
+    {
+        std::fill(this->m_smoothed.begin(), this->m_smoothed.end(), 0.f);
+        std::fill(this->m_armed.begin(), this->m_armed.end(), true);
+        this->m_ringHead = 0;
+        this->m_ringCount = 0;
+        this->m_eventHead = 0;
+        this->m_eventCount = 0;
+        this->m_refractoryLeft = 0;
+        this->m_updateCount = 0;
+    }
+
+    float KwsDetector::GetSmoothedScore(const uint32_t labelIdx) const
+    {
+        return labelIdx < this->m_numClasses ? this->m_smoothed[labelIdx] : 0.f;
+    }
+
+    size_t KwsDetector::GetEventCount() const
+    {
+        return this->m_eventCount;
+    }
+
+    const KwsEvent& KwsDetector::GetEvent(const size_t i) const
+    {
+        const size_t capacity = this->m_events.size();
+        return this->m_events[(this->m_eventHead + capacity - this->m_eventCount + i) % capacity];
+    }
+
+    const KwsEvent& KwsDetector::GetLastEvent() const
+    {
+        return this->GetEvent(this->m_eventCount - 1);
+    }
+
+} /* namespace kws */
+} /* namespace app */
+} /* namespace arm */
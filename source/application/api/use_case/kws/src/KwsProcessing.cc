@@ -18,17 +18,22 @@
 #include "log_macros.h"
 #include "MicroNetKwsModel.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace arm {
 namespace app {
 
     KwsPreProcess::KwsPreProcess(TfLiteTensor* inputTensor, size_t numFeatures, size_t numMfccFrames,
-            int mfccFrameLength, int mfccFrameStride
+            int mfccFrameLength, int mfccFrameStride, size_t audioDataStride
         ):
         m_inputTensor{inputTensor},
         m_mfccFrameLength{mfccFrameLength},
         m_mfccFrameStride{mfccFrameStride},
         m_numMfccFrames{numMfccFrames},
-        m_mfcc{audio::MicroNetKwsMFCC(numFeatures, mfccFrameLength)}
+        m_mfcc{audio::MicroNetKwsMFCC(numFeatures, mfccFrameLength)},
+        m_featureRing(inputTensor->bytes),
+        m_featureRowSize{inputTensor->bytes / numMfccFrames}
     {
         this->m_mfcc.Init();
 
@@ -40,15 +45,18 @@ namespace app {
         this->m_mfccSlidingWindow = audio::SlidingWindow<const int16_t>(nullptr, this->m_audioDataWindowSize,
                 this->m_mfccFrameLength, this->m_mfccFrameStride);
 
-        /* For longer audio clips we choose to move by half the audio window size
+        /* For longer audio clips we choose to move by half the audio window size by default
          * => for a 1 second window size there is an overlap of 0.5 seconds. */
-        this->m_audioDataStride = this->m_audioDataWindowSize / 2;
+        this->m_audioDataStride = audioDataStride ? audioDataStride : this->m_audioDataWindowSize / 2;
 
         /* To have the previously calculated features re-usable, stride must be multiple
          * of MFCC features window stride. Reduce stride through audio if needed. */
         if (0 != this->m_audioDataStride % this->m_mfccFrameStride) {
             this->m_audioDataStride -= this->m_audioDataStride % this->m_mfccFrameStride;
         }
+        this->m_audioDataStride = std::max<size_t>(this->m_audioDataStride, this->m_mfccFrameStride);
+        this->m_audioDataStride = std::min<size_t>(this->m_audioDataStride,
+                                                   this->m_numMfccFrames * this->m_mfccFrameStride);
 
         this->m_numMfccVectorsInAudioStride = this->m_audioDataStride / this->m_mfccFrameStride;
 
@@ -58,8 +66,7 @@ namespace app {
                 - this->m_numMfccVectorsInAudioStride;
 
         /* Construct feature calculation function. */
-        this->m_mfccFeatureCalculator = GetFeatureCalculator(this->m_mfcc, this->m_inputTensor,
-                                                             this->m_numReusedMfccVectors);
+        this->m_mfccFeatureCalculator = GetFeatureCalculator(this->m_mfcc, this->m_inputTensor);
 
         if (!this->m_mfccFeatureCalculator) {
             printf_err("Feature calculator not initialized.");
@@ -70,6 +77,7 @@ namespace app {
     {
         if (data == nullptr) {
             printf_err("Data pointer is null");
+            return false;
         }
 
         /* Set the features sliding window to the new address. */
@@ -79,18 +87,36 @@ namespace app {
         /* Cache is only usable if we have more than 1 inference to do and it's not the first inference. */
         bool useCache = inferenceIndex > 0 && this->m_numReusedMfccVectors > 0;
 
+        /* The feature ring holds the MFCC vectors of the previous window starting at
+         * m_featureRingStart. Moving the start by one stride drops the oldest vectors,
+         * whose rows are then overwritten by the vectors of the new stride. */
+        if (useCache) {
+            this->m_featureRingStart = (this->m_featureRingStart + this->m_numMfccVectorsInAudioStride) %
+                                       this->m_numMfccFrames;
+            this->m_mfccSlidingWindow.FastForward(this->m_numReusedMfccVectors);
+        } else {
+            this->m_featureRingStart = 0;
+        }
+
         /* Use a sliding window to calculate MFCC features frame by frame. */
         while (this->m_mfccSlidingWindow.HasNext()) {
             const int16_t* mfccWindow = this->m_mfccSlidingWindow.Next();
 
-            std::vector<int16_t> mfccFrameAudioData = std::vector<int16_t>(mfccWindow,
-                    mfccWindow + this->m_mfccFrameLength);
-
-            /* Compute features for this window and write them to input tensor. */
-            this->m_mfccFeatureCalculator(mfccFrameAudioData, this->m_mfccSlidingWindow.Index(),
-                                          useCache, this->m_numMfccVectorsInAudioStride);
+            /* Compute features for this window and write them to the feature ring. */
+            const size_t row = (this->m_featureRingStart + this->m_mfccSlidingWindow.Index()) %
+                               this->m_numMfccFrames;
+            this->m_mfccFeatureCalculator(mfccWindow,
+                                          this->m_featureRing.data() + row * this->m_featureRowSize);
         }
 
+        /* Copy the ring to the input tensor, oldest vector first. */
+        auto* tensorData = tflite::GetTensorData<uint8_t>(this->m_inputTensor);
+        const size_t headBytes = this->m_featureRingStart * this->m_featureRowSize;
+        std::memcpy(tensorData, this->m_featureRing.data() + headBytes,
+                    this->m_featureRing.size() - headBytes);
+        std::memcpy(tensorData + this->m_featureRing.size() - headBytes,
+                    this->m_featureRing.data(), headBytes);
+
         debug("Input tensor populated \n");
 
         return true;
@@ -99,65 +125,37 @@ namespace app {
     /**
      * @brief Generic feature calculator factory.
      *
-     * Returns lambda function to compute features using features cache.
-     * Real features math is done by a lambda function provided as a parameter.
-     * Features are written to input tensor memory.
+     * Returns lambda function to compute features straight into a row of the
+     * feature ring, so that nothing is allocated per frame. Real features math
+     * is done by a lambda function provided as a parameter.
      *
-     * @tparam T                Feature vector type.
-     * @param[in] inputTensor   Model input tensor pointer.
-     * @param[in] cacheSize     Number of feature vectors to cache. Defined by the sliding window overlap.
-     * @param[in] compute       Features calculator function.
+     * @tparam T                Feature type.
+     * @param[in] compute       Features calculator function, writing to its second argument.
      * @return                  Lambda function to compute features.
      */
     template<class T>
-    std::function<void (std::vector<int16_t>&, size_t, bool, size_t)>
-    KwsPreProcess::FeatureCalc(TfLiteTensor* inputTensor, size_t cacheSize,
-                               std::function<std::vector<T> (std::vector<int16_t>& )> compute)
+    std::function<void (const int16_t*, uint8_t*)>
+    KwsPreProcess::FeatureCalc(std::function<void (const int16_t*, T*)> compute)
     {
-        /* Feature cache to be captured by lambda function. */
-        static std::vector<std::vector<T>> featureCache = std::vector<std::vector<T>>(cacheSize);
-
-        return [=](std::vector<int16_t>& audioDataWindow,
-                   size_t index,
-                   bool useCache,
-                   size_t featuresOverlapIndex)
+        return [=](const int16_t* audioDataWindow, uint8_t* row)
         {
-            T* tensorData = tflite::GetTensorData<T>(inputTensor);
-            std::vector<T> features;
-
-            /* Reuse features from cache if cache is ready and sliding windows overlap.
-             * Overlap is in the beginning of sliding window with a size of a feature cache. */
-            if (useCache && index < featureCache.size()) {
-                features = std::move(featureCache[index]);
-            } else {
-                features = std::move(compute(audioDataWindow));
-            }
-            auto size = features.size();
-            auto sizeBytes = sizeof(T) * size;
-            std::memcpy(tensorData + (index * size), features.data(), sizeBytes);
-
-            /* Start renewing cache as soon iteration goes out of the windows overlap. */
-            if (index >= featuresOverlapIndex) {
-                featureCache[index - featuresOverlapIndex] = std::move(features);
-            }
+            /* Rows are a whole number of features from the start of the ring. */
+            compute(audioDataWindow, reinterpret_cast<T*>(row));
         };
     }
 
-    template std::function<void (std::vector<int16_t>&, size_t , bool, size_t)>
-    KwsPreProcess::FeatureCalc<int8_t>(TfLiteTensor* inputTensor,
-                                       size_t cacheSize,
-                                       std::function<std::vector<int8_t> (std::vector<int16_t>&)> compute);
+    template std::function<void (const int16_t*, uint8_t*)>
+    KwsPreProcess::FeatureCalc<int8_t>(std::function<void (const int16_t*, int8_t*)> compute);
 
-    template std::function<void(std::vector<int16_t>&, size_t, bool, size_t)>
-    KwsPreProcess::FeatureCalc<float>(TfLiteTensor* inputTensor,
-                                      size_t cacheSize,
-                                      std::function<std::vector<float>(std::vector<int16_t>&)> compute);
+    template std::function<void (const int16_t*, uint8_t*)>
+    KwsPreProcess::FeatureCalc<float>(std::function<void (const int16_t*, float*)> compute);
 
 
-    std::function<void (std::vector<int16_t>&, int, bool, size_t)>
-    KwsPreProcess::GetFeatureCalculator(audio::MicroNetKwsMFCC& mfcc, TfLiteTensor* inputTensor, size_t cacheSize)
+    std::function<void (const int16_t*, uint8_t*)>
+    KwsPreProcess::GetFeatureCalculator(audio::MicroNetKwsMFCC& mfcc, TfLiteTensor* inputTensor)
     {
-        std::function<void (std::vector<int16_t>&, size_t, bool, size_t)> mfccFeatureCalc = nullptr;
+        std::function<void (const int16_t*, uint8_t*)> mfccFeatureCalc = nullptr;
+        const size_t frameLength = this->m_mfccFrameLength;
 
         TfLiteQuantization quant = inputTensor->quantization;
 
@@ -168,12 +166,13 @@ namespace app {
 
             switch (inputTensor->type) {
                 case kTfLiteInt8: {
-                    mfccFeatureCalc = this->FeatureCalc<int8_t>(inputTensor,
-                                                          cacheSize,
-                                                          [=, &mfcc](std::vector<int16_t>& audioDataWindow) {
-                                                              return mfcc.MfccComputeQuant<int8_t>(audioDataWindow,
-                                                                                                   quantScale,
-                                                                                                   quantOffset);
+                    mfccFeatureCalc = this->FeatureCalc<int8_t>(
+                                                          [=, &mfcc](const int16_t* audioDataWindow, int8_t* out) {
+                                                              mfcc.MfccComputeQuant<int8_t>(audioDataWindow,
+                                                                                            frameLength,
+                                                                                            quantScale,
+                                                                                            quantOffset,
+                                                                                            out);
                                                           }
                     );
                     break;
@@ -182,9 +181,9 @@ namespace app {
                 printf_err("Tensor type %s not supported\n", TfLiteTypeGetName(inputTensor->type));
             }
         } else {
-            mfccFeatureCalc = this->FeatureCalc<float>(inputTensor, cacheSize,
-                    [&mfcc](std::vector<int16_t>& audioDataWindow) {
-                return mfcc.MfccCompute(audioDataWindow); }
+            mfccFeatureCalc = this->FeatureCalc<float>(
+                    [=, &mfcc](const int16_t* audioDataWindow, float* out) {
+                mfcc.MfccCompute(audioDataWindow, frameLength, out); }
                 );
         }
         return mfccFeatureCalc;
@@ -192,11 +191,13 @@ namespace app {
 
     KwsPostProcess::KwsPostProcess(TfLiteTensor* outputTensor, KwsClassifier& classifier,
                                    const std::vector<std::string>& labels,
-                                   std::vector<ClassificationResult>& results, size_t averagingWindowLen)
+                                   std::vector<ClassificationResult>& results, size_t averagingWindowLen,
+                                   uint32_t topN)
             :m_outputTensor{outputTensor},
              m_kwsClassifier{classifier},
              m_labels{labels},
-             m_results{results}
+             m_results{results},
+             m_topN{topN}
     {
         this->m_resultHistory = {averagingWindowLen, std::vector<float>(labels.size())};
     }
@@ -205,7 +206,7 @@ namespace app {
     {
         return this->m_kwsClassifier.GetClassificationResults(
                 this->m_outputTensor, this->m_results,
-                this->m_labels, 1, true, this->m_resultHistory);
+                this->m_labels, this->m_topN, true, this->m_resultHistory);
     }
 
 } /* namespace app */
@@ -33,22 +33,15 @@ namespace rnn {
     using math::FftInstance;
     using math::FftType;
 
-    class FrameFeatures {
-    public:
-        bool m_silence{false};        /* If frame contains silence or not. */
-        vec1D32F m_featuresVec{};     /* Calculated feature vector to feed to model. */
-        vec1D32F m_fftX{};            /* Vector of floats arranged to represent complex numbers. */
-        vec1D32F m_fftP{};            /* Vector of floats arranged to represent complex numbers. */
-        vec1D32F m_Ex{};              /* Spectral band energy for audio x. */
-        vec1D32F m_Ep{};              /* Spectral band energy for pitch p. */
-        vec1D32F m_Exp{};             /* Correlated spectral energy between x and p. */
-    };
+    class FrameFeatures;
 
     /**
      * @brief   RNNoise pre and post processing class based on the 2018 paper from
      *          Jan-Marc Valin. Recommended reading:
      *          - https://jmvalin.ca/demo/rnnoise/
      *          - https://arxiv.org/abs/1709.08243
+     *          All the state and working buffers are fixed size members, so that
+     *          processing a frame does not allocate any memory.
      **/
     class RNNoiseFeatureProcessor {
     /* Public interface */
@@ -56,18 +49,47 @@ namespace rnn {
         RNNoiseFeatureProcessor();
         ~RNNoiseFeatureProcessor() = default;
 
+        /**
+         * @brief   Clears the state carried from frame to frame, to start
+         *          processing an unrelated audio stream.
+         **/
+        void Reset();
+
         /**
          * @brief        Calculates the features from a given audio buffer ready to be sent to RNNoise model.
          * @param[in]    audioData   Pointer to the floating point vector
          *                           with audio data (within the numerical
          *                           limits of int16_t type).
-         * @param[in]    audioLen    Number of elements in the audio window.
+         * @param[in]    audioLen    Number of elements in the audio window. Only
+         *                           FRAME_SIZE elements are used, shorter windows
+         *                           are zero padded.
          * @param[out]   features    FrameFeatures object reference.
          **/
         void PreprocessFrame(const float*   audioData,
                              size_t   audioLen,
                              FrameFeatures& features);
 
+        /**
+         * @brief        Calculates the features from a given audio buffer ready to be sent to RNNoise model.
+         * @param[in]    audioData   Pointer to the audio data.
+         * @param[in]    audioLen    Number of elements in the audio window. Only
+         *                           FRAME_SIZE elements are used, shorter windows
+         *                           are zero padded.
+         * @param[out]   features    FrameFeatures object reference.
+         **/
+        void PreprocessFrame(const int16_t* audioData,
+                             size_t   audioLen,
+                             FrameFeatures& features);
+
+        /**
+         * @brief        Use the RNNoise model output gain values with pre-processing features
+         *               to generate audio with noise suppressed.
+         * @param[in]    modelOutput   Output gain values from model, NB_BANDS elements.
+         * @param[in]    features      Calculated features from pre-processing step.
+         * @param[out]   outFrame      Output frame to be populated, FRAME_SIZE elements.
+         **/
+        void PostProcessFrame(const float* modelOutput, FrameFeatures& features, float* outFrame);
+
         /**
          * @brief        Use the RNNoise model output gain values with pre-processing features
          *               to generate audio with noise suppressed.
@@ -109,126 +131,125 @@ namespace rnn {
          * @param[in]       bHp           Constant coefficient set b (arrHp type).
          * @param[in]       aHp           Constant coefficient set a (arrHp type).
          * @param[in,out]   memHpX        Coefficients populated by this function.
-         * @param[in,out]   audioWindow   Floating point vector with audio data.
+         * @param[in,out]   audioWindow   Audio data, FRAME_SIZE elements.
          **/
         void BiQuad(
             const arrHp& bHp,
             const arrHp& aHp,
             arrHp& memHpX,
-            vec1D32F& audioWindow);
+            float* audioWindow);
 
         /**
          * @brief        Computes features from the "filtered" audio window.
-         * @param[in]    audioWindow   Floating point vector with audio data.
+         * @param[in]    audioWindow   Audio data, FRAME_SIZE elements.
          * @param[out]   features      FrameFeatures object reference.
          **/
-        void ComputeFrameFeatures(vec1D32F& audioWindow, FrameFeatures& features);
+        void ComputeFrameFeatures(const float* audioWindow, FrameFeatures& features);
 
         /**
-         * @brief        Runs analysis on the audio buffer.
-         * @param[in]    audioWindow   Floating point vector with audio data.
-         * @param[out]   fft           Floating point FFT vector containing real and
-         *                             imaginary pairs of elements. NOTE: this vector
+         * @brief        Runs analysis on the audio buffer, with the previous
+         *               frame kept in m_analysisMem.
+         * @param[in]    audioWindow   Audio data, FRAME_SIZE elements.
+         * @param[out]   fft           Floating point FFT buffer containing real and
+         *                             imaginary pairs of elements. NOTE: this buffer
          *                             does not contain the mirror image (conjugates)
          *                             part of the spectrum.
          * @param[out]   energy        Computed energy for each band in the Bark scale.
-         * @param[out]   analysisMem   Buffer sequentially, but partially,
-         *                             populated with new audio data.
          **/
         void FrameAnalysis(
-            const vec1D32F& audioWindow,
-            vec1D32F& fft,
-            vec1D32F& energy,
-            vec1D32F& analysisMem);
+            const float* audioWindow,
+            float* fft,
+            float* energy);
 
         /**
          * @brief               Applies the window function, in-place, over the given
          *                      floating point buffer.
-         * @param[in,out]   x   Buffer the window will be applied to.
+         * @param[in,out]   x   Buffer the window will be applied to, WINDOW_SIZE elements.
          **/
-        void ApplyWindow(vec1D32F& x);
+        void ApplyWindow(float* x);
 
         /**
-         * @brief        Computes the FFT for a given vector.
-         * @param[in]    x     Vector to compute the FFT from.
-         * @param[out]   fft   Floating point FFT vector containing real and
-         *                     imaginary pairs of elements. NOTE: this vector
-         *                     does not contain the mirror image (conjugates)
-         *                     part of the spectrum.
+         * @brief        Computes the FFT for a given buffer.
+         * @param[in]    x     Buffer to compute the FFT from, WINDOW_SIZE elements
+         *                     (modified).
+         * @param[out]   fft   Floating point FFT buffer containing real and
+         *                     imaginary pairs of elements, 2 * FREQ_SIZE elements.
+         *                     NOTE: this buffer does not contain the mirror image
+         *                     (conjugates) part of the spectrum.
          **/
         void ForwardTransform(
-            vec1D32F& x,
-            vec1D32F& fft);
+            float* x,
+            float* fft);
 
         /**
          * @brief        Computes band energy for each of the 22 Bark scale bands.
          * @param[in]    fft_X   FFT spectrum (as computed by ForwardTransform).
-         * @param[out]   bandE   Vector with 22 elements populated with energy for
+         * @param[out]   bandE   Buffer with 22 elements populated with energy for
          *                       each band.
          **/
-        void ComputeBandEnergy(const vec1D32F& fft_X, vec1D32F& bandE);
+        void ComputeBandEnergy(const float* fft_X, float* bandE);
 
         /**
          * @brief        Computes band energy correlation.
-         * @param[in]    X       FFT vector X.
-         * @param[in]    P       FFT vector P.
-         * @param[out]   bandC   Vector with 22 elements populated with band energy
-         *                       correlation for the two input FFT vectors.
+         * @param[in]    X       FFT buffer X.
+         * @param[in]    P       FFT buffer P.
+         * @param[out]   bandC   Buffer with 22 elements populated with band energy
+         *                       correlation for the two input FFT buffers.
          **/
-        void ComputeBandCorr(const vec1D32F& X, const vec1D32F& P, vec1D32F& bandC);
+        void ComputeBandCorr(const float* X, const float* P, float* bandC);
 
         /**
-         * @brief        Performs pitch auto-correlation for a given vector for
+         * @brief        Performs pitch auto-correlation for a given buffer for
          *               given lag.
-         * @param[in]    x     Input vector.
-         * @param[out]   ac    Auto-correlation output vector.
+         * @param[in]    x     Input buffer.
+         * @param[out]   ac    Auto-correlation output buffer (lag + 1 elements).
          * @param[in]    lag   Lag value.
          * @param[in]    n     Number of elements to consider for correlation
          *                     computation.
          **/
-        void AutoCorr(const vec1D32F &x,
-                     vec1D32F &ac,
+        void AutoCorr(const float* x,
+                     float* ac,
                      size_t lag,
                      size_t n);
 
         /**
          * @brief       Computes pitch cross-correlation.
-         * @param[in]   x          Input vector 1.
-         * @param[in]   y          Input vector 2.
-         * @param[out]  xCorr         Cross-correlation output vector.
+         * @param[in]   x          Input buffer 1.
+         * @param[in]   y          Input buffer 2.
+         * @param[out]  xCorr      Cross-correlation output buffer.
          * @param[in]   len        Number of elements to consider for correlation.
          *                         computation.
          * @param[in]   maxPitch   Maximum pitch.
          **/
         void PitchXCorr(
-            const vec1D32F& x,
-            const vec1D32F& y,
-            vec1D32F& xCorr,
+            const float* x,
+            const float* y,
+            float* xCorr,
             size_t len,
             size_t maxPitch);
 
         /**
          * @brief        Computes "Linear Predictor Coefficients".
-         * @param[in]    ac    Correlation vector.
-         * @param[in]    p     Number of elements of input vector to consider.
-         * @param[out]   lpc   Output coefficients vector.
+         * @param[in]    ac    Correlation buffer (p + 1 elements).
+         * @param[in]    p     Number of coefficients.
+         * @param[out]   lpc   Output coefficients buffer.
          **/
-        void LPC(const vec1D32F& ac, int32_t p, vec1D32F& lpc);
+        void LPC(const float* ac, int32_t p, float* lpc);
 
         /**
          * @brief        Custom FIR implementation.
-         * @param[in]    num   FIR coefficient vector.
+         * @param[in]    num   FIR coefficients (5 elements).
          * @param[in]    N     Number of elements.
-         * @param[out]   x     Vector to be be processed.
+         * @param[out]   x     Buffer to be be processed.
          **/
-        void Fir5(const vec1D32F& num, uint32_t N, vec1D32F& x);
+        void Fir5(const float* num, uint32_t N, float* x);
 
         /**
          * @brief           Down-sample the pitch buffer.
-         * @param[in,out]   pitchBuf     Pitch buffer.
-         * @param[in]       pitchBufSz   Buffer size.
+         * @param[out]      pitchBuf     Down-sampled pitch buffer.
+         * @param[in]       pitchBufSz   Size of the pitch buffer before down-sampling.
          **/
-        void PitchDownsample(vec1D32F& pitchBuf, size_t pitchBufSz);
+        void PitchDownsample(float* pitchBuf, size_t pitchBufSz);
 
         /**
          * @brief       Pitch search function.
@@ -238,21 +259,21 @@ namespace rnn {
          * @param[in]   maxPitch   Maximum pitch.
          * @return      pitch index.
          **/
-        int PitchSearch(vec1D32F& xLp, vec1D32F& y, uint32_t len, uint32_t maxPitch);
+        int PitchSearch(const float* xLp, const float* y, uint32_t len, uint32_t maxPitch);
 
         /**
          * @brief       Finds the "best" pitch from the buffer.
-         * @param[in]   xCorr      Pitch correlation vector.
+         * @param[in]   xCorr      Pitch correlation buffer.
          * @param[in]   y          Pitch buffer input.
          * @param[in]   len        Length to search for.
          * @param[in]   maxPitch   Maximum pitch.
          * @return      pitch array (2 elements).
          **/
-        arrHp FindBestPitch(vec1D32F& xCorr, vec1D32F& y, uint32_t len, uint32_t maxPitch);
+        arrHp FindBestPitch(const float* xCorr, const float* y, uint32_t len, uint32_t maxPitch);
 
         /**
          * @brief           Remove pitch period doubling errors.
-         * @param[in,out]   pitchBuf     Pitch buffer vector.
+         * @param[in]       pitchBuf     Pitch buffer.
          * @param[in]       maxPeriod    Maximum period.
          * @param[in]       minPeriod    Minimum period.
          * @param[in]       frameSize    Frame size.
@@ -260,7 +281,7 @@ namespace rnn {
          * @return          pitch index.
          **/
         int RemoveDoubling(
-                vec1D32F& pitchBuf,
+                const float* pitchBuf,
                 uint32_t maxPeriod,
                 uint32_t minPeriod,
                 uint32_t frameSize,
@@ -276,56 +297,72 @@ namespace rnn {
         float ComputePitchGain(float xy, float xx, float yy);
 
         /**
-         * @brief        Computes DCT vector from the given input.
-         * @param[in]    input    Input vector.
-         * @param[out]   output   Output vector with DCT coefficients.
+         * @brief        Computes DCT from the given input.
+         * @param[in]    input    Input buffer, NB_BANDS elements.
+         * @param[out]   output   Output buffer with NB_BANDS DCT coefficients.
          **/
-        void DCT(vec1D32F& input, vec1D32F& output);
+        void DCT(const float* input, float* output);
 
         /**
-         * @brief        Perform inverse fourier transform on complex spectral vector.
-         * @param[out]   out      Output vector.
-         * @param[in]    fftXIn   Vector of floats arranged to represent complex numbers interleaved.
+         * @brief        Perform inverse fourier transform on complex spectral buffer.
+         * @param[out]   out      Output buffer, WINDOW_SIZE elements.
+         * @param[in]    fftXIn   Buffer of floats arranged to represent complex numbers interleaved.
          **/
-        void InverseTransform(vec1D32F& out, vec1D32F& fftXIn);
+        void InverseTransform(float* out, const float* fftXIn);
 
         /**
          * @brief       Perform pitch filtering.
          * @param[in]   features   Object with pre-processing calculated frame features.
-         * @param[in]   g          Gain values.
+         * @param[in]   g          Gain values, NB_BANDS elements.
          **/
-        void PitchFilter(FrameFeatures& features, vec1D32F& g);
+        void PitchFilter(FrameFeatures& features, const float* g);
 
         /**
          * @brief        Interpolate the band gain values.
          * @param[out]   g       Gain values.
-         * @param[in]    bandE   Vector with 22 elements populated with energy for
+         * @param[in]    bandE   Buffer with 22 elements populated with energy for
          *                       each band.
          **/
-        void InterpBandGain(vec1D32F& g, vec1D32F& bandE);
+        void InterpBandGain(float* g, const float* bandE);
 
         /**
          * @brief        Create de-noised frame.
-         * @param[out]   outFrame   Output vector for storing the created audio frame.
-         * @param[in]    fftY       Gain adjusted complex spectral vector.
+         * @param[out]   outFrame   Output buffer for storing the created audio frame.
+         * @param[in]    fftY       Gain adjusted complex spectral buffer.
          */
-        void FrameSynthesis(vec1D32F& outFrame, vec1D32F& fftY);
+        void FrameSynthesis(float* outFrame, const float* fftY);
 
     /* Private objects */
     private:
         FftInstance m_fftInstReal;  /* FFT instance for real numbers */
         FftInstance m_fftInstCmplx; /* FFT instance for complex numbers */
-        vec1D32F m_halfWindow;      /* Window coefficients */
-        vec1D32F m_dctTable;        /* DCT table */
-        vec1D32F m_analysisMem;     /* Buffer used for frame analysis */
-        vec2D32F m_cepstralMem;     /* Cepstral coefficients */
-        size_t m_memId;             /* memory ID */
-        vec1D32F m_synthesisMem;    /* Synthesis mem (used by post-processing) */
-        vec1D32F m_pitchBuf;        /* Pitch buffer */
-        float m_lastGain;           /* Last gain calculated */
-        int m_lastPeriod;           /* Last period calculated */
-        arrHp m_memHpX;             /* HpX coefficients. */
-        vec1D32F m_lastGVec;        /* Last gain vector (used by post-processing) */
+        std::array<float, FRAME_SIZE> m_halfWindow{};           /* Window coefficients */
+        std::array<float, NB_BANDS * NB_BANDS> m_dctTable{};    /* DCT table */
+
+        /* State carried from frame to frame (see Reset). */
+        std::array<float, FRAME_SIZE> m_analysisMem{};          /* Buffer used for frame analysis */
+        std::array<std::array<float, NB_BANDS>, CEPS_MEM> m_cepstralMem{};  /* Cepstral coefficients */
+        size_t m_memId{0};                                      /* memory ID */
+        std::array<float, FRAME_SIZE> m_synthesisMem{};         /* Synthesis mem (used by post-processing) */
+        std::array<float, PITCH_BUF_SIZE> m_pitchBuf{};         /* Pitch buffer */
+        float m_lastGain{0};                                    /* Last gain calculated */
+        int m_lastPeriod{0};                                    /* Last period calculated */
+        arrHp m_memHpX{};                                       /* HpX coefficients. */
+        std::array<float, NB_BANDS> m_lastGVec{};               /* Last gain vector (used by post-processing) */
+
+        /* Working buffers, overwritten by each frame. */
+        std::array<float, FRAME_SIZE> m_audioWindow{};          /* High pass filtered audio frame. */
+        std::array<float, WINDOW_SIZE> m_window{};              /* Windowed analysis, pitch or synthesis frame. */
+        std::array<float, PITCH_BUF_SIZE / 2> m_pitchBufDown{}; /* Pitch buffer down-sampled by 2. */
+        std::array<float, PITCH_FRAME_SIZE / 4> m_xLp4{};       /* Pitch frame down-sampled by 4. */
+        std::array<float, (PITCH_FRAME_SIZE + PITCH_MAX_PERIOD) / 4> m_yLp4{};  /* Pitch buffer down-sampled by 4. */
+        std::array<float, PITCH_MAX_PERIOD / 2> m_xCorr{};      /* Pitch cross-correlation. */
+        std::array<float, PITCH_MAX_PERIOD / 2 + 1> m_yyLookup{};   /* Pitch energy per period. */
+        std::array<float, WINDOW_SIZE * 2> m_ifftIn{};          /* Complex spectrum, with the conjugates. */
+        std::array<float, WINDOW_SIZE * 2> m_ifftOut{};         /* Complex inverse FFT output. */
+        std::array<float, NB_BANDS> m_bandGain{};               /* Model output gains, filtered. */
+        std::array<float, NB_BANDS> m_bandScratch{};            /* Per band pitch filter values. */
+        std::array<float, FREQ_SIZE> m_interpGain{};            /* Per bin gains; bins above the last band stay 0. */
 
         /* Constants */
         const std::array <uint32_t, NB_BANDS> m_eband5ms {
@@ -333,6 +370,19 @@ namespace rnn {
             14, 16, 20, 24, 28, 34, 40, 48, 60, 78, 100};
     };
 
+    class FrameFeatures {
+    public:
+        using Processor = RNNoiseFeatureProcessor;
+
+        bool m_silence{false};                                      /* If frame contains silence or not. */
+        std::array<float, Processor::NB_FEATURES> m_featuresVec{};  /* Calculated feature vector to feed to model. */
+        std::array<float, 2 * Processor::FREQ_SIZE> m_fftX{};       /* Floats arranged to represent complex numbers. */
+        std::array<float, 2 * Processor::FREQ_SIZE> m_fftP{};       /* Floats arranged to represent complex numbers. */
+        std::array<float, Processor::NB_BANDS> m_Ex{};              /* Spectral band energy for audio x. */
+        std::array<float, Processor::NB_BANDS> m_Ep{};              /* Spectral band energy for pitch p. */
+        std::array<float, Processor::NB_BANDS> m_Exp{};             /* Correlated spectral energy between x and p. */
+    };
+
 
 } /* namespace rnn */
 } /* namespace app */
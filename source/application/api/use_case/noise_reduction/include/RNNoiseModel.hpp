@@ -29,6 +29,9 @@ namespace app {
 
     class RNNoiseModel : public Model {
     public:
+        /** @brief  Constructor: binds the GRU states (see Model::BindState). */
+        RNNoiseModel();
+
         /**
          * @brief Runs inference for RNNoise model.
          *
@@ -47,6 +50,7 @@ namespace app {
         /**
         * @brief Copy current GRU output states to input states.
         * Call this method before starting processing the next sequence of logically related data.
+        * Nothing is allocated, see Model::CarryStates.
          */
         bool CopyGruStates();
 
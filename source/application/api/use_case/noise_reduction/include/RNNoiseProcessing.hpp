@@ -21,6 +21,8 @@
 #include "Model.hpp"
 #include "RNNoiseFeatureProcessor.hpp"
 
+#include <memory>
+
 namespace arm {
 namespace app {
 
@@ -56,16 +58,16 @@ namespace app {
         TfLiteTensor* m_inputTensor;                        /* Model input tensor. */
         std::shared_ptr<rnn::RNNoiseFeatureProcessor> m_featureProcessor;   /* RNNoise feature processor shared between pre & post-processing. */
         std::shared_ptr<rnn::FrameFeatures> m_frameFeatures;                /* RNNoise features shared between pre & post-processing. */
-        rnn::vec1D32F m_audioFrame;                         /* Audio frame cast to FP32 */
 
         /**
          * @brief            Quantize the given features and populate the input Tensor.
-         * @param[in]        inputFeatures   Vector of floating point features to quantize.
+         * @param[in]        inputFeatures   Floating point features to quantize.
+         * @param[in]        numFeatures     Number of features.
          * @param[in]        quantScale      Quantization scale for the inputTensor.
          * @param[in]        quantOffset     Quantization offset for the inputTensor.
          * @param[in,out]    inputTensor     TFLite micro tensor to populate.
          **/
-        static void QuantizeAndPopulateInput(rnn::vec1D32F& inputFeatures,
+        static void QuantizeAndPopulateInput(const float* inputFeatures, size_t numFeatures,
                 float quantScale, int quantOffset,
                 TfLiteTensor* inputTensor);
     };
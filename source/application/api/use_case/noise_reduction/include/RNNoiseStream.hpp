@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RNNOISE_STREAM_HPP
+#define RNNOISE_STREAM_HPP
+
+#include "AudioRingBuffer.hpp"
+#include "RNNoiseFeatureProcessor.hpp"
+#include "RNNoiseModel.hpp"
+#include "RNNoiseProcessing.hpp"
+#include "StreamScheduler.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace arm {
+namespace app {
+
+    /**
+     * @brief   Runs RNNoise over a continuous stream of audio, one frame at a
+     *          time. The GRU state is carried over from one frame to the next
+     *          and the denoised frames (already overlap-added by the frame
+     *          synthesis) are appended to a ring buffer that a downstream
+     *          stage, eg KWS or ASR, reads from.
+     *          All buffers are allocated in the constructor.
+     *          Several streams can share one model, eg one per microphone,
+     *          each then keeping its GRU state in its own snapshot (see
+     *          StreamState) that is swapped in and out around its inferences.
+     */
+    class RNNoiseStream {
+    public:
+        /* Samples consumed and produced by each call to ProcessFrame. */
+        static constexpr uint32_t ms_frameSize = rnn::RNNoiseFeatureProcessor::FRAME_SIZE;
+
+        /* Sample rate the model is trained for, in Hz. */
+        static constexpr uint32_t ms_sampleRate = 48000;
+
+        /**
+         * @brief           Constructor.
+         * @param[in,out]   model    Initialised RNNoise model.
+         * @param[out]      output   Ring buffer the denoised audio is written to.
+         * @param[in]       shared   Whether other streams run on the model too.
+         **/
+        RNNoiseStream(RNNoiseModel& model, audio::AudioRingBuffer& output, bool shared = false);
+
+        /**
+         * @brief   Starts a new, unrelated, stream: the feature history is
+         *          cleared and the GRU state is reset on the next frame.
+         */
+        void Reset();
+
+        /**
+         * @brief       Denoises the next frame of the stream.
+         * @param[in]   frame   ms_frameSize samples.
+         * @return      true if successful, false otherwise.
+         **/
+        bool ProcessFrame(const int16_t* frame);
+
+        /** @brief  Gets the number of frames processed since the last reset. */
+        uint32_t GetFrameCount() const;
+
+    private:
+        RNNoiseModel&                                   m_model;
+        audio::AudioRingBuffer&                         m_output;
+        std::shared_ptr<rnn::RNNoiseFeatureProcessor>   m_featureProcessor;
+        std::shared_ptr<rnn::FrameFeatures>             m_frameFeatures;
+        std::vector<int16_t>                            m_denoisedFrame;    /* Output of the last frame. */
+        RNNoisePreProcess                               m_preProcess;
+        RNNoisePostProcess                              m_postProcess;
+        std::unique_ptr<StreamState>                    m_state;            /* Only if the model is shared. */
+        uint32_t                                        m_frameCount{0};
+    };
+
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* RNNOISE_STREAM_HPP */
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "RNNoiseFeatureProcessor.hpp"
+#include "AudioUtils.hpp"
 #include "log_macros.h"
 
 #include <algorithm>
@@ -33,18 +34,7 @@ do {                                                \
     }                                               \
 } while(0)
 
-RNNoiseFeatureProcessor::RNNoiseFeatureProcessor() :
-        m_halfWindow(FRAME_SIZE, 0),
-        m_dctTable(NB_BANDS * NB_BANDS),
-        m_analysisMem(FRAME_SIZE, 0),
-        m_cepstralMem(CEPS_MEM, vec1D32F(NB_BANDS, 0)),
-        m_memId{0},
-        m_synthesisMem(FRAME_SIZE, 0),
-        m_pitchBuf(PITCH_BUF_SIZE, 0),
-        m_lastGain{0.0},
-        m_lastPeriod{0},
-        m_memHpX{},
-        m_lastGVec(NB_BANDS, 0)
+RNNoiseFeatureProcessor::RNNoiseFeatureProcessor()
 {
     constexpr uint32_t numFFt = 2 * FRAME_SIZE;
     static_assert(numFFt != 0, "Num FFT can't be 0");
@@ -54,42 +44,84 @@ RNNoiseFeatureProcessor::RNNoiseFeatureProcessor() :
     this->InitTables();
 }
 
+void RNNoiseFeatureProcessor::Reset()
+{
+    this->m_analysisMem.fill(0);
+    for (auto& ceps : this->m_cepstralMem) {
+        ceps.fill(0);
+    }
+    this->m_memId = 0;
+    this->m_synthesisMem.fill(0);
+    this->m_pitchBuf.fill(0);
+    this->m_lastGain = 0;
+    this->m_lastPeriod = 0;
+    this->m_memHpX.fill(0);
+    this->m_lastGVec.fill(0);
+}
+
 void RNNoiseFeatureProcessor::PreprocessFrame(const float*   audioData,
                                               const size_t   audioLen,
                                               FrameFeatures& features)
 {
+    const size_t len = std::min<size_t>(audioLen, FRAME_SIZE);
+    std::copy_n(audioData, len, this->m_audioWindow.begin());
+    std::fill(this->m_audioWindow.begin() + len, this->m_audioWindow.end(), 0.f);
+
     /* Note audioWindow is modified in place */
     const arrHp aHp {-1.99599, 0.99600 };
     const arrHp bHp {-2.00000, 1.00000 };
 
-    vec1D32F audioWindow{audioData, audioData + audioLen};
+    this->BiQuad(bHp, aHp, this->m_memHpX, this->m_audioWindow.data());
+    this->ComputeFrameFeatures(this->m_audioWindow.data(), features);
+}
+
+void RNNoiseFeatureProcessor::PreprocessFrame(const int16_t* audioData,
+                                              const size_t   audioLen,
+                                              FrameFeatures& features)
+{
+    const size_t len = std::min<size_t>(audioLen, FRAME_SIZE);
+    for (size_t i = 0; i < len; ++i) {
+        this->m_audioWindow[i] = static_cast<float>(audioData[i]);
+    }
+    std::fill(this->m_audioWindow.begin() + len, this->m_audioWindow.end(), 0.f);
+
+    const arrHp aHp {-1.99599, 0.99600 };
+    const arrHp bHp {-2.00000, 1.00000 };
 
-    this->BiQuad(bHp, aHp, this->m_memHpX, audioWindow);
-    this->ComputeFrameFeatures(audioWindow, features);
+    this->BiQuad(bHp, aHp, this->m_memHpX, this->m_audioWindow.data());
+    this->ComputeFrameFeatures(this->m_audioWindow.data(), features);
 }
 
 void RNNoiseFeatureProcessor::PostProcessFrame(vec1D32F& modelOutput, FrameFeatures& features, vec1D32F& outFrame)
 {
-    std::vector<float> outputBands = modelOutput;
-    std::vector<float> gain(FREQ_SIZE, 0);
+    if (modelOutput.size() < NB_BANDS || outFrame.size() < FRAME_SIZE) {
+        printf_err("Invalid size for model output or output frame\n");
+        return;
+    }
+    this->PostProcessFrame(modelOutput.data(), features, outFrame.data());
+}
+
+void RNNoiseFeatureProcessor::PostProcessFrame(const float* modelOutput, FrameFeatures& features, float* outFrame)
+{
+    std::copy_n(modelOutput, NB_BANDS, this->m_bandGain.begin());
 
     if (!features.m_silence) {
-        PitchFilter(features, outputBands);
+        PitchFilter(features, this->m_bandGain.data());
         for (size_t i = 0; i < NB_BANDS; i++) {
             float alpha = .6f;
-            outputBands[i] = std::max(outputBands[i], alpha * m_lastGVec[i]);
-            m_lastGVec[i] = outputBands[i];
+            m_bandGain[i] = std::max(m_bandGain[i], alpha * m_lastGVec[i]);
+            m_lastGVec[i] = m_bandGain[i];
         }
-        InterpBandGain(gain, outputBands);
+        InterpBandGain(this->m_interpGain.data(), this->m_bandGain.data());
         for (size_t i = 0; i < FREQ_SIZE; i++) {
-            features.m_fftX[2 * i] *= gain[i];  /* Real. */
-            features.m_fftX[2 * i + 1] *= gain[i];  /*imaginary. */
+            features.m_fftX[2 * i] *= m_interpGain[i];  /* Real. */
+            features.m_fftX[2 * i + 1] *= m_interpGain[i];  /*imaginary. */
 
         }
 
     }
 
-    FrameSynthesis(outFrame, features.m_fftX);
+    FrameSynthesis(outFrame, features.m_fftX.data());
 }
 
 void RNNoiseFeatureProcessor::InitTables()
@@ -115,9 +147,10 @@ void RNNoiseFeatureProcessor::BiQuad(
         const arrHp& bHp,
         const arrHp& aHp,
         arrHp& memHpX,
-        vec1D32F& audioWindow)
+        float* audioWindow)
 {
-    for (float& audioElement : audioWindow) {
+    for (size_t i = 0; i < FRAME_SIZE; ++i) {
+        float& audioElement = audioWindow[i];
         const auto xi = audioElement;
         const auto yi = audioElement + memHpX[0];
         memHpX[0] = memHpX[1] + (bHp[0] * xi - aHp[0] * yi);
@@ -126,35 +159,32 @@ void RNNoiseFeatureProcessor::BiQuad(
     }
 }
 
-void RNNoiseFeatureProcessor::ComputeFrameFeatures(vec1D32F& audioWindow,
+void RNNoiseFeatureProcessor::ComputeFrameFeatures(const float* audioWindow,
                                                    FrameFeatures& features)
 {
     this->FrameAnalysis(audioWindow,
-                        features.m_fftX,
-                        features.m_Ex,
-                        this->m_analysisMem);
+                        features.m_fftX.data(),
+                        features.m_Ex.data());
 
     float energy = 0.0;
 
-    vec1D32F Ly(NB_BANDS, 0);
-    vec1D32F p(WINDOW_SIZE, 0);
-    vec1D32F pitchBuf(PITCH_BUF_SIZE >> 1, 0);
+    std::array<float, NB_BANDS> Ly{};
+    float* pitchBuf = this->m_pitchBufDown.data();
 
-    VERIFY(PITCH_BUF_SIZE >= this->m_pitchBuf.size());
+    static_assert(PITCH_BUF_SIZE > FRAME_SIZE, "Pitch buffer must hold more than a frame");
     std::copy_n(this->m_pitchBuf.begin() + FRAME_SIZE,
                 PITCH_BUF_SIZE - FRAME_SIZE,
                 this->m_pitchBuf.begin());
 
-    VERIFY(FRAME_SIZE <= audioWindow.size() && PITCH_BUF_SIZE > FRAME_SIZE);
-    std::copy_n(audioWindow.begin(),
+    std::copy_n(audioWindow,
                 FRAME_SIZE,
                 this->m_pitchBuf.begin() + PITCH_BUF_SIZE - FRAME_SIZE);
 
     this->PitchDownsample(pitchBuf, PITCH_BUF_SIZE);
 
-    VERIFY(pitchBuf.size() > PITCH_MAX_PERIOD/2);
-    vec1D32F xLp(pitchBuf.size() - PITCH_MAX_PERIOD/2, 0);
-    std::copy_n(pitchBuf.begin() + PITCH_MAX_PERIOD/2, xLp.size(), xLp.begin());
+    /* The shifted pitch buffer is read in place. */
+    static_assert((PITCH_BUF_SIZE >> 1) > PITCH_MAX_PERIOD/2, "Pitch buffer too small");
+    const float* xLp = pitchBuf + PITCH_MAX_PERIOD/2;
 
     int pitchIdx = this->PitchSearch(xLp, pitchBuf,
             PITCH_FRAME_SIZE, (PITCH_MAX_PERIOD - (3*PITCH_MIN_PERIOD)));
@@ -168,22 +198,22 @@ void RNNoiseFeatureProcessor::ComputeFrameFeatures(vec1D32F& audioWindow,
 
     size_t stIdx = PITCH_BUF_SIZE - WINDOW_SIZE - pitchIdx;
     VERIFY((static_cast<int>(PITCH_BUF_SIZE) - static_cast<int>(WINDOW_SIZE) - pitchIdx) >= 0);
-    std::copy_n(this->m_pitchBuf.begin() + stIdx, WINDOW_SIZE, p.begin());
+    std::copy_n(this->m_pitchBuf.begin() + stIdx, WINDOW_SIZE, this->m_window.begin());
 
-    this->ApplyWindow(p);
-    this->ForwardTransform(p, features.m_fftP);
-    this->ComputeBandEnergy(features.m_fftP, features.m_Ep);
-    this->ComputeBandCorr(features.m_fftX, features.m_fftP, features.m_Exp);
+    this->ApplyWindow(this->m_window.data());
+    this->ForwardTransform(this->m_window.data(), features.m_fftP.data());
+    this->ComputeBandEnergy(features.m_fftP.data(), features.m_Ep.data());
+    this->ComputeBandCorr(features.m_fftX.data(), features.m_fftP.data(), features.m_Exp.data());
 
     for (uint32_t i = 0 ; i < NB_BANDS; ++i) {
         features.m_Exp[i] /= math::MathUtils::SqrtF32(
             0.001f + features.m_Ex[i] * features.m_Ep[i]);
     }
 
-    vec1D32F dctVec(NB_BANDS, 0);
-    this->DCT(features.m_Exp, dctVec);
+    std::array<float, NB_BANDS> dctVec{};
+    this->DCT(features.m_Exp.data(), dctVec.data());
 
-    features.m_featuresVec = vec1D32F (NB_FEATURES, 0);
+    features.m_featuresVec.fill(0);
     for (uint32_t i = 0; i < NB_DELTA_CEPS; ++i) {
         features.m_featuresVec[NB_BANDS + 2*NB_DELTA_CEPS + i] = dctVec[i];
     }
@@ -210,17 +240,19 @@ void RNNoiseFeatureProcessor::ComputeFrameFeatures(vec1D32F& audioWindow,
         features.m_silence = false;
     }
 
-    this->DCT(Ly, features.m_featuresVec);
+    this->DCT(Ly.data(), features.m_featuresVec.data());
     features.m_featuresVec[0] -= 12.0;
     features.m_featuresVec[1] -= 4.0;
 
-    VERIFY(CEPS_MEM > 2);
+    static_assert(CEPS_MEM > 2, "Not enough cepstral memory for the deltas");
     uint32_t stIdx1 = this->m_memId < 1 ? CEPS_MEM + this->m_memId - 1 : this->m_memId - 1;
     uint32_t stIdx2 = this->m_memId < 2 ? CEPS_MEM + this->m_memId - 2 : this->m_memId - 2;
     VERIFY(stIdx1 < this->m_cepstralMem.size());
     VERIFY(stIdx2 < this->m_cepstralMem.size());
-    auto ceps1 = this->m_cepstralMem[stIdx1];
-    auto ceps2 = this->m_cepstralMem[stIdx2];
+
+    /* Neither is the entry overwritten below. */
+    const auto& ceps1 = this->m_cepstralMem[stIdx1];
+    const auto& ceps2 = this->m_cepstralMem[stIdx2];
 
     /* Ceps 0 */
     for (uint32_t i = 0; i < NB_BANDS; ++i) {
@@ -242,13 +274,11 @@ void RNNoiseFeatureProcessor::ComputeFrameFeatures(vec1D32F& audioWindow,
 
     float specVariability = 0.f;
 
-    VERIFY(this->m_cepstralMem.size() >= CEPS_MEM);
     for (size_t i = 0; i < CEPS_MEM; ++i) {
         float minDist = 1e15;
         for (size_t j = 0; j < CEPS_MEM; ++j) {
             float dist = 0.f;
             for (size_t k = 0; k < NB_BANDS; ++k) {
-                VERIFY(this->m_cepstralMem[i].size() >= NB_BANDS);
                 auto tmp = this->m_cepstralMem[i][k] - this->m_cepstralMem[j][k];
                 dist += tmp * tmp;
             }
@@ -260,25 +290,20 @@ void RNNoiseFeatureProcessor::ComputeFrameFeatures(vec1D32F& audioWindow,
         specVariability += minDist;
     }
 
-    VERIFY(features.m_featuresVec.size() >= NB_BANDS + 3 * NB_DELTA_CEPS + 1);
     features.m_featuresVec[NB_BANDS + 3 * NB_DELTA_CEPS + 1] = specVariability / CEPS_MEM - 2.1;
 }
 
 void RNNoiseFeatureProcessor::FrameAnalysis(
-    const vec1D32F& audioWindow,
-    vec1D32F& fft,
-    vec1D32F& energy,
-    vec1D32F& analysisMem)
+    const float* audioWindow,
+    float* fft,
+    float* energy)
 {
-    vec1D32F x(WINDOW_SIZE, 0);
+    float* x = this->m_window.data();
 
     /* Move old audio down and populate end with latest audio window. */
-    VERIFY(x.size() >= FRAME_SIZE && analysisMem.size() >= FRAME_SIZE);
-    VERIFY(audioWindow.size() >= FRAME_SIZE);
-
-    std::copy_n(analysisMem.begin(), FRAME_SIZE, x.begin());
-    std::copy_n(audioWindow.begin(), x.size() - FRAME_SIZE, x.begin() + FRAME_SIZE);
-    std::copy_n(audioWindow.begin(), FRAME_SIZE, analysisMem.begin());
+    std::copy_n(this->m_analysisMem.begin(), FRAME_SIZE, x);
+    std::copy_n(audioWindow, WINDOW_SIZE - FRAME_SIZE, x + FRAME_SIZE);
+    std::copy_n(audioWindow, FRAME_SIZE, this->m_analysisMem.begin());
 
     this->ApplyWindow(x);
 
@@ -289,15 +314,8 @@ void RNNoiseFeatureProcessor::FrameAnalysis(
     ComputeBandEnergy(fft, energy);
 }
 
-void RNNoiseFeatureProcessor::ApplyWindow(vec1D32F& x)
+void RNNoiseFeatureProcessor::ApplyWindow(float* x)
 {
-    if (WINDOW_SIZE != x.size()) {
-        printf_err("Invalid size for vector to be windowed\n");
-        return;
-    }
-
-    VERIFY(this->m_halfWindow.size() >= FRAME_SIZE);
-
     /* Multiply input by sinusoidal function. */
     for (size_t i = 0; i < FRAME_SIZE; i++) {
         x[i] *= this->m_halfWindow[i];
@@ -306,55 +324,36 @@ void RNNoiseFeatureProcessor::ApplyWindow(vec1D32F& x)
 }
 
 void RNNoiseFeatureProcessor::ForwardTransform(
-    vec1D32F& x,
-    vec1D32F& fft)
+    float* x,
+    float* fft)
 {
-    /* The input vector can be modified by the fft function. */
-    fft.reserve(x.size() + 2);
-    fft.resize(x.size() + 2, 0);
-    math::MathUtils::FftF32(x, fft, this->m_fftInstReal);
+    constexpr uint32_t fftSize = 2 * FREQ_SIZE;
+
+    /* The input buffer can be modified by the fft function. */
+    math::MathUtils::FftF32(x, WINDOW_SIZE, fft, fftSize, this->m_fftInstReal);
 
     /* Normalise. */
-    for (auto& f : fft) {
-        f /= this->m_fftInstReal.m_fftLen;
+    for (uint32_t i = 0; i < fftSize; ++i) {
+        fft[i] /= this->m_fftInstReal.m_fftLen;
     }
 
     /* Place the last freq element correctly */
-    fft[fft.size()-2] = fft[1];
+    fft[fftSize - 2] = fft[1];
     fft[1] = 0;
 
-    /* NOTE: We don't truncate out FFT vector as it already contains only the
+    /* NOTE: We don't truncate out FFT buffer as it already contains only the
      * first half of the FFT's. The conjugates are not present. */
 }
 
-void RNNoiseFeatureProcessor::ComputeBandEnergy(const vec1D32F& fftX, vec1D32F& bandE)
+void RNNoiseFeatureProcessor::ComputeBandEnergy(const float* fftX, float* bandE)
 {
-    bandE = vec1D32F(NB_BANDS, 0);
-
-    VERIFY(this->m_eband5ms.size() >= NB_BANDS);
-    for (uint32_t i = 0; i < NB_BANDS - 1; i++) {
-        const auto bandSize = (this->m_eband5ms[i + 1] - this->m_eband5ms[i])
-                              << FRAME_SIZE_SHIFT;
-
-        for (uint32_t j = 0; j < bandSize; j++) {
-            const auto frac = static_cast<float>(j) / bandSize;
-            const auto idx = (this->m_eband5ms[i] << FRAME_SIZE_SHIFT) + j;
-
-            auto tmp = fftX[2 * idx] * fftX[2 * idx]; /* Real part */
-            tmp += fftX[2 * idx + 1] * fftX[2 * idx + 1]; /* Imaginary part */
-
-            bandE[i] += (1 - frac) * tmp;
-            bandE[i + 1] += frac * tmp;
-        }
-    }
-    bandE[0] *= 2;
-    bandE[NB_BANDS - 1] *= 2;
+    audio::ComputeBandEnergy(fftX, this->m_eband5ms.data(), NB_BANDS,
+                             FRAME_SIZE_SHIFT, bandE);
 }
 
-void RNNoiseFeatureProcessor::ComputeBandCorr(const vec1D32F& X, const vec1D32F& P, vec1D32F& bandC)
+void RNNoiseFeatureProcessor::ComputeBandCorr(const float* X, const float* P, float* bandC)
 {
-    bandC = vec1D32F(NB_BANDS, 0);
-    VERIFY(this->m_eband5ms.size() >= NB_BANDS);
+    std::fill(bandC, bandC + NB_BANDS, 0.f);
 
     for (uint32_t i = 0; i < NB_BANDS - 1; i++) {
         const auto bandSize = (this->m_eband5ms[i + 1] - this->m_eband5ms[i]) << FRAME_SIZE_SHIFT;
@@ -374,9 +373,8 @@ void RNNoiseFeatureProcessor::ComputeBandCorr(const vec1D32F& X, const vec1D32F&
     bandC[NB_BANDS - 1] *= 2;
 }
 
-void RNNoiseFeatureProcessor::DCT(vec1D32F& input, vec1D32F& output)
+void RNNoiseFeatureProcessor::DCT(const float* input, float* output)
 {
-    VERIFY(this->m_dctTable.size() >= NB_BANDS * NB_BANDS);
     for (uint32_t i = 0; i < NB_BANDS; ++i) {
         float sum = 0;
 
@@ -387,7 +385,7 @@ void RNNoiseFeatureProcessor::DCT(vec1D32F& input, vec1D32F& output)
     }
 }
 
-void RNNoiseFeatureProcessor::PitchDownsample(vec1D32F& pitchBuf, size_t pitchBufSz) {
+void RNNoiseFeatureProcessor::PitchDownsample(float* pitchBuf, size_t pitchBufSz) {
     for (size_t i = 1; i < (pitchBufSz >> 1); ++i) {
         pitchBuf[i] = 0.5 * (
                         0.5 * (this->m_pitchBuf[2 * i - 1] + this->m_pitchBuf[2 * i + 1])
@@ -396,10 +394,10 @@ void RNNoiseFeatureProcessor::PitchDownsample(vec1D32F& pitchBuf, size_t pitchBu
 
     pitchBuf[0] = 0.5*(0.5*(this->m_pitchBuf[1]) + this->m_pitchBuf[0]);
 
-    vec1D32F ac(5, 0);
-    size_t numLags = 4;
+    constexpr size_t numLags = 4;
+    std::array<float, numLags + 1> ac{};
 
-    this->AutoCorr(pitchBuf, ac, numLags, pitchBufSz >> 1);
+    this->AutoCorr(pitchBuf, ac.data(), numLags, pitchBufSz >> 1);
 
     /* Noise floor -40db */
     ac[0] *= 1.0001;
@@ -409,8 +407,8 @@ void RNNoiseFeatureProcessor::PitchDownsample(vec1D32F& pitchBuf, size_t pitchBu
         ac[i] -= ac[i] * (0.008 * i) * (0.008 * i);
     }
 
-    vec1D32F lpc(numLags, 0);
-    this->LPC(ac, numLags, lpc);
+    std::array<float, numLags> lpc{};
+    this->LPC(ac.data(), numLags, lpc.data());
 
     float tmp = 1.0;
     for (size_t i = 0; i < numLags; ++i) {
@@ -418,7 +416,7 @@ void RNNoiseFeatureProcessor::PitchDownsample(vec1D32F& pitchBuf, size_t pitchBu
         lpc[i] = lpc[i] * tmp;
     }
 
-    vec1D32F lpc2(numLags + 1, 0);
+    std::array<float, numLags + 1> lpc2{};
     float c1 = 0.8;
 
     /* Add a zero. */
@@ -428,14 +426,17 @@ void RNNoiseFeatureProcessor::PitchDownsample(vec1D32F& pitchBuf, size_t pitchBu
     lpc2[3] = lpc[3] + (c1 * lpc[2]);
     lpc2[4] = (c1 * lpc[3]);
 
-    this->Fir5(lpc2, pitchBufSz >> 1, pitchBuf);
+    this->Fir5(lpc2.data(), pitchBufSz >> 1, pitchBuf);
 }
 
-int RNNoiseFeatureProcessor::PitchSearch(vec1D32F& xLp, vec1D32F& y, uint32_t len, uint32_t maxPitch) {
+int RNNoiseFeatureProcessor::PitchSearch(const float* xLp, const float* y, uint32_t len, uint32_t maxPitch) {
     uint32_t lag = len + maxPitch;
-    vec1D32F xLp4(len >> 2, 0);
-    vec1D32F yLp4(lag >> 2, 0);
-    vec1D32F xCorr(maxPitch >> 1, 0);
+    VERIFY((len >> 2) <= this->m_xLp4.size());
+    VERIFY((lag >> 2) <= this->m_yLp4.size());
+    VERIFY((maxPitch >> 1) <= this->m_xCorr.size());
+    float* xLp4 = this->m_xLp4.data();
+    float* yLp4 = this->m_yLp4.data();
+    float* xCorr = this->m_xCorr.data();
 
     /* Downsample by 2 again. */
     for (size_t j = 0; j < (len >> 2); ++j) {
@@ -470,9 +471,10 @@ int RNNoiseFeatureProcessor::PitchSearch(vec1D32F& xLp, vec1D32F& y, uint32_t le
     int offset;
     /* Refine by pseudo-interpolation. */
     if ( 0 < bestPitch[0] && bestPitch[0] < ((maxPitch >> 1) - 1)) {
-        float a = xCorr[bestPitch[0] - 1];
-        float b = xCorr[bestPitch[0]];
-        float c = xCorr[bestPitch[0] + 1];
+        const auto best = static_cast<size_t>(bestPitch[0]);
+        float a = xCorr[best - 1];
+        float b = xCorr[best];
+        float c = xCorr[best + 1];
 
         if ( (c-a) > 0.7*(b-a) ) {
             offset = 1;
@@ -488,7 +490,7 @@ int RNNoiseFeatureProcessor::PitchSearch(vec1D32F& xLp, vec1D32F& y, uint32_t le
     return 2*bestPitch[0] - offset;
 }
 
-arrHp RNNoiseFeatureProcessor::FindBestPitch(vec1D32F& xCorr, vec1D32F& y, uint32_t len, uint32_t maxPitch)
+arrHp RNNoiseFeatureProcessor::FindBestPitch(const float* xCorr, const float* y, uint32_t len, uint32_t maxPitch)
 {
     float Syy = 1;
     arrHp bestNum {-1, -1};
@@ -528,7 +530,7 @@ arrHp RNNoiseFeatureProcessor::FindBestPitch(vec1D32F& xCorr, vec1D32F& y, uint3
 }
 
 int RNNoiseFeatureProcessor::RemoveDoubling(
-    vec1D32F& pitchBuf,
+    const float* pitchBuf,
     uint32_t maxPeriod,
     uint32_t minPeriod,
     uint32_t frameSize,
@@ -562,11 +564,12 @@ int RNNoiseFeatureProcessor::RemoveDoubling(
         xy += (pitchBuf[i] * pitchBuf[i-pitchIdx0]);
     }
 
-    vec1D32F yyLookup (maxPeriod+1, 0);
+    VERIFY(maxPeriod + 1 <= this->m_yyLookup.size());
+    float* yyLookup = this->m_yyLookup.data();
     yyLookup[0] = xx;
     float yy = xx;
 
-    for ( size_t i = 1; i < yyLookup.size(); ++i) {
+    for ( size_t i = 1; i < maxPeriod + 1; ++i) {
         yy = yy + (pitchBuf[xStart-i] * pitchBuf[xStart-i]) -
                 (pitchBuf[xStart+frameSize-i] * pitchBuf[xStart+frameSize-i]);
         yyLookup[i] = std::max(0.0f, yy);
@@ -685,8 +688,8 @@ float RNNoiseFeatureProcessor::ComputePitchGain(float xy, float xx, float yy)
 }
 
 void RNNoiseFeatureProcessor::AutoCorr(
-    const vec1D32F& x,
-    vec1D32F& ac,
+    const float* x,
+    float* ac,
     size_t lag,
     size_t n)
 {
@@ -712,9 +715,9 @@ void RNNoiseFeatureProcessor::AutoCorr(
 
 
 void RNNoiseFeatureProcessor::PitchXCorr(
-    const vec1D32F& x,
-    const vec1D32F& y,
-    vec1D32F& xCorr,
+    const float* x,
+    const float* y,
+    float* xCorr,
     size_t len,
     size_t maxPitch)
 {
@@ -729,9 +732,9 @@ void RNNoiseFeatureProcessor::PitchXCorr(
 
 /* Linear predictor coefficients */
 void RNNoiseFeatureProcessor::LPC(
-    const vec1D32F& correlation,
+    const float* correlation,
     int32_t p,
-    vec1D32F& lpc)
+    float* lpc)
 {
     auto error = correlation[0];
 
@@ -767,9 +770,9 @@ void RNNoiseFeatureProcessor::LPC(
 }
 
 void RNNoiseFeatureProcessor::Fir5(
-    const vec1D32F &num,
+    const float* num,
     uint32_t N,
-    vec1D32F &x)
+    float* x)
 {
     auto num0 = num[0];
     auto num1 = num[1];
@@ -794,10 +797,9 @@ void RNNoiseFeatureProcessor::Fir5(
     }
 }
 
-void RNNoiseFeatureProcessor::PitchFilter(FrameFeatures &features, vec1D32F &gain) {
-    std::vector<float> r(NB_BANDS, 0);
-    std::vector<float> rf(FREQ_SIZE, 0);
-    std::vector<float> newE(NB_BANDS);
+void RNNoiseFeatureProcessor::PitchFilter(FrameFeatures &features, const float* gain) {
+    float* r = this->m_bandScratch.data();
+    float* rf = this->m_interpGain.data();
 
     for (size_t i = 0; i < NB_BANDS; i++) {
         if (features.m_Exp[i] > gain[i]) {
@@ -820,11 +822,13 @@ void RNNoiseFeatureProcessor::PitchFilter(FrameFeatures &features, vec1D32F &gai
         features.m_fftX[2 * i + 1] += rf[i] * features.m_fftP[2 * i + 1];  /* Imaginary. */
 
     }
-    ComputeBandEnergy(features.m_fftX, newE);
-    std::vector<float> norm(NB_BANDS);
-    std::vector<float> normf(FRAME_SIZE, 0);
+
+    /* New band energies, then the normalisation gains, in place of r. */
+    float* norm = this->m_bandScratch.data();
+    float* normf = this->m_interpGain.data();
+    ComputeBandEnergy(features.m_fftX.data(), norm);
     for (size_t i = 0; i < NB_BANDS; i++) {
-        norm[i] = math::MathUtils::SqrtF32(features.m_Ex[i] / (1e-8f + newE[i]));
+        norm[i] = math::MathUtils::SqrtF32(features.m_Ex[i] / (1e-8f + norm[i]));
     }
 
     InterpBandGain(normf, norm);
@@ -835,8 +839,8 @@ void RNNoiseFeatureProcessor::PitchFilter(FrameFeatures &features, vec1D32F &gai
     }
 }
 
-void RNNoiseFeatureProcessor::FrameSynthesis(vec1D32F& outFrame, vec1D32F& fftY) {
-    std::vector<float> x(WINDOW_SIZE, 0);
+void RNNoiseFeatureProcessor::FrameSynthesis(float* outFrame, const float* fftY) {
+    float* x = this->m_window.data();
     InverseTransform(x, fftY);
     ApplyWindow(x);
     for (size_t i = 0; i < FRAME_SIZE; i++) {
@@ -845,7 +849,7 @@ void RNNoiseFeatureProcessor::FrameSynthesis(vec1D32F& outFrame, vec1D32F& fftY)
     memcpy((m_synthesisMem.data()), &x[FRAME_SIZE], FRAME_SIZE*sizeof(float));
 }
 
-void RNNoiseFeatureProcessor::InterpBandGain(vec1D32F& g, vec1D32F& bandE) {
+void RNNoiseFeatureProcessor::InterpBandGain(float* g, const float* bandE) {
     for (size_t i = 0; i < NB_BANDS - 1; i++) {
         int bandSize = (m_eband5ms[i + 1] - m_eband5ms[i]) << FRAME_SIZE_SHIFT;
         for (int j = 0; j < bandSize; j++) {
@@ -855,10 +859,9 @@ void RNNoiseFeatureProcessor::InterpBandGain(vec1D32F& g, vec1D32F& bandE) {
     }
 }
 
-void RNNoiseFeatureProcessor::InverseTransform(vec1D32F& out, vec1D32F& fftXIn) {
+void RNNoiseFeatureProcessor::InverseTransform(float* out, const float* fftXIn) {
 
-    std::vector<float> x(WINDOW_SIZE * 2);  /* This is complex. */
-    vec1D32F newFFT;  /* This is complex. */
+    float* x = this->m_ifftIn.data();  /* This is complex. */
 
     size_t i;
     for (i = 0; i < FREQ_SIZE * 2; i++) {
@@ -872,11 +875,11 @@ void RNNoiseFeatureProcessor::InverseTransform(vec1D32F& out, vec1D32F& fftXIn)
     constexpr uint32_t numFFt = 2 * FRAME_SIZE;
     static_assert(numFFt != 0, "numFFt cannot be 0!");
 
-    vec1D32F fftOut = vec1D32F(x.size(), 0);
-    math::MathUtils::FftF32(x,fftOut, m_fftInstCmplx);
+    float* fftOut = this->m_ifftOut.data();
+    math::MathUtils::FftF32(x, this->m_ifftIn.size(), fftOut, this->m_ifftOut.size(), this->m_fftInstCmplx);
 
     /* Normalize. */
-    for (auto &f: fftOut) {
+    for (auto &f: this->m_ifftOut) {
         f /= numFFt;
     }
 
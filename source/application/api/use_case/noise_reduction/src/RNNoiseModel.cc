@@ -17,6 +17,13 @@
 #include "RNNoiseModel.hpp"
 #include "log_macros.h"
 
+arm::app::RNNoiseModel::RNNoiseModel()
+{
+    for (auto& stateMapping: this->m_gruStateMap) {
+        this->BindState(stateMapping.first, stateMapping.second);
+    }
+}
+
 const tflite::MicroOpResolver& arm::app::RNNoiseModel::GetOpResolver()
 {
     return this->m_opResolver;
@@ -56,41 +63,11 @@ bool arm::app::RNNoiseModel::RunInference()
 
 void arm::app::RNNoiseModel::ResetGruState()
 {
-    for (auto& stateMapping: this->m_gruStateMap) {
-        TfLiteTensor* inputGruStateTensor = this->GetInputTensor(stateMapping.second);
-        auto* inputGruState = tflite::GetTensorData<int8_t>(inputGruStateTensor);
-        /* Initial value of states is 0, but this is affected by quantization zero point. */
-        auto quantParams = arm::app::GetTensorQuantParams(inputGruStateTensor);
-        memset(inputGruState, quantParams.offset, inputGruStateTensor->bytes);
-    }
+    /* Initial value of states is 0, but this is affected by quantization zero point. */
+    this->ResetStates();
 }
 
 bool arm::app::RNNoiseModel::CopyGruStates()
 {
-    std::vector<std::pair<size_t, std::vector<int8_t>>> tempOutGruStates;
-    /* Saving output states before copying them to input states to avoid output states modification in the tensor.
-     * tflu shares input and output tensors memory, thus writing to input tensor can change output tensor values. */
-    for (auto& stateMapping: this->m_gruStateMap) {
-        TfLiteTensor* outputGruStateTensor = this->GetOutputTensor(stateMapping.first);
-        std::vector<int8_t> tempOutGruState(outputGruStateTensor->bytes);
-        auto* outGruState = tflite::GetTensorData<int8_t>(outputGruStateTensor);
-        memcpy(tempOutGruState.data(), outGruState, outputGruStateTensor->bytes);
-        /* Index of the input tensor and the data to copy. */
-        tempOutGruStates.emplace_back(stateMapping.second, std::move(tempOutGruState));
-    }
-    /* Updating input GRU states with saved GRU output states. */
-    for (auto& stateMapping: tempOutGruStates) {
-        auto outputGruStateTensorData = stateMapping.second;
-        TfLiteTensor* inputGruStateTensor = this->GetInputTensor(stateMapping.first);
-        if (outputGruStateTensorData.size() != inputGruStateTensor->bytes) {
-            printf_err("Unexpected number of bytes for GRU state mapping. Input = %zuz, output = %zuz.\n",
-                       inputGruStateTensor->bytes,
-                       outputGruStateTensorData.size());
-            return false;
-        }
-        auto* inputGruState = tflite::GetTensorData<int8_t>(inputGruStateTensor);
-        auto* outGruState = outputGruStateTensorData.data();
-        memcpy(inputGruState, outGruState, inputGruStateTensor->bytes);
-    }
-    return true;
+    return this->CarryStates();
 }
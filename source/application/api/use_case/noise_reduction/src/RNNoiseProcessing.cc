@@ -35,10 +35,10 @@ namespace app {
         }
 
         auto input = static_cast<const int16_t*>(data);
-        this->m_audioFrame = rnn::vec1D32F(input, input + inputSize);
-        m_featureProcessor->PreprocessFrame(this->m_audioFrame.data(), inputSize, *this->m_frameFeatures);
+        m_featureProcessor->PreprocessFrame(input, inputSize, *this->m_frameFeatures);
 
-        QuantizeAndPopulateInput(this->m_frameFeatures->m_featuresVec,
+        QuantizeAndPopulateInput(this->m_frameFeatures->m_featuresVec.data(),
+                this->m_frameFeatures->m_featuresVec.size(),
                 this->m_inputTensor->params.scale, this->m_inputTensor->params.zero_point,
                 this->m_inputTensor);
 
@@ -47,7 +47,7 @@ namespace app {
         return true;
     }
 
-    void RNNoisePreProcess::QuantizeAndPopulateInput(rnn::vec1D32F& inputFeatures,
+    void RNNoisePreProcess::QuantizeAndPopulateInput(const float* inputFeatures, const size_t numFeatures,
             const float quantScale, const int quantOffset,
             TfLiteTensor* inputTensor)
     {
@@ -56,7 +56,7 @@ namespace app {
 
         auto* inputTensorData = tflite::GetTensorData<int8_t>(inputTensor);
 
-        for (size_t i=0; i < inputFeatures.size(); ++i) {
+        for (size_t i=0; i < numFeatures; ++i) {
             float quantValue = ((inputFeatures[i] / quantScale) + quantOffset);
             inputTensorData[i] = static_cast<int8_t>(std::min<float>(std::max<float>(quantValue, minVal), maxVal));
         }
@@ -71,12 +71,18 @@ namespace app {
         m_featureProcessor{featureProcessor},
         m_frameFeatures{frameFeatures}
         {
-            this->m_denoisedAudioFrameFloat.reserve(denoisedAudioFrame.size());
+            this->m_denoisedAudioFrameFloat.resize(rnn::RNNoiseFeatureProcessor::FRAME_SIZE);
             this->m_modelOutputFloat.resize(outputTensor->bytes);
         }
 
     bool RNNoisePostProcess::DoPostProcess()
     {
+        if (this->m_modelOutputFloat.size() < rnn::RNNoiseFeatureProcessor::NB_BANDS ||
+                this->m_denoisedAudioFrame.size() > this->m_denoisedAudioFrameFloat.size()) {
+            printf_err("Model output or denoised frame size not supported\n");
+            return false;
+        }
+
         const auto* outputData = tflite::GetTensorData<int8_t>(this->m_outputTensor);
         auto outputQuantParams = GetTensorQuantParams(this->m_outputTensor);
 
@@ -85,8 +91,8 @@ namespace app {
                                   * outputQuantParams.scale;
         }
 
-        this->m_featureProcessor->PostProcessFrame(this->m_modelOutputFloat,
-                *this->m_frameFeatures, this->m_denoisedAudioFrameFloat);
+        this->m_featureProcessor->PostProcessFrame(this->m_modelOutputFloat.data(),
+                *this->m_frameFeatures, this->m_denoisedAudioFrameFloat.data());
 
         for (size_t i = 0; i < this->m_denoisedAudioFrame.size(); ++i) {
             this->m_denoisedAudioFrame[i] = static_cast<int16_t>(
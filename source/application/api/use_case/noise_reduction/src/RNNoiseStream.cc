@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "RNNoiseStream.hpp"
+#include "log_macros.h"
+
+namespace arm {
+namespace app {
+
+    RNNoiseStream::RNNoiseStream(RNNoiseModel& model, audio::AudioRingBuffer& output, bool shared)
+    :   m_model{model},
+        m_output{output},
+        m_featureProcessor{std::make_shared<rnn::RNNoiseFeatureProcessor>()},
+        m_frameFeatures{std::make_shared<rnn::FrameFeatures>()},
+        m_denoisedFrame(ms_frameSize),
+        m_preProcess{model.GetInputTensor(0), m_featureProcessor, m_frameFeatures},
+        m_postProcess{model.GetOutputTensor(model.m_indexForModelOutput), m_denoisedFrame,
+                      m_featureProcessor, m_frameFeatures},
+        m_state{shared ? new StreamState(model) : nullptr}
+    {}
+
+    void RNNoiseStream::Reset()
+    {
+        this->m_featureProcessor->Reset();
+        this->m_frameCount = 0;
+        if (this->m_state) {
+            this->m_state->Reset();
+        }
+    }
+
+    bool RNNoiseStream::ProcessFrame(const int16_t* frame)
+    {
+        if (!this->m_preProcess.DoPreProcess(frame, ms_frameSize)) {
+            printf_err("Pre-processing failed.\n");
+            return false;
+        }
+
+        if (this->m_state) {
+            /* Another stream may have run since: bring this stream's GRU state back. */
+            if (!this->m_state->RunInference(this->m_model)) {
+                printf_err("Inference failed.\n");
+                return false;
+            }
+        } else {
+            /* The GRU state only carries over between frames of the same stream. */
+            if (this->m_frameCount == 0) {
+                this->m_model.ResetGruState();
+            } else if (!this->m_model.CopyGruStates()) {
+                printf_err("Failed to copy the GRU states.\n");
+                return false;
+            }
+
+            if (!this->m_model.RunInference()) {
+                printf_err("Inference failed.\n");
+                return false;
+            }
+        }
+
+        if (!this->m_postProcess.DoPostProcess()) {
+            printf_err("Post-processing failed.\n");
+            return false;
+        }
+        ++this->m_frameCount;
+
+        if (!this->m_output.Write(this->m_denoisedFrame.data(), this->m_denoisedFrame.size())) {
+            debug("Denoised audio overrun, oldest samples dropped\n");
+        }
+        return true;
+    }
+
+    uint32_t RNNoiseStream::GetFrameCount() const
+    {
+        return this->m_frameCount;
+    }
+
+} /* namespace app */
+} /* namespace arm */
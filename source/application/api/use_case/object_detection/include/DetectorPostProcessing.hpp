@@ -92,6 +92,7 @@ namespace object_detection {
         std::vector<object_detection::DetectionResult>& m_results;       /* Single inference results. */
         const object_detection::PostProcessParams& m_postProcessParams;  /* Post processing param struct. */
         object_detection::Network m_net;                                 /* YOLO network object. */
+        std::vector<float> m_objectness;                                 /* Objectness scores of a branch. */
 
         /**
          * @brief       Insert the given Detection in the list.
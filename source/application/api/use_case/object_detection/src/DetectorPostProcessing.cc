@@ -149,16 +149,22 @@ void DetectorPostProcess::GetNetworkBoxes(
         int width    = net.branches[i].resolution;
         int channel  = net.branches[i].numBox*(5+numClasses);
 
+        /* Objectness scores of the whole branch at once, most anchors being below threshold. */
+        const size_t numAnchors = static_cast<size_t>(height) * width * net.branches[i].numBox;
+        this->m_objectness.resize(numAnchors);
+        for (size_t a = 0; a < numAnchors; ++a) {
+            this->m_objectness[a] = (static_cast<float>(net.branches[i].modelOutput[a * (numClasses + 5) + 4])
+                    - net.branches[i].zeroPoint) * net.branches[i].scale;
+        }
+        math::MathUtils::VecSigmoidF32(this->m_objectness.data(), this->m_objectness.data(), numAnchors);
+
         for (int h = 0; h < net.branches[i].resolution; h++) {
             for (int w = 0; w < net.branches[i].resolution; w++) {
                 for (int anc = 0; anc < net.branches[i].numBox; anc++) {
 
                     /* Objectness score */
                     int bbox_obj_offset = h * width * channel + w * channel + anc * (numClasses + 5) + 4;
-                    float objectness = math::MathUtils::SigmoidF32(
-                            (static_cast<float>(net.branches[i].modelOutput[bbox_obj_offset])
-                            - net.branches[i].zeroPoint
-                            ) * net.branches[i].scale);
+                    float objectness = this->m_objectness[(h * width + w) * net.branches[i].numBox + anc];
 
                     if(objectness > threshold) {
                         image::Detection det;
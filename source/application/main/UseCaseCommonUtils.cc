@@ -19,6 +19,10 @@
 #include "InputFiles.hpp"
 #include "log_macros.h"
 
+#if defined(ARM_NPU)
+#include "ethosu_cache_policy.h"
+#endif /* ARM_NPU */
+
 #include <cinttypes>
 
 void DisplayCommonMenu()
@@ -123,6 +127,35 @@ namespace app {
         return runInf;
     }
 
+    bool RegisterNpuCacheRegions(const arm::app::Model& model,
+                                 const uint8_t* tensorArenaAddr,
+                                 size_t tensorArenaSize)
+    {
+#if defined(ARM_NPU)
+        bool registered = true;
+        for (size_t i = 0; i < model.GetNumInputs(); ++i) {
+            const TfLiteTensor* tensor = model.GetInputTensor(i);
+            registered &= ethosu_cache_policy_add_region(
+                tensor->data.data, tensor->bytes, ETHOSU_CACHE_REGION_IO);
+        }
+        for (size_t i = 0; i < model.GetNumOutputs(); ++i) {
+            const TfLiteTensor* tensor = model.GetOutputTensor(i);
+            registered &= ethosu_cache_policy_add_region(
+                tensor->data.data, tensor->bytes, ETHOSU_CACHE_REGION_IO);
+        }
+        if (tensorArenaAddr) {
+            registered &= ethosu_cache_policy_add_region(
+                tensorArenaAddr, tensorArenaSize, ETHOSU_CACHE_REGION_TENSOR_ARENA);
+        }
+        return registered;
+#else /* ARM_NPU */
+        UNUSED(model);
+        UNUSED(tensorArenaAddr);
+        UNUSED(tensorArenaSize);
+        return true;
+#endif /* ARM_NPU */
+    }
+
     int ReadUserInputAsInt()
     {
         char chInput[128];
@@ -78,6 +78,22 @@ namespace app {
      **/
     bool RunInference(arm::app::Model& model, Profiler& profiler);
 
+    /**
+     * @brief           Registers the model's input and output tensors and
+     *                  the tensor arena with the NPU cache maintenance
+     *                  policy. The tensors are registered first, so that
+     *                  they are told apart from the arena containing them.
+     *                  Does nothing without an NPU.
+     * @param[in]       model             Reference to the initialised model.
+     * @param[in]       tensorArenaAddr   Tensor arena the model was initialised
+     *                                    with, nullptr if already registered.
+     * @param[in]       tensorArenaSize   Size of the tensor arena in bytes.
+     * @return          true if all the regions are registered, false otherwise.
+     **/
+    bool RegisterNpuCacheRegions(const arm::app::Model& model,
+                                 const uint8_t* tensorArenaAddr,
+                                 size_t tensorArenaSize);
+
     /**
      * @brief           Read input and return as an integer.
      * @return          Integer value corresponding to the user input.
@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IPC_QUEUE_H
+#define IPC_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define IPC_QUEUE_DEPTH         (8)             /**< Number of slots; must be a power of two. */
+#define IPC_QUEUE_LINE_SIZE     (32)            /**< Cache line size, the unit of sharing between cores. */
+#define IPC_WAIT_FOREVER        (0xFFFFFFFFu)   /**< Timeout value to wait without limit. */
+
+/**
+ * @brief   Message passed through a queue. Buffers are handed over by
+ *          address, not copied: the sender must not touch a buffer again
+ *          until the receiver gives it back (eg through a second queue).
+ */
+typedef struct _ipc_msg {
+    uint32_t id;        /**< Application defined message type. */
+    uint32_t arg;       /**< Small inline argument, eg a label index. */
+    uintptr_t data;     /**< Address of the buffer handed over, 0 for none. */
+    uint32_t size;      /**< Size of the buffer in bytes. */
+} ipc_msg;
+
+/**
+ * @brief   Single producer, single consumer ring. It lives in memory both
+ *          sides can access at the same address; the producer only writes
+ *          head and the slots, the consumer only writes tail, so no locks
+ *          or read-modify-write operations are needed between cores. The
+ *          indices sit on their own cache lines.
+ */
+typedef struct _ipc_queue {
+    volatile uint32_t head __attribute__((aligned(IPC_QUEUE_LINE_SIZE)));  /**< Next slot to write. */
+    volatile uint32_t tail __attribute__((aligned(IPC_QUEUE_LINE_SIZE)));  /**< Next slot to read. */
+    ipc_msg slots[IPC_QUEUE_DEPTH] __attribute__((aligned(IPC_QUEUE_LINE_SIZE)));
+} ipc_queue;
+
+/**
+ * @brief   Doorbell the queues use to wake the other side, and the memory
+ *          synchronisation needed between the two sides. The doorbell keeps
+ *          a count of rings: a waiter reads the count before checking its
+ *          queue and then waits for it to change, so no ring is lost.
+ */
+typedef struct _ipc_doorbell {
+    void* ctx;                                                  /**< Backend context. */
+    void (*ring)(void* ctx);                                    /**< Notifies the other side. */
+    uint32_t (*count)(void* ctx);                               /**< Number of rings received so far. */
+    bool (*wait)(void* ctx, uint32_t count, uint32_t timeout_ms); /**< Waits for the count to change; false on timeout. */
+    void (*sync_out)(const void* p, size_t bytes);              /**< Makes local writes visible to the other side (eg cache clean), can be NULL. */
+    void (*sync_in)(const void* p, size_t bytes);               /**< Drops stale local copies before reading (eg cache invalidate), can be NULL. */
+} ipc_doorbell;
+
+/**
+ * @brief   Gets the platform doorbell: the MHU between the two M55 cores on
+ *          Ensemble, a condition variable between threads on native.
+ *          Not available on platforms with a single core.
+ * @return  Pointer to the doorbell.
+ */
+const ipc_doorbell* platform_ipc_doorbell(void);
+
+/**
+ * @brief   Empties a queue. Done once by one side before either side uses it.
+ * @param[in]   q       Queue.
+ * @param[in]   db      Doorbell.
+ */
+void ipc_queue_init(ipc_queue* q, const ipc_doorbell* db);
+
+/**
+ * @brief   Gets the number of messages in a queue.
+ * @param[in]   q       Queue.
+ * @param[in]   db      Doorbell.
+ * @return      Number of messages waiting.
+ */
+uint32_t ipc_queue_count(ipc_queue* q, const ipc_doorbell* db);
+
+/**
+ * @brief   Adds a message without blocking. The buffer is made visible to
+ *          the consumer and the doorbell rung if the queue was empty.
+ *          Producer side only.
+ * @param[in]   q       Queue.
+ * @param[in]   msg     Message to add.
+ * @param[in]   db      Doorbell.
+ * @return      true if added, false if the queue is full.
+ */
+bool ipc_queue_push(ipc_queue* q, const ipc_msg* msg, const ipc_doorbell* db);
+
+/**
+ * @brief   Takes a message without blocking. The doorbell is rung if the
+ *          queue was full. Consumer side only.
+ * @param[in]   q       Queue.
+ * @param[out]  msg     Message taken.
+ * @param[in]   db      Doorbell.
+ * @return      true if a message was taken, false if the queue is empty.
+ */
+bool ipc_queue_pop(ipc_queue* q, ipc_msg* msg, const ipc_doorbell* db);
+
+/**
+ * @brief   Adds a message, waiting for a free slot.
+ * @param[in]   q           Queue.
+ * @param[in]   msg         Message to add.
+ * @param[in]   db          Doorbell.
+ * @param[in]   timeout_ms  Longest wait for the doorbell, or IPC_WAIT_FOREVER.
+ * @return      true if added, false on timeout.
+ */
+bool ipc_queue_push_wait(ipc_queue* q, const ipc_msg* msg, const ipc_doorbell* db, uint32_t timeout_ms);
+
+/**
+ * @brief   Takes a message, waiting for one to arrive.
+ * @param[in]   q           Queue.
+ * @param[out]  msg         Message taken.
+ * @param[in]   db          Doorbell.
+ * @param[in]   timeout_ms  Longest wait for the doorbell, or IPC_WAIT_FOREVER.
+ * @return      true if a message was taken, false on timeout.
+ */
+bool ipc_queue_pop_wait(ipc_queue* q, ipc_msg* msg, const ipc_doorbell* db, uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IPC_QUEUE_H */
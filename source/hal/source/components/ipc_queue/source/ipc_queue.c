@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ipc_queue.h"
+
+#include "log_macros.h"     /* Logging macros */
+
+#define IPC_QUEUE_MASK      (IPC_QUEUE_DEPTH - 1)
+
+#if (IPC_QUEUE_DEPTH & IPC_QUEUE_MASK) != 0
+    #error "IPC_QUEUE_DEPTH must be a power of two"
+#endif
+
+/* The indices run freely and wrap at 2^32; head - tail is the fill level. */
+
+static void sync_out(const ipc_doorbell* db, const volatile void* p, size_t bytes)
+{
+    if (db->sync_out) {
+        db->sync_out((const void*)p, bytes);
+    }
+}
+
+static void sync_in(const ipc_doorbell* db, const volatile void* p, size_t bytes)
+{
+    if (db->sync_in) {
+        db->sync_in((const void*)p, bytes);
+    }
+}
+
+/* Reads an index written by the other side. */
+static uint32_t load_index(const ipc_doorbell* db, const volatile uint32_t* index)
+{
+    sync_in(db, index, sizeof(*index));
+    return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+/* Publishes an index; everything written before it is visible first. */
+static void store_index(const ipc_doorbell* db, volatile uint32_t* index, uint32_t value)
+{
+    __atomic_store_n(index, value, __ATOMIC_RELEASE);
+    sync_out(db, index, sizeof(*index));
+}
+
+void ipc_queue_init(ipc_queue* q, const ipc_doorbell* db)
+{
+    __atomic_store_n(&q->head, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&q->tail, 0, __ATOMIC_SEQ_CST);
+    sync_out(db, q, sizeof(*q));
+}
+
+uint32_t ipc_queue_count(ipc_queue* q, const ipc_doorbell* db)
+{
+    const uint32_t tail = load_index(db, &q->tail);
+    return load_index(db, &q->head) - tail;
+}
+
+bool ipc_queue_push(ipc_queue* q, const ipc_msg* msg, const ipc_doorbell* db)
+{
+    /* Only this side writes head, so the local copy is current. */
+    const uint32_t head = q->head;
+    const uint32_t tail = load_index(db, &q->tail);
+
+    if (head - tail >= IPC_QUEUE_DEPTH) {
+        return false;
+    }
+
+    /* Hand over the buffer, then the message describing it. */
+    if (msg->data && msg->size) {
+        sync_out(db, (const void*)msg->data, msg->size);
+    }
+    ipc_msg* slot = &q->slots[head & IPC_QUEUE_MASK];
+    *slot = *msg;
+    sync_out(db, slot, sizeof(*slot));
+    store_index(db, &q->head, head + 1);
+
+    /* A waiting consumer can only be waiting on an empty queue. The tail
+     * read above may be stale by now (the consumer can have emptied the
+     * queue since), so it is read again after publishing head: with a full
+     * barrier in between, either the consumer sees the new head or this
+     * sees its tail. */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (load_index(db, &q->tail) == head) {
+        db->ring(db->ctx);
+    }
+    return true;
+}
+
+bool ipc_queue_pop(ipc_queue* q, ipc_msg* msg, const ipc_doorbell* db)
+{
+    /* Only this side writes tail, so the local copy is current. */
+    const uint32_t tail = q->tail;
+    const uint32_t head = load_index(db, &q->head);
+
+    if (head == tail) {
+        return false;
+    }
+
+    const ipc_msg* slot = &q->slots[tail & IPC_QUEUE_MASK];
+    sync_in(db, slot, sizeof(*slot));
+    *msg = *slot;
+    if (msg->data && msg->size) {
+        sync_in(db, (const void*)msg->data, msg->size);
+    }
+    store_index(db, &q->tail, tail + 1);
+
+    /* A waiting producer can only be waiting on a full queue; as in
+     * ipc_queue_push, head is read again after publishing tail. */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (load_index(db, &q->head) - tail == IPC_QUEUE_DEPTH) {
+        db->ring(db->ctx);
+    }
+    return true;
+}
+
+bool ipc_queue_push_wait(ipc_queue* q, const ipc_msg* msg, const ipc_doorbell* db, uint32_t timeout_ms)
+{
+    for (;;) {
+        /* Read the count first: a ring after the check changes it. */
+        const uint32_t count = db->count(db->ctx);
+        if (ipc_queue_push(q, msg, db)) {
+            return true;
+        }
+        if (!db->wait(db->ctx, count, timeout_ms)) {
+            trace("IPC queue push timed out\n");
+            return false;
+        }
+    }
+}
+
+bool ipc_queue_pop_wait(ipc_queue* q, ipc_msg* msg, const ipc_doorbell* db, uint32_t timeout_ms)
+{
+    for (;;) {
+        const uint32_t count = db->count(db->ctx);
+        if (ipc_queue_pop(q, msg, db)) {
+            return true;
+        }
+        if (!db->wait(db->ctx, count, timeout_ms)) {
+            trace("IPC queue pop timed out\n");
+            return false;
+        }
+    }
+}
@@ -28,20 +28,20 @@
  */
 
 #include "ethosu_cpu_cache.h"
+#include "ethosu_cache_policy.h"
 
 #include "RTE_Components.h"         /* For CPU related defintiions */
 #include "ethosu_driver.h"          /* Arm Ethos-U driver header */
 #include "log_macros.h"             /* Logging macros */
 
-/** Structure to maintain data cache states. */
-typedef struct _cpu_cache_state {
-    uint32_t dcache_invalidated : 1;
-    uint32_t dcache_cleaned : 1;
-} cpu_cache_state;
-
-/** Static CPU cache state object.
- * @note This logic around flipping these states is based on the driver
- *       calling the functions in this sequence:
+/**
+ * @note The Arm Ethos-U NPU driver calls the flush and invalidate functions
+ *       repeatedly, once for each region it accesses. The policy skips
+ *       read-only and non-cacheable regions, maintains small areas by
+ *       address and falls back to the whole cache above the breakpoint,
+ *       where maintaining by address would take longer. The whole cache is
+ *       maintained at most once per inference, based on the driver calling
+ *       the functions in this sequence:
  *
  *       Cache flush (ethosu_flush_dcache)
  *                  ↓
@@ -52,105 +52,125 @@ typedef struct _cpu_cache_state {
  *       End inference (ethosu_inference_end)
  *                  ↓
  *       Cache invalidate (ethosu_dcache_invalidate)
+ *
+ *       If the neural network to be executed is completely falling
+ *       onto the NPU, consider disabling the data cache altogether
+ *       for the duration of the inference to further reduce the cache
+ *       maintenance burden in these functions.
  **/
-static cpu_cache_state s_cache_state = {.dcache_cleaned = 0, .dcache_invalidated = 0};
 
-/**
- * @brief   Gets the current CPU cache state.
- * @return  Pointer to the CPU cache state object.
- */
-static cpu_cache_state* ethosu_get_cpu_cache_state(void)
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+
+static bool dcache_enabled(void)
 {
-    return &s_cache_state;
+    return SCB->CCR & SCB_CCR_DC_Msk;
 }
 
-bool __attribute__((weak)) ethosu_area_needs_flush_dcache(const uint32_t *p, size_t bytes)
+static void clean_range(uintptr_t addr, size_t bytes)
+{
+    SCB_CleanDCache_by_Addr((void *)addr, (int32_t)bytes);
+}
+
+static void clean_invalidate_range(uintptr_t addr, size_t bytes)
+{
+    SCB_CleanInvalidateDCache_by_Addr((void *)addr, (int32_t)bytes);
+}
+
+static void clean_all(void)
+{
+    SCB_CleanDCache();
+}
+
+static void clean_invalidate_all(void)
+{
+    SCB_CleanInvalidateDCache();
+}
+
+#else /* defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U) */
+
+static bool dcache_enabled(void)
 {
-    UNUSED(p);
-    UNUSED(bytes);
-#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
-    return SCB->CCR & SCB_CCR_DC_Msk;
-#else
     return false;
-#endif
+}
 
+static void clean_range(uintptr_t addr, size_t bytes)
+{
+    UNUSED(addr);
+    UNUSED(bytes);
 }
 
-bool __attribute__((weak)) ethosu_area_needs_invalidate_dcache(const uint32_t *p, size_t bytes)
+static void clean_invalidate_range(uintptr_t addr, size_t bytes)
 {
-    UNUSED(p);
+    UNUSED(addr);
     UNUSED(bytes);
-#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
-    return SCB->CCR & SCB_CCR_DC_Msk;
-#else
-    return false;
-#endif
+}
+
+static void clean_all(void)
+{
+}
+
+static void clean_invalidate_all(void)
+{
+}
+
+#endif /* defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U) */
+
+static void barrier(void)
+{
+    __DSB();
+}
+
+uint64_t __attribute__((weak)) ethosu_cpu_cache_cycle_count(void)
+{
+    return 0;
+}
+
+/** CPU cache operations used by the maintenance policy. */
+static const ethosu_cache_ops s_cache_ops = {
+    .dcache_enabled = dcache_enabled,
+    .clean_range = clean_range,
+    .clean_invalidate_range = clean_invalidate_range,
+    .clean_all = clean_all,
+    .clean_invalidate_all = clean_invalidate_all,
+    .barrier = barrier,
+    .cycle_count = ethosu_cpu_cache_cycle_count
+};
+
+void ethosu_cpu_cache_init(void)
+{
+    ethosu_cache_policy_init(&s_cache_ops);
+}
+
+bool __attribute__((weak)) ethosu_area_needs_flush_dcache(const uint32_t *p, size_t bytes)
+{
+    return ethosu_cache_policy_needs_clean(p, bytes);
+}
+
+bool __attribute__((weak)) ethosu_area_needs_invalidate_dcache(const uint32_t *p, size_t bytes)
+{
+    return ethosu_cache_policy_needs_maintenance(p, bytes);
 }
 
 void ethosu_clear_cache_states(void)
 {
-    cpu_cache_state* const state = ethosu_get_cpu_cache_state();
     trace("Clearing cache state members\n");
-    state->dcache_invalidated = 0;
-    state->dcache_cleaned     = 0;
+    ethosu_cache_policy_clear_state();
 }
 
 void ethosu_flush_dcache(uint32_t *p, size_t bytes)
 {
-    cpu_cache_state* const state = ethosu_get_cpu_cache_state();
     if (ethosu_area_needs_flush_dcache(p, bytes)) {
-
-        /**
-         * @note We could choose to call the `SCB_CleanDCache_by_Addr` function
-         *       here, but the sizes which this function is called for, can
-         *       cause unnecessary delays. It's worth noting that this function
-         *       is called from the Arm Ethos-U NPU drive repeatedly for each
-         *       region it accesses. This could even be RO memory which does
-         *       not need cache maintenance, along with parts of the input and
-         *       output tensors which rightly need to be cleaned. Therefore, to
-         *       reduce overhead of repeated calls for large memory sizes, we
-         *       call the clean and invalidation functions for whole cache.
-         *
-         *       If the neural network to be executed is completely falling
-         *       onto the NPU, consider disabling the data cache altogether
-         *       for the duration of the inference to further reduce the cache
-         *       maintenance burden in these functions.
-         */
-
-        /** Clean the cache if it hasn't been cleaned already  */
-        if (!state->dcache_cleaned) {
-            trace("Cleaning data cache\n");
-            SCB_CleanDCache();
-
-            /** Assert the cache cleaned state and clear the invalidation
-             *  state. */
-            state->dcache_cleaned     = 1;
-            state->dcache_invalidated = 0;
-        }
+        ethosu_cache_policy_clean(p, bytes);
     } else {
-        __DSB();
+        ethosu_cache_policy_skip();
     }
 }
 
 void ethosu_invalidate_dcache(uint32_t *p, size_t bytes)
 {
-    cpu_cache_state* const state = ethosu_get_cpu_cache_state();
     if (ethosu_area_needs_invalidate_dcache(p, bytes)) {
-        /**
-         * See note in ethosu_flush_dcache function for why we clean the whole
-         * cache instead of calling it for specific addresses.
-         **/
-        if (!state->dcache_invalidated) {
-            trace("Invalidating data cache\n");
-            /* Not safe to simply invalidate without cleaning unless we know there are no write-back areas in the system */
-            SCB_CleanInvalidateDCache();
-
-            /** Assert the cache invalidation state and clear the clean
-             *  state. */
-            state->dcache_invalidated = 1;
-            state->dcache_cleaned     = 0;
-        }
+        ethosu_cache_policy_invalidate(p, bytes);
     } else {
-        __DSB();
+        ethosu_cache_policy_skip();
     }
 }
@@ -20,6 +20,7 @@
 #include "RTE_Components.h"         /* For CPU related defintiions */
 #include "log_macros.h"             /* Logging functions */
 
+#include "ethosu_cpu_cache.h"       /* Arm Ethos-U CPU cache maintenance */
 #include "ethosu_mem_config.h"      /* Arm Ethos-U memory config */
 #include "ethosu_driver.h"          /* Arm Ethos-U driver header */
 
@@ -77,6 +78,9 @@ int arm_ethosu_npu_init(void)
 {
     int err = 0;
 
+    /* Set up the cache maintenance policy before the driver can call it */
+    ethosu_cpu_cache_init();
+
     /* Initialise the IRQ */
     arm_ethosu_npu_irq_init();
 
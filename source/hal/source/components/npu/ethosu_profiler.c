@@ -17,6 +17,7 @@
 
 #include "ethosu_profiler.h"
 #include "ethosu_cpu_cache.h"
+#include "ethosu_cache_policy.h"
 #include "log_macros.h"
 
 #include <string.h>
@@ -166,6 +167,13 @@ ethosu_pmu_counters ethosu_get_pmu_counters(void)
     }
 #endif /* ETHOSU_DERIVED_NCOUNTERS >= 1 */
 
+    /* CPU side cache maintenance done for the NPU */
+    ethosu_cache_stats cache_stats;
+    ethosu_cache_policy_get_stats(&cache_stats);
+    counters->npu_cache_maint_ops = cache_stats.ranged_cleans + cache_stats.whole_cleans +
+                                    cache_stats.ranged_invalidates + cache_stats.whole_invalidates;
+    counters->npu_cache_maint_cycles = cache_stats.cycles;
+
     return *counters;
 }
 
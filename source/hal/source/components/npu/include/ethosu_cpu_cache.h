@@ -33,6 +33,20 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+/**
+ * @brief   Sets up the cache maintenance policy with the CPU cache functions.
+ *          Regions should be registered with the policy after this call.
+ */
+void ethosu_cpu_cache_init(void);
+
+/**
+ * @brief   Cycle counter used to account for the time spent on cache
+ *          maintenance. Default weak implementation returns 0; platforms
+ *          can override it with their CPU cycle counter.
+ * @return  CPU cycle count.
+ */
+uint64_t ethosu_cpu_cache_cycle_count(void);
+
 /**
  * @brief   Clears all the cache state members.
  */
@@ -40,8 +54,9 @@ void ethosu_clear_cache_states(void);
 
 /**
  * @brief   Precheck hook for ethosu_flush_dcache. Default weak implementation
- *          returns true if the data cache is enabled. Can be overridden to
- *          skip flush/clean for certain regions (eg TCM, or write-through cached areas).
+ *          returns true if the data cache is enabled and the area is not a
+ *          read-only, non-cacheable or write-through region of the policy. Can
+ *          be overridden to skip flush/clean for other regions.
  * @param[in]   p       Pointer to the start address.
  * @param[in]   bytes   Number of bytes to flush beginning at start address.
  * @return      true if a flush/clean is required
@@ -50,7 +65,8 @@ bool ethosu_area_needs_flush_dcache(const uint32_t *p, size_t bytes);
 
 /**
  * @brief   Precheck hook for ethosu_invalidate_dcache. Default weak implementation
- *          returns true if the data cache is enabled. Can be overridden to
+ *          returns true if the data cache is enabled and the area is not a
+ *          read-only or non-cacheable region of the policy. Can be overridden to
  *          skip invalidates for certain regions (eg TCM).
  * @param[in]   p       Pointer to the start address (or NULL).
  * @param[in]   bytes   Number of bytes to flush beginning at start address.
@@ -44,6 +44,8 @@ typedef struct ethosu_pmu_counters_ {
     npu_evt_counter         npu_evt_counters[ETHOSU_PMU_NCOUNTERS];
     npu_derived_counter     npu_derived_counters[ETHOSU_DERIVED_NCOUNTERS];
     uint32_t                num_total_counters; /**< Total number of counters */
+    uint32_t                npu_cache_maint_ops;    /**< CPU cache maintenance operations for the NPU */
+    uint64_t                npu_cache_maint_cycles; /**< CPU cycles spent on cache maintenance */
 } ethosu_pmu_counters;
 
 /**
@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ETHOSU_CACHE_POLICY_H
+#define ETHOSU_CACHE_POLICY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define ETHOSU_CACHE_POLICY_MAX_REGIONS         (16)        /**< Maximum number of registered regions. */
+#define ETHOSU_CACHE_POLICY_DEFAULT_BREAKPOINT  (16 * 1024) /**< Default ranged/whole cache breakpoint in bytes. */
+#define ETHOSU_CACHE_LINE_SIZE                  (32)        /**< Data cache line size in bytes. */
+
+/**
+ * @brief   Memory region classes. Areas not covered by a registered region
+ *          are treated as cacheable read-write memory. Write-through regions
+ *          are an attribute of the memory rather than a class: an area in one
+ *          takes the class of the other regions it is in, but is never dirty,
+ *          so it is invalidated without being cleaned first.
+ */
+typedef enum _ethosu_cache_region_type {
+    ETHOSU_CACHE_REGION_DEFAULT = 0,    /**< Cacheable read-write memory. */
+    ETHOSU_CACHE_REGION_RO_MODEL,       /**< Model weights; never written while running. */
+    ETHOSU_CACHE_REGION_TENSOR_ARENA,   /**< Tensor arena, written by the CPU and the NPU. */
+    ETHOSU_CACHE_REGION_IO,             /**< Input and output feature maps. */
+    ETHOSU_CACHE_REGION_NON_CACHEABLE,  /**< Memory the data cache does not cover (eg TCM). */
+    ETHOSU_CACHE_REGION_WRITE_THROUGH,  /**< Memory cached write-through, never needing a clean. */
+    ETHOSU_CACHE_REGION_NUM_TYPES
+} ethosu_cache_region_type;
+
+/**
+ * @brief   Cache maintenance operations the policy issues. Set by the NPU
+ *          component from the CPU's cache functions; a mock can be used to
+ *          test the policy natively.
+ */
+typedef struct _ethosu_cache_ops {
+    bool (*dcache_enabled)(void);                               /**< Whether the data cache is on. */
+    void (*clean_range)(uintptr_t addr, size_t bytes);          /**< Clean by address, line aligned. */
+    void (*clean_invalidate_range)(uintptr_t addr, size_t bytes); /**< Clean and invalidate by address, line aligned. */
+    void (*clean_all)(void);                                    /**< Clean the whole cache. */
+    void (*clean_invalidate_all)(void);                         /**< Clean and invalidate the whole cache. */
+    void (*barrier)(void);                                      /**< Data synchronisation barrier. */
+    uint64_t (*cycle_count)(void);                              /**< CPU cycle counter, can be NULL. */
+} ethosu_cache_ops;
+
+/**
+ * @brief   Cache maintenance statistics. Counters only ever increase; the
+ *          profiler reports differences.
+ */
+typedef struct _ethosu_cache_stats {
+    uint32_t ranged_cleans;         /**< Cleans by address. */
+    uint32_t whole_cleans;          /**< Cleans of the whole cache. */
+    uint32_t ranged_invalidates;    /**< Clean and invalidates by address. */
+    uint32_t whole_invalidates;     /**< Clean and invalidates of the whole cache. */
+    uint32_t skipped;               /**< Requests needing no maintenance. */
+    uint32_t per_region[ETHOSU_CACHE_REGION_NUM_TYPES]; /**< Requests per region class. */
+    uint64_t cycles;                /**< CPU cycles spent on maintenance. */
+} ethosu_cache_stats;
+
+/**
+ * @brief   Initialises the policy: sets the operations to use, clears the
+ *          regions and statistics and restores the default breakpoint.
+ * @param[in]   ops     Cache maintenance operations; must outlive the policy.
+ */
+void ethosu_cache_policy_init(const ethosu_cache_ops* ops);
+
+/**
+ * @brief   Registers a memory region. Regions are matched in registration
+ *          order, so smaller regions (eg IFM/OFM) should be added before the
+ *          regions containing them (eg the tensor arena).
+ * @param[in]   start   Start address of the region.
+ * @param[in]   bytes   Size of the region in bytes.
+ * @param[in]   type    Region class.
+ * @return      true if registered, false if the table is full or the region invalid.
+ */
+bool ethosu_cache_policy_add_region(const void* start, size_t bytes, ethosu_cache_region_type type);
+
+/**
+ * @brief   Sets the size above which the whole cache is maintained instead
+ *          of the requested range.
+ * @param[in]   bytes   Breakpoint in bytes.
+ */
+void ethosu_cache_policy_set_breakpoint(size_t bytes);
+
+/**
+ * @brief   Gets the class of an area; the area must fit in a region to take
+ *          its class. Write-through regions are not classes and are skipped.
+ * @param[in]   p       Start address of the area.
+ * @param[in]   bytes   Size of the area in bytes.
+ * @return      Region class.
+ */
+ethosu_cache_region_type ethosu_cache_policy_get_region_type(const void* p, size_t bytes);
+
+/**
+ * @brief   Checks if an area needs cache maintenance at all: the data cache
+ *          must be on and the area must not be read-only or non-cacheable.
+ *          A NULL pointer means the whole cache.
+ * @param[in]   p       Start address of the area.
+ * @param[in]   bytes   Size of the area in bytes.
+ * @return      true if maintenance is required.
+ */
+bool ethosu_cache_policy_needs_maintenance(const void* p, size_t bytes);
+
+/**
+ * @brief   Checks if an area needs cleaning before the NPU reads it: it must
+ *          need maintenance and not fit in a write-through region.
+ * @param[in]   p       Start address of the area.
+ * @param[in]   bytes   Size of the area in bytes.
+ * @return      true if a clean is required.
+ */
+bool ethosu_cache_policy_needs_clean(const void* p, size_t bytes);
+
+/**
+ * @brief   Cleans an area before the NPU reads it: by address up to the
+ *          breakpoint, the whole cache (once per inference) above it.
+ * @param[in]   p       Start address of the area, NULL for the whole cache.
+ * @param[in]   bytes   Size of the area in bytes.
+ */
+void ethosu_cache_policy_clean(const void* p, size_t bytes);
+
+/**
+ * @brief   Cleans and invalidates an area after the NPU has written it: by
+ *          address up to the breakpoint, the whole cache (once per inference)
+ *          above it.
+ * @param[in]   p       Start address of the area, NULL for the whole cache.
+ * @param[in]   bytes   Size of the area in bytes.
+ */
+void ethosu_cache_policy_invalidate(const void* p, size_t bytes);
+
+/**
+ * @brief   Records a request that needed no maintenance and issues a barrier.
+ */
+void ethosu_cache_policy_skip(void);
+
+/**
+ * @brief   Clears the whole cache cleaned/invalidated states; called at the
+ *          start of each inference.
+ */
+void ethosu_cache_policy_clear_state(void);
+
+/**
+ * @brief   Gets the maintenance statistics.
+ * @param[out]  stats   Statistics copy.
+ */
+void ethosu_cache_policy_get_stats(ethosu_cache_stats* stats);
+
+/**
+ * @brief   Resets the maintenance statistics.
+ */
+void ethosu_cache_policy_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ETHOSU_CACHE_POLICY_H */
@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ethosu_cache_policy.h"
+
+#include "log_macros.h"     /* Logging macros */
+
+#include <string.h>
+
+/** Registered memory region. */
+typedef struct _cache_region {
+    uintptr_t base;
+    uintptr_t limit;        /* Inclusive. */
+    ethosu_cache_region_type type;
+} cache_region;
+
+/** Policy state. */
+typedef struct _cache_policy {
+    const ethosu_cache_ops* ops;
+    cache_region regions[ETHOSU_CACHE_POLICY_MAX_REGIONS];
+    size_t num_regions;
+    size_t breakpoint;
+    uint32_t dcache_cleaned : 1;        /* Whole cache cleaned this inference. */
+    uint32_t dcache_invalidated : 1;    /* Whole cache invalidated this inference. */
+    ethosu_cache_stats stats;
+} cache_policy;
+
+static cache_policy s_policy = {
+    .ops = NULL,
+    .num_regions = 0,
+    .breakpoint = ETHOSU_CACHE_POLICY_DEFAULT_BREAKPOINT
+};
+
+static uint64_t get_cycle_count(void)
+{
+    if (s_policy.ops && s_policy.ops->cycle_count) {
+        return s_policy.ops->cycle_count();
+    }
+    return 0;
+}
+
+/**
+ * @brief       Aligns an area to whole cache lines.
+ * @param[in]   p       Start address of the area.
+ * @param[in]   bytes   Size of the area in bytes.
+ * @param[out]  addr    Line aligned start address.
+ * @param[out]  size    Size covering whole lines.
+ */
+static void align_to_lines(const void* p, size_t bytes, uintptr_t* addr, size_t* size)
+{
+    const uintptr_t mask = (uintptr_t)(ETHOSU_CACHE_LINE_SIZE - 1);
+    const uintptr_t start = (uintptr_t)p & ~mask;
+    const uintptr_t end = ((uintptr_t)p + bytes + mask) & ~mask;
+    *addr = start;
+    *size = (size_t)(end - start);
+}
+
+void ethosu_cache_policy_init(const ethosu_cache_ops* ops)
+{
+    s_policy.ops = ops;
+    s_policy.num_regions = 0;
+    s_policy.breakpoint = ETHOSU_CACHE_POLICY_DEFAULT_BREAKPOINT;
+    ethosu_cache_policy_clear_state();
+    ethosu_cache_policy_reset_stats();
+}
+
+bool ethosu_cache_policy_add_region(const void* start, size_t bytes, ethosu_cache_region_type type)
+{
+    if (bytes == 0 || type >= ETHOSU_CACHE_REGION_NUM_TYPES) {
+        printf_err("Invalid cache region\n");
+        return false;
+    }
+    if (s_policy.num_regions >= ETHOSU_CACHE_POLICY_MAX_REGIONS) {
+        printf_err("Cache region table full\n");
+        return false;
+    }
+
+    cache_region* region = &s_policy.regions[s_policy.num_regions++];
+    region->base = (uintptr_t)start;
+    region->limit = (uintptr_t)start + bytes - 1;
+    region->type = type;
+    debug("Cache region %d: 0x%08lx - 0x%08lx\n", (int)type,
+          (unsigned long)region->base, (unsigned long)region->limit);
+    return true;
+}
+
+void ethosu_cache_policy_set_breakpoint(size_t bytes)
+{
+    s_policy.breakpoint = bytes;
+}
+
+/**
+ * @brief       Finds the first region an area fits in.
+ * @param[in]   p               Start address of the area.
+ * @param[in]   bytes           Size of the area in bytes.
+ * @param[in]   write_through    Whether to look for write-through regions
+ *                              rather than for the other classes.
+ * @return      Region, NULL if none.
+ */
+static const cache_region* find_region(const void* p, size_t bytes, bool write_through)
+{
+    const uintptr_t base = (uintptr_t)p;
+    const uintptr_t limit = base + (bytes ? bytes - 1 : 0);
+
+    for (size_t i = 0; i < s_policy.num_regions; ++i) {
+        const cache_region* region = &s_policy.regions[i];
+        if ((region->type == ETHOSU_CACHE_REGION_WRITE_THROUGH) == write_through &&
+                base >= region->base && limit <= region->limit) {
+            return region;
+        }
+    }
+    return NULL;
+}
+
+ethosu_cache_region_type ethosu_cache_policy_get_region_type(const void* p, size_t bytes)
+{
+    const cache_region* region = find_region(p, bytes, false);
+    return region ? region->type : ETHOSU_CACHE_REGION_DEFAULT;
+}
+
+bool ethosu_cache_policy_needs_maintenance(const void* p, size_t bytes)
+{
+    if (!s_policy.ops || !s_policy.ops->dcache_enabled()) {
+        return false;
+    }
+    if (!p) {
+        return true;
+    }
+    if (bytes == 0) {
+        return false;
+    }
+
+    const ethosu_cache_region_type type = ethosu_cache_policy_get_region_type(p, bytes);
+    ++s_policy.stats.per_region[type];
+    return type != ETHOSU_CACHE_REGION_RO_MODEL && type != ETHOSU_CACHE_REGION_NON_CACHEABLE;
+}
+
+bool ethosu_cache_policy_needs_clean(const void* p, size_t bytes)
+{
+    if (!ethosu_cache_policy_needs_maintenance(p, bytes)) {
+        return false;
+    }
+    return !p || !find_region(p, bytes, true);
+}
+
+void ethosu_cache_policy_clean(const void* p, size_t bytes)
+{
+    if (!s_policy.ops) {
+        return;
+    }
+
+    /* Nothing left to clean since the whole cache was cleaned. */
+    if (s_policy.dcache_cleaned) {
+        ++s_policy.stats.skipped;
+        s_policy.ops->barrier();
+        return;
+    }
+
+    const uint64_t start = get_cycle_count();
+    if (p && bytes <= s_policy.breakpoint) {
+        uintptr_t addr;
+        size_t size;
+        align_to_lines(p, bytes, &addr, &size);
+        s_policy.ops->clean_range(addr, size);
+        ++s_policy.stats.ranged_cleans;
+    } else {
+        trace("Cleaning data cache\n");
+        s_policy.ops->clean_all();
+        ++s_policy.stats.whole_cleans;
+
+        /* Assert the cache cleaned state and clear the invalidation state. */
+        s_policy.dcache_cleaned = 1;
+        s_policy.dcache_invalidated = 0;
+    }
+    s_policy.stats.cycles += get_cycle_count() - start;
+}
+
+void ethosu_cache_policy_invalidate(const void* p, size_t bytes)
+{
+    if (!s_policy.ops) {
+        return;
+    }
+
+    /* Nothing left to invalidate since the whole cache was invalidated. */
+    if (s_policy.dcache_invalidated) {
+        ++s_policy.stats.skipped;
+        s_policy.ops->barrier();
+        return;
+    }
+
+    /* Not safe to simply invalidate without cleaning unless we know there
+     * are no write-back areas in the system, so both clean and invalidate. */
+    const uint64_t start = get_cycle_count();
+    if (p && bytes <= s_policy.breakpoint) {
+        uintptr_t addr;
+        size_t size;
+        align_to_lines(p, bytes, &addr, &size);
+        s_policy.ops->clean_invalidate_range(addr, size);
+        ++s_policy.stats.ranged_invalidates;
+    } else {
+        trace("Invalidating data cache\n");
+        s_policy.ops->clean_invalidate_all();
+        ++s_policy.stats.whole_invalidates;
+
+        /* Assert the cache invalidation state and clear the clean state. */
+        s_policy.dcache_invalidated = 1;
+        s_policy.dcache_cleaned = 0;
+    }
+    s_policy.stats.cycles += get_cycle_count() - start;
+}
+
+void ethosu_cache_policy_skip(void)
+{
+    ++s_policy.stats.skipped;
+    if (s_policy.ops) {
+        s_policy.ops->barrier();
+    }
+}
+
+void ethosu_cache_policy_clear_state(void)
+{
+    s_policy.dcache_cleaned = 0;
+    s_policy.dcache_invalidated = 0;
+}
+
+void ethosu_cache_policy_get_stats(ethosu_cache_stats* stats)
+{
+    *stats = s_policy.stats;
+}
+
+void ethosu_cache_policy_reset_stats(void)
+{
+    memset(&s_policy.stats, 0, sizeof(s_policy.stats));
+}
@@ -62,6 +62,15 @@ extern bool run_requested(void);
 extern void init_trigger_rx(void);
 extern void init_trigger_tx(void);
 
+/** M55-M55 message id used as the ipc_queue doorbell. */
+#define IPC_DOORBELL_MSG_ID     (4)
+
+/**
+ * @brief   Records a doorbell ring from the other core; called from the
+ *          M55-M55 message callbacks.
+ */
+void ipc_doorbell_received(void);
+
 #ifdef __cplusplus
 }
 #endif
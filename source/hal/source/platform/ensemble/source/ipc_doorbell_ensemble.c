@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Doorbell between the two M55 cores: a ring is an MHU message on the
+ * M55-M55 channel set up by init_trigger_rx()/init_trigger_tx(). Queue
+ * memory and buffers must be in memory both cores reach at the same global
+ * address (eg SRAM0/SRAM1, or TCM through LocalToGlobal). */
+
+#include "platform_drivers.h"
+#include "ipc_queue.h"
+#include "services_main.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+extern uint64_t Get_SysTick_Cycle_Count(void);
+
+static volatile uint32_t s_ring_count = 0;
+
+/* Read by the other core, so it stays valid for the whole run. */
+static m55_data_payload_t s_ring_payload = {
+    .id = IPC_DOORBELL_MSG_ID,
+    .msg = "ipc"
+};
+
+void ipc_doorbell_received(void)
+{
+    ++s_ring_count;
+}
+
+static void ensemble_ring(void* ctx)
+{
+    UNUSED(ctx);
+    /* Queue updates must land before the other core is woken. */
+    __DSB();
+    send_message_to_HE(&s_ring_payload);
+}
+
+static uint32_t ensemble_count(void* ctx)
+{
+    UNUSED(ctx);
+    return s_ring_count;
+}
+
+static bool ensemble_wait(void* ctx, uint32_t count, uint32_t timeout_ms)
+{
+    UNUSED(ctx);
+    const uint64_t timeout_cycles = (uint64_t)timeout_ms * (GetSystemCoreClock() / 1000);
+    const uint64_t start = Get_SysTick_Cycle_Count();
+
+    while (s_ring_count == count) {
+        if (timeout_ms != IPC_WAIT_FOREVER &&
+            Get_SysTick_Cycle_Count() - start >= timeout_cycles) {
+            return false;
+        }
+        /* Woken by the MHU interrupt, or the SysTick to re-check the timeout. */
+        __WFE();
+    }
+    return true;
+}
+
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+static bool dcache_enabled(void)
+{
+    return (SCB->CCR & SCB_CCR_DC_Msk) != 0;
+}
+
+static void line_align(const void* p, size_t bytes, uint32_t* addr, int32_t* size)
+{
+    const uint32_t mask = IPC_QUEUE_LINE_SIZE - 1;
+    const uint32_t start = (uint32_t)p & ~mask;
+    *addr = start;
+    *size = (int32_t)((((uint32_t)p + bytes + mask) & ~mask) - start);
+}
+
+static void ensemble_sync_out(const void* p, size_t bytes)
+{
+    if (dcache_enabled()) {
+        uint32_t addr;
+        int32_t size;
+        line_align(p, bytes, &addr, &size);
+        SCB_CleanDCache_by_Addr((volatile void*)addr, size);
+    } else {
+        __DMB();
+    }
+}
+
+static void ensemble_sync_in(const void* p, size_t bytes)
+{
+    if (dcache_enabled()) {
+        uint32_t addr;
+        int32_t size;
+        line_align(p, bytes, &addr, &size);
+        SCB_InvalidateDCache_by_Addr((volatile void*)addr, size);
+    } else {
+        __DMB();
+    }
+}
+#else /* __DCACHE_PRESENT */
+static void ensemble_sync_out(const void* p, size_t bytes)
+{
+    UNUSED(p);
+    UNUSED(bytes);
+    __DMB();
+}
+
+static void ensemble_sync_in(const void* p, size_t bytes)
+{
+    UNUSED(p);
+    UNUSED(bytes);
+    __DMB();
+}
+#endif /* __DCACHE_PRESENT */
+
+static const ipc_doorbell s_ensemble_doorbell = {
+    .ctx = NULL,
+    .ring = ensemble_ring,
+    .count = ensemble_count,
+    .wait = ensemble_wait,
+    .sync_out = ensemble_sync_out,
+    .sync_in = ensemble_sync_in
+};
+
+const ipc_doorbell* platform_ipc_doorbell(void)
+{
+    return &s_ensemble_doorbell;
+}
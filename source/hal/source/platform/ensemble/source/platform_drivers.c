@@ -49,6 +49,7 @@
 #if defined(ARM_NPU)
 #include "ethosu_driver.h"
 #include "ethosu_npu_init.h"
+#include "ethosu_cache_policy.h"
 
 #if defined(ETHOS_U_BASE_ADDR)
     #if (ETHOS_U_NPU_BASE != ETHOS_U_BASE_ADDR)
@@ -74,6 +75,10 @@ static void ipc_rx_callback(void *data)
     m55_data_payload_t* payload = (m55_data_payload_t*)data;
     char *st = (char*)payload->msg;
     uint16_t id = payload->id;
+    if (id == IPC_DOORBELL_MSG_ID) {
+        ipc_doorbell_received();
+        return;
+    }
     printf("****** Got message from other CPU: %s, id: %d\n", st, id);
 }
 
@@ -115,6 +120,15 @@ int platform_init(void)
         return state;
     }
 
+    /* TCM is never cached and MRAM should never change while running */
+    ethosu_cache_policy_add_region((const void *)ITCM_BASE, ITCM_SIZE, ETHOSU_CACHE_REGION_NON_CACHEABLE);
+    ethosu_cache_policy_add_region((const void *)DTCM_BASE, DTCM_SIZE, ETHOSU_CACHE_REGION_NON_CACHEABLE);
+    ethosu_cache_policy_add_region((const void *)MRAM_BASE, MRAM_SIZE, ETHOSU_CACHE_REGION_RO_MODEL);
+
+    /* The SRAMs are cached write-through, so the NPU's areas never need a clean, only invalidates */
+    ethosu_cache_policy_add_region((const void *)SRAM0_BASE, SRAM0_SIZE, ETHOSU_CACHE_REGION_WRITE_THROUGH);
+    ethosu_cache_policy_add_region((const void *)SRAM1_BASE, SRAM1_SIZE, ETHOSU_CACHE_REGION_WRITE_THROUGH);
+
 #endif /* ARM_NPU */
 
     /* Print target design info */
@@ -180,6 +194,9 @@ static void MHU_msg_received(void* data)
             break;
         case 3:
             break;
+        case IPC_DOORBELL_MSG_ID:
+            ipc_doorbell_received();
+            break;
         default:
             break;
     }
@@ -218,61 +235,6 @@ uint64_t ethosu_address_remap(uint64_t address, int index)
     /* Double cast to avoid build warning about pointer/integer size mismatch */
     return LocalToGlobal((void *) (uint32_t) address);
 }
-typedef struct address_range
-{
-    uintptr_t base;
-    uintptr_t limit;
-} address_range_t;
-
-const address_range_t no_need_to_invalidate_areas[] = {
-    /* TCM is never cached */
-    {
-        .base = ITCM_BASE,
-        .limit = ITCM_BASE + ITCM_SIZE - 1,
-    },
-    {
-        .base = DTCM_BASE,
-        .limit = DTCM_BASE + DTCM_SIZE - 1,
-    },
-    /* MRAM should never change while running */
-    {
-        .base = MRAM_BASE,
-        .limit = MRAM_BASE + MRAM_SIZE - 1,
-    }
-};
-
-static bool check_need_to_invalidate(const void *p, size_t bytes)
-{
-    uintptr_t base = (uintptr_t) p;
-    if (bytes == 0) {
-        return false;
-    }
-    uintptr_t limit = base + bytes - 1;
-    for (unsigned int i = 0; i < sizeof no_need_to_invalidate_areas / sizeof no_need_to_invalidate_areas[0]; i++) {
-        if (base >= no_need_to_invalidate_areas[i].base && limit <= no_need_to_invalidate_areas[i].limit) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool ethosu_area_needs_invalidate_dcache(const void *p, size_t bytes)
-{
-    /* API says null pointer can be passed */
-    if (!p) {
-        return true;
-    }
-    /* We know we have a cache and assume the cache is on */
-    return check_need_to_invalidate(p, bytes);
-}
-
-bool ethosu_area_needs_flush_dcache(const void *p, size_t bytes)
-{
-    /* We're not using writeback for any Ethos areas */
-    UNUSED(p);
-    UNUSED(bytes);
-    return false;
-}
 
 // void MPU_Load_Regions(void)
 // {
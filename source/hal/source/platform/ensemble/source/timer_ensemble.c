@@ -142,6 +142,16 @@ void platform_get_counters(pmu_counters* counters)
             "NPU TOTAL",
             "cycles",
             counters);
+    add_pmu_counter(
+            npu_counters.npu_cache_maint_ops,
+            "NPU CACHE MAINT OPS",
+            "ops",
+            counters);
+    add_pmu_counter(
+            npu_counters.npu_cache_maint_cycles,
+            "NPU CACHE MAINT CYCLES",
+            "cycles",
+            counters);
 #else  /* defined (ARM_NPU) */
     UNUSED(i);
 #endif /* defined (ARM_NPU) */
@@ -163,6 +173,14 @@ void platform_get_counters(pmu_counters* counters)
 
 }
 
+#if defined (ARM_NPU)
+uint64_t ethosu_cpu_cache_cycle_count(void)
+{
+    /* Accounts the time spent on NPU cache maintenance. */
+    return Get_SysTick_Cycle_Count();
+}
+#endif /* defined (ARM_NPU) */
+
 __WEAK void lv_tick_handler(int ticks)
 {
     UNUSED(ticks);
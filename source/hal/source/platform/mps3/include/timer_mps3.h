@@ -24,6 +24,7 @@
 
 #if defined (ARM_NPU)
     #include "ethosu_profiler.h"    /* Arm Ethos-U NPU profiling functions. */
+    #include "ethosu_cpu_cache.h"   /* Arm Ethos-U NPU cache maintenance. */
 #endif /* defined (ARM_NPU) */
 
 /* Container for timestamp up-counters. */
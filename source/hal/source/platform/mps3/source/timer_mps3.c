@@ -98,6 +98,16 @@ void platform_get_counters(pmu_counters* counters)
         "NPU TOTAL",
         unit_cycles,
         counters);
+    add_pmu_counter(
+        npu_counters.npu_cache_maint_ops,
+        "NPU CACHE MAINT OPS",
+        "ops",
+        counters);
+    add_pmu_counter(
+        npu_counters.npu_cache_maint_cycles,
+        "NPU CACHE MAINT CYCLES",
+        unit_cycles,
+        counters);
 #else
     UNUSED(i);
 #endif /* defined (ARM_NPU) */
@@ -134,6 +144,14 @@ void platform_get_counters(pmu_counters* counters)
 #endif /* !defined(CPU_PROFILE_ENABLED) */
 }
 
+#if defined (ARM_NPU)
+uint64_t ethosu_cpu_cache_cycle_count(void)
+{
+    /* Accounts the time spent on NPU cache maintenance. */
+    return Get_SysTick_Cycle_Count();
+}
+#endif /* defined (ARM_NPU) */
+
 uint32_t get_mps3_core_clock(void)
 {
     const uint32_t default_clock = 32000000 /* 32 MHz clock */;
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Doorbell between threads sharing the process memory, standing in for the
+ * two cores so that pipelines using ipc_queue can be tested on the host. */
+
+#include "ipc_queue.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+typedef struct _native_doorbell {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t count;
+} native_doorbell;
+
+static native_doorbell s_doorbell = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+    .count = 0
+};
+
+static void native_ring(void* ctx)
+{
+    native_doorbell* db = (native_doorbell*)ctx;
+    pthread_mutex_lock(&db->lock);
+    ++db->count;
+    pthread_cond_broadcast(&db->cond);
+    pthread_mutex_unlock(&db->lock);
+}
+
+static uint32_t native_count(void* ctx)
+{
+    native_doorbell* db = (native_doorbell*)ctx;
+    pthread_mutex_lock(&db->lock);
+    const uint32_t count = db->count;
+    pthread_mutex_unlock(&db->lock);
+    return count;
+}
+
+static bool native_wait(void* ctx, uint32_t count, uint32_t timeout_ms)
+{
+    native_doorbell* db = (native_doorbell*)ctx;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        ++deadline.tv_sec;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    int err = 0;
+    pthread_mutex_lock(&db->lock);
+    while (db->count == count && err != ETIMEDOUT) {
+        if (timeout_ms == IPC_WAIT_FOREVER) {
+            pthread_cond_wait(&db->cond, &db->lock);
+        } else {
+            err = pthread_cond_timedwait(&db->cond, &db->lock, &deadline);
+        }
+    }
+    const bool rung = db->count != count;
+    pthread_mutex_unlock(&db->lock);
+    return rung;
+}
+
+/* Threads see each other's writes once the queue's acquire/release ordering
+ * is respected, so no extra synchronisation is needed. */
+static const ipc_doorbell s_native_doorbell = {
+    .ctx = &s_doorbell,
+    .ring = native_ring,
+    .count = native_count,
+    .wait = native_wait,
+    .sync_out = NULL,
+    .sync_in = NULL
+};
+
+const ipc_doorbell* platform_ipc_doorbell(void)
+{
+    return &s_native_doorbell;
+}
@@ -17,11 +17,99 @@
 #include "PlatformMath.hpp"
 #include "log_macros.h"
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace arm {
 namespace app {
 namespace math {
 
+    /* The approximations below are branch free so that the loops calling
+     * them can be vectorised by the compiler (SSE/NEON on native, Helium on
+     * Cortex-M55 when CMSIS-DSP does not provide the function). Polynomials
+     * are the single precision ones from the Cephes library. */
+
+    static inline float AsFloat(uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static inline uint32_t AsBits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+#if !(defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+    static inline float LogF32Approx(float x)
+    {
+        /* Denormals are scaled up first. */
+        const bool denormal = x < std::numeric_limits<float>::min();
+        const float scaled = denormal ? x * 8388608.f /* 2^23 */ : x;
+        const uint32_t bits = AsBits(scaled);
+
+        /* x = m * 2^e, with m in [sqrt(0.5), sqrt(2)). */
+        int32_t e = static_cast<int32_t>((bits >> 23) & 0xff) - 126 - (denormal ? 23 : 0);
+        float m = AsFloat((bits & 0x007fffffu) | 0x3f000000u);
+        const bool belowSqrtHalf = m < 0.707106781186547524f;
+        e = belowSqrtHalf ? e - 1 : e;
+        m = belowSqrtHalf ? m + m - 1.f : m - 1.f;
+
+        const float z = m * m;
+        float y = 7.0376836292e-2f;
+        y = y * m - 1.1514610310e-1f;
+        y = y * m + 1.1676998740e-1f;
+        y = y * m - 1.2420140846e-1f;
+        y = y * m + 1.4249322787e-1f;
+        y = y * m - 1.6668057665e-1f;
+        y = y * m + 2.0000714765e-1f;
+        y = y * m - 2.4999993993e-1f;
+        y = y * m + 3.3333331174e-1f;
+        y = y * m * z;
+
+        const float fe = static_cast<float>(e);
+        y += fe * -2.12194440e-4f;
+        y -= 0.5f * z;
+        const float result = m + y + fe * 0.693359375f;
+
+        /* Special values: log(0) = -inf, log(inf) = inf, NaN otherwise. */
+        const float special = x == 0.f ? -std::numeric_limits<float>::infinity() :
+                              x == std::numeric_limits<float>::infinity() ? x :
+                              std::numeric_limits<float>::quiet_NaN();
+        return (x > 0.f && x < std::numeric_limits<float>::infinity()) ? result : special;
+    }
+
+    static inline float ExpF32Approx(float x)
+    {
+        /* Saturate so that 2^n stays a normal number; underflows go to 0 below.
+         * NaN fails the compare, so it is clamped too (the conversion below
+         * is undefined for it) and only passed through at the end. */
+        const float input = x;
+        const bool underflow = x < -87.33654f;
+        x = std::min(x >= -87.33654f ? x : -87.33654f, 88.f);
+
+        /* x = n * ln(2) + r, with |r| <= ln(2)/2; n = floor(x / ln(2) + 0.5). */
+        const float fx = x * 1.44269504088896341f + 0.5f;
+        float n = static_cast<float>(static_cast<int32_t>(fx));
+        n = n > fx ? n - 1.f : n;
+        const float r = x - n * 0.693359375f + n * 2.12194440e-4f;
+
+        float y = 1.9875691500e-4f;
+        y = y * r + 1.3981999507e-3f;
+        y = y * r + 8.3334519073e-3f;
+        y = y * r + 4.1665795894e-2f;
+        y = y * r + 1.6666665459e-1f;
+        y = y * r + 5.0000001201e-1f;
+        y = y * r * r + r + 1.f;
+
+        const float result = y * AsFloat(static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23);
+        return input != input ? input : underflow ? 0.f : result;
+    }
+#endif /* !__ARM_FEATURE_DSP */
+
     float MathUtils::CosineF32(float radians)
     {
 #if (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
@@ -40,7 +128,7 @@ namespace math {
 #endif /* __ARM_FEATURE_DSP */
     }
 
-    float MathUtils::MeanF32(float* ptrSrc, const uint32_t srcLen)
+    float MathUtils::MeanF32(const float* ptrSrc, const uint32_t srcLen)
     {
         if (!srcLen) {
             return 0.f;
@@ -56,7 +144,23 @@ namespace math {
 #endif /* __ARM_FEATURE_DSP */
     }
 
-    float MathUtils::StdDevF32(float* ptrSrc, const uint32_t srcLen,
+    float MathUtils::MeanF32(const float* ptrSrc, const uint32_t srcLen, const uint32_t stride)
+    {
+        if (stride == 1) {
+            return MeanF32(ptrSrc, srcLen);
+        }
+        if (!srcLen) {
+            return 0.f;
+        }
+
+        double acc = 0;
+        for (uint32_t i = 0; i < srcLen; ++i, ptrSrc += stride) {
+            acc += *ptrSrc;
+        }
+        return acc/srcLen;
+    }
+
+    float MathUtils::StdDevF32(const float* ptrSrc, const uint32_t srcLen,
                                const float mean)
     {
         if (!srcLen) {
@@ -84,6 +188,24 @@ namespace math {
 #endif /* __ARM_FEATURE_DSP */
     }
 
+    float MathUtils::StdDevF32(const float* ptrSrc, const uint32_t srcLen,
+                               const uint32_t stride, const float mean)
+    {
+        if (stride == 1) {
+            return StdDevF32(ptrSrc, srcLen, mean);
+        }
+        if (!srcLen) {
+            return 0.f;
+        }
+
+        /* No strided CMSIS-DSP function: the pre-computed mean is used on all platforms. */
+        double acc = 0;
+        for (uint32_t i = 0; i < srcLen; ++i, ptrSrc += stride) {
+            acc += (*ptrSrc - mean) * (*ptrSrc - mean);
+        }
+        return sqrtf(acc/srcLen);
+    }
+
     void MathUtils::FftInitF32(const uint16_t fftLen,
                                FftInstance& fftInstance,
                                const FftType type)
@@ -121,11 +243,85 @@ namespace math {
         fftInstance.m_initialised = true;
     }
 
-    static void FftRealF32(std::vector<float>& input,
-                           std::vector<float>& fftOutput)
+    static bool IsPowerOfTwo(const size_t len)
+    {
+        return len != 0 && (len & (len - 1)) == 0;
+    }
+
+    /* In place radix-2 FFT of fftLen (a power of 2) interleaved complex numbers. */
+    static void FftRadix2F32(float* data, const size_t fftLen)
     {
-        const size_t inputLength = input.size();
-        const size_t halfLength = input.size() / 2;
+        /* Bit reversal permutation. */
+        for (size_t i = 1, j = 0; i < fftLen; ++i) {
+            size_t bit = fftLen >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(data[2 * i], data[2 * j]);
+                std::swap(data[2 * i + 1], data[2 * j + 1]);
+            }
+        }
+
+        /* Butterflies, one twiddle factor at a time. */
+        for (size_t len = 2; len <= fftLen; len <<= 1) {
+            const size_t half = len >> 1;
+            for (size_t k = 0; k < half; ++k) {
+                const auto angle = static_cast<float>(2 * M_PI * k / len);
+                const float wr = MathUtils::CosineF32(angle);
+                const float wi = -MathUtils::SineF32(angle);
+                for (size_t start = k; start < fftLen; start += len) {
+                    float* a = data + 2 * start;
+                    float* b = data + 2 * (start + half);
+                    const float tr = b[0] * wr - b[1] * wi;
+                    const float ti = b[0] * wi + b[1] * wr;
+                    b[0] = a[0] - tr;
+                    b[1] = a[1] - ti;
+                    a[0] += tr;
+                    a[1] += ti;
+                }
+            }
+        }
+    }
+
+    static void FftRealF32(const float* input, const size_t inputLength,
+                           float* fftOutput)
+    {
+        const size_t halfLength = inputLength / 2;
+
+        if (inputLength >= 4 && IsPowerOfTwo(inputLength)) {
+            /* Even and odd samples as the real and imaginary parts of a half length FFT. */
+            std::copy(input, input + inputLength, fftOutput);
+            FftRadix2F32(fftOutput, halfLength);
+
+            /* Split into the spectrum: X[k] = E[k] + W^k O[k] and X[N/2 - k] = conj(E[k] - W^k O[k]). */
+            const float z0r = fftOutput[0];
+            const float z0i = fftOutput[1];
+            fftOutput[0] = z0r + z0i;
+            fftOutput[1] = z0r - z0i;
+            for (size_t k = 1; k <= halfLength / 2; ++k) {
+                float* zk = fftOutput + 2 * k;
+                float* zj = fftOutput + 2 * (halfLength - k);
+                const float eReal = 0.5f * (zk[0] + zj[0]);
+                const float eImag = 0.5f * (zk[1] - zj[1]);
+                const float oReal = 0.5f * (zk[1] + zj[1]);
+                const float oImag = -0.5f * (zk[0] - zj[0]);
+
+                const auto angle = static_cast<float>(2 * M_PI * k / inputLength);
+                const float wr = MathUtils::CosineF32(angle);
+                const float wi = -MathUtils::SineF32(angle);
+                const float tr = oReal * wr - oImag * wi;
+                const float ti = oReal * wi + oImag * wr;
+
+                /* Arrange output to [real0, realN/2, real1, im1, real2, im2, ...] */
+                zj[0] = eReal - tr;
+                zj[1] = ti - eImag;
+                zk[0] = eReal + tr;
+                zk[1] = eImag + ti;
+            }
+            return;
+        }
 
         fftOutput[0] = 0;
         fftOutput[1] = 0;
@@ -153,10 +349,16 @@ namespace math {
         }
     }
 
-    static void FftComplexF32(std::vector<float>& input,
-                           std::vector<float>& fftOutput)
+    static void FftComplexF32(const float* input, const size_t inputLength,
+                              float* fftOutput)
     {
-        const size_t fftLen = input.size() / 2;
+        const size_t fftLen = inputLength / 2;
+        if (IsPowerOfTwo(fftLen)) {
+            std::copy(input, input + 2 * fftLen, fftOutput);
+            FftRadix2F32(fftOutput, fftLen);
+            return;
+        }
+
         for (size_t k = 0; k < fftLen; k++) {
             float sumReal = 0;
             float sumImag = 0;
@@ -176,15 +378,22 @@ namespace math {
     void MathUtils::FftF32(std::vector<float>& input,
                            std::vector<float>& fftOutput,
                            arm::app::math::FftInstance& fftInstance)
+    {
+        FftF32(input.data(), input.size(), fftOutput.data(), fftOutput.size(), fftInstance);
+    }
+
+    void MathUtils::FftF32(float* input, const uint32_t inputLen,
+                           float* fftOutput, const uint32_t outputLen,
+                           arm::app::math::FftInstance& fftInstance)
     {
         if (!fftInstance.m_initialised) {
             printf_err("FFT uninitialised\n");
             return;
-        } else if (input.size() < fftInstance.m_fftLen) {
-            printf_err("FFT len: %" PRIu16 "; input len: %zu\n",
-                fftInstance.m_fftLen, input.size());
+        } else if (inputLen < fftInstance.m_fftLen) {
+            printf_err("FFT len: %" PRIu16 "; input len: %" PRIu32 "\n",
+                fftInstance.m_fftLen, inputLen);
             return;
-        } else if (fftOutput.size() < input.size()) {
+        } else if (outputLen < inputLen) {
             printf_err("Output vector len insufficient to hold FFTs\n");
             return;
         }
@@ -194,26 +403,27 @@ namespace math {
 
 #if (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
             if (fftInstance.m_optimisedOptionAvailable) {
-                arm_rfft_fast_f32(&fftInstance.m_instanceReal, input.data(), fftOutput.data(), 0);
+                arm_rfft_fast_f32(&fftInstance.m_instanceReal, input, fftOutput, 0);
                 return;
             }
 #endif /* __ARM_FEATURE_DSP */
-            FftRealF32(input, fftOutput);
+            FftRealF32(input, inputLen, fftOutput);
             return;
 
         case FftType::complex:
-            if (input.size() < fftInstance.m_fftLen * 2) {
+            if (inputLen < fftInstance.m_fftLen * 2u) {
                 printf_err("Complex FFT instance should have input size >= (FFT len x 2)");
                 return;
             }
 #if (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
             if (fftInstance.m_optimisedOptionAvailable) {
-                fftOutput = input; /* Complex function works in-place */
-                arm_cfft_f32(&fftInstance.m_instanceComplex, fftOutput.data(), 0, 1);
+                /* Complex function works in-place */
+                std::copy(input, input + inputLen, fftOutput);
+                arm_cfft_f32(&fftInstance.m_instanceComplex, fftOutput, 0, 1);
                 return;
             }
 #endif /* __ARM_FEATURE_DSP */
-            FftComplexF32(input, fftOutput);
+            FftComplexF32(input, inputLen, fftOutput);
             return;
 
         default:
@@ -225,18 +435,79 @@ namespace math {
     void MathUtils::VecLogarithmF32(std::vector <float>& input,
                                     std::vector <float>& output)
     {
+        VecLogarithmF32(input.data(), output.data(), std::min(input.size(), output.size()));
+    }
+
+    void MathUtils::VecLogarithmF32(const float* input, float* output, const uint32_t len)
+    {
 #if (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
-        arm_vlog_f32(input.data(), output.data(),
-                     output.size());
+        arm_vlog_f32(input, output, len);
 #else  /* __ARM_FEATURE_DSP */
-        for (auto in = input.begin(), out = output.begin();
-             in != input.end() && out != output.end(); ++in, ++out) {
-            *out = logf(*in);
+        for (uint32_t i = 0; i < len; ++i) {
+            output[i] = LogF32Approx(input[i]);
         }
 #endif /* __ARM_FEATURE_DSP */
     }
 
-    float MathUtils::DotProductF32(float* srcPtrA, float* srcPtrB,
+    void MathUtils::VecExpF32(const float* input, float* output, const uint32_t len)
+    {
+#if (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+        arm_vexp_f32(input, output, len);
+#else  /* __ARM_FEATURE_DSP */
+        for (uint32_t i = 0; i < len; ++i) {
+            output[i] = ExpF32Approx(input[i]);
+        }
+#endif /* __ARM_FEATURE_DSP */
+    }
+
+    void MathUtils::VecSigmoidF32(const float* input, float* output, const uint32_t len)
+    {
+        /* 1 / (1 + exp(-x)), in place in the output. */
+        for (uint32_t i = 0; i < len; ++i) {
+            output[i] = -input[i];
+        }
+        VecExpF32(output, output, len);
+        for (uint32_t i = 0; i < len; ++i) {
+            output[i] = 1.f / (1.f + output[i]);
+        }
+    }
+
+    void MathUtils::VecTanhF32(const float* input, float* output, const uint32_t len)
+    {
+        /* Blocks of exp(2|x|), so that the input is still there when the output is written. */
+        constexpr uint32_t blockLen = 64;
+        float exp2x[blockLen];
+
+        for (uint32_t start = 0; start < len; start += blockLen) {
+            const uint32_t count = std::min(blockLen, len - start);
+            const float* in = input + start;
+            float* out = output + start;
+
+            for (uint32_t i = 0; i < count; ++i) {
+                exp2x[i] = 2.f * std::fabs(in[i]);
+            }
+            VecExpF32(exp2x, exp2x, count);
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const float x = in[i];
+                const float ax = std::fabs(x);
+
+                /* Odd polynomial for small inputs, 1 - 2 / (exp(2|x|) + 1) otherwise. */
+                const float z = x * x;
+                float poly = -5.70498872745e-3f;
+                poly = poly * z + 2.06390887954e-2f;
+                poly = poly * z - 5.37397155531e-2f;
+                poly = poly * z + 1.33314422036e-1f;
+                poly = poly * z - 3.33332819422e-1f;
+                poly = poly * z * x + x;
+
+                const float large = 1.f - 2.f / (exp2x[i] + 1.f);
+                out[i] = ax < 0.625f ? poly : (x < 0.f ? -large : large);
+            }
+        }
+    }
+
+    float MathUtils::DotProductF32(const float* srcPtrA, const float* srcPtrB,
                                    const uint32_t srcLen)
     {
         float output = 0.f;
@@ -252,7 +523,89 @@ namespace math {
         return output;
     }
 
-    bool MathUtils::ComplexMagnitudeSquaredF32(float* ptrSrc,
+    float MathUtils::DotProductF32(const float* srcPtrA, const uint32_t strideA,
+                                   const float* srcPtrB, const uint32_t strideB,
+                                   const uint32_t srcLen)
+    {
+        if (strideA == 1 && strideB == 1) {
+            return DotProductF32(srcPtrA, srcPtrB, srcLen);
+        }
+
+        float output = 0.f;
+        for (uint32_t i = 0; i < srcLen; ++i, srcPtrA += strideA, srcPtrB += strideB) {
+            output += *srcPtrA * *srcPtrB;
+        }
+        return output;
+    }
+
+    /* Index of the first largest element of a row: the maximum is a
+     * reduction that vectorises, and finding it again is a short scan. */
+    template<typename T>
+    static inline uint32_t ArgMax(const T* row, const uint32_t len)
+    {
+        T maxVal = std::numeric_limits<T>::lowest();
+        for (uint32_t i = 0; i < len; ++i) {
+            maxVal = std::max(maxVal, row[i]);
+        }
+
+        uint32_t idx = 0;
+        while (idx + 1 < len && row[idx] != maxVal) {
+            ++idx;
+        }
+        return idx;
+    }
+
+    template<typename T>
+    static uint32_t TopK(const T* src, const uint32_t srcLen, const uint32_t k, uint32_t* dst)
+    {
+        if (k == 0 || srcLen == 0) {
+            return 0;
+        } else if (k == 1) {
+            dst[0] = ArgMax(src, srcLen);
+            return 1;
+        }
+
+        /* Insertion into the sorted indices kept so far; k is small for classifiers.
+         * Only strictly larger elements move ahead, keeping lower indices first. */
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < srcLen; ++i) {
+            if (count == k && src[i] <= src[dst[count - 1]]) {
+                continue;
+            }
+            uint32_t pos = count < k ? count++ : count - 1;
+            for (; pos > 0 && src[i] > src[dst[pos - 1]]; --pos) {
+                dst[pos] = dst[pos - 1];
+            }
+            dst[pos] = i;
+        }
+        return count;
+    }
+
+    void MathUtils::RowArgMaxS8(const int8_t* src, const uint32_t numRows, const uint32_t rowLen, uint32_t* dst)
+    {
+        for (uint32_t r = 0; r < numRows; ++r, src += rowLen) {
+            dst[r] = ArgMax(src, rowLen);
+        }
+    }
+
+    void MathUtils::RowArgMaxU8(const uint8_t* src, const uint32_t numRows, const uint32_t rowLen, uint32_t* dst)
+    {
+        for (uint32_t r = 0; r < numRows; ++r, src += rowLen) {
+            dst[r] = ArgMax(src, rowLen);
+        }
+    }
+
+    uint32_t MathUtils::TopKS8(const int8_t* src, const uint32_t srcLen, const uint32_t k, uint32_t* dst)
+    {
+        return TopK(src, srcLen, k, dst);
+    }
+
+    uint32_t MathUtils::TopKU8(const uint8_t* src, const uint32_t srcLen, const uint32_t k, uint32_t* dst)
+    {
+        return TopK(src, srcLen, k, dst);
+    }
+
+    bool MathUtils::ComplexMagnitudeSquaredF32(const float* ptrSrc,
                                                const uint32_t srcLen,
                                                float* ptrDst,
                                                const uint32_t dstLen)
@@ -276,14 +629,24 @@ namespace math {
 
     void MathUtils::SoftmaxF32(std::vector<float>& vec)
     {
+        SoftmaxF32(vec.data(), vec.size());
+    }
+
+    void MathUtils::SoftmaxF32(float* ptrVec, const uint32_t len)
+    {
+        if (!len) {
+            return;
+        }
+
         /* Fix for numerical stability and apply exp. */
-        auto start = vec.begin();
-        auto end = vec.end();
+        float* start = ptrVec;
+        float* end = ptrVec + len;
 
         float maxValue = *std::max_element(start, end);
         for (auto it = start; it != end; ++it) {
-            *it = std::exp((*it) - maxValue);
+            *it -= maxValue;
         }
+        VecExpF32(ptrVec, ptrVec, len);
 
         float sumExp = std::accumulate(start, end, 0.0f);
 
@@ -0,0 +1,451 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AdMelSpectrogram.hpp"
+#include "ImageUtils.hpp"
+#include "Mfcc.hpp"
+#include "PlatformMath.hpp"
+#include "RNNoiseFeatureProcessor.hpp"
+#include "Wav2LetterPreprocess.hpp"
+#include "hal.h"
+#include "log_macros.h"
+
+#if defined(IPC_QUEUE_BENCHMARKS)
+#include "ipc_queue.h"
+#endif /* IPC_QUEUE_BENCHMARKS */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using arm::app::math::FftInstance;
+using arm::app::math::FftType;
+using arm::app::math::MathUtils;
+using arm::app::audio::AdMelSpectrogram;
+using arm::app::audio::MFCC;
+using arm::app::audio::MfccParams;
+using arm::app::image::FrameChangeDetector;
+using arm::app::rnn::RNNoiseFeatureProcessor;
+
+namespace {
+
+    /* Gives access to the per window steps of the ASR pre-processing. */
+    class AsrPreProcessSteps : public arm::app::AsrPreProcess {
+    public:
+        using AsrPreProcess::ComputeDeltas;
+    };
+
+    /* Repetitions of each benchmark; the mean and the minimum over them are reported. */
+    constexpr uint32_t ms_repetitions = 5;
+
+    /* Keeps the results alive so that the calls benchmarked are not optimised away. */
+    volatile float ms_sink = 0;
+
+    /**
+     * Counter the benchmarks are timed with: CPU cycles on targets (which
+     * needs CPU_PROFILE_ENABLED), time on the native platform.
+     */
+    struct Counter {
+        uint32_t    index{0};
+        const char* name{nullptr};
+        const char* unit{nullptr};
+
+        bool Init()
+        {
+            pmu_counters counters{};
+            hal_pmu_get_counters(&counters);
+            for (const char* wanted : {"CPU TOTAL", "Duration"}) {
+                for (uint32_t i = 0; i < counters.num_counters; ++i) {
+                    if (counters.counters[i].name && 0 == std::strcmp(counters.counters[i].name, wanted)) {
+                        this->index = i;
+                        this->name = counters.counters[i].name;
+                        this->unit = counters.counters[i].unit;
+                        return true;
+                    }
+                }
+            }
+            printf_err("No CPU counter available, is CPU_PROFILE_ENABLED set?\n");
+            return false;
+        }
+
+        uint64_t Read() const
+        {
+            pmu_counters counters{};
+            hal_pmu_get_counters(&counters);
+            return counters.counters[this->index].value;
+        }
+    };
+
+    Counter ms_counter;
+    const char* ms_separator = "";
+
+    /**
+     * Times `iterations` calls of fn(i), ms_repetitions times, and prints the
+     * per call mean and minimum as one entry of the "benchmarks" JSON array.
+     */
+    template <typename Fn>
+    void Run(const char* name, uint32_t size, uint32_t iterations, Fn fn)
+    {
+        double total = 0;
+        uint64_t best = UINT64_MAX;
+        for (uint32_t rep = 0; rep < ms_repetitions; ++rep) {
+            const uint64_t start = ms_counter.Read();
+            for (uint32_t i = 0; i < iterations; ++i) {
+                fn(i);
+            }
+            const uint64_t elapsed = ms_counter.Read() - start;
+            total += elapsed;
+            best = std::min(best, elapsed);
+        }
+
+        printf("%s\n    {\"name\": \"%s\", \"size\": %" PRIu32 ", \"iterations\": %" PRIu32
+               ", \"mean\": %.4f, \"min\": %.4f}",
+               ms_separator, name, size, iterations,
+               total / (static_cast<double>(ms_repetitions) * iterations),
+               static_cast<double>(best) / iterations);
+        ms_separator = ",";
+    }
+
+    /* Deterministic, positive test data in (0, 1]. */
+    std::vector<float> MakeData(size_t size)
+    {
+        std::vector<float> data(size);
+        uint32_t state = 12345;
+        for (auto& value : data) {
+            state = state * 1664525u + 1013904223u;
+            value = static_cast<float>((state >> 8) + 1) / static_cast<float>(1u << 24);
+        }
+        return data;
+    }
+
+    void BenchmarkScalar()
+    {
+        const std::vector<float> data = MakeData(256);
+        const uint32_t iterations = 100000;
+
+        Run("CosineF32", 1, iterations, [&](uint32_t i) {
+            ms_sink = MathUtils::CosineF32(data[i & 255] * 6.28f);
+        });
+        Run("SineF32", 1, iterations, [&](uint32_t i) {
+            ms_sink = MathUtils::SineF32(data[i & 255] * 6.28f);
+        });
+        Run("SqrtF32", 1, iterations, [&](uint32_t i) {
+            ms_sink = MathUtils::SqrtF32(data[i & 255]);
+        });
+        Run("SigmoidF32", 1, iterations, [&](uint32_t i) {
+            ms_sink = MathUtils::SigmoidF32(data[i & 255] * 16.f - 8.f);
+        });
+    }
+
+    void BenchmarkStatistics()
+    {
+        for (const uint32_t size : {40u, 512u}) {
+            std::vector<float> data = MakeData(size);
+            Run("MeanF32", size, 1000, [&](uint32_t) {
+                ms_sink = MathUtils::MeanF32(data.data(), size);
+            });
+            Run("StdDevF32", size, 1000, [&](uint32_t) {
+                ms_sink = MathUtils::StdDevF32(data.data(), size, 0.5f);
+            });
+            std::vector<float> other = MakeData(size);
+            Run("DotProductF32", size, 1000, [&](uint32_t) {
+                ms_sink = MathUtils::DotProductF32(data.data(), other.data(), size);
+            });
+        }
+    }
+
+    void BenchmarkFft()
+    {
+        /* Without CMSIS-DSP the FFT is a radix-2 one for these (power of 2) lengths. */
+        const uint32_t iterations = 100;
+
+        for (const uint16_t size : {256, 512, 1024}) {
+            FftInstance instance;
+            Run("FftInitF32", size, iterations, [&](uint32_t) {
+                MathUtils::FftInitF32(size, instance, FftType::real);
+            });
+
+            std::vector<float> input = MakeData(size);
+            std::vector<float> output(size);
+            Run("FftF32/real", size, iterations, [&](uint32_t) {
+                MathUtils::FftF32(input, output, instance);
+                ms_sink = output[1];
+            });
+
+            FftInstance complexInstance;
+            MathUtils::FftInitF32(size, complexInstance, FftType::complex);
+            std::vector<float> complexInput = MakeData(size * 2);
+            std::vector<float> complexOutput(size * 2);
+            Run("FftF32/complex", size, iterations, [&](uint32_t) {
+                MathUtils::FftF32(complexInput, complexOutput, complexInstance);
+                ms_sink = complexOutput[1];
+            });
+
+            /* Power spectrum of the real FFT output. */
+            std::vector<float> power(size / 2);
+            Run("ComplexMagnitudeSquaredF32", size, 1000, [&](uint32_t) {
+                MathUtils::ComplexMagnitudeSquaredF32(output.data(), size, power.data(), size / 2);
+                ms_sink = power[0];
+            });
+        }
+    }
+
+    void BenchmarkLogarithm()
+    {
+        /* Mel filter bank energies. */
+        for (const uint32_t size : {40u, 128u}) {
+            std::vector<float> input = MakeData(size);
+            std::vector<float> output(size);
+            Run("VecLogarithmF32", size, 1000, [&](uint32_t) {
+                MathUtils::VecLogarithmF32(input, output);
+                ms_sink = output[0];
+            });
+        }
+    }
+
+    void BenchmarkArgMax()
+    {
+        /* Wav2Letter output (time steps by letters), then keyword spotting scores. */
+        std::vector<int8_t> output(148 * 29);
+        const std::vector<float> data = MakeData(output.size());
+        for (size_t i = 0; i < output.size(); ++i) {
+            output[i] = static_cast<int8_t>(data[i] * 255.f - 128.f);
+        }
+
+        std::vector<uint32_t> indices(148);
+        Run("RowArgMaxS8", 148 * 29, 1000, [&](uint32_t) {
+            MathUtils::RowArgMaxS8(output.data(), 148, 29, indices.data());
+            ms_sink = indices[0];
+        });
+        Run("TopKS8", 12, 1000, [&](uint32_t i) {
+            MathUtils::TopKS8(output.data() + (i & 255), 12, 3, indices.data());
+            ms_sink = indices[0];
+        });
+    }
+
+    void BenchmarkActivations()
+    {
+        /* From a GRU layer to a detector output branch. */
+        for (const uint32_t size : {96u, 2535u}) {
+            std::vector<float> input = MakeData(size);
+            for (auto& value : input) {
+                value = value * 16.f - 8.f;
+            }
+            std::vector<float> output(size);
+            Run("VecExpF32", size, 100, [&](uint32_t) {
+                MathUtils::VecExpF32(input.data(), output.data(), size);
+                ms_sink = output[0];
+            });
+            Run("VecSigmoidF32", size, 100, [&](uint32_t) {
+                MathUtils::VecSigmoidF32(input.data(), output.data(), size);
+                ms_sink = output[0];
+            });
+            Run("VecTanhF32", size, 100, [&](uint32_t) {
+                MathUtils::VecTanhF32(input.data(), output.data(), size);
+                ms_sink = output[0];
+            });
+        }
+    }
+
+    void BenchmarkSoftmax()
+    {
+        /* From keyword spotting to image classification outputs. */
+        for (const uint32_t size : {12u, 35u, 1001u}) {
+            /* Applied in place over and over: the cost does not depend on the values. */
+            std::vector<float> scores = MakeData(size);
+            Run("SoftmaxF32", size, 1000, [&](uint32_t) {
+                MathUtils::SoftmaxF32(scores);
+                ms_sink = scores[0];
+            });
+        }
+    }
+
+    void BenchmarkKwsFeatures()
+    {
+        /* One MFCC vector of keyword spotting (MicroNet parameters): an audio
+         * stride of the KWS use case costs stride / 320 of these. */
+        const uint32_t frameLen = 640;
+        const uint32_t numFeatures = 10;
+        MFCC mfcc{MfccParams(16000, 40, 20, 4000, numFeatures, frameLen, true)};
+        mfcc.Init();
+
+        const std::vector<float> data = MakeData(frameLen);
+        std::vector<int16_t> audio(frameLen);
+        for (size_t i = 0; i < frameLen; ++i) {
+            audio[i] = static_cast<int16_t>(data[i] * 16000.f - 8000.f);
+        }
+
+        std::vector<float> features(numFeatures);
+        Run("MfccCompute/kws", frameLen, 100, [&](uint32_t) {
+            mfcc.MfccCompute(audio.data(), frameLen, features.data());
+            ms_sink = features[0];
+        });
+        std::vector<int8_t> quantised(numFeatures);
+        Run("MfccComputeQuant/kws", frameLen, 100, [&](uint32_t) {
+            mfcc.MfccComputeQuant<int8_t>(audio.data(), frameLen, 0.5f, 0, quantised.data());
+            ms_sink = quantised[0];
+        });
+    }
+
+    void BenchmarkAsrFeatures()
+    {
+        /* The deltas of an ASR window: 13 MFCC features over 296 frames. */
+        const uint32_t numFeatures = 13;
+        const uint32_t numFrames = 296;
+        arm::app::Array2d<float> mfcc(numFeatures, numFrames);
+        arm::app::Array2d<float> delta1(numFeatures, numFrames);
+        arm::app::Array2d<float> delta2(numFeatures, numFrames);
+        const std::vector<float> data = MakeData(mfcc.totalSize());
+        std::transform(data.begin(), data.end(), mfcc.begin(), [](float value) {
+            return value * 40.f - 20.f;
+        });
+
+        Run("ComputeDeltas/asr", numFeatures * numFrames, 100, [&](uint32_t) {
+            AsrPreProcessSteps::ComputeDeltas(mfcc, delta1, delta2);
+            ms_sink = delta1(0, 4);
+        });
+    }
+
+    void BenchmarkAdFeatures()
+    {
+        /* One log MEL frame of anomaly detection: the pre-processing computes
+         * one per 512 sample stride, and reuses the others of the window. */
+        const uint32_t frameLen = 1024;
+        AdMelSpectrogram melSpec{frameLen};
+        melSpec.Init();
+
+        const std::vector<float> data = MakeData(frameLen);
+        std::vector<int16_t> audio(frameLen);
+        for (size_t i = 0; i < frameLen; ++i) {
+            audio[i] = static_cast<int16_t>(data[i] * 16000.f - 8000.f);
+        }
+
+        Run("ComputeMelEnergies/ad", frameLen, 100, [&](uint32_t) {
+            ms_sink = melSpec.ComputeMelEnergies(audio.data(), frameLen)[0];
+        });
+    }
+
+    void BenchmarkNoiseReduction()
+    {
+        /* One 512 sample frame of noise reduction, around the RNNoise model:
+         * 48 kHz audio needs one every 10.7 ms. */
+        const uint32_t size = RNNoiseFeatureProcessor::FRAME_SIZE;
+        const std::vector<float> data = MakeData(2 * size);
+        std::vector<float> audio(2 * size);
+        for (size_t i = 0; i < audio.size(); ++i) {
+            audio[i] = data[i] * 16000.f - 8000.f;
+        }
+        const std::vector<float> gains = MakeData(RNNoiseFeatureProcessor::NB_BANDS);
+
+        RNNoiseFeatureProcessor processor;
+        arm::app::rnn::FrameFeatures features;
+        std::vector<float> denoised(size);
+        Run("RNNoisePreprocessFrame", size, 100, [&](uint32_t i) {
+            processor.PreprocessFrame(audio.data() + (i & 1) * size, size, features);
+            ms_sink = features.m_featuresVec[0];
+        });
+        Run("RNNoisePostProcessFrame", size, 100, [&](uint32_t) {
+            processor.PostProcessFrame(gains.data(), features, denoised.data());
+            ms_sink = denoised[0];
+        });
+    }
+
+    void BenchmarkFrameChange()
+    {
+        /* A 224x224 RGB camera frame, checked against a reference differing by sensor noise. */
+        const uint32_t size = 224 * 224 * 3;
+        const std::vector<float> data = MakeData(size);
+        std::vector<uint8_t> frame(size);
+        std::vector<uint8_t> noisy(size);
+        for (size_t i = 0; i < size; ++i) {
+            frame[i] = static_cast<uint8_t>(data[i] * 200.f + 20.f);
+            noisy[i] = frame[i] + (i % 5) - 2;
+        }
+
+        Run("SumAbsDiffU8", size, 100, [&](uint32_t) {
+            ms_sink = arm::app::image::SumAbsDiffU8(frame.data(), noisy.data(), size);
+        });
+
+        /* The gate run ahead of an image classification inference. */
+        FrameChangeDetector detector{224, 224, 3, 4.f, 0};
+        detector.HasChanged(frame.data());
+        Run("FrameChangeDetector", size, 100, [&](uint32_t) {
+            ms_sink = detector.HasChanged(noisy.data());
+        });
+    }
+
+#if defined(IPC_QUEUE_BENCHMARKS)
+    void BenchmarkIpcQueue()
+    {
+        /* An audio block handed over and taken back, on one core: the cost
+         * of the queue and of the platform doorbell, without the wait. */
+        const ipc_doorbell* db = platform_ipc_doorbell();
+        static ipc_queue queue;
+        alignas(IPC_QUEUE_LINE_SIZE) static int16_t block[256];
+        ipc_queue_init(&queue, db);
+
+        ipc_msg msg{1, 0, reinterpret_cast<uintptr_t>(block), sizeof(block)};
+        Run("IpcQueuePushPop", sizeof(block), 1000, [&](uint32_t i) {
+            msg.arg = i;
+            ipc_queue_push(&queue, &msg, db);
+            ipc_queue_pop(&queue, &msg, db);
+            ms_sink = msg.arg;
+        });
+    }
+#endif /* IPC_QUEUE_BENCHMARKS */
+
+} /* namespace */
+
+/*
+ * Microbenchmarks of the MathUtils functions, and of the per frame kernels of
+ * the use cases built on them, over the sizes the use cases run them with. Results are printed as JSON (see scripts/py/compare_math_benchmarks.py).
+ */
+int main()
+{
+    if (!hal_platform_init()) {
+        printf_err("Failed to initialise platform\n");
+        return 1;
+    }
+    hal_pmu_init();
+    if (!ms_counter.Init()) {
+        return 1;
+    }
+
+    printf("{\n  \"counter\": \"%s\",\n  \"unit\": \"%s\",\n  \"repetitions\": %" PRIu32
+           ",\n  \"benchmarks\": [",
+           ms_counter.name, ms_counter.unit, ms_repetitions);
+
+    BenchmarkScalar();
+    BenchmarkStatistics();
+    BenchmarkFft();
+    BenchmarkLogarithm();
+    BenchmarkArgMax();
+    BenchmarkActivations();
+    BenchmarkSoftmax();
+    BenchmarkKwsFeatures();
+    BenchmarkAsrFeatures();
+    BenchmarkAdFeatures();
+    BenchmarkNoiseReduction();
+    BenchmarkFrameChange();
+#if defined(IPC_QUEUE_BENCHMARKS)
+    BenchmarkIpcQueue();
+#endif /* IPC_QUEUE_BENCHMARKS */
+
+    printf("\n  ]\n}\n");
+    return 0;
+}
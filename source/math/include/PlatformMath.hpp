@@ -53,7 +53,10 @@ namespace math {
      * This will allow other classes, functions to be independent of
      * #if definition checks and provide a cleaner API. Also, it will
      * consolidate all arm math functions used in one place and make
-     * them easier to test. */
+     * them easier to test.
+     * Vector functions take a pointer and a length, so that tensor memory
+     * and static buffers can be used directly; the std::vector overloads
+     * are convenience wrappers. */
     class MathUtils {
 
     public:
@@ -84,7 +87,17 @@ namespace math {
          * @param[in]   srcLen   Number of elements in the array/vector.
          * @return      Average value.
          */
-        static float MeanF32(float* ptrSrc, uint32_t srcLen);
+        static float MeanF32(const float* ptrSrc, uint32_t srcLen);
+
+        /**
+         * @brief       Gets the mean of every stride-th element of a floating
+         *              point array, eg of a column of a row major matrix.
+         * @param[in]   ptrSrc   Pointer to the first element.
+         * @param[in]   srcLen   Number of elements to average.
+         * @param[in]   stride   Distance between two elements, 1 if contiguous.
+         * @return      Average value.
+         */
+        static float MeanF32(const float* ptrSrc, uint32_t srcLen, uint32_t stride);
 
         /**
          * @brief       Gets the standard deviation of a floating point array
@@ -94,9 +107,21 @@ namespace math {
          * @param[in]   mean     Pre-computed mean value.
          * @return      Standard deviation value.
          */
-        static float StdDevF32(float* ptrSrc, uint32_t srcLen,
+        static float StdDevF32(const float* ptrSrc, uint32_t srcLen,
                                float mean);
 
+        /**
+         * @brief       Gets the standard deviation of every stride-th element
+         *              of a floating point array.
+         * @param[in]   ptrSrc   Pointer to the first element.
+         * @param[in]   srcLen   Number of elements.
+         * @param[in]   stride   Distance between two elements, 1 if contiguous.
+         * @param[in]   mean     Pre-computed mean value.
+         * @return      Standard deviation value.
+         */
+        static float StdDevF32(const float* ptrSrc, uint32_t srcLen,
+                               uint32_t stride, float mean);
+
         /**
          * @brief       Initialises the internal FFT structures (if available
          *              for the platform). This function should be called
@@ -119,6 +144,20 @@ namespace math {
                            std::vector<float>& fftOutput,
                            FftInstance& fftInstance);
 
+        /**
+         * @brief       Computes the FFT for the input array.
+         * @param[in]   input       Input elements; may be modified by the
+         *                          optimised real FFT.
+         * @param[in]   inputLen    Number of input elements, at least the FFT
+         *                          length (twice that for a complex FFT).
+         * @param[out]  fftOutput   Output buffer to be populated by computed FFTs.
+         * @param[in]   outputLen   Output buffer length, at least inputLen.
+         * @param[in]   fftInstance FFT instance struct to use.
+         */
+        static void FftF32(float* input, uint32_t inputLen,
+                           float* fftOutput, uint32_t outputLen,
+                           FftInstance& fftInstance);
+
         /**
          * @brief       Computes the natural logarithms of input floating point
          *              vector
@@ -129,6 +168,47 @@ namespace math {
         static void VecLogarithmF32(std::vector<float>& input,
                                     std::vector<float>& output);
 
+        /**
+         * @brief       Computes the natural logarithms of a floating point
+         *              array. Without CMSIS-DSP, a polynomial approximation
+         *              with a relative error below 2e-7 is used; zero gives
+         *              -inf and negative values NaN.
+         * @param[in]   input    Input elements.
+         * @param[out]  output   Output buffer, which can be the input one.
+         * @param[in]   len      Number of elements.
+         */
+        static void VecLogarithmF32(const float* input, float* output, uint32_t len);
+
+        /**
+         * @brief       Computes the exponentials of a floating point array.
+         *              Without CMSIS-DSP, a polynomial approximation with a
+         *              relative error below 3e-7 is used; inputs below -87.3
+         *              give 0 and results saturate at exp(88) instead of overflowing.
+         * @param[in]   input    Input elements.
+         * @param[out]  output   Output buffer, which can be the input one.
+         * @param[in]   len      Number of elements.
+         */
+        static void VecExpF32(const float* input, float* output, uint32_t len);
+
+        /**
+         * @brief       Computes the sigmoid of a floating point array, from
+         *              VecExpF32 (absolute error below 1e-7).
+         * @param[in]   input    Input elements.
+         * @param[out]  output   Output buffer, which can be the input one.
+         * @param[in]   len      Number of elements.
+         */
+        static void VecSigmoidF32(const float* input, float* output, uint32_t len);
+
+        /**
+         * @brief       Computes the hyperbolic tangent of a floating point
+         *              array: a polynomial below 0.625 in magnitude, from
+         *              VecExpF32 above (absolute error below 3e-7).
+         * @param[in]   input    Input elements.
+         * @param[out]  output   Output buffer, which can be the input one.
+         * @param[in]   len      Number of elements.
+         */
+        static void VecTanhF32(const float* input, float* output, uint32_t len);
+
         /**
          * @brief       Computes the dot product of two 1D floating point
          *              vectors.
@@ -140,20 +220,66 @@ namespace math {
          * @param[in]   srcLen    Number of elements in the array/vector.
          * @return      Dot product.
          */
-        static float DotProductF32(float* srcPtrA, float* srcPtrB,
+        static float DotProductF32(const float* srcPtrA, const float* srcPtrB,
                                    uint32_t srcLen);
 
+        /**
+         * @brief       Computes the dot product of two strided floating point
+         *              arrays, eg a row and a column of matrices.
+         *              result = sum(srcA[0]*srcB[0] + srcA[strideA]*srcB[strideB] + ..)
+         * @param[in]   srcPtrA   Pointer to the first element of first array.
+         * @param[in]   strideA   Distance between two elements of the first array.
+         * @param[in]   srcPtrB   Pointer to the first element of second array.
+         * @param[in]   strideB   Distance between two elements of the second array.
+         * @param[in]   srcLen    Number of elements to multiply.
+         * @return      Dot product.
+         */
+        static float DotProductF32(const float* srcPtrA, uint32_t strideA,
+                                   const float* srcPtrB, uint32_t strideB,
+                                   uint32_t srcLen);
+
+        /**
+         * @brief       Gets the index of the largest element of each row of a
+         *              row major int8 matrix, the first one if several are
+         *              equal, as classifiers of sequences need for every
+         *              time step of their output.
+         * @param[in]   src       Matrix, numRows x rowLen.
+         * @param[in]   numRows   Number of rows.
+         * @param[in]   rowLen    Number of elements in each row.
+         * @param[out]  dst       Index of the largest element of each row.
+         */
+        static void RowArgMaxS8(const int8_t* src, uint32_t numRows, uint32_t rowLen, uint32_t* dst);
+
+        /** @brief  As above, for a uint8 matrix. */
+        static void RowArgMaxU8(const uint8_t* src, uint32_t numRows, uint32_t rowLen, uint32_t* dst);
+
+        /**
+         * @brief       Gets the indices of the k largest elements of an int8
+         *              array, largest first, and lowest index first among
+         *              equal elements.
+         * @param[in]   src      Array.
+         * @param[in]   srcLen   Number of elements in the array.
+         * @param[in]   k        Number of indices wanted.
+         * @param[out]  dst      Indices, room for k of them.
+         * @return      Number of indices written, the lower of k and srcLen.
+         */
+        static uint32_t TopKS8(const int8_t* src, uint32_t srcLen, uint32_t k, uint32_t* dst);
+
+        /** @brief  As above, for a uint8 array. */
+        static uint32_t TopKU8(const uint8_t* src, uint32_t srcLen, uint32_t k, uint32_t* dst);
+
         /**
          * @brief       Computes the squared magnitude of floating point
          *              complex number array.
          * @param[in]   ptrSrc   Pointer to the first element of input
          *                       array.
          * @param[in]   srcLen   Number of elements in the array/vector.
-         * @param[out]  ptrDst   Output buffer to be populated.
+         * @param[out]  ptrDst   Output buffer to be populated, which can be
+         *                       the input one.
          * @param[in]   dstLen   Output buffer len (for sanity check only).
          * @return      true if successful, false otherwise.
          */
-        static bool ComplexMagnitudeSquaredF32(float* ptrSrc,
+        static bool ComplexMagnitudeSquaredF32(const float* ptrSrc,
                                                uint32_t srcLen,
                                                float* ptrDst,
                                                uint32_t dstLen);
@@ -165,6 +291,14 @@ namespace math {
         */
         static void SoftmaxF32(std::vector<float>& vec);
 
+        /**
+        * @brief       Scales output scores for an arbitrary number of classes so
+        *              that they sum to 1, in place.
+        * @param[in]   ptrVec   Pointer to the first score.
+        * @param[in]   len      Number of scores.
+        */
+        static void SoftmaxF32(float* ptrVec, uint32_t len);
+
         /**
         * @brief       Calculate the Sigmoid function of the given value.
         * @param[in]   x   Value to apply Sigmoid to.
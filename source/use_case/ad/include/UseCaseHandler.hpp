@@ -28,6 +28,17 @@ namespace app {
      * @return      True or false based on execution success
      **/
     bool ClassifyVibrationHandler(ApplicationContext& ctx, uint32_t dataIndex, bool runAll);
+
+    /**
+     * @brief       Handles streaming anomaly detection: the anomaly score is
+     *              smoothed window by window and a recording is classified as
+     *              soon as its score is conclusive, skipping its remaining
+     *              windows. Live audio, where available, is monitored
+     *              continuously, logging timestamped anomaly events.
+     * @param[in]   ctx   pointer to the application context
+     * @return      True or false based on execution success
+     **/
+    bool ClassifyVibrationStreamHandler(ApplicationContext& ctx);
 } /* namespace app */
 } /* namespace arm */
 #endif /* AD_EVT_HANDLER_H */
\ No newline at end of file
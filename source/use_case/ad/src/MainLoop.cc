@@ -37,7 +37,8 @@ enum opcodes
     MENU_OPT_RUN_INF_CHOSEN,         /* Run on a user provided vector index */
     MENU_OPT_RUN_INF_ALL,            /* Run inference on all */
     MENU_OPT_SHOW_MODEL_INFO,        /* Show model info */
-    MENU_OPT_LIST_AUDIO_CLIPS        /* List the current baked audio signals */
+    MENU_OPT_LIST_AUDIO_CLIPS,       /* List the current baked audio signals */
+    MENU_OPT_RUN_STREAM              /* Stream audio with early decisions */
 };
 
 static void DisplayMenu()
@@ -49,7 +50,8 @@ static void DisplayMenu()
     printf("  %u. Classify audio signal at chosen index\n", MENU_OPT_RUN_INF_CHOSEN);
     printf("  %u. Run classification on all audio signals\n", MENU_OPT_RUN_INF_ALL);
     printf("  %u. Show NN model info\n", MENU_OPT_SHOW_MODEL_INFO);
-    printf("  %u. List audio signals\n\n", MENU_OPT_LIST_AUDIO_CLIPS);
+    printf("  %u. List audio signals\n", MENU_OPT_LIST_AUDIO_CLIPS);
+    printf("  %u. Run streaming anomaly detection\n\n", MENU_OPT_RUN_STREAM);
     printf("  Choice: ");
     fflush(stdout);
 }
@@ -67,6 +69,9 @@ void main_loop()
         return;
     }
 
+    /* Lets the NPU cache maintenance tell the model's tensors and arena apart. */
+    arm::app::RegisterNpuCacheRegions(model, arm::app::tensorArena, sizeof(arm::app::tensorArena));
+
     /* Instantiate application context. */
     arm::app::ApplicationContext caseContext;
 
@@ -121,6 +126,9 @@ void main_loop()
             case MENU_OPT_LIST_AUDIO_CLIPS:
                 executionSuccessful = ListFilesHandler(caseContext);
                 break;
+            case MENU_OPT_RUN_STREAM:
+                executionSuccessful = ClassifyVibrationStreamHandler(caseContext);
+                break;
             default:
                 printf("Incorrect choice, try again.");
                 break;
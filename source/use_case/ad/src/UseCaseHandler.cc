@@ -17,6 +17,7 @@
 #include "UseCaseHandler.hpp"
 
 #include "AdMelSpectrogram.hpp"
+#include "AdDetector.hpp"
 #include "AdModel.hpp"
 #include "AdProcessing.hpp"
 #include "AudioUtils.hpp"
@@ -27,6 +28,17 @@
 #include "hal.h"
 #include "log_macros.h"
 
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if !defined(AD_LIVE_AUDIO) && (defined(__unix__) || defined(__APPLE__))
+#define AD_WAV_STREAM
+#include "WavFile.hpp"
+
+#include <cstdlib>
+#endif /* !defined(AD_LIVE_AUDIO) && (defined(__unix__) || defined(__APPLE__)) */
+
 namespace arm {
 namespace app {
 
@@ -47,6 +59,115 @@ namespace app {
      **/
     static int8_t OutputIndexFromFileName(std::string wavFileName);
 
+    /** @brief      Given a machine ID, e.g. 0, 2, 4 or 6, return AD model output index.
+     *  @param[in]  machineIdx  Machine ID.
+     *  @return     AD model output index as 8 bit integer, -1 if the ID is unknown.
+     **/
+    static int8_t OutputIndexFromMachineId(int machineIdx);
+
+    /* Audio sample rate the model is trained for, in Hz. */
+    constexpr uint32_t ms_sampleRate = audio::AdMelSpectrogram::ms_defaultSamplingFreq;
+
+#if defined(AD_LIVE_AUDIO)
+    /* Windows the mean score is taken over when monitoring live audio. */
+    constexpr uint32_t ms_liveMeanWindows = 1024;
+#endif /* defined(AD_LIVE_AUDIO) */
+
+    /* Pipeline running each window of a stream. */
+    struct AdStreamPipeline {
+        Model&          m_model;
+        Profiler&       m_profiler;
+        AdPreProcess&   m_preProcess;
+        AdPostProcess&  m_postProcess;
+
+        /**
+         * @brief       Runs one window.
+         * @param[in]   window          Audio of the window.
+         * @param[in]   windowIdx       Index of the window in its stream, for the feature reuse.
+         * @param[in]   outputIdx       Model output of the machine.
+         * @param[out]  score           Anomaly score of the window.
+         * @return      true if successful, false otherwise.
+         **/
+        bool Run(const int16_t* window, uint32_t windowIdx, int8_t outputIdx, float& score)
+        {
+            this->m_preProcess.SetAudioWindowIndex(windowIdx);
+            if (!this->m_preProcess.DoPreProcess(window, this->m_preProcess.GetAudioWindowSize())) {
+                return false;
+            }
+            if (!RunInference(this->m_model, this->m_profiler)) {
+                return false;
+            }
+            if (!this->m_postProcess.DoPostProcess()) {
+                return false;
+            }
+            score = 0 - this->m_postProcess.GetOutputValue(outputIdx);
+            return true;
+        }
+    };
+
+    static void LogEvent(const ad::AdEvent& event)
+    {
+        info("%.2f s: anomaly %s (score %f)\n", event.m_timeStamp,
+             event.m_anomalous ? "detected" : "over", event.m_score);
+    }
+
+    /**
+     * @brief           Classifies a recording window by window, stopping as
+     *                  soon as the anomaly score is conclusive.
+     * @param[in,out]   pipeline    Window pipeline.
+     * @param[in,out]   detector    Decision engine.
+     * @param[in]       audio       Recording.
+     * @param[in]       audioLen    Number of samples.
+     * @param[in]       outputIdx   Model output of the machine.
+     * @param[in]       threshold   Anomaly score threshold.
+     * @param[in,out]   windowsRun  Incremented by the number of windows run.
+     * @param[in,out]   windowsAll  Incremented by the number of windows of the recording.
+     * @return          true if successful, false otherwise.
+     **/
+    static bool StreamRecording(AdStreamPipeline& pipeline, ad::AdDetector& detector,
+                                const int16_t* audio, size_t audioLen, int8_t outputIdx, float threshold,
+                                uint32_t& windowsRun, uint32_t& windowsAll)
+    {
+        const uint32_t windowSize = pipeline.m_preProcess.GetAudioWindowSize();
+        const uint32_t stride = pipeline.m_preProcess.GetAudioDataStride();
+        auto audioDataSlider = audio::SlidingWindow<const int16_t>(audio, audioLen, windowSize, stride);
+        const uint32_t numWindows = audioDataSlider.TotalStrides() + 1;
+        if (audioLen < windowSize) {
+            printf_err("Recording shorter than a window: %zu < %" PRIu32 " samples\n", audioLen, windowSize);
+            return false;
+        }
+
+        detector.Reset();
+        while (audioDataSlider.HasNext()) {
+            const int16_t* inferenceWindow = audioDataSlider.Next();
+            const uint32_t windowIdx = audioDataSlider.Index();
+
+            float score = 0;
+            if (!pipeline.Run(inferenceWindow, windowIdx, outputIdx, score)) {
+                return false;
+            }
+
+            const float timeStamp = static_cast<float>(windowIdx * stride + windowSize) / ms_sampleRate;
+            if (detector.Update(score, timeStamp)) {
+                LogEvent(detector.GetLastEvent());
+            }
+            if (detector.GetDecision() != ad::AdDecision::undecided) {
+                break;
+            }
+        }
+
+        const uint32_t windowsDone = detector.GetWindowCount();
+        windowsRun += windowsDone;
+        windowsAll += numWindows;
+
+        /* Inconclusive to the end: decided on the mean score, as the whole clip classification is. */
+        const bool conclusive = detector.GetDecision() != ad::AdDecision::undecided;
+        info("Decided after %" PRIu32 " of %" PRIu32 " windows%s\n", windowsDone, numWindows,
+             conclusive ? "" : " (inconclusive)");
+        return PresentInferenceResult(conclusive ? detector.GetSmoothedScore() : detector.GetMeanScore(),
+                                      threshold);
+    }
+
     /* Anomaly Detection inference handler */
     bool ClassifyVibrationHandler(ApplicationContext& ctx, uint32_t clipIndex, bool runAll)
     {
@@ -161,6 +282,161 @@ namespace app {
         return true;
     }
 
+#if defined(AD_LIVE_AUDIO)
+    /**
+     * @brief           Monitors live audio from the HAL audio source, forever.
+     * @param[in,out]   pipeline    Window pipeline.
+     * @param[in,out]   detector    Decision engine.
+     * @param[in]       outputIdx   Model output of the machine.
+     * @return          false on error.
+     **/
+    static bool MonitorLiveAudio(AdStreamPipeline& pipeline, ad::AdDetector& detector, int8_t outputIdx)
+    {
+        const uint32_t windowSize = pipeline.m_preProcess.GetAudioWindowSize();
+        const uint32_t stride = pipeline.m_preProcess.GetAudioDataStride();
+
+        /* A stride of audio is captured while the window ending with the previous one is processed. */
+        std::vector<int16_t> window(windowSize, 0);
+        std::vector<int16_t> captureBuf(2 * stride);
+        static bool audioInited;
+
+        if (!audioInited) {
+            int err = hal_audio_init(ms_sampleRate, 32);
+            if (err) {
+                printf_err("hal_audio_init failed with error: %d\n", err);
+                return false;
+            }
+            audioInited = true;
+        }
+
+        info("Monitoring live audio, machine output %d\n", outputIdx);
+        size_t current = 0;
+        hal_get_audio_data(captureBuf.data(), stride);
+
+        uint64_t numSamples = 0;
+        uint32_t windowIdx = 0;
+        while (true) {
+            int err = hal_wait_for_audio();
+            if (err) {
+                printf_err("hal_get_audio_data failed with error: %d\n", err);
+                return false;
+            }
+
+            const size_t next = current ^ 1;
+            hal_get_audio_data(captureBuf.data() + next * stride, stride);
+
+            /* Slide the window by one stride, so that the features of the overlap are reused. */
+            int16_t* chunk = captureBuf.data() + current * stride;
+            hal_audio_preprocessing(chunk, stride);
+            std::memmove(window.data(), window.data() + stride, (windowSize - stride) * sizeof(int16_t));
+            std::memcpy(window.data() + windowSize - stride, chunk, stride * sizeof(int16_t));
+            numSamples += stride;
+            current = next;
+
+            if (numSamples < windowSize) {
+                continue;
+            }
+
+            float score = 0;
+            if (!pipeline.Run(window.data(), windowIdx++, outputIdx, score)) {
+                return false;
+            }
+            if (detector.Update(score, static_cast<float>(numSamples) / ms_sampleRate)) {
+                LogEvent(detector.GetLastEvent());
+            }
+        }
+    }
+#endif /* defined(AD_LIVE_AUDIO) */
+
+    /* Anomaly Detection streaming handler */
+    bool ClassifyVibrationStreamHandler(ApplicationContext& ctx)
+    {
+        auto& model = ctx.Get<Model&>("model");
+        if (!model.IsInited()) {
+            printf_err("Model is not initialised! Terminating processing.\n");
+            return false;
+        }
+
+        auto& profiler                = ctx.Get<Profiler&>("profiler");
+        const auto melSpecFrameLength = ctx.Get<uint32_t>("frameLength");
+        const auto melSpecFrameStride = ctx.Get<uint32_t>("frameStride");
+        const auto scoreThreshold     = ctx.Get<float>("scoreThreshold");
+        const auto trainingMean       = ctx.Get<float>("trainingMean");
+
+        AdPreProcess preProcess{model.GetInputTensor(0), melSpecFrameLength, melSpecFrameStride, trainingMean};
+        AdPostProcess postProcess{model.GetOutputTensor(0)};
+        AdStreamPipeline pipeline{model, profiler, preProcess, postProcess};
+
+        ad::AdDetectorParams params;
+        params.m_threshold = scoreThreshold;
+#if defined(AD_LIVE_AUDIO)
+        /* Live audio has no end: decisions come from the smoothed score, and
+         * the mean is kept over a bounded number of windows. */
+        params.m_meanWindowLen = ms_liveMeanWindows;
+#endif /* defined(AD_LIVE_AUDIO) */
+        ad::AdDetector detector{params};
+
+#if defined(AD_LIVE_AUDIO)
+        const int8_t outputIdx = OutputIndexFromMachineId(AD_LIVE_MACHINE_ID);
+        if (outputIdx < 0) {
+            return false;
+        }
+        return MonitorLiveAudio(pipeline, detector, outputIdx);
+#else
+        uint32_t windowsRun = 0;
+        uint32_t windowsAll = 0;
+
+#if defined(AD_WAV_STREAM)
+        /* A WAV file named like the clips, eg anomaly_id_02_00000000.wav, can be streamed instead. */
+        const char* inputPath = std::getenv("AD_STREAM_INPUT");
+        if (inputPath) {
+            std::vector<int16_t> input;
+            uint32_t sampleRate = 0;
+            if (!audio::ReadWav(inputPath, input, sampleRate)) {
+                return false;
+            }
+            if (sampleRate != ms_sampleRate) {
+                printf_err("%s is sampled at %" PRIu32 " Hz, %" PRIu32 " Hz expected\n",
+                           inputPath, sampleRate, ms_sampleRate);
+                return false;
+            }
+            const std::string path{inputPath};
+            const int8_t outputIdx = OutputIndexFromFileName(path.substr(path.find_last_of('/') + 1));
+            if (outputIdx < 0) {
+                return false;
+            }
+
+            info("Streaming %s\n", inputPath);
+            if (!StreamRecording(pipeline, detector, input.data(), input.size(), outputIdx,
+                                 scoreThreshold, windowsRun, windowsAll)) {
+                return false;
+            }
+            profiler.PrintProfilingResult();
+            return true;
+        }
+#endif /* defined(AD_WAV_STREAM) */
+
+        /* Each clip is a separate recording. */
+        for (uint32_t clipIdx = 0; clipIdx < NUMBER_OF_FILES; ++clipIdx) {
+            const int8_t outputIdx = OutputIndexFromFileName(GetFilename(clipIdx));
+            if (outputIdx < 0) {
+                return false;
+            }
+
+            info("Streaming audio clip %" PRIu32 " => %s\n", clipIdx, GetFilename(clipIdx));
+            if (!StreamRecording(pipeline, detector, GetAudioArray(clipIdx), GetAudioArraySize(clipIdx),
+                                 outputIdx, scoreThreshold, windowsRun, windowsAll)) {
+                return false;
+            }
+        }
+
+        info("Inferences run: %" PRIu32 " of %" PRIu32 " (%.1f%% saved by early decisions)\n",
+             windowsRun, windowsAll, windowsAll ? 100.f * (windowsAll - windowsRun) / windowsAll : 0.f);
+        profiler.PrintProfilingResult();
+        return true;
+#endif /* defined(AD_LIVE_AUDIO) */
+    }
+
     static bool PresentInferenceResult(float result, float threshold)
     {
         constexpr uint32_t dataPsnTxtStartX1 = 20;
@@ -222,8 +498,11 @@ namespace app {
             return !str.empty() && it == str.end();
         };
 
-        const int8_t machineIdx = is_number(subString) ? std::stoi(subString) : -1;
+        return OutputIndexFromMachineId(is_number(subString) ? std::stoi(subString) : -1);
+    }
 
+    static int8_t OutputIndexFromMachineId(int machineIdx)
+    {
         /* Return corresponding index in the output vector. */
         if (machineIdx == 0) {
             return 0;
@@ -57,6 +57,16 @@ generate_audio_code(${${use_case}_FILE_PATH} ${SRC_GEN_DIR} ${INC_GEN_DIR}
         ${${use_case}_AUDIO_RES_TYPE}
         ${${use_case}_AUDIO_MIN_SAMPLES})
 
+# Live audio monitoring needs the HAL audio source, which only the Ensemble platform has.
+if (TARGET_PLATFORM STREQUAL ensemble)
+    USER_OPTION(${use_case}_LIVE_MACHINE_ID "Specify the ID of the machine monitored from live audio: 0, 2, 4 or 6."
+        0
+        STRING)
+    set(${use_case}_COMPILE_DEFS
+        "AD_LIVE_AUDIO=1"
+        "AD_LIVE_MACHINE_ID=${${use_case}_LIVE_MACHINE_ID}")
+endif()
+
 USER_OPTION(${use_case}_ACTIVATION_BUF_SZ "Activation buffer size for the chosen model"
         0x00200000
         STRING)
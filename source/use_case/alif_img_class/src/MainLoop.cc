@@ -33,6 +33,7 @@
 #include "UseCaseHandler.hpp"       /* Handlers for different user options. */
 #include "UseCaseCommonUtils.hpp"   /* Utils functions. */
 #include "BufAttributes.hpp"        /* Buffer attributes to be applied */
+#include "ImageUtils.hpp"           /* Frame change detection. */
 
 namespace arm {
 namespace app {
@@ -65,6 +66,9 @@ void main_loop()
         printf_err("Failed to initialise model\n");
         return;
     }
+
+    /* Lets the NPU cache maintenance tell the model's tensors and arena apart. */
+    arm::app::RegisterNpuCacheRegions(model, arm::app::tensorArena, sizeof(arm::app::tensorArena));
 #endif
 
     /* Instantiate application context. */
@@ -81,6 +85,17 @@ void main_loop()
     GetLabelsVector(labels);
     caseContext.Set<const std::vector <std::string>&>("labels", labels);
 
+#if !SKIP_MODEL
+    /* Skips inference while the camera is looking at a static scene. */
+    TfLiteIntArray* inputShape = model.GetInputShape(0);
+    arm::app::image::FrameChangeDetector changeDetector{
+        static_cast<uint32_t>(inputShape->data[arm::app::MobileNetModel::ms_inputColsIdx]),
+        static_cast<uint32_t>(inputShape->data[arm::app::MobileNetModel::ms_inputRowsIdx]),
+        static_cast<uint32_t>(inputShape->data[arm::app::MobileNetModel::ms_inputChannelsIdx]),
+        CHANGE_THRESHOLD, MAX_SKIP_FRAMES};
+    caseContext.Set<arm::app::image::FrameChangeDetector&>("changeDetector", changeDetector);
+#endif
+
     /* Loop. */
     do {
         alif::app::ClassifyImageHandler(caseContext);
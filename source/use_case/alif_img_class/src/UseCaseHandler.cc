@@ -106,6 +106,7 @@ namespace app {
 #if !SKIP_MODEL
         auto& profiler = ctx.Get<Profiler&>("profiler");
         auto& model = ctx.Get<Model&>("model");
+        auto& changeDetector = ctx.Get<image::FrameChangeDetector&>("changeDetector");
 
         if (!model.IsInited()) {
             printf_err("Model is not initialised! Terminating processing.\n");
@@ -170,6 +171,16 @@ namespace app {
             return true;
         }
 
+#if !SKIP_MODEL
+        /* Static scene: the results on display are still valid. */
+        if (!changeDetector.HasChanged(image_data)) {
+            debug("Frame unchanged (diff=%.2f), skipping inference\n",
+                  changeDetector.GetLastDifference());
+            lv_led_off(ScreenLayoutLEDObject());
+            return true;
+        }
+#endif
+
         lv_led_on(ScreenLayoutLEDObject());
 
 #if !SKIP_MODEL
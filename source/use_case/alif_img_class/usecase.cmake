@@ -27,7 +27,17 @@
 # Append the API to use for this use case
 list(APPEND ${use_case}_API_LIST "img_class" "alif_ui")
 
-set(${use_case}_COMPILE_DEFS SHOW_PROFILING=0 SKIP_MODEL=0)
+USER_OPTION(${use_case}_CHANGE_THRESHOLD "Mean absolute block difference (0-255) above which a camera frame is deemed changed and inference is run. Set to 0 to run inference on every frame."
+    4.0
+    STRING)
+
+USER_OPTION(${use_case}_MAX_SKIP_FRAMES "Maximum number of consecutive unchanged frames for which inference is skipped. Set to 0 for no limit."
+    30
+    STRING)
+
+set(${use_case}_COMPILE_DEFS SHOW_PROFILING=0 SKIP_MODEL=0
+    "CHANGE_THRESHOLD=${${use_case}_CHANGE_THRESHOLD}"
+    "MAX_SKIP_FRAMES=${${use_case}_MAX_SKIP_FRAMES}")
 
 USER_OPTION(${use_case}_LABELS_TXT_FILE "Labels' txt file for the chosen model"
     ${CMAKE_CURRENT_SOURCE_DIR}/resources/img_class/labels/labels_mobilenet_v2_1.0_224.txt
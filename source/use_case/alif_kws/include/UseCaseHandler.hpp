@@ -31,6 +31,10 @@
 
 #include "AppContext.hpp"
 
+#ifndef AUDIO_STRIDE
+#define AUDIO_STRIDE 8000 /* Audio samples between inferences, 0.5 seconds. */
+#endif /* AUDIO_STRIDE */
+
 namespace alif {
 namespace app {
 
@@ -27,7 +27,7 @@
  * limitations under the License.
  */
 #include "InputFiles.hpp"           /* For input audio clips. */
-#include "KwsClassifier.hpp"        /* Classifier. */
+#include "KwsDetector.hpp"          /* Keyword decision engine. */
 #include "MicroNetKwsModel.hpp"     /* Model class for running inference. */
 #include "hal.h"                    /* Brings in platform definitions. */
 #include "Labels.hpp"               /* For label strings. */
@@ -35,6 +35,19 @@
 #include "UseCaseCommonUtils.hpp"   /* Utils functions. */
 #include "log_macros.h"             /* Logging functions */
 #include "BufAttributes.hpp"        /* Buffer attributes to be applied */
+#include "VoiceActivityDetector.hpp" /* Voice activity gate. */
+
+#ifndef SMOOTHING_WINDOW
+#define SMOOTHING_WINDOW 2
+#endif /* SMOOTHING_WINDOW */
+
+#ifndef REFRACTORY_MS
+#define REFRACTORY_MS 500
+#endif /* REFRACTORY_MS */
+
+#ifndef VAD_HANGOVER_MS
+#define VAD_HANGOVER_MS 1000
+#endif /* VAD_HANGOVER_MS */
 
 namespace arm {
 namespace app {
@@ -62,6 +75,9 @@ void main_loop()
         return;
     }
 
+    /* Lets the NPU cache maintenance tell the model's tensors and arena apart. */
+    arm::app::RegisterNpuCacheRegions(model, arm::app::tensorArena, sizeof(arm::app::tensorArena));
+
     /* Instantiate application context. */
     arm::app::ApplicationContext caseContext;
 
@@ -71,16 +87,35 @@ void main_loop()
     caseContext.Set<int>("frameLength", arm::app::kws::g_FrameLength);
     caseContext.Set<int>("frameStride", arm::app::kws::g_FrameStride);
     caseContext.Set<int>("audioRate", arm::app::kws::g_AudioRate);
-    caseContext.Set<float>("scoreThreshold", arm::app::kws::g_ScoreThreshold);  /* Normalised score threshold. */
 
-    arm::app::KwsClassifier classifier;  /* classifier wrapper object. */
-    caseContext.Set<arm::app::KwsClassifier&>("classifier", classifier);
+#if VAD_HANGOVER_MS >= 0
+    /* Voice activity gate skipping inference for silent strides. */
+    arm::app::audio::VadParams vadParams;
+    vadParams.m_samplingFreq = arm::app::kws::g_AudioRate;
+    vadParams.m_hangoverFrames = (VAD_HANGOVER_MS * arm::app::kws::g_AudioRate / 1000) /
+                                 vadParams.m_frameLen;
+    arm::app::audio::VoiceActivityDetector vad{vadParams};
+    caseContext.Set<arm::app::audio::VoiceActivityDetector&>("vad", vad);
+#endif /* VAD_HANGOVER_MS >= 0 */
 
     std::vector <std::string> labels;
     GetLabelsVector(labels);
 
     caseContext.Set<const std::vector <std::string>&>("labels", labels);
 
+    /* Keyword decision engine, updated once per audio stride. */
+    arm::app::kws::KwsDetectorParams detectorParams;
+    detectorParams.m_smoothingWindowLen = SMOOTHING_WINDOW;
+    detectorParams.m_refractoryStrides = (REFRACTORY_MS * arm::app::kws::g_AudioRate / 1000) / AUDIO_STRIDE;
+    detectorParams.m_defaultThreshold = arm::app::kws::g_ScoreThreshold;  /* Normalised score threshold. */
+    arm::app::kws::KwsDetector detector{labels.size(), detectorParams};
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (labels[i] == "_silence_" || labels[i] == "_unknown_") {
+            detector.SetThreshold(i, 2.f);  /* Never reported. */
+        }
+    }
+    caseContext.Set<arm::app::kws::KwsDetector&>("detector", detector);
+
     bool executionSuccessful = true;
 
     /* Loop. */
@@ -28,13 +28,13 @@
  */
 #include "UseCaseHandler.hpp"
 
-#include "KwsClassifier.hpp"
+#include "KwsDetector.hpp"
 #include "MicroNetKwsModel.hpp"
 #include "hal.h"
 #include "AudioUtils.hpp"
 #include "ImageUtils.hpp"
+#include "VoiceActivityDetector.hpp"
 #include "UseCaseCommonUtils.hpp"
-#include "KwsResult.hpp"
 #include "log_macros.h"
 #include "KwsProcessing.hpp"
 #include "services_lib_api.h"
@@ -45,18 +45,13 @@
 extern uint32_t m55_comms_handle;
 m55_data_payload_t mhu_data;
 
-using arm::app::KwsClassifier;
 using arm::app::Profiler;
-using arm::app::ClassificationResult;
 using arm::app::ApplicationContext;
 using arm::app::Model;
 using arm::app::KwsPreProcess;
-using arm::app::KwsPostProcess;
 using arm::app::MicroNetKwsModel;
 
 #define AUDIO_SAMPLES 16000 // 16k samples/sec, 1sec sample
-#define AUDIO_STRIDE 8000 // 0.5 seconds
-#define RESULTS_MEMORY 8
 
 static int16_t audio_inf[AUDIO_SAMPLES + AUDIO_STRIDE];
 
@@ -72,32 +67,25 @@ using namespace arm::app::kws;
 }
 
  /**
- * @brief           Presents KWS inference results.
- * @param[in]       results     Vector of KWS classification results to be displayed.
+ * @brief           Presents KWS events.
+ * @param[in]       detector    Decision engine holding the recent events.
+ * @param[in]       labels      Vector of labels to name the events.
  * @return          true if successful, false otherwise.
  **/
-static bool PresentInferenceResult(const std::vector<arm::app::kws::KwsResult>& results);
+static bool PresentInferenceResult(const kws::KwsDetector& detector,
+                                   const std::vector<std::string>& labels);
 
-static std::string last_label;
-
-static void send_msg_if_needed(arm::app::kws::KwsResult &result)
+static void send_msg_if_needed(const kws::KwsEvent& event, const std::vector<std::string>& labels)
 {
     mhu_data.id = 2; // id for M55_HE
-    if (result.m_resultVec.empty()) {
-        last_label.clear();
-        return;
-    }
-
-    arm::app::ClassificationResult classification = result.m_resultVec[0];
 
-    if (classification.m_label != last_label) {
-        if (classification.m_label == "go" || classification.m_label == "stop") {
-            info("******************* send_msg_if_needed, FOUND \"%s\", copy data end send! ******************\n", classification.m_label.c_str());
-            strcpy(mhu_data.msg, classification.m_label.c_str());
-            __DMB();
-            SERVICES_send_msg(m55_comms_handle, &mhu_data);
-        }
-        last_label = classification.m_label;
+    /* Repeated detections of one utterance are already suppressed by the detector. */
+    const std::string& label = labels[event.m_labelIdx];
+    if (label == "go" || label == "stop") {
+        info("******************* send_msg_if_needed, FOUND \"%s\", copy data end send! ******************\n", label.c_str());
+        strcpy(mhu_data.msg, label.c_str());
+        __DMB();
+        SERVICES_send_msg(m55_comms_handle, &mhu_data);
     }
 }
 
@@ -110,7 +98,9 @@ static void send_msg_if_needed(arm::app::kws::KwsResult &result)
         const auto mfccFrameLength = ctx.Get<int>("frameLength");
         const auto mfccFrameStride = ctx.Get<int>("frameStride");
         const auto audioRate = ctx.Get<int>("audioRate");
-        const auto scoreThreshold = ctx.Get<float>("scoreThreshold");
+        auto& detector = ctx.Get<kws::KwsDetector&>("detector");
+        const auto& labels = ctx.Get<const std::vector<std::string>&>("labels");
+        auto* vad = ctx.Has("vad") ? &ctx.Get<audio::VoiceActivityDetector&>("vad") : nullptr;
 
         constexpr int minTensorDims = static_cast<int>(
             (MicroNetKwsModel::ms_inputRowsIdx > MicroNetKwsModel::ms_inputColsIdx)?
@@ -143,15 +133,18 @@ static void send_msg_if_needed(arm::app::kws::KwsResult &result)
 
         /* Set up pre and post-processing. */
         KwsPreProcess preProcess = KwsPreProcess(inputTensor, numMfccFeatures, numMfccFrames,
-                                                 mfccFrameLength, mfccFrameStride);
+                                                 mfccFrameLength, mfccFrameStride, AUDIO_STRIDE);
 
-        std::vector<ClassificationResult> singleInfResult;
-        KwsPostProcess postProcess = KwsPostProcess(outputTensor, ctx.Get<KwsClassifier &>("classifier"),
-                                                    ctx.Get<std::vector<std::string>&>("labels"),
-                                                    singleInfResult);
+        /* The feature cache relies on the capture stride matching the pre-processing one. */
+        if (preProcess.m_audioDataStride != static_cast<size_t>(AUDIO_STRIDE) ||
+            preProcess.m_audioDataWindowSize != static_cast<size_t>(AUDIO_SAMPLES)) {
+            printf_err("Audio stride %d must be a multiple of %d within the inference window\n",
+                       AUDIO_STRIDE, mfccFrameStride);
+            return false;
+        }
 
         int index = 0;
-        std::vector<kws::KwsResult> infResults;
+        bool featuresCached = false; /* Feature cache in preProcess holds the previous stride. */
         static bool audio_inited;
         if (!audio_inited) {
             int err = hal_audio_init(audioRate, 32);
@@ -183,9 +176,20 @@ static void send_msg_if_needed(arm::app::kws::KwsResult &result)
 
             const int16_t* inferenceWindow = audio_inf;
 
+            /* Skip feature extraction and inference if the new stride is silent. */
+            if (vad && !vad->IsVoiceActive(audio_inf + AUDIO_SAMPLES - AUDIO_STRIDE, AUDIO_STRIDE)) {
+                debug("No voice activity, skipping inference (noise floor %.1f dB)\n",
+                      vad->GetNoiseFloorDb());
+                featuresCached = false;
+                ++index;
+                continue;
+            }
+
             uint32_t start = ARM_PMU_Get_CCNTR();
-            /* Run the pre-processing, inference and post-processing. */
-            if (!preProcess.DoPreProcess(inferenceWindow, index)) {
+            /* Run the pre-processing, inference and post-processing.
+             * Index 0 makes the pre-processing recompute all the features
+             * when the previous stride was skipped. */
+            if (!preProcess.DoPreProcess(inferenceWindow, featuresCached ? index : 0)) {
                 printf_err("Pre-processing failed.");
                 return false;
             }
@@ -199,40 +203,38 @@ static void send_msg_if_needed(arm::app::kws::KwsResult &result)
             printf("Inference time = %.3f ms\n", (double) (ARM_PMU_Get_CCNTR() - start) / SystemCoreClock * 1000);
 
             start = ARM_PMU_Get_CCNTR();
-            if (!postProcess.DoPostProcess()) {
+            bool event = false;
+            if (!detector.Update(outputTensor, index * secondsPerSample * preProcess.m_audioDataStride,
+                                 true, event)) {
                 printf_err("Post-processing failed.");
                 return false;
             }
             printf("Postprocessing time = %.3f ms\n", (double) (ARM_PMU_Get_CCNTR() - start) / SystemCoreClock * 1000);
 
-            /* Add results from this window to our final results vector. */
-            if (infResults.size() == RESULTS_MEMORY) {
-                infResults.erase(infResults.begin());
-            }
-            infResults.emplace_back(kws::KwsResult(singleInfResult,
-                    index * secondsPerSample * preProcess.m_audioDataStride,
-                    index, scoreThreshold));
-
-            send_msg_if_needed(infResults.back());
-
 #if VERIFY_TEST_OUTPUT
             DumpTensor(outputTensor);
 #endif /* VERIFY_TEST_OUTPUT */
 
-            hal_lcd_clear(COLOR_BLACK);
+            if (event) {
+                send_msg_if_needed(detector.GetLastEvent(), labels);
 
-            if (!PresentInferenceResult(infResults)) {
-                return false;
+                hal_lcd_clear(COLOR_BLACK);
+
+                if (!PresentInferenceResult(detector, labels)) {
+                    return false;
+                }
             }
 
             profiler.PrintProfilingResult();
 
+            featuresCached = true;
             ++index;
 
         } while (true);
     }
 
-    static bool PresentInferenceResult(const std::vector<kws::KwsResult>& results)
+    static bool PresentInferenceResult(const kws::KwsDetector& detector,
+                                       const std::vector<std::string>& labels)
     {
         constexpr uint32_t dataPsnTxtStartX1 = 20;
         constexpr uint32_t dataPsnTxtStartY1 = 30;
@@ -240,46 +242,27 @@ static void send_msg_if_needed(arm::app::kws::KwsResult &result)
 
         hal_lcd_set_text_color(COLOR_GREEN);
         info("Final results:\n");
-        info("Total number of inferences: %zu\n", results.size());
+        info("Total number of events: %zu\n", detector.GetEventCount());
 
-        /* Display each result */
+        /* Display each event */
         uint32_t rowIdx1 = dataPsnTxtStartY1 + 2 * dataPsnTxtYIncr;
 
-        for (const auto& result : results) {
+        for (size_t i = 0; i < detector.GetEventCount(); ++i) {
+            const kws::KwsEvent& event = detector.GetEvent(i);
+            const std::string& keyword = labels[event.m_labelIdx];
 
-            std::string topKeyword{"<none>"};
-            float score = 0.f;
-            if (!result.m_resultVec.empty()) {
-                topKeyword = result.m_resultVec[0].m_label;
-                score = result.m_resultVec[0].m_normalisedVal;
-            }
-
-            std::string resultStr =
-                    std::string{"@"} + std::to_string(result.m_timeStamp) +
-                    std::string{"s: "} + topKeyword + std::string{" ("} +
-                    std::to_string(static_cast<int>(score * 100)) + std::string{"%)"};
+            char resultStr[64];
+            const int len = snprintf(resultStr, sizeof(resultStr), "@%.1fs: %s (%d%%)",
+                                     event.m_timeStamp, keyword.c_str(),
+                                     static_cast<int>(event.m_score * 100));
 
-            hal_lcd_display_text(resultStr.c_str(), resultStr.size(),
-                    dataPsnTxtStartX1, rowIdx1, false);
+            hal_lcd_display_text(resultStr, len, dataPsnTxtStartX1, rowIdx1, false);
             rowIdx1 += dataPsnTxtYIncr;
 
-            if (result.m_resultVec.empty()) {
-                info("For timestamp: %f (inference #: %" PRIu32
-                             "); label: %s; threshold: %f\n",
-                     result.m_timeStamp, result.m_inferenceNumber,
-                     topKeyword.c_str(),
-                     result.m_threshold);
-            } else {
-                for (uint32_t j = 0; j < result.m_resultVec.size(); ++j) {
-                    info("For timestamp: %f (inference #: %" PRIu32
-                                 "); label: %s, score: %f; threshold: %f\n",
-                         result.m_timeStamp,
-                         result.m_inferenceNumber,
-                         result.m_resultVec[j].m_label.c_str(),
-                         result.m_resultVec[j].m_normalisedVal,
-                         result.m_threshold);
-                }
-            }
+            info("For timestamp: %f (inference #: %" PRIu32
+                         "); label: %s, score: %f\n",
+                 event.m_timeStamp, event.m_inferenceNumber,
+                 keyword.c_str(), event.m_score);
         }
 
         return true;
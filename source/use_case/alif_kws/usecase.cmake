@@ -39,6 +39,28 @@ USER_OPTION(${use_case}_MODEL_SCORE_THRESHOLD "Specify the score threshold [0.0,
     0.5
     STRING)
 
+USER_OPTION(${use_case}_VAD_HANGOVER_MS "Time in milliseconds the voice activity gate stays open after the last voiced frame. Set to a negative value to disable the gate."
+    1000
+    STRING)
+
+USER_OPTION(${use_case}_AUDIO_STRIDE "Number of audio samples between consecutive inferences. Must be a multiple of the MFCC frame stride (320) and shorter than the 1 second inference window."
+    8000
+    STRING)
+
+USER_OPTION(${use_case}_SMOOTHING_WINDOW "Number of inference results averaged before a keyword decision."
+    2
+    STRING)
+
+USER_OPTION(${use_case}_REFRACTORY_MS "Time in milliseconds after a keyword event during which no other keyword is reported."
+    500
+    STRING)
+
+set(${use_case}_COMPILE_DEFS
+    "AUDIO_STRIDE=${${use_case}_AUDIO_STRIDE}"
+    "VAD_HANGOVER_MS=${${use_case}_VAD_HANGOVER_MS}"
+    "SMOOTHING_WINDOW=${${use_case}_SMOOTHING_WINDOW}"
+    "REFRACTORY_MS=${${use_case}_REFRACTORY_MS}")
+
 # Generate labels file
 set(${use_case}_LABELS_CPP_FILE Labels)
 generate_labels_code(
@@ -33,6 +33,7 @@
 #include "UseCaseCommonUtils.hpp"     /* Utils functions. */
 #include "log_macros.h"             /* Logging functions */
 #include "BufAttributes.hpp"        /* Buffer attributes to be applied */
+#include "ImageUtils.hpp"           /* Frame change detection. */
 
 namespace arm {
 namespace app {
@@ -63,6 +64,9 @@ void main_loop()
         return;
     }
 
+    /* Lets the NPU cache maintenance tell the model's tensors and arena apart. */
+    arm::app::RegisterNpuCacheRegions(model, arm::app::tensorArena, sizeof(arm::app::tensorArena));
+
     /* Instantiate application context. */
     arm::app::ApplicationContext caseContext;
 
@@ -70,6 +74,15 @@ void main_loop()
     caseContext.Set<arm::app::Profiler&>("profiler", profiler);
     caseContext.Set<arm::app::Model&>("model", model);
 
+    /* Skips inference while the camera is looking at a static scene. The camera
+     * frame is RGB even though the model input is grayscale. */
+    TfLiteIntArray* inputShape = model.GetInputShape(0);
+    arm::app::image::FrameChangeDetector changeDetector{
+        static_cast<uint32_t>(inputShape->data[arm::app::YoloFastestModel::ms_inputColsIdx]),
+        static_cast<uint32_t>(inputShape->data[arm::app::YoloFastestModel::ms_inputRowsIdx]),
+        3, CHANGE_THRESHOLD, MAX_SKIP_FRAMES};
+    caseContext.Set<arm::app::image::FrameChangeDetector&>("changeDetector", changeDetector);
+
     /* Loop. */
     do {
         alif::app::ObjectDetectionHandler(caseContext);
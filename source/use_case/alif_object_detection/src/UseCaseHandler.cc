@@ -31,6 +31,7 @@
 #include "UseCaseCommonUtils.hpp"
 #include "DetectorPostProcessing.hpp"
 #include "DetectorPreProcessing.hpp"
+#include "ImageUtils.hpp"
 #include "ScreenLayout.hpp"
 #include "hal.h"
 #include "log_macros.h"
@@ -112,6 +113,7 @@ using namespace arm::app::object_detection;
     {
         auto& profiler = ctx.Get<Profiler&>("profiler");
         auto& model = ctx.Get<Model&>("model");
+        auto& changeDetector = ctx.Get<arm::app::image::FrameChangeDetector&>("changeDetector");
 
         if (!model.IsInited()) {
             printf_err("Model is not initialised! Terminating processing.\n");
@@ -168,6 +170,14 @@ using namespace arm::app::object_detection;
                return false;
             }
 
+            /* Static scene: the boxes on display are still valid. */
+            if (!changeDetector.HasChanged(currImage)) {
+               debug("Frame unchanged (diff=%.2f), skipping inference\n",
+                     changeDetector.GetLastDifference());
+               lv_led_off(ScreenLayoutLEDObject());
+               return true;
+            }
+
             lv_led_on(ScreenLayoutLEDObject());
 
             const size_t copySz = inputTensor->bytes;
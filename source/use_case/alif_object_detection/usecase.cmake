@@ -39,6 +39,18 @@ USER_OPTION(${use_case}_ANCHOR_2 "Second anchor array estimated during training.
     "{14, 26, 19, 37, 28, 55 }"
     STRING)
 
+USER_OPTION(${use_case}_CHANGE_THRESHOLD "Mean absolute block difference (0-255) above which a camera frame is deemed changed and inference is run. Set to 0 to run inference on every frame."
+    4.0
+    STRING)
+
+USER_OPTION(${use_case}_MAX_SKIP_FRAMES "Maximum number of consecutive unchanged frames for which inference is skipped. Set to 0 for no limit."
+    30
+    STRING)
+
+set(${use_case}_COMPILE_DEFS
+    "CHANGE_THRESHOLD=${${use_case}_CHANGE_THRESHOLD}"
+    "MAX_SKIP_FRAMES=${${use_case}_MAX_SKIP_FRAMES}")
+
 USER_OPTION(${use_case}_ACTIVATION_BUF_SZ "Activation buffer size for the chosen model"
     0x00082000
     STRING)
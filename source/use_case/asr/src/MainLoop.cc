@@ -75,6 +75,9 @@ void main_loop()
         return;
     }
 
+    /* Lets the NPU cache maintenance tell the model's tensors and arena apart. */
+    arm::app::RegisterNpuCacheRegions(model, arm::app::tensorArena, sizeof(arm::app::tensorArena));
+
     /* Instantiate application context. */
     arm::app::ApplicationContext caseContext;
     std::vector <std::string> labels;
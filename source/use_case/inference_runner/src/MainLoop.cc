@@ -20,6 +20,9 @@
 #include "UseCaseCommonUtils.hpp"   /* Utils functions. */
 #include "log_macros.h"             /* Logging functions */
 #include "BufAttributes.hpp"        /* Buffer attributes to be applied */
+#include "ModelLoader.hpp"          /* Runtime model loading. */
+
+#include <cstdlib>
 
 namespace arm {
 namespace app {
@@ -41,12 +44,49 @@ static size_t GetModelLen()
     return static_cast<size_t>(DYNAMIC_MODEL_SIZE);
 }
 
+#elif defined(MODEL_PARTITION_BASE) && defined(MODEL_PARTITION_SIZE)
+
+/* Model container written to flash separately from the application. */
+static bool LoadModel(LoadedModel& model)
+{
+    info("Model partition: 0x%08x\n", MODEL_PARTITION_BASE);
+    return LoadModelFromContainer(reinterpret_cast<const uint8_t*>(MODEL_PARTITION_BASE),
+                                  static_cast<size_t>(MODEL_PARTITION_SIZE), model);
+}
+
+#elif defined(MODEL_FILE_PATH)
+
+/* Model file mapped for the lifetime of the application. */
+static bool LoadModel(LoadedModel& model)
+{
+    static ModelFile s_modelFile;
+    const char* path = std::getenv("MODEL_PATH");
+    if (!s_modelFile.Open(path ? path : MODEL_FILE_PATH)) {
+        return false;
+    }
+    model = s_modelFile.GetModel();
+    return true;
+}
+
 #else /* defined(DYNAMIC_MODEL_BASE) && defined(DYNAMIC_MODEL_SIZE) */
 
 extern uint8_t* GetModelPointer();
 extern size_t GetModelLen();
 
 #endif /* defined(DYNAMIC_MODEL_BASE) && defined(DYNAMIC_MODEL_SIZE) */
+
+#if !defined(MODEL_PARTITION_BASE) && !defined(MODEL_FILE_PATH)
+
+/* Model compiled into, or placed alongside, the application. */
+static bool LoadModel(LoadedModel& model)
+{
+    model.m_data = GetModelPointer();
+    model.m_size = GetModelLen();
+    model.m_arenaHint = 0;
+    return true;
+}
+
+#endif /* !defined(MODEL_PARTITION_BASE) && !defined(MODEL_FILE_PATH) */
     }  /* namespace inference_runner */
 } /* namespace app */
 } /* namespace arm */
@@ -61,15 +101,28 @@ void main_loop()
 {
     arm::app::TestModel model;  /* Model wrapper object. */
 
+    arm::app::LoadedModel loadedModel;
+    if (!arm::app::inference_runner::LoadModel(loadedModel)) {
+        printf_err("Failed to find a model\n");
+        return;
+    }
+
+    if (!arm::app::ModelFitsArena(loadedModel, sizeof(arm::app::tensorArena))) {
+        return;
+    }
+
     /* Load the model. */
     if (!model.Init(arm::app::tensorArena,
                     sizeof(arm::app::tensorArena),
-                    arm::app::inference_runner::GetModelPointer(),
-                    arm::app::inference_runner::GetModelLen())) {
+                    loadedModel.m_data,
+                    loadedModel.m_size)) {
         printf_err("Failed to initialise model\n");
         return;
     }
 
+    /* Lets the NPU cache maintenance tell the model's tensors and arena apart. */
+    arm::app::RegisterNpuCacheRegions(model, arm::app::tensorArena, sizeof(arm::app::tensorArena));
+
     /* Instantiate application context. */
     arm::app::ApplicationContext caseContext;
 
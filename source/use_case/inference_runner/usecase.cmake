@@ -37,6 +37,12 @@ if (NOT TARGET_PLATFORM STREQUAL native)
         BOOL)
 endif()
 
+USER_OPTION(
+    ${use_case}_RUNTIME_MODEL_LOAD_ENABLED
+    "Load the model at runtime from a model container instead of compiling it in"
+    OFF
+    BOOL)
+
 # For non-native targets, for use with the FVPs only.
 if (${${use_case}_DYNAMIC_MEM_LOAD_ENABLED})
 
@@ -63,6 +69,47 @@ if (${${use_case}_DYNAMIC_MEM_LOAD_ENABLED})
         message(WARNING "${TARGET_PLATFORM} does not support dumping of output tensors.")
     endif()
 
+elseif (${${use_case}_RUNTIME_MODEL_LOAD_ENABLED})
+    USER_OPTION(${use_case}_MODEL_TFLITE_PATH "NN models file to be used in the evaluation application. Model files must be in tflite format."
+        ${DEFAULT_MODEL_PATH}
+        FILEPATH)
+
+    USER_OPTION(${use_case}_MODEL_ARENA_HINT "Tensor arena size the model needs, written into its container; applications with a smaller activation buffer refuse the container"
+        ${${use_case}_ACTIVATION_BUF_SZ}
+        STRING)
+
+    # Pack the model for loading at runtime; nothing is compiled in.
+    set(${use_case}_MODEL_CONTAINER_PATH ${CMAKE_BINARY_DIR}/${use_case}_model.bin)
+    generate_model_container(
+        MODEL_PATH  ${${use_case}_MODEL_TFLITE_PATH}
+        OUTPUT_PATH ${${use_case}_MODEL_CONTAINER_PATH}
+        ARENA_HINT  ${${use_case}_MODEL_ARENA_HINT})
+
+    if (TARGET_PLATFORM STREQUAL native)
+        # The container written here is mapped by default, the MODEL_PATH
+        # environment variable selects another .tflite or container file.
+        message(STATUS "NOTE: ${use_case} maps its model at runtime, default ${${use_case}_MODEL_CONTAINER_PATH}")
+        set(${use_case}_COMPILE_DEFS
+            "MODEL_FILE_PATH=\"${${use_case}_MODEL_CONTAINER_PATH}\"")
+    else()
+        USER_OPTION(${use_case}_MODEL_PARTITION_BASE "Address of the flash partition holding the model container"
+            ""
+            STRING)
+        USER_OPTION(${use_case}_MODEL_PARTITION_SIZE "Size of the flash partition holding the model container"
+            ""
+            STRING)
+
+        if ("${${use_case}_MODEL_PARTITION_BASE}" STREQUAL "" OR
+            "${${use_case}_MODEL_PARTITION_SIZE}" STREQUAL "")
+            message(FATAL_ERROR "${use_case}_MODEL_PARTITION_BASE and ${use_case}_MODEL_PARTITION_SIZE "
+                "are needed to load the model at runtime on ${TARGET_PLATFORM}.")
+        endif()
+
+        message(STATUS "NOTE: Write ${${use_case}_MODEL_CONTAINER_PATH} to ${${use_case}_MODEL_PARTITION_BASE}")
+        set(${use_case}_COMPILE_DEFS
+            "MODEL_PARTITION_BASE=${${use_case}_MODEL_PARTITION_BASE};MODEL_PARTITION_SIZE=${${use_case}_MODEL_PARTITION_SIZE}")
+    endif()
+
 else()
     USER_OPTION(${use_case}_MODEL_TFLITE_PATH "NN models file to be used in the evaluation application. Model files must be in tflite format."
         ${DEFAULT_MODEL_PATH}
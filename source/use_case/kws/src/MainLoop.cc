@@ -30,6 +30,7 @@ namespace app {
     namespace kws {
         extern uint8_t* GetModelPointer();
         extern size_t GetModelLen();
+        extern const int g_AudioStride;
     } /* namespace kws */
 } /* namespace app */
 } /* namespace arm */
@@ -71,6 +72,9 @@ void main_loop()
         return;
     }
 
+    /* Lets the NPU cache maintenance tell the model's tensors and arena apart. */
+    arm::app::RegisterNpuCacheRegions(model, arm::app::tensorArena, sizeof(arm::app::tensorArena));
+
     /* Instantiate application context. */
     arm::app::ApplicationContext caseContext;
 
@@ -80,6 +84,7 @@ void main_loop()
     caseContext.Set<uint32_t>("clipIndex", 0);
     caseContext.Set<int>("frameLength", arm::app::kws::g_FrameLength);
     caseContext.Set<int>("frameStride", arm::app::kws::g_FrameStride);
+    caseContext.Set<int>("audioStride", arm::app::kws::g_AudioStride);  /* 0 for half of the window. */
     caseContext.Set<float>("scoreThreshold", arm::app::kws::g_ScoreThreshold);  /* Normalised score threshold. */
 
     arm::app::KwsClassifier classifier;  /* classifier wrapper object. */
@@ -47,6 +47,7 @@ namespace app {
         const auto mfccFrameLength = ctx.Get<int>("frameLength");
         const auto mfccFrameStride = ctx.Get<int>("frameStride");
         const auto scoreThreshold  = ctx.Get<float>("scoreThreshold");
+        const auto audioStride     = ctx.Has("audioStride") ? ctx.Get<int>("audioStride") : 0;
 
         /* If the request has a valid size, set the audio index. */
         if (clipIndex < NUMBER_OF_FILES) {
@@ -91,7 +92,7 @@ namespace app {
 
         /* Set up pre and post-processing. */
         KwsPreProcess preProcess = KwsPreProcess(
-            inputTensor, numMfccFeatures, numMfccFrames, mfccFrameLength, mfccFrameStride);
+            inputTensor, numMfccFeatures, numMfccFrames, mfccFrameLength, mfccFrameStride, audioStride);
 
         std::vector<ClassificationResult> singleInfResult;
         KwsPostProcess postProcess = KwsPostProcess(outputTensor,
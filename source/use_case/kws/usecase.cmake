@@ -51,6 +51,10 @@ USER_OPTION(${use_case}_MODEL_SCORE_THRESHOLD "Specify the score threshold [0.0,
     0.7
     STRING)
 
+USER_OPTION(${use_case}_AUDIO_STRIDE "Specify the number of audio samples between consecutive inferences, down to one MFCC frame stride (320). By default is 0, meaning half of the inference window."
+    0
+    STRING)
+
 # Generate input files
 generate_audio_code(${${use_case}_FILE_PATH} ${SRC_GEN_DIR} ${INC_GEN_DIR}
     ${${use_case}_AUDIO_RATE}
@@ -85,6 +89,7 @@ set(EXTRA_MODEL_CODE
     "extern const int   g_FrameLength    = 640"
     "extern const int   g_FrameStride    = 320"
     "extern const float g_ScoreThreshold = ${${use_case}_MODEL_SCORE_THRESHOLD}"
+    "extern const int   g_AudioStride    = ${${use_case}_AUDIO_STRIDE}"
     )
 
 USER_OPTION(${use_case}_MODEL_TFLITE_PATH "NN models file to be used in the evaluation application. Model files must be in tflite format."
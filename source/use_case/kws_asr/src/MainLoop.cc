@@ -18,7 +18,6 @@
 #include "Labels_micronetkws.hpp"   /* For MicroNetKws label strings. */
 #include "Labels_wav2letter.hpp"    /* For Wav2Letter label strings. */
 #include "KwsClassifier.hpp"        /* KWS classifier. */
-#include "AsrClassifier.hpp"        /* ASR classifier. */
 #include "MicroNetKwsModel.hpp"     /* KWS model class for running inference. */
 #include "Wav2LetterModel.hpp"      /* ASR model class for running inference. */
 #include "UseCaseCommonUtils.hpp"   /* Utils functions. */
@@ -32,6 +31,7 @@ namespace app {
     namespace asr {
         extern uint8_t* GetModelPointer();
         extern size_t GetModelLen();
+        extern const int g_BeamWidth;
     } /* namespace asr */
 
     namespace kws {
@@ -97,6 +97,10 @@ void main_loop()
         return;
     }
 
+    /* Lets the NPU cache maintenance tell the models' tensors and the shared arena apart. */
+    arm::app::RegisterNpuCacheRegions(kwsModel, nullptr, 0);
+    arm::app::RegisterNpuCacheRegions(asrModel, arm::app::tensorArena, sizeof(arm::app::tensorArena));
+
     /* Instantiate application context. */
     arm::app::ApplicationContext caseContext;
 
@@ -114,12 +118,10 @@ void main_loop()
 
     caseContext.Set<int>("asrFrameLength", arm::app::asr::g_FrameLength);
     caseContext.Set<int>("asrFrameStride", arm::app::asr::g_FrameStride);
-    caseContext.Set<float>("asrScoreThreshold", arm::app::asr::g_ScoreThreshold);  /* Normalised score threshold. */
+    caseContext.Set<uint32_t>("asrBeamWidth", arm::app::asr::g_BeamWidth);  /* CTC decoder beams; 1 is greedy. */
 
     arm::app::KwsClassifier kwsClassifier;  /* Classifier wrapper object. */
-    arm::app::AsrClassifier asrClassifier;  /* Classifier wrapper object. */
     caseContext.Set<arm::app::KwsClassifier&>("kwsClassifier", kwsClassifier);
-    caseContext.Set<arm::app::AsrClassifier&>("asrClassifier", asrClassifier);
 
     std::vector<std::string> asrLabels;
     arm::app::asr::GetLabelsVector(asrLabels);
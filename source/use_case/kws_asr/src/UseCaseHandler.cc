@@ -16,17 +16,15 @@
  */
 #include "UseCaseHandler.hpp"
 
-#include "AsrClassifier.hpp"
-#include "AsrResult.hpp"
 #include "AudioUtils.hpp"
 #include "Classifier.hpp"
+#include "CtcDecoder.hpp"
 #include "ImageUtils.hpp"
 #include "InputFiles.hpp"
 #include "KwsProcessing.hpp"
 #include "KwsResult.hpp"
 #include "MicroNetKwsMfcc.hpp"
 #include "MicroNetKwsModel.hpp"
-#include "OutputDecode.hpp"
 #include "UseCaseCommonUtils.hpp"
 #include "Wav2LetterMfcc.hpp"
 #include "Wav2LetterModel.hpp"
@@ -54,11 +52,11 @@ namespace app {
     static bool PresentInferenceResult(std::vector<kws::KwsResult>& results);
 
     /**
-     * @brief       Presents ASR inference results.
-     * @param[in]   results   Vector of ASR classification results to be displayed.
+     * @brief       Presents the ASR transcript.
+     * @param[in]   transcript   Decoded text to be displayed.
      * @return      true if successful, false otherwise.
      **/
-    static bool PresentInferenceResult(std::vector<asr::AsrResult>& results);
+    static bool PresentInferenceResult(const std::string& transcript);
 
     /**
      * @brief           Performs the KWS pipeline.
@@ -218,8 +216,8 @@ namespace app {
         auto& profiler          = ctx.Get<Profiler&>("profiler");
         auto asrMfccFrameLen    = ctx.Get<uint32_t>("asrFrameLength");
         auto asrMfccFrameStride = ctx.Get<uint32_t>("asrFrameStride");
-        auto asrScoreThreshold  = ctx.Get<float>("asrScoreThreshold");
         auto asrInputCtxLen     = ctx.Get<uint32_t>("ctxLen");
+        auto asrBeamWidth       = ctx.Get<uint32_t>("asrBeamWidth");
 
         constexpr uint32_t dataPsnTxtInfStartX = 20;
         constexpr uint32_t dataPsnTxtInfStartY = 40;
@@ -253,31 +251,25 @@ namespace app {
         const uint32_t asrAudioDataWindowLen =
             (asrInputRows - 1) * asrMfccFrameStride + (asrMfccFrameLen);
         const uint32_t asrAudioDataWindowStride = asrInputInnerLen * asrMfccFrameStride;
-        const float asrAudioParamsSecondsPerSample =
-            1.0 / audio::Wav2LetterMFCC::ms_defaultSamplingFreq;
 
         /* Get the remaining audio buffer and respective size from KWS results. */
         const int16_t* audioArr     = kwsOutput.asrAudioStart;
         const uint32_t audioArrSize = kwsOutput.asrAudioSamples;
 
         /* Audio clip must have enough samples to produce 1 MFCC feature. */
-        std::vector<int16_t> audioBuffer = std::vector<int16_t>(audioArr, audioArr + audioArrSize);
         if (audioArrSize < asrMfccFrameLen) {
             printf_err("Not enough audio samples, minimum needed is %" PRIu32 "\n",
                        asrMfccFrameLen);
             return false;
         }
 
-        /* Initialise an audio slider. */
+        /* Initialise an audio slider straight over the clip, no copy needed. */
         auto audioDataSlider =
-            audio::FractionalSlidingWindow<const int16_t>(audioBuffer.data(),
-                                                          audioBuffer.size(),
+            audio::FractionalSlidingWindow<const int16_t>(audioArr,
+                                                          audioArrSize,
                                                           asrAudioDataWindowLen,
                                                           asrAudioDataWindowStride);
 
-        /* Declare a container for results. */
-        std::vector<asr::AsrResult> asrResults;
-
         /* Display message on the LCD - inference running. */
         std::string str_inf{"Running ASR inference... "};
         hal_lcd_display_text(
@@ -293,23 +285,19 @@ namespace app {
                           asrMfccFrameLen,
                           asrMfccFrameStride);
 
-        std::vector<ClassificationResult> singleInfResult;
+        /* Output rows are decoded as each window completes; the context rows
+         * AsrPostProcess would erase are skipped by the decoder. */
         const uint32_t outputCtxLen = AsrPostProcess::GetOutputContextLen(asrModel, asrInputCtxLen);
-        AsrPostProcess asrPostProcess =
-            AsrPostProcess(asrOutputTensor,
-                           ctx.Get<AsrClassifier&>("asrClassifier"),
-                           ctx.Get<std::vector<std::string>&>("asrLabels"),
-                           singleInfResult,
-                           outputCtxLen,
-                           Wav2LetterModel::ms_blankTokenIdx,
-                           Wav2LetterModel::ms_outputRowsIdx);
+        audio::asr::CtcDecoder decoder(ctx.Get<std::vector<std::string>&>("asrLabels"),
+                                       Wav2LetterModel::ms_blankTokenIdx,
+                                       asrBeamWidth);
         /* Start sliding through audio clip. */
         while (audioDataSlider.HasNext()) {
 
             /* If not enough audio see how much can be sent for processing. */
             size_t nextStartIndex = audioDataSlider.NextWindowStartIndex();
-            if (nextStartIndex + asrAudioDataWindowLen > audioBuffer.size()) {
-                asrInferenceWindowLen = audioBuffer.size() - nextStartIndex;
+            if (nextStartIndex + asrAudioDataWindowLen > audioArrSize) {
+                asrInferenceWindowLen = audioArrSize - nextStartIndex;
             }
 
             const int16_t* asrInferenceWindow = audioDataSlider.Next();
@@ -330,27 +318,18 @@ namespace app {
                 return false;
             }
 
-            /* Post processing needs to know if we are on the last audio window. */
-            asrPostProcess.m_lastIteration = !audioDataSlider.HasNext();
-            if (!asrPostProcess.DoPostProcess()) {
-                printf_err("ASR post-processing failed.");
+            /* Decoding needs to know if we are on the first or last audio window. */
+            if (!decoder.DecodeWindow(asrOutputTensor,
+                                      outputCtxLen,
+                                      audioDataSlider.Index() == 0,
+                                      !audioDataSlider.HasNext())) {
+                printf_err("ASR decoding failed.");
                 return false;
             }
 
-            /* Get results. */
-            std::vector<ClassificationResult> asrClassificationResult;
-            auto& asrClassifier = ctx.Get<AsrClassifier&>("asrClassifier");
-            asrClassifier.GetClassificationResults(asrOutputTensor,
-                                                   asrClassificationResult,
-                                                   ctx.Get<std::vector<std::string>&>("asrLabels"),
-                                                   1);
-
-            asrResults.emplace_back(
-                asr::AsrResult(asrClassificationResult,
-                               (audioDataSlider.Index() * asrAudioParamsSecondsPerSample *
-                                asrAudioDataWindowStride),
-                               audioDataSlider.Index(),
-                               asrScoreThreshold));
+            info("Partial result for inf %zu: %s\n",
+                 audioDataSlider.Index(),
+                 decoder.GetBestText().c_str());
 
 #if VERIFY_TEST_OUTPUT
             armDumpTensor(asrOutputTensor,
@@ -362,7 +341,8 @@ namespace app {
             hal_lcd_display_text(
                 str_inf.c_str(), str_inf.size(), dataPsnTxtInfStartX, dataPsnTxtInfStartY, false);
         }
-        if (!PresentInferenceResult(asrResults)) {
+        decoder.Flush();
+        if (!PresentInferenceResult(decoder.GetStableText())) {
             return false;
         }
 
@@ -451,7 +431,7 @@ namespace app {
         return true;
     }
 
-    static bool PresentInferenceResult(std::vector<arm::app::asr::AsrResult>& results)
+    static bool PresentInferenceResult(const std::string& transcript)
     {
         constexpr uint32_t dataPsnTxtStartX1 = 20;
         constexpr uint32_t dataPsnTxtStartY1 = 80;
@@ -459,30 +439,13 @@ namespace app {
 
         hal_lcd_set_text_color(COLOR_GREEN);
 
-        /* Results from multiple inferences should be combined before processing. */
-        std::vector<arm::app::ClassificationResult> combinedResults;
-        for (auto& result : results) {
-            combinedResults.insert(
-                combinedResults.end(), result.m_resultVec.begin(), result.m_resultVec.end());
-        }
-
-        for (auto& result : results) {
-            /* Get the final result string using the decoder. */
-            std::string infResultStr = audio::asr::DecodeOutput(result.m_resultVec);
-
-            info(
-                "Result for inf %" PRIu32 ": %s\n", result.m_inferenceNumber, infResultStr.c_str());
-        }
-
-        std::string finalResultStr = audio::asr::DecodeOutput(combinedResults);
-
-        hal_lcd_display_text(finalResultStr.c_str(),
-                             finalResultStr.size(),
+        hal_lcd_display_text(transcript.c_str(),
+                             transcript.size(),
                              dataPsnTxtStartX1,
                              dataPsnTxtStartY1,
                              allow_multiple_lines);
 
-        info("Final result: %s\n", finalResultStr.c_str());
+        info("Final result: %s\n", transcript.c_str());
         return true;
     }
 
@@ -62,8 +62,8 @@ USER_OPTION(${use_case}_MODEL_SCORE_THRESHOLD_KWS "Specify the score threshold [
     0.7
     STRING)
 
-USER_OPTION(${use_case}_MODEL_SCORE_THRESHOLD_ASR "Specify the score threshold [0.0, 1.0) that must be applied to the ASR results for a label to be deemed valid."
-    0.5
+USER_OPTION(${use_case}_ASR_BEAM_WIDTH "Number of beams kept by the ASR CTC decoder; 1 selects greedy decoding."
+    1
     STRING)
 
 if (ETHOS_U_NPU_ENABLED)
@@ -103,7 +103,7 @@ set(EXTRA_MODEL_CODE_ASR
         "extern const int   g_FrameLength    = 512"
         "extern const int   g_FrameStride    = 160"
         "extern const int   g_ctxLen         =  98"
-        "extern const float g_ScoreThreshold = ${${use_case}_MODEL_SCORE_THRESHOLD_ASR}"
+        "extern const int   g_BeamWidth      = ${${use_case}_ASR_BEAM_WIDTH}"
         )
 
 # Generate model file for KWS
@@ -31,6 +31,20 @@ namespace app {
      **/
     bool NoiseReductionHandler(ApplicationContext& ctx, bool runAll);
 
+    /**
+     * @brief       Runs noise reduction on a continuous stream of audio: live
+     *              audio from the HAL on platforms with an audio source, a WAV
+     *              file (NR_STREAM_INPUT, else the current clip) denoised into
+     *              another (NR_STREAM_OUTPUT) on the native platform.
+     *              The denoised audio is written to the AudioRingBuffer set as
+     *              "denoisedAudio" in the context, if any, for a downstream use
+     *              case to read. Frames taking longer than their duration are
+     *              counted as deadline misses.
+     * @param[in]   ctx   Pointer to the application context.
+     * @return      True or false based on execution success.
+     **/
+    bool NoiseReductionStreamHandler(ApplicationContext& ctx);
+
     /**
      * @brief           Dumps the output tensors to a memory address.
      * This functionality is required for RNNoise use case as we want to
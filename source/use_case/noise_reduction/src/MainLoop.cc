@@ -37,7 +37,8 @@ enum opcodes
     MENU_OPT_RUN_INF_CHOSEN,         /* Run on a user provided vector index. */
     MENU_OPT_RUN_INF_ALL,            /* Run inference on all. */
     MENU_OPT_SHOW_MODEL_INFO,        /* Show model info. */
-    MENU_OPT_LIST_AUDIO_CLIPS        /* List the current baked audio clip features. */
+    MENU_OPT_LIST_AUDIO_CLIPS,       /* List the current baked audio clip features. */
+    MENU_OPT_RUN_STREAM              /* Run on a continuous audio stream. */
 };
 
 static void DisplayMenu()
@@ -49,7 +50,8 @@ static void DisplayMenu()
     printf("  %u. Run noise reduction on a WAV at chosen index\n", MENU_OPT_RUN_INF_CHOSEN);
     printf("  %u. Run noise reduction on all WAVs\n", MENU_OPT_RUN_INF_ALL);
     printf("  %u. Show NN model info\n", MENU_OPT_SHOW_MODEL_INFO);
-    printf("  %u. List audio clips\n\n", MENU_OPT_LIST_AUDIO_CLIPS);
+    printf("  %u. List audio clips\n", MENU_OPT_LIST_AUDIO_CLIPS);
+    printf("  %u. Run noise reduction on an audio stream\n\n", MENU_OPT_RUN_STREAM);
     printf("  Choice: ");
     fflush(stdout);
 }
@@ -81,6 +83,9 @@ void main_loop()
         return;
     }
 
+    /* Lets the NPU cache maintenance tell the model's tensors and arena apart. */
+    arm::app::RegisterNpuCacheRegions(model, arm::app::tensorArena, sizeof(arm::app::tensorArena));
+
     /* Instantiate application context. */
     arm::app::ApplicationContext caseContext;
 
@@ -133,6 +138,9 @@ void main_loop()
             case MENU_OPT_LIST_AUDIO_CLIPS:
                 executionSuccessful = ListFilesHandler(caseContext);
                 break;
+            case MENU_OPT_RUN_STREAM:
+                executionSuccessful = NoiseReductionStreamHandler(caseContext);
+                break;
             default:
                 printf("Incorrect choice, try again.");
                 break;
@@ -21,10 +21,25 @@
 #include "RNNoiseFeatureProcessor.hpp"
 #include "RNNoiseModel.hpp"
 #include "RNNoiseProcessing.hpp"
+#include "RNNoiseStream.hpp"
+#include "StreamScheduler.hpp"
 #include "UseCaseCommonUtils.hpp"
 #include "hal.h"
 #include "log_macros.h"
 
+#include <algorithm>
+#include <memory>
+
+#if !defined(NR_LIVE_AUDIO) && (defined(__unix__) || defined(__APPLE__))
+#define NR_WAV_STREAM
+#include "WavFile.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#endif /* !defined(NR_LIVE_AUDIO) && (defined(__unix__) || defined(__APPLE__)) */
+
 namespace arm {
 namespace app {
 
@@ -34,6 +49,219 @@ namespace app {
      **/
     static void IncrementAppCtxClipIdx(ApplicationContext& ctx);
 
+    /* Duration of a frame: each round of frames has to be processed within it to keep up. */
+    constexpr uint64_t ms_framePeriodUs =
+        UINT64_C(1000000) * RNNoiseStream::ms_frameSize / RNNoiseStream::ms_sampleRate;
+
+#if defined(NR_LIVE_AUDIO)
+    /* Time from the CPU cycle counter, carried past its wrap around (read at least once a frame). */
+    static uint64_t GetTimeUs()
+    {
+        static uint32_t lastCount = ARM_PMU_Get_CCNTR();
+        static uint64_t cycles = 0;
+        const uint32_t count = ARM_PMU_Get_CCNTR();
+        cycles += count - lastCount;
+        lastCount = count;
+        return cycles * 1000000 / SystemCoreClock;
+    }
+
+    /**
+     * @brief           Denoises live audio from the HAL audio source, forever.
+     * @param[in]       ctx     Application context, with the "denoisedAudio"
+     *                          ring buffer if the audio has a consumer.
+     * @param[in,out]   model   RNNoise model.
+     * @return          false on error.
+     **/
+    static bool StreamLiveAudio(ApplicationContext& ctx, RNNoiseModel& model)
+    {
+        constexpr size_t frameSize = RNNoiseStream::ms_frameSize;
+
+        /* Report about every 10 seconds. */
+        constexpr uint32_t reportInterval = 10 * RNNoiseStream::ms_sampleRate / frameSize;
+
+        /* A frame is captured while the previous one is denoised. */
+        static int16_t captureBuf[2][frameSize];
+        static bool audioInited;
+
+        const bool hasConsumer = ctx.Has("denoisedAudio");
+        std::unique_ptr<audio::AudioRingBuffer> localOutput;
+        if (!hasConsumer) {
+            /* Nothing reads the denoised audio: only keep the last frames. */
+            localOutput.reset(new audio::AudioRingBuffer(2 * frameSize));
+        }
+        audio::AudioRingBuffer& output = hasConsumer ?
+            ctx.Get<audio::AudioRingBuffer&>("denoisedAudio") : *localOutput;
+        RNNoiseStream stream(model, output);
+
+        /* The HAL has a single audio source: one stream. */
+        StreamScheduler scheduler(1, ms_framePeriodUs, GetTimeUs);
+
+        if (!audioInited) {
+            int err = hal_audio_init(RNNoiseStream::ms_sampleRate, 32);
+            if (err) {
+                printf_err("hal_audio_init failed with error: %d\n", err);
+                return false;
+            }
+            audioInited = true;
+        }
+
+        info("Streaming live audio, %zu samples per frame\n", frameSize);
+        size_t current = 0;
+        hal_get_audio_data(captureBuf[current], frameSize);
+
+        while (true) {
+            int err = hal_wait_for_audio();
+            if (err) {
+                printf_err("hal_get_audio_data failed with error: %d\n", err);
+                return false;
+            }
+
+            /* Start capturing the next frame before processing this one, so as not to lose anything. */
+            const size_t next = current ^ 1;
+            hal_get_audio_data(captureBuf[next], frameSize);
+
+            const bool ok = scheduler.RunRound([&](size_t) {
+                hal_audio_preprocessing(captureBuf[current], frameSize);
+                return stream.ProcessFrame(captureBuf[current]);
+            });
+            if (!ok) {
+                return false;
+            }
+            current = next;
+
+            if (scheduler.GetRounds() % reportInterval == 0) {
+                scheduler.PrintReport();
+                if (hasConsumer) {
+                    info("Denoised samples dropped unread: %" PRIu64 "\n", output.GetOverrunCount());
+                }
+            }
+        }
+    }
+#elif defined(NR_WAV_STREAM)
+    /* Splits a comma separated list. */
+    static std::vector<std::string> SplitList(const char* list)
+    {
+        std::vector<std::string> items;
+        std::string item;
+        for (const char* c = list; ; ++c) {
+            if (*c == ',' || *c == '\0') {
+                items.push_back(item);
+                item.clear();
+                if (*c == '\0') {
+                    break;
+                }
+            } else {
+                item += *c;
+            }
+        }
+        return items;
+    }
+
+    static uint64_t GetTimeUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief           Denoises WAV files frame by frame, as if streamed, into
+     *                  other WAV files. Several files are streamed at once,
+     *                  as from several microphones, by time multiplexing
+     *                  the model.
+     * @param[in]       ctx     Application context.
+     * @param[in,out]   model   RNNoise model.
+     * @return          false on error.
+     **/
+    static bool StreamWav(ApplicationContext& ctx, RNNoiseModel& model)
+    {
+        constexpr size_t frameSize = RNNoiseStream::ms_frameSize;
+
+        const char* inputList = std::getenv("NR_STREAM_INPUT");
+        const char* outputList = std::getenv("NR_STREAM_OUTPUT");
+
+        std::vector<std::string> inputPaths;
+        std::vector<std::vector<int16_t>> inputs;
+        if (inputList) {
+            inputPaths = SplitList(inputList);
+            inputs.resize(inputPaths.size());
+            for (size_t i = 0; i < inputPaths.size(); ++i) {
+                uint32_t sampleRate = 0;
+                if (!audio::ReadWav(inputPaths[i].c_str(), inputs[i], sampleRate)) {
+                    return false;
+                }
+                if (sampleRate != RNNoiseStream::ms_sampleRate) {
+                    printf_err("%s is sampled at %" PRIu32 " Hz, %" PRIu32 " Hz expected\n",
+                               inputPaths[i].c_str(), sampleRate, RNNoiseStream::ms_sampleRate);
+                    return false;
+                }
+            }
+        } else {
+            const auto clipIdx = ctx.Get<uint32_t>("clipIndex");
+            inputs.emplace_back(GetAudioArray(clipIdx), GetAudioArray(clipIdx) + GetAudioArraySize(clipIdx));
+            inputPaths.emplace_back(GetFilename(clipIdx));
+        }
+        const size_t numStreams = inputs.size();
+
+        std::vector<std::string> outputPaths;
+        if (outputList) {
+            outputPaths = SplitList(outputList);
+        } else if (numStreams == 1) {
+            outputPaths.emplace_back("denoised.wav");
+        } else {
+            for (size_t i = 0; i < numStreams; ++i) {
+                outputPaths.push_back("denoised_" + std::to_string(i) + ".wav");
+            }
+        }
+        if (outputPaths.size() != numStreams) {
+            printf_err("%zu outputs given for %zu inputs\n", outputPaths.size(), numStreams);
+            return false;
+        }
+
+        /* Last frames are zero padded, up to the longest input; the padding is left out of the outputs. */
+        std::vector<size_t> numSamples(numStreams);
+        size_t paddedSize = 0;
+        for (size_t i = 0; i < numStreams; ++i) {
+            numSamples[i] = inputs[i].size();
+            paddedSize = std::max(paddedSize, (numSamples[i] + frameSize - 1) / frameSize * frameSize);
+            info("Stream %zu: %s, %zu samples per frame\n", i, inputPaths[i].c_str(), frameSize);
+        }
+
+        /* The output files are the consumers: each frame is read out as soon as written. */
+        std::vector<std::vector<int16_t>> denoised(numStreams, std::vector<int16_t>(paddedSize));
+        std::vector<std::unique_ptr<audio::AudioRingBuffer>> outputs;
+        std::vector<std::unique_ptr<RNNoiseStream>> streams;
+        for (size_t i = 0; i < numStreams; ++i) {
+            inputs[i].resize(paddedSize, 0);
+            outputs.emplace_back(new audio::AudioRingBuffer(frameSize));
+            streams.emplace_back(new RNNoiseStream(model, *outputs[i], numStreams > 1));
+        }
+
+        StreamScheduler scheduler(numStreams, ms_framePeriodUs, GetTimeUs);
+        for (size_t offset = 0; offset < paddedSize; offset += frameSize) {
+            const bool ok = scheduler.RunRound([&](size_t i) {
+                if (!streams[i]->ProcessFrame(&inputs[i][offset])) {
+                    return false;
+                }
+                outputs[i]->Read(&denoised[i][offset], frameSize);
+                return true;
+            });
+            if (!ok) {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < numStreams; ++i) {
+            if (!audio::WriteWav(outputPaths[i].c_str(), denoised[i].data(), numSamples[i],
+                                 RNNoiseStream::ms_sampleRate)) {
+                return false;
+            }
+            info("Denoised audio written to %s\n", outputPaths[i].c_str());
+        }
+        scheduler.PrintReport();
+        return true;
+    }
+#endif /* defined(NR_LIVE_AUDIO) */
+
     /* Noise reduction inference handler. */
     bool NoiseReductionHandler(ApplicationContext& ctx, bool runAll)
     {
@@ -94,6 +322,20 @@ namespace app {
             audioFileAccessorFunc =
                 ctx.Get<std::function<const char*(const uint32_t)>>("featureFileNames");
         }
+
+        /* Set up pre and post-processing once: their buffers are reused for all the clips. */
+        std::shared_ptr<rnn::RNNoiseFeatureProcessor> featureProcessor =
+            std::make_shared<rnn::RNNoiseFeatureProcessor>();
+        std::shared_ptr<rnn::FrameFeatures> frameFeatures =
+            std::make_shared<rnn::FrameFeatures>();
+
+        RNNoisePreProcess preProcess =
+            RNNoisePreProcess(inputTensor, featureProcessor, frameFeatures);
+
+        std::vector<int16_t> denoisedAudioFrame(audioFrameLen);
+        RNNoisePostProcess postProcess = RNNoisePostProcess(
+            outputTensor, denoisedAudioFrame, featureProcessor, frameFeatures);
+
         do {
             hal_lcd_clear(COLOR_BLACK);
 
@@ -117,19 +359,8 @@ namespace app {
                                         memDumpBaseAddr + memDumpBytesWritten,
                                         memDumpMaxLen - memDumpBytesWritten);
 
-            /* Set up pre and post-processing. */
-            std::shared_ptr<rnn::RNNoiseFeatureProcessor> featureProcessor =
-                std::make_shared<rnn::RNNoiseFeatureProcessor>();
-            std::shared_ptr<rnn::FrameFeatures> frameFeatures =
-                std::make_shared<rnn::FrameFeatures>();
-
-            RNNoisePreProcess preProcess =
-                RNNoisePreProcess(inputTensor, featureProcessor, frameFeatures);
-
-            std::vector<int16_t> denoisedAudioFrame(audioFrameLen);
-            RNNoisePostProcess postProcess = RNNoisePostProcess(
-                outputTensor, denoisedAudioFrame, featureProcessor, frameFeatures);
-
+            /* Each clip is an unrelated stream. */
+            featureProcessor->Reset();
             bool resetGRU = true;
 
             while (audioDataSlider.HasNext()) {
@@ -231,6 +462,25 @@ namespace app {
         return true;
     }
 
+    /* Noise reduction streaming handler. */
+    bool NoiseReductionStreamHandler(ApplicationContext& ctx)
+    {
+        auto& model = ctx.Get<RNNoiseModel&>("model");
+        if (!model.IsInited()) {
+            printf_err("Model is not initialised! Terminating processing.\n");
+            return false;
+        }
+
+#if defined(NR_LIVE_AUDIO)
+        return StreamLiveAudio(ctx, model);
+#elif defined(NR_WAV_STREAM)
+        return StreamWav(ctx, model);
+#else
+        printf_err("No audio source to stream from on this platform.\n");
+        return true;
+#endif /* defined(NR_LIVE_AUDIO) */
+    }
+
     size_t DumpDenoisedAudioHeader(const char* filename,
                                    size_t dumpSize,
                                    uint8_t* memAddress,
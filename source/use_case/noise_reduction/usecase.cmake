@@ -57,6 +57,11 @@ USER_OPTION(${use_case}_AUDIO_MIN_SAMPLES "Specify the minimum number of samples
     512
     STRING)
 
+# Live audio streaming needs the HAL audio source, which only the Ensemble platform has.
+if (TARGET_PLATFORM STREQUAL ensemble)
+    set(${use_case}_COMPILE_DEFS "NR_LIVE_AUDIO=1")
+endif()
+
 # Generate input files from audio wav files
 generate_audio_code(${${use_case}_FILE_PATH} ${SRC_GEN_DIR} ${INC_GEN_DIR}
     ${${use_case}_AUDIO_RATE}
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AudioFrontEnd.hpp"
+#include "Mfcc.hpp"
+
+#include <catch.hpp>
+#include <cmath>
+
+using arm::app::audio::AudioFrontEnd;
+using arm::app::audio::AudioFrontEndParams;
+using arm::app::audio::FeatureStage;
+
+/* A chirp with some deterministic noise on top. */
+static std::vector<int16_t> MakeAudio(size_t len)
+{
+    std::vector<int16_t> audio(len);
+    uint32_t state = 1;
+    for (size_t i = 0; i < len; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const double t = static_cast<double>(i) / 16000;
+        audio[i] = static_cast<int16_t>(8000 * std::sin(2 * M_PI * (200 + 2000 * t) * t) +
+                                        static_cast<int32_t>(state >> 22) - 512);
+    }
+    return audio;
+}
+
+static AudioFrontEndParams MfccFrontEndParams()
+{
+    AudioFrontEndParams params;
+    params.m_frameLen = 640;
+    params.m_numMelBins = 40;
+    params.m_melLoFreq = 20;
+    params.m_melHiFreq = 4000;
+    params.m_numDctCoeffs = 10;
+    params.m_quantScale = 1.1088106632232666;
+    params.m_quantOffset = 95;
+    return params;
+}
+
+TEST_CASE("Audio front end stage table")
+{
+    std::vector<FeatureStage> stages;
+
+    SECTION("Parsing")
+    {
+        REQUIRE(AudioFrontEnd::ParseStages("frame,window,fft,magnitude,mel,log,dct,quantise", stages));
+        REQUIRE(stages.size() == 8);
+        CHECK(stages.front() == FeatureStage::frame);
+        CHECK(stages[3] == FeatureStage::magnitude);
+        CHECK(stages.back() == FeatureStage::quantise);
+
+        CHECK_FALSE(AudioFrontEnd::ParseStages("frame,fft,cepstrum", stages));
+        CHECK(stages.empty());
+        CHECK_FALSE(AudioFrontEnd::ParseStages("frame,,fft", stages));
+    }
+
+    SECTION("Validation")
+    {
+        const AudioFrontEndParams params = MfccFrontEndParams();
+
+        REQUIRE(AudioFrontEnd::ParseStages("frame,window,fft,magnitude,mel,log,dct", stages));
+        AudioFrontEnd mfcc(stages, params);
+        REQUIRE(mfcc.IsValid());
+        CHECK(mfcc.GetNumFeatures() == 10);
+        CHECK(mfcc.GetNumBlockFeatures() == 10);
+
+        REQUIRE(AudioFrontEnd::ParseStages("frame,window,fft,power,mel,decibel", stages));
+        CHECK(AudioFrontEnd(stages, params).GetNumFeatures() == 40);
+
+        REQUIRE(AudioFrontEnd::ParseStages("frame,fft,power", stages));
+        CHECK(AudioFrontEnd(stages, params).GetNumFeatures() == 513);
+
+        /* Out of order, missing or conflicting stages. */
+        REQUIRE(AudioFrontEnd::ParseStages("frame,fft,window,power", stages));
+        CHECK_FALSE(AudioFrontEnd(stages, params).IsValid());
+        REQUIRE(AudioFrontEnd::ParseStages("frame,fft,mel,log", stages));
+        CHECK_FALSE(AudioFrontEnd(stages, params).IsValid());
+        REQUIRE(AudioFrontEnd::ParseStages("frame,fft,power,magnitude", stages));
+        CHECK_FALSE(AudioFrontEnd(stages, params).IsValid());
+        REQUIRE(AudioFrontEnd::ParseStages("frame,fft,power,dct", stages));
+        CHECK_FALSE(AudioFrontEnd(stages, params).IsValid());
+
+        /* Block stages need enough frames. */
+        REQUIRE(AudioFrontEnd::ParseStages("frame,window,fft,power,mel,log,dct,deltas", stages));
+        CHECK_FALSE(AudioFrontEnd(stages, params).IsValid());
+        AudioFrontEndParams blockParams = params;
+        blockParams.m_numFrames = 8;
+        blockParams.m_frameStride = 320;
+        CHECK_FALSE(AudioFrontEnd(stages, blockParams).IsValid());
+        blockParams.m_numFrames = 9;
+        AudioFrontEnd block(stages, blockParams);
+        REQUIRE(block.IsValid());
+        CHECK(block.GetNumBlockFeatures() == 30);
+
+        /* Frames can't be quantised ahead of block stages. */
+        stages.push_back(FeatureStage::quantise);
+        AudioFrontEnd blockQuant(stages, blockParams);
+        REQUIRE(blockQuant.IsValid());
+        std::vector<int8_t> features(blockQuant.GetNumFeatures());
+        const std::vector<int16_t> audio = MakeAudio(640);
+        CHECK_FALSE(blockQuant.ComputeFrame(audio.data(), audio.size(), features.data()));
+    }
+}
+
+TEST_CASE("Audio front end matches MFCC")
+{
+    const AudioFrontEndParams params = MfccFrontEndParams();
+    arm::app::audio::MFCC mfcc(arm::app::audio::MfccParams(
+        params.m_samplingFreq, params.m_numMelBins, params.m_melLoFreq, params.m_melHiFreq,
+        params.m_numDctCoeffs, params.m_frameLen, params.m_useHtkMethod));
+    mfcc.Init();
+
+    std::vector<FeatureStage> stages;
+    REQUIRE(AudioFrontEnd::ParseStages("frame,window,fft,magnitude,mel,log,dct,quantise", stages));
+    AudioFrontEnd frontEnd(stages, params);
+    REQUIRE(frontEnd.IsValid());
+
+    const std::vector<int16_t> audio = MakeAudio(4 * params.m_frameLen);
+    std::vector<float> features(frontEnd.GetNumFeatures());
+    std::vector<int8_t> quantFeatures(frontEnd.GetNumFeatures());
+
+    /* Full frames, and a short one being zero padded. */
+    for (const size_t offset : {0u, 640u, 1280u, 2500u}) {
+        const size_t len = std::min<size_t>(params.m_frameLen, audio.size() - offset);
+
+        REQUIRE(frontEnd.ComputeFrame(audio.data() + offset, len, features.data()));
+        CHECK(features == mfcc.MfccCompute(audio.data() + offset, len));
+
+        REQUIRE(frontEnd.ComputeFrame(audio.data() + offset, len, quantFeatures.data()));
+        CHECK(quantFeatures == mfcc.MfccComputeQuant<int8_t>(audio.data() + offset, len,
+                                                             params.m_quantScale, params.m_quantOffset));
+    }
+}
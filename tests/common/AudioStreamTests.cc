@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AudioRingBuffer.hpp"
+#include "WavFile.hpp"
+
+#include <catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+using arm::app::audio::AudioRingBuffer;
+
+TEST_CASE("Common: Audio ring buffer")
+{
+    AudioRingBuffer ring(8);
+    std::vector<int16_t> in(12);
+    std::iota(in.begin(), in.end(), 1);
+    std::vector<int16_t> out(12, 0);
+
+    REQUIRE(ring.Capacity() == 8);
+    REQUIRE(ring.Available() == 0);
+    REQUIRE(ring.Read(out.data(), out.size()) == 0);
+
+    SECTION("Reads what was written, across the wrap around")
+    {
+        REQUIRE(ring.Write(in.data(), 6));
+        REQUIRE(ring.Read(out.data(), 4) == 4);
+        REQUIRE(ring.Write(in.data() + 6, 5));
+        REQUIRE(ring.Available() == 7);
+        REQUIRE(ring.Read(out.data() + 4, out.size()) == 7);
+        REQUIRE(std::vector<int16_t>(out.begin(), out.begin() + 11) ==
+                std::vector<int16_t>(in.begin(), in.begin() + 11));
+        REQUIRE(ring.GetOverrunCount() == 0);
+    }
+
+    SECTION("Overwrites the oldest samples when full")
+    {
+        REQUIRE(ring.Write(in.data(), 6));
+        REQUIRE_FALSE(ring.Write(in.data() + 6, 4));
+        REQUIRE(ring.GetOverrunCount() == 2);
+        REQUIRE(ring.Read(out.data(), out.size()) == 8);
+        REQUIRE(out[0] == 3);
+        REQUIRE(out[7] == 10);
+    }
+
+    SECTION("Keeps the end of writes larger than the capacity")
+    {
+        REQUIRE(ring.Write(in.data(), 2));
+        REQUIRE_FALSE(ring.Write(in.data(), in.size()));
+        REQUIRE(ring.GetOverrunCount() == 6);
+        REQUIRE(ring.Read(out.data(), out.size()) == 8);
+        REQUIRE(out[0] == 5);
+        REQUIRE(out[7] == 12);
+    }
+
+    SECTION("Clear")
+    {
+        ring.Write(in.data(), in.size());
+        ring.Clear();
+        REQUIRE(ring.Available() == 0);
+        REQUIRE(ring.GetOverrunCount() == 0);
+    }
+}
+
+TEST_CASE("Common: WAV file round trip")
+{
+    const char* path = "wav_file_test.wav";
+    const std::vector<int16_t> samples{0, 1, -1, 32767, -32768, 1234, -4321};
+    std::vector<int16_t> read{42};
+    uint32_t sampleRate = 0;
+
+    SECTION("Mono")
+    {
+        REQUIRE(arm::app::audio::WriteWav(path, samples.data(), samples.size(), 48000));
+        REQUIRE(arm::app::audio::ReadWav(path, read, sampleRate));
+        REQUIRE(sampleRate == 48000);
+        REQUIRE(read == samples);
+    }
+
+    SECTION("Stereo is mixed down, unknown chunks skipped")
+    {
+        const uint8_t wav[] = {
+            'R', 'I', 'F', 'F', 56, 0, 0, 0, 'W', 'A', 'V', 'E',
+            'L', 'I', 'S', 'T', 3, 0, 0, 0, 'a', 'b', 'c', 0,
+            'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0, 2, 0,
+            0x80, 0x3E, 0, 0, 0, 0xFA, 0, 0, 4, 0, 16, 0,
+            'd', 'a', 't', 'a', 8, 0, 0, 0,
+            10, 0, 20, 0, 0xF6, 0xFF, 0xEC, 0xFF};
+        FILE* f = std::fopen(path, "wb");
+        REQUIRE(f);
+        std::fwrite(wav, 1, sizeof(wav), f);
+        std::fclose(f);
+
+        REQUIRE(arm::app::audio::ReadWav(path, read, sampleRate));
+        REQUIRE(sampleRate == 16000);
+        REQUIRE(read == std::vector<int16_t>{15, -15});
+    }
+
+    SECTION("Not a WAV file")
+    {
+        FILE* f = std::fopen(path, "wb");
+        REQUIRE(f);
+        std::fputs("not a wav file", f);
+        std::fclose(f);
+
+        REQUIRE_FALSE(arm::app::audio::ReadWav(path, read, sampleRate));
+        REQUIRE(read.empty());
+    }
+
+    std::remove(path);
+}
@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DataPack.hpp"
+
+#include <catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    struct TestSample {
+        std::string name;
+        std::string label;
+        arm::app::DataPackType type;
+        std::vector<uint8_t> data;
+        uint32_t dims[3];
+    };
+
+    size_t Align(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /* Same layout as scripts/py/gen_data_pack.py. Returned as uint64_t words to keep the pack aligned. */
+    std::vector<uint64_t> MakePack(const std::vector<TestSample>& samples, uint32_t alignment, size_t& len)
+    {
+        std::string strings(1, '\0');
+        std::vector<arm::app::DataPackEntry> entries(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            entries[i].m_nameOffset = strings.size();
+            strings += samples[i].name + '\0';
+            entries[i].m_labelOffset = 0;
+            if (!samples[i].label.empty()) {
+                entries[i].m_labelOffset = strings.size();
+                strings += samples[i].label + '\0';
+            }
+            entries[i].m_type = samples[i].type;
+            std::memcpy(entries[i].m_dims, samples[i].dims, sizeof(entries[i].m_dims));
+            entries[i].m_size = samples[i].data.size();
+        }
+
+        arm::app::DataPackHeader header{};
+        header.m_magic = arm::app::ms_dataPackMagic;
+        header.m_version = arm::app::ms_dataPackVersion;
+        header.m_headerSize = sizeof(header);
+        header.m_count = samples.size();
+        header.m_entrySize = sizeof(arm::app::DataPackEntry);
+        header.m_stringsOffset = sizeof(header) + entries.size() * sizeof(arm::app::DataPackEntry);
+        header.m_stringsSize = strings.size();
+        header.m_alignment = alignment;
+
+        len = header.m_stringsOffset + strings.size();
+        for (auto& entry : entries) {
+            len = Align(len, alignment);
+            entry.m_offset = len;
+            len += entry.m_size;
+        }
+
+        std::vector<uint64_t> words(Align(len, sizeof(uint64_t)) / sizeof(uint64_t));
+        auto* pack = reinterpret_cast<uint8_t*>(words.data());
+        std::memcpy(pack, &header, sizeof(header));
+        std::memcpy(pack + sizeof(header), entries.data(), entries.size() * sizeof(arm::app::DataPackEntry));
+        std::memcpy(pack + header.m_stringsOffset, strings.data(), strings.size());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            std::memcpy(pack + entries[i].m_offset, samples[i].data.data(), samples[i].data.size());
+        }
+        return words;
+    }
+
+    std::vector<TestSample> MakeSamples()
+    {
+        std::vector<uint8_t> audio(2 * 1000);
+        for (size_t i = 0; i < 1000; ++i) {
+            const auto sample = static_cast<int16_t>(i * 31 - 16000);
+            std::memcpy(audio.data() + 2 * i, &sample, sizeof(sample));
+        }
+        std::vector<uint8_t> image(4 * 3 * 3);
+        for (size_t i = 0; i < image.size(); ++i) {
+            image[i] = static_cast<uint8_t>(i);
+        }
+
+        return {
+            {"yes_0.wav", "yes", arm::app::DataPackType::Int16, audio, {1000, 1, 1}},
+            {"cat.bmp", "", arm::app::DataPackType::Uint8, image, {4, 3, 3}},
+            {"no_1.wav", "no", arm::app::DataPackType::Int16,
+                std::vector<uint8_t>(audio.begin(), audio.begin() + 10), {5, 1, 1}},
+        };
+    }
+} /* namespace */
+
+TEST_CASE("Common: Data pack parsing")
+{
+    const auto samples = MakeSamples();
+    size_t len = 0;
+    auto words = MakePack(samples, 16, len);
+    auto* pack = reinterpret_cast<uint8_t*>(words.data());
+
+    arm::app::DataPack dataPack;
+
+    SECTION("Valid pack")
+    {
+        REQUIRE(dataPack.Attach(pack, len));
+        REQUIRE(dataPack.GetCount() == 3);
+
+        REQUIRE(std::string(dataPack.GetFilename(0)) == "yes_0.wav");
+        REQUIRE(std::string(dataPack.GetLabel(0)) == "yes");
+        REQUIRE(dataPack.GetAudioArraySize(0) == 1000);
+        REQUIRE(dataPack.GetAudioArray(0)[1] == 31 - 16000);
+        REQUIRE(dataPack.GetImgArray(0) == nullptr);
+
+        /* Payloads are used in place and aligned. */
+        REQUIRE(reinterpret_cast<const uint8_t*>(dataPack.GetData(1)) == pack + dataPack.GetEntry(1)->m_offset);
+        REQUIRE((reinterpret_cast<uintptr_t>(dataPack.GetData(1)) & 15) == 0);
+        REQUIRE(std::string(dataPack.GetLabel(1)).empty());
+        REQUIRE(dataPack.GetImgArray(1)[35] == 35);
+        REQUIRE(dataPack.GetEntry(1)->m_dims[0] == 4);
+        REQUIRE(dataPack.GetAudioArray(1) == nullptr);
+        REQUIRE(dataPack.GetAudioArraySize(1) == 0);
+
+        REQUIRE(dataPack.GetAudioArraySize(2) == 5);
+        REQUIRE(std::string(dataPack.GetLabel(2)) == "no");
+
+        REQUIRE(dataPack.GetFilename(3) == nullptr);
+        REQUIRE(dataPack.GetLabel(3) == nullptr);
+        REQUIRE(dataPack.GetData(3) == nullptr);
+        REQUIRE(dataPack.GetAudioArray(3) == nullptr);
+    }
+
+    SECTION("Invalid packs are refused")
+    {
+        REQUIRE_FALSE(dataPack.Attach(nullptr, len));
+        REQUIRE_FALSE(dataPack.Attach(pack, 16));
+
+        /* Last payload truncated. */
+        REQUIRE_FALSE(dataPack.Attach(pack, len - 1));
+
+        auto badMagic = words;
+        reinterpret_cast<uint8_t*>(badMagic.data())[0] = 0;
+        REQUIRE_FALSE(dataPack.Attach(reinterpret_cast<uint8_t*>(badMagic.data()), len));
+
+        auto badName = words;
+        auto* entries = reinterpret_cast<arm::app::DataPackEntry*>(
+            reinterpret_cast<uint8_t*>(badName.data()) + sizeof(arm::app::DataPackHeader));
+        entries[2].m_nameOffset = 0xFFFF;
+        REQUIRE_FALSE(dataPack.Attach(reinterpret_cast<uint8_t*>(badName.data()), len));
+
+        auto misaligned = words;
+        entries = reinterpret_cast<arm::app::DataPackEntry*>(
+            reinterpret_cast<uint8_t*>(misaligned.data()) + sizeof(arm::app::DataPackHeader));
+        entries[1].m_offset += 1;
+        REQUIRE_FALSE(dataPack.Attach(reinterpret_cast<uint8_t*>(misaligned.data()), len));
+
+        REQUIRE(dataPack.GetCount() == 0);
+        REQUIRE(dataPack.GetFilename(0) == nullptr);
+    }
+}
+
+TEST_CASE("Common: Data pack file mapping")
+{
+    const auto samples = MakeSamples();
+    size_t len = 0;
+    const auto words = MakePack(samples, 32, len);
+    const char* path = "data_pack_test.bin";
+
+    arm::app::DataPack dataPack;
+
+    SECTION("Pack file")
+    {
+        FILE* f = std::fopen(path, "wb");
+        REQUIRE(f);
+        std::fwrite(words.data(), 1, len, f);
+        std::fclose(f);
+
+        REQUIRE(dataPack.Open(path));
+        REQUIRE(dataPack.GetCount() == 3);
+        REQUIRE(0 == std::memcmp(dataPack.GetAudioArray(0), samples[0].data.data(), samples[0].data.size()));
+        REQUIRE(std::string(dataPack.GetFilename(2)) == "no_1.wav");
+    }
+
+    SECTION("Missing file")
+    {
+        REQUIRE_FALSE(dataPack.Open("does_not_exist.bin"));
+        REQUIRE(dataPack.GetCount() == 0);
+    }
+
+    dataPack.Close();
+    std::remove(path);
+}
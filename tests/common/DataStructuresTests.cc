@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DataStructures.hpp"
+
+#include <catch.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using arm::app::Array2d;
+using arm::app::Array2dLayout;
+
+template<typename Array>
+static void Fill(Array& array)
+{
+    for (size_t i = 0; i < array.size(0); ++i) {
+        for (size_t j = 0; j < array.size(1); ++j) {
+            array(i, j) = static_cast<float>(i * 10 + j);
+        }
+    }
+}
+
+TEST_CASE("Array2d layouts")
+{
+    SECTION("Row-major")
+    {
+        Array2d<float> array(2, 3);
+        Fill(array);
+        CHECK(std::vector<float>(array.begin(), array.end()) == std::vector<float>{0, 1, 2, 10, 11, 12});
+
+        CHECK(array.row(1).IsContiguous());
+        CHECK(array.row(1).data() == &array(1, 0));
+        CHECK(array.row(1)[2] == 12);
+        CHECK_FALSE(array.col(2).IsContiguous());
+        CHECK(array.col(2).size() == 2);
+        CHECK(array.col(2)[1] == 12);
+    }
+
+    SECTION("Column-major")
+    {
+        Array2d<float, Array2dLayout::colMajor> array(2, 3);
+        Fill(array);
+        CHECK(std::vector<float>(array.begin(), array.end()) == std::vector<float>{0, 10, 1, 11, 2, 12});
+
+        CHECK(array.col(2).IsContiguous());
+        CHECK(array.col(2).data() == &array(0, 2));
+        CHECK(array.col(2)[1] == 12);
+        CHECK(array.row(1).stride() == 2);
+        CHECK(array.row(1).size() == 3);
+        CHECK(array.row(1)[2] == 12);
+    }
+}
+
+TEST_CASE("Array2d storage")
+{
+    for (const unsigned cols : {1u, 3u, 13u}) {
+        Array2d<float> array(7, cols);
+        CHECK(reinterpret_cast<uintptr_t>(array.data()) % Array2d<float>::ms_alignment == 0);
+    }
+
+    Array2d<float> array(2, 3);
+    Fill(array);
+    const float* data = array.data();
+
+    Array2d<float> moved(std::move(array));
+    CHECK(moved.data() == data);
+    CHECK(moved(1, 2) == 12);
+    CHECK(array.data() == nullptr);
+    CHECK(array.totalSize() == 0);
+
+    Array2d<float> assigned(1, 1);
+    assigned = std::move(moved);
+    CHECK(assigned.data() == data);
+    CHECK(assigned.size(0) == 2);
+    CHECK(assigned.size(1) == 3);
+    CHECK(moved.data() == nullptr);
+}
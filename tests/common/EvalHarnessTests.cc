@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "EvalHarness.hpp"
+
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace arm::app::eval;
+
+TEST_CASE("Common: Eval latency percentiles")
+{
+    LatencyStats stats;
+    REQUIRE(stats.Percentile(50) == 0);
+    REQUIRE(stats.Mean() == 0);
+
+    for (uint64_t v = 100; v >= 1; --v) {
+        stats.Add(v);
+    }
+    REQUIRE(stats.Count() == 100);
+    REQUIRE(stats.Mean() == Approx(50.5));
+    REQUIRE(stats.Percentile(0) == 1);
+    REQUIRE(stats.Percentile(50) == 50);
+    REQUIRE(stats.Percentile(90) == 90);
+    REQUIRE(stats.Percentile(99) == 99);
+    REQUIRE(stats.Percentile(100) == 100);
+
+    /* Samples added after a query are taken into account. */
+    stats.Add(1000);
+    REQUIRE(stats.Percentile(100) == 1000);
+}
+
+TEST_CASE("Common: Eval ROC AUC")
+{
+    /* Perfect separation, inverted separation, then every score tied. */
+    REQUIRE(RocAuc({0.1, 0.2, 0.8, 0.9}, {false, false, true, true}) == Approx(1.0));
+    REQUIRE(RocAuc({0.9, 0.8, 0.2, 0.1}, {false, false, true, true}) == Approx(0.0));
+    REQUIRE(RocAuc({0.5, 0.5, 0.5, 0.5}, {false, true, false, true}) == Approx(0.5));
+
+    /* One of the four positive/negative pairs is misordered. */
+    REQUIRE(RocAuc({0.1, 0.6, 0.5, 0.9}, {false, false, true, true}) == Approx(0.75));
+
+    /* Single class. */
+    REQUIRE(RocAuc({0.1, 0.2}, {true, true}) == Approx(0.5));
+}
+
+TEST_CASE("Common: Eval average precision")
+{
+    const std::vector<std::vector<Box>> truth = {
+        {{10, 10, 20, 20}, {50, 50, 10, 10}},
+        {{0, 0, 40, 40}},
+    };
+
+    REQUIRE(Iou({10, 10, 20, 20}, {10, 10, 20, 20}) == Approx(1.0));
+    REQUIRE(Iou({0, 0, 10, 10}, {5, 0, 10, 10}) == Approx(50.0 / 150.0));
+    REQUIRE(Iou({0, 0, 10, 10}, {20, 20, 10, 10}) == 0);
+
+    SECTION("All found")
+    {
+        const std::vector<ScoredBox> detections = {
+            {0, 0.9f, {11, 11, 20, 20}},
+            {0, 0.8f, {50, 50, 10, 10}},
+            {1, 0.7f, {0, 0, 38, 40}},
+        };
+        REQUIRE(AveragePrecision(detections, truth, 0.5f) == Approx(1.0));
+    }
+
+    SECTION("False positive ranked first, one box missed")
+    {
+        const std::vector<ScoredBox> detections = {
+            {1, 0.95f, {100, 100, 10, 10}},
+            {0, 0.9f, {10, 10, 20, 20}},
+            {0, 0.85f, {10, 10, 20, 20}},   /* Duplicate: false positive. */
+            {1, 0.5f, {0, 0, 40, 40}},
+        };
+        /* Recall 1/3 at precision 1/2, then 2/3 at precision 1/2. */
+        REQUIRE(AveragePrecision(detections, truth, 0.5f) == Approx(1.0 / 3.0));
+    }
+
+    SECTION("Nothing to find")
+    {
+        REQUIRE(AveragePrecision({}, {{}, {}}, 0.5f) == Approx(1.0));
+        REQUIRE(AveragePrecision({{0, 0.9f, {0, 0, 1, 1}}}, {{}}, 0.5f) == Approx(0.0));
+    }
+}
+
+TEST_CASE("Common: Eval box labels")
+{
+    std::vector<Box> boxes;
+    REQUIRE(ParseBoxes("", boxes));
+    REQUIRE(boxes.empty());
+
+    REQUIRE(ParseBoxes("1 2 3 4;5.5 6 7 8", boxes));
+    REQUIRE(boxes.size() == 2);
+    REQUIRE(boxes[1].x0 == Approx(5.5));
+    REQUIRE(boxes[1].h == Approx(8));
+
+    REQUIRE_FALSE(ParseBoxes("1 2 3", boxes));
+    REQUIRE_FALSE(ParseBoxes("1 2 3 4,5 6 7 8", boxes));
+    REQUIRE_FALSE(ParseBoxes("1 2 0 4", boxes));
+    REQUIRE_FALSE(ParseBoxes(nullptr, boxes));
+    REQUIRE(boxes.empty());
+
+    REQUIRE(MatchesLabel("yes", 2, "yes"));
+    REQUIRE(MatchesLabel("yes", 2, "2"));
+    REQUIRE_FALSE(MatchesLabel("yes", 2, "no"));
+}
+
+TEST_CASE("Common: Eval summary")
+{
+    const char* path = "eval_summary_test.json";
+    EvalReport report("test", "data \"pack\".bin");
+    report.CountEntry(true);
+    report.CountEntry(false);
+    report.SetMetric("top1_accuracy", 0.5);
+    report.StartStage();
+    report.StopStage("inference");
+    REQUIRE(report.WriteJson(path));
+
+    std::ifstream file(path);
+    std::stringstream json;
+    json << file.rdbuf();
+    REQUIRE(json.str().find("\"use_case\": \"test\"") != std::string::npos);
+    REQUIRE(json.str().find("\"data\": \"data \\\"pack\\\".bin\"") != std::string::npos);
+    REQUIRE(json.str().find("\"entries\": 2,\n  \"failed\": 1") != std::string::npos);
+    REQUIRE(json.str().find("\"top1_accuracy\": 0.500000") != std::string::npos);
+    REQUIRE(json.str().find("\"inference\": {\"count\": 1,") != std::string::npos);
+    std::remove(path);
+}
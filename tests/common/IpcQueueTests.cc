@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ipc_queue.h"
+
+#include <catch.hpp>
+#include <functional>
+#include <thread>
+
+TEST_CASE("Common: IPC queue order and capacity")
+{
+    const ipc_doorbell* db = platform_ipc_doorbell();
+    static ipc_queue queue;
+    ipc_queue_init(&queue, db);
+
+    ipc_msg msg{};
+    REQUIRE_FALSE(ipc_queue_pop(&queue, &msg, db));
+
+    for (uint32_t i = 0; i < IPC_QUEUE_DEPTH; ++i) {
+        msg.id = i;
+        REQUIRE(ipc_queue_push(&queue, &msg, db));
+    }
+    REQUIRE(ipc_queue_count(&queue, db) == IPC_QUEUE_DEPTH);
+    REQUIRE_FALSE(ipc_queue_push(&queue, &msg, db));
+    REQUIRE_FALSE(ipc_queue_push_wait(&queue, &msg, db, 10));
+
+    /* Wrap the indices round a few times. */
+    for (uint32_t i = IPC_QUEUE_DEPTH; i < 5 * IPC_QUEUE_DEPTH; ++i) {
+        REQUIRE(ipc_queue_pop(&queue, &msg, db));
+        REQUIRE(msg.id == i - IPC_QUEUE_DEPTH);
+        msg.id = i;
+        REQUIRE(ipc_queue_push(&queue, &msg, db));
+    }
+    for (uint32_t i = 4 * IPC_QUEUE_DEPTH; i < 5 * IPC_QUEUE_DEPTH; ++i) {
+        REQUIRE(ipc_queue_pop(&queue, &msg, db));
+        REQUIRE(msg.id == i);
+    }
+    REQUIRE(ipc_queue_count(&queue, db) == 0);
+    REQUIRE_FALSE(ipc_queue_pop_wait(&queue, &msg, db, 10));
+}
+
+TEST_CASE("Common: IPC queue producer/consumer pipeline")
+{
+    /* Audio blocks are handed from the producer (eg VAD + KWS core) to the
+     * consumer (eg ASR core) and given back, never copied. */
+    constexpr size_t numBuffers = 4;
+    constexpr size_t blockSamples = 256;
+    constexpr uint32_t numBlocks = 20000;
+    constexpr uint32_t msgAudio = 1;
+
+    const ipc_doorbell* db = platform_ipc_doorbell();
+    static ipc_queue fullQueue;
+    static ipc_queue freeQueue;
+    alignas(IPC_QUEUE_LINE_SIZE) static int16_t buffers[numBuffers][blockSamples];
+
+    ipc_queue_init(&fullQueue, db);
+    ipc_queue_init(&freeQueue, db);
+
+    /* The consumer owns the buffers to begin with. */
+    for (auto& buffer : buffers) {
+        ipc_msg msg{msgAudio, 0, reinterpret_cast<uintptr_t>(buffer), sizeof(buffer)};
+        REQUIRE(ipc_queue_push(&freeQueue, &msg, db));
+    }
+
+    bool consumerOk = true;
+    uint32_t received = 0;
+
+    std::thread consumer([&]() {
+        ipc_msg msg{};
+        while (received < numBlocks && ipc_queue_pop_wait(&fullQueue, &msg, db, 1000)) {
+            const auto* samples = reinterpret_cast<const int16_t*>(msg.data);
+            const bool inPool = msg.data >= reinterpret_cast<uintptr_t>(buffers) &&
+                                msg.data < reinterpret_cast<uintptr_t>(buffers + numBuffers);
+            if (!inPool || msg.arg != received ||
+                samples[0] != static_cast<int16_t>(received) ||
+                samples[blockSamples - 1] != static_cast<int16_t>(~received)) {
+                consumerOk = false;
+                break;
+            }
+            ++received;
+            if (!ipc_queue_push_wait(&freeQueue, &msg, db, 1000)) {
+                consumerOk = false;
+                break;
+            }
+        }
+    });
+
+    bool producerOk = true;
+    for (uint32_t block = 0; block < numBlocks; ++block) {
+        ipc_msg msg{};
+        if (!ipc_queue_pop_wait(&freeQueue, &msg, db, 1000)) {
+            producerOk = false;
+            break;
+        }
+        auto* samples = reinterpret_cast<int16_t*>(msg.data);
+        samples[0] = static_cast<int16_t>(block);
+        samples[blockSamples - 1] = static_cast<int16_t>(~block);
+        msg.arg = block;
+        if (!ipc_queue_push_wait(&fullQueue, &msg, db, 1000)) {
+            producerOk = false;
+            break;
+        }
+    }
+    consumer.join();
+
+    REQUIRE(producerOk);
+    REQUIRE(consumerOk);
+    REQUIRE(received == numBlocks);
+
+    /* All the buffers are back with the consumer's free queue. */
+    REQUIRE(ipc_queue_count(&freeQueue, db) == numBuffers);
+    REQUIRE(ipc_queue_count(&fullQueue, db) == 0);
+}
+
+namespace {
+
+    /* Doorbell that counts rings and, when armed, runs the other side's
+     * step as this side syncs a slot, between reading the other side's
+     * index and publishing its own: a deterministic interleaving. */
+    struct Interleaving {
+        uint32_t rings{0};
+        const volatile void* trigger{nullptr};
+        std::function<void()> step;
+    } ms_interleaving;
+
+    void InterleavingRing(void*)
+    {
+        ++ms_interleaving.rings;
+    }
+
+    uint32_t InterleavingCount(void*)
+    {
+        return ms_interleaving.rings;
+    }
+
+    bool InterleavingWait(void*, uint32_t count, uint32_t)
+    {
+        return ms_interleaving.rings != count;
+    }
+
+    void InterleavingSync(const void* p, size_t)
+    {
+        if (p == ms_interleaving.trigger) {
+            ms_interleaving.trigger = nullptr;
+            ms_interleaving.step();
+        }
+    }
+
+    const ipc_doorbell ms_interleavingDb {
+        nullptr, InterleavingRing, InterleavingCount, InterleavingWait, InterleavingSync, InterleavingSync
+    };
+
+} /* namespace */
+
+TEST_CASE("Common: IPC queue wakeups are not lost")
+{
+    const ipc_doorbell* db = &ms_interleavingDb;
+    static ipc_queue queue;
+    ipc_msg msg{};
+    uint32_t waitCount = 0;
+
+    SECTION("Consumer empties the queue while a message is pushed")
+    {
+        ipc_queue_init(&queue, db);
+        REQUIRE(ipc_queue_push(&queue, &msg, db));
+
+        /* Once the producer has read tail, the consumer takes the queued
+         * message and finds the queue empty: it would now wait on the doorbell. */
+        ms_interleaving.trigger = &queue.slots[1];
+        ms_interleaving.step = [&]() {
+            ipc_msg popped{};
+            REQUIRE(ipc_queue_pop(&queue, &popped, db));
+            waitCount = db->count(db->ctx);
+            REQUIRE_FALSE(ipc_queue_pop(&queue, &popped, db));
+        };
+        REQUIRE(ipc_queue_push(&queue, &msg, db));
+
+        REQUIRE(ipc_queue_count(&queue, db) == 1);
+        REQUIRE(db->count(db->ctx) != waitCount);
+    }
+
+    SECTION("Producer fills the queue while a message is popped")
+    {
+        ipc_queue_init(&queue, db);
+        for (uint32_t i = 0; i < IPC_QUEUE_DEPTH - 1; ++i) {
+            REQUIRE(ipc_queue_push(&queue, &msg, db));
+        }
+
+        /* Once the consumer has read head, the producer fills the last slot
+         * and finds the queue full: it would now wait on the doorbell. */
+        ms_interleaving.trigger = &queue.slots[0];
+        ms_interleaving.step = [&]() {
+            REQUIRE(ipc_queue_push(&queue, &msg, db));
+            waitCount = db->count(db->ctx);
+            REQUIRE_FALSE(ipc_queue_push(&queue, &msg, db));
+        };
+        REQUIRE(ipc_queue_pop(&queue, &msg, db));
+
+        REQUIRE(ipc_queue_count(&queue, db) == IPC_QUEUE_DEPTH - 1);
+        REQUIRE(db->count(db->ctx) != waitCount);
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ModelLoader.hpp"
+
+#include <catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+    /* Stand-in for a model: only the flatbuffer identifier is checked. */
+    std::vector<uint8_t> MakeModel(size_t size)
+    {
+        std::vector<uint8_t> model(size);
+        for (size_t i = 0; i < size; ++i) {
+            model[i] = static_cast<uint8_t>(i * 7);
+        }
+        std::memcpy(model.data() + 4, "TFL3", 4);
+        return model;
+    }
+
+    /* Same layout as scripts/py/gen_model_container.py. */
+    std::vector<uint8_t> MakeContainer(const std::vector<uint8_t>& model, uint32_t alignment, uint32_t arenaHint)
+    {
+        arm::app::ModelContainerHeader header{};
+        header.m_magic = arm::app::ms_modelContainerMagic;
+        header.m_version = arm::app::ms_modelContainerVersion;
+        header.m_headerSize = sizeof(header);
+        header.m_modelOffset = (sizeof(header) + alignment - 1) / alignment * alignment;
+        header.m_modelSize = model.size();
+        header.m_modelCrc32 = arm::app::Crc32(model.data(), model.size());
+        header.m_alignment = alignment;
+        header.m_arenaHint = arenaHint;
+
+        std::vector<uint8_t> container(header.m_modelOffset + model.size());
+        std::memcpy(container.data(), &header, sizeof(header));
+        std::memcpy(container.data() + header.m_modelOffset, model.data(), model.size());
+        return container;
+    }
+} /* namespace */
+
+TEST_CASE("Common: Model container CRC")
+{
+    const char check[] = "123456789";
+    REQUIRE(arm::app::Crc32(reinterpret_cast<const uint8_t*>(check), 9) == 0xCBF43926);
+    REQUIRE(arm::app::Crc32(nullptr, 0) == 0);
+}
+
+TEST_CASE("Common: Model container parsing")
+{
+    const auto model = MakeModel(1000);
+    auto container = MakeContainer(model, 16, 0x4000);
+    arm::app::LoadedModel loaded;
+
+    SECTION("Valid container")
+    {
+        REQUIRE(arm::app::LoadModelFromContainer(container.data(), container.size(), loaded));
+        REQUIRE(loaded.m_data == container.data() + 32);
+        REQUIRE(loaded.m_size == model.size());
+        REQUIRE(loaded.m_arenaHint == 0x4000);
+
+        /* The arena hint is checked against the application's arena. */
+        REQUIRE(arm::app::ModelFitsArena(loaded, 0x4000));
+        REQUIRE_FALSE(arm::app::ModelFitsArena(loaded, 0x3FFF));
+
+        /* A partition larger than the container is fine. */
+        container.resize(container.size() + 4096);
+        REQUIRE(arm::app::LoadModelFromContainer(container.data(), container.size(), loaded));
+    }
+
+    SECTION("Invalid containers are refused")
+    {
+        REQUIRE_FALSE(arm::app::LoadModelFromContainer(nullptr, container.size(), loaded));
+        REQUIRE_FALSE(arm::app::LoadModelFromContainer(container.data(), 16, loaded));
+        REQUIRE_FALSE(arm::app::LoadModelFromContainer(container.data(), container.size() - 1, loaded));
+
+        auto corrupt = container;
+        corrupt[100] ^= 1;
+        REQUIRE_FALSE(arm::app::LoadModelFromContainer(corrupt.data(), corrupt.size(), loaded));
+
+        auto badMagic = container;
+        badMagic[0] = 0;
+        REQUIRE_FALSE(arm::app::LoadModelFromContainer(badMagic.data(), badMagic.size(), loaded));
+
+        /* Model not at the alignment the header promises. */
+        std::vector<uint8_t> shifted(container.size() + 64);
+        const size_t misalign = 64 - (reinterpret_cast<uintptr_t>(shifted.data()) & 63) + 1;
+        std::memcpy(shifted.data() + misalign, container.data(), container.size());
+        REQUIRE_FALSE(arm::app::LoadModelFromContainer(shifted.data() + misalign, container.size(), loaded));
+
+        REQUIRE(loaded.m_data == nullptr);
+    }
+}
+
+TEST_CASE("Common: Model file mapping")
+{
+    const auto model = MakeModel(2048);
+    const auto container = MakeContainer(model, 64, 0);
+    const char* path = "model_loader_test.bin";
+
+    arm::app::ModelFile file;
+
+    SECTION("Plain model")
+    {
+        FILE* f = std::fopen(path, "wb");
+        REQUIRE(f);
+        std::fwrite(model.data(), 1, model.size(), f);
+        std::fclose(f);
+
+        REQUIRE(file.Open(path));
+        REQUIRE(file.GetModel().m_size == model.size());
+        REQUIRE(0 == std::memcmp(file.GetModel().m_data, model.data(), model.size()));
+    }
+
+    SECTION("Container")
+    {
+        FILE* f = std::fopen(path, "wb");
+        REQUIRE(f);
+        std::fwrite(container.data(), 1, container.size(), f);
+        std::fclose(f);
+
+        REQUIRE(file.Open(path));
+        REQUIRE(file.GetModel().m_size == model.size());
+        REQUIRE(0 == std::memcmp(file.GetModel().m_data, model.data(), model.size()));
+    }
+
+    SECTION("Missing file")
+    {
+        REQUIRE_FALSE(file.Open("does_not_exist.tflite"));
+        REQUIRE(file.GetModel().m_data == nullptr);
+    }
+
+    file.Close();
+    std::remove(path);
+}
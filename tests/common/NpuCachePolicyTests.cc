@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ethosu_cache_policy.h"
+
+#include <catch.hpp>
+
+/* Mock CPU cache: records the operations the policy issues. */
+namespace {
+    struct MockCache {
+        bool enabled = true;
+        uint32_t rangedCleans = 0;
+        uint32_t rangedInvalidates = 0;
+        uint32_t wholeCleans = 0;
+        uint32_t wholeInvalidates = 0;
+        uint32_t barriers = 0;
+        uintptr_t lastAddr = 0;
+        size_t lastBytes = 0;
+        uint64_t cycles = 0;
+    } s_mock;
+
+    bool MockEnabled() { return s_mock.enabled; }
+    void MockCleanRange(uintptr_t addr, size_t bytes)
+    {
+        ++s_mock.rangedCleans;
+        s_mock.lastAddr = addr;
+        s_mock.lastBytes = bytes;
+        s_mock.cycles += bytes / 32;
+    }
+    void MockCleanInvalidateRange(uintptr_t addr, size_t bytes)
+    {
+        ++s_mock.rangedInvalidates;
+        s_mock.lastAddr = addr;
+        s_mock.lastBytes = bytes;
+        s_mock.cycles += bytes / 32;
+    }
+    void MockCleanAll() { ++s_mock.wholeCleans; s_mock.cycles += 1000; }
+    void MockCleanInvalidateAll() { ++s_mock.wholeInvalidates; s_mock.cycles += 1000; }
+    void MockBarrier() { ++s_mock.barriers; }
+    uint64_t MockCycles() { return s_mock.cycles; }
+
+    const ethosu_cache_ops s_mockOps = {
+        MockEnabled,
+        MockCleanRange,
+        MockCleanInvalidateRange,
+        MockCleanAll,
+        MockCleanInvalidateAll,
+        MockBarrier,
+        MockCycles
+    };
+
+    /* Stand-ins for the model, tensor arena and a TCM area. */
+    alignas(32) uint8_t s_model[4096];
+    alignas(32) uint8_t s_arena[64 * 1024];
+    alignas(32) uint8_t s_tcm[1024];
+
+    void InitPolicy()
+    {
+        s_mock = MockCache{};
+        ethosu_cache_policy_init(&s_mockOps);
+        REQUIRE(ethosu_cache_policy_add_region(s_arena, 1024, ETHOSU_CACHE_REGION_IO));
+        REQUIRE(ethosu_cache_policy_add_region(s_arena, sizeof(s_arena), ETHOSU_CACHE_REGION_TENSOR_ARENA));
+        REQUIRE(ethosu_cache_policy_add_region(s_model, sizeof(s_model), ETHOSU_CACHE_REGION_RO_MODEL));
+        REQUIRE(ethosu_cache_policy_add_region(s_tcm, sizeof(s_tcm), ETHOSU_CACHE_REGION_NON_CACHEABLE));
+    }
+} /* namespace */
+
+TEST_CASE("Common: NPU cache policy region classes")
+{
+    InitPolicy();
+
+    REQUIRE(ethosu_cache_policy_get_region_type(s_arena, 512) == ETHOSU_CACHE_REGION_IO);
+    REQUIRE(ethosu_cache_policy_get_region_type(s_arena + 512, 1024) == ETHOSU_CACHE_REGION_TENSOR_ARENA);
+    REQUIRE(ethosu_cache_policy_get_region_type(s_model, sizeof(s_model)) == ETHOSU_CACHE_REGION_RO_MODEL);
+    REQUIRE(ethosu_cache_policy_get_region_type(s_tcm + 16, 16) == ETHOSU_CACHE_REGION_NON_CACHEABLE);
+
+    /* An area spilling out of the model is not read-only. */
+    REQUIRE(ethosu_cache_policy_get_region_type(s_model, sizeof(s_model) + 1) == ETHOSU_CACHE_REGION_DEFAULT);
+
+    REQUIRE_FALSE(ethosu_cache_policy_needs_maintenance(s_model, sizeof(s_model)));
+    REQUIRE_FALSE(ethosu_cache_policy_needs_maintenance(s_tcm, sizeof(s_tcm)));
+    REQUIRE(ethosu_cache_policy_needs_maintenance(s_arena, 256));
+    REQUIRE(ethosu_cache_policy_needs_maintenance(nullptr, 0));
+
+    s_mock.enabled = false;
+    REQUIRE_FALSE(ethosu_cache_policy_needs_maintenance(s_arena, 256));
+    s_mock.enabled = true;
+
+    /* Write-through memory is invalidated but never cleaned, and keeps the classes within it. */
+    REQUIRE(ethosu_cache_policy_needs_clean(s_arena, 256));
+    REQUIRE(ethosu_cache_policy_add_region(s_arena, sizeof(s_arena), ETHOSU_CACHE_REGION_WRITE_THROUGH));
+    REQUIRE(ethosu_cache_policy_get_region_type(s_arena, 512) == ETHOSU_CACHE_REGION_IO);
+    REQUIRE(ethosu_cache_policy_needs_maintenance(s_arena, 256));
+    REQUIRE_FALSE(ethosu_cache_policy_needs_clean(s_arena, 256));
+    REQUIRE_FALSE(ethosu_cache_policy_needs_clean(s_model, sizeof(s_model)));
+    REQUIRE(ethosu_cache_policy_needs_clean(nullptr, 0));
+
+    /* Table full. */
+    for (size_t i = 5; i < ETHOSU_CACHE_POLICY_MAX_REGIONS; ++i) {
+        REQUIRE(ethosu_cache_policy_add_region(s_tcm, 1, ETHOSU_CACHE_REGION_DEFAULT));
+    }
+    REQUIRE_FALSE(ethosu_cache_policy_add_region(s_tcm, 1, ETHOSU_CACHE_REGION_DEFAULT));
+}
+
+TEST_CASE("Common: NPU cache policy maintenance")
+{
+    InitPolicy();
+    ethosu_cache_policy_set_breakpoint(8 * 1024);
+
+    SECTION("Small areas are maintained by address on whole lines")
+    {
+        ethosu_cache_policy_clean(s_arena + 40, 100);
+        REQUIRE(s_mock.rangedCleans == 1);
+        REQUIRE(s_mock.lastAddr == reinterpret_cast<uintptr_t>(s_arena + 32));
+        REQUIRE(s_mock.lastBytes == 128);
+
+        ethosu_cache_policy_invalidate(s_arena, 64);
+        REQUIRE(s_mock.rangedInvalidates == 1);
+        REQUIRE(s_mock.lastBytes == 64);
+        REQUIRE(s_mock.wholeCleans == 0);
+        REQUIRE(s_mock.wholeInvalidates == 0);
+    }
+
+    SECTION("Large areas use the whole cache once per inference")
+    {
+        ethosu_cache_policy_clean(s_arena, sizeof(s_arena));
+        ethosu_cache_policy_clean(s_arena, sizeof(s_arena));
+        ethosu_cache_policy_clean(s_arena, 64);
+        REQUIRE(s_mock.wholeCleans == 1);
+        REQUIRE(s_mock.rangedCleans == 0);
+
+        ethosu_cache_policy_invalidate(nullptr, 0);
+        ethosu_cache_policy_invalidate(s_arena, 64);
+        REQUIRE(s_mock.wholeInvalidates == 1);
+        REQUIRE(s_mock.rangedInvalidates == 0);
+
+        /* Next inference. */
+        ethosu_cache_policy_clear_state();
+        ethosu_cache_policy_clean(s_arena, sizeof(s_arena));
+        REQUIRE(s_mock.wholeCleans == 2);
+    }
+
+    SECTION("Statistics")
+    {
+        ethosu_cache_policy_clean(s_arena, 64);
+        ethosu_cache_policy_clean(s_arena, sizeof(s_arena));
+        ethosu_cache_policy_invalidate(s_arena, 64);
+        ethosu_cache_policy_skip();
+
+        ethosu_cache_stats stats;
+        ethosu_cache_policy_get_stats(&stats);
+        REQUIRE(stats.ranged_cleans == 1);
+        REQUIRE(stats.whole_cleans == 1);
+        REQUIRE(stats.ranged_invalidates == 1);
+        REQUIRE(stats.whole_invalidates == 0);
+        REQUIRE(stats.skipped == 1);
+        REQUIRE(stats.cycles == 64 / 32 + 1000 + 64 / 32);
+        REQUIRE(s_mock.barriers == 1);
+
+        ethosu_cache_policy_reset_stats();
+        ethosu_cache_policy_get_stats(&stats);
+        REQUIRE(stats.cycles == 0);
+    }
+}
@@ -16,6 +16,7 @@
  */
 #include "PlatformMath.hpp"
 #include <catch.hpp>
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -704,3 +705,221 @@ TEST_CASE("Test SoftmaxF32")
         TestSoftmaxF32(input, expectedOutput);
     }
 }
+
+TEST_CASE("Test strided MeanF32, StdDevF32 and DotProductF32")
+{
+    /* 3x4 row major matrix. */
+    const std::vector<float> matrix {
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12
+    };
+    const uint32_t rows = 3;
+    const uint32_t cols = 4;
+
+    /* Second column: 2, 6, 10. */
+    const float mean = arm::app::math::MathUtils::MeanF32(matrix.data() + 1, rows, cols);
+    CHECK(mean == Approx(6.f));
+    CHECK(arm::app::math::MathUtils::StdDevF32(matrix.data() + 1, rows, cols, mean) ==
+          Approx(std::sqrt(32.f / 3)));
+
+    /* Stride 1 is the contiguous function. */
+    CHECK(arm::app::math::MathUtils::MeanF32(matrix.data(), cols, 1) ==
+          Approx(arm::app::math::MathUtils::MeanF32(matrix.data(), cols)));
+
+    /* Last row by last column: 9*4 + 10*8 + 11*12. */
+    const float dotProduct = arm::app::math::MathUtils::DotProductF32(
+        matrix.data() + (rows - 1) * cols, 1, matrix.data() + cols - 1, cols, rows);
+    CHECK(dotProduct == Approx(248.f));
+
+    CHECK(arm::app::math::MathUtils::DotProductF32(matrix.data(), 1, matrix.data() + cols, 1, cols) ==
+          Approx(arm::app::math::MathUtils::DotProductF32(matrix.data(), matrix.data() + cols, cols)));
+}
+
+TEST_CASE("Test RowArgMax and TopK")
+{
+    /* Small values so that ties are common; lengths across the vector widths. */
+    uint32_t state = 7;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 24;
+    };
+
+    for (const uint32_t rowLen : {1u, 5u, 12u, 15u, 16u, 17u, 29u, 40u}) {
+        const uint32_t numRows = 20;
+        std::vector<int8_t> s8(numRows * rowLen);
+        std::vector<uint8_t> u8(numRows * rowLen);
+        for (uint32_t i = 0; i < s8.size(); ++i) {
+            const uint32_t value = next();
+            s8[i] = static_cast<int8_t>(static_cast<int32_t>(value % 9) * 16 - 128);
+            u8[i] = static_cast<uint8_t>(value % 7 == 0 ? 255 : value % 5);
+        }
+
+        std::vector<uint32_t> s8Indices(numRows);
+        std::vector<uint32_t> u8Indices(numRows);
+        arm::app::math::MathUtils::RowArgMaxS8(s8.data(), numRows, rowLen, s8Indices.data());
+        arm::app::math::MathUtils::RowArgMaxU8(u8.data(), numRows, rowLen, u8Indices.data());
+
+        for (uint32_t r = 0; r < numRows; ++r) {
+            const int8_t* s8Row = s8.data() + r * rowLen;
+            const uint8_t* u8Row = u8.data() + r * rowLen;
+            CHECK(s8Indices[r] == std::max_element(s8Row, s8Row + rowLen) - s8Row);
+            CHECK(u8Indices[r] == std::max_element(u8Row, u8Row + rowLen) - u8Row);
+
+            /* Largest first, the lowest index first among equal values. */
+            std::vector<uint32_t> expected(rowLen);
+            std::iota(expected.begin(), expected.end(), 0);
+            std::stable_sort(expected.begin(), expected.end(),
+                             [s8Row](uint32_t a, uint32_t b) { return s8Row[a] > s8Row[b]; });
+
+            for (const uint32_t k : {0u, 1u, 3u, rowLen, rowLen + 1}) {
+                std::vector<uint32_t> topK(k);
+                const uint32_t count = arm::app::math::MathUtils::TopKS8(s8Row, rowLen, k, topK.data());
+                REQUIRE(count == std::min(k, rowLen));
+                CHECK(std::equal(topK.begin(), topK.begin() + count, expected.begin()));
+            }
+
+            uint32_t top = rowLen;
+            CHECK(arm::app::math::MathUtils::TopKU8(u8Row, rowLen, 1, &top) == 1);
+            CHECK(top == u8Indices[r]);
+        }
+    }
+}
+
+TEST_CASE("Test pointer overloads")
+{
+    SECTION("VecLogarithmF32 in place") {
+        std::vector<float> data { 0.5, 1, M_E };
+        arm::app::math::MathUtils::VecLogarithmF32(data.data(), data.data(), data.size());
+        CHECK(data[0] == Approx(-0.693147181));
+        CHECK(data[1] == Approx(0));
+        CHECK(data[2] == Approx(1));
+    }
+
+    SECTION("SoftmaxF32 on part of a buffer") {
+        std::vector<float> data { 42, 0.001, 1000.000, 42 };
+        arm::app::math::MathUtils::SoftmaxF32(data.data() + 1, 2);
+        CHECK(data[0] == 42);
+        CHECK(data[1] == Approx(0));
+        CHECK(data[2] == Approx(1));
+        CHECK(data[3] == 42);
+    }
+
+    SECTION("FftF32 matches the vector overload") {
+        const uint16_t fftLen = 16;
+        std::vector<float> input(fftLen);
+        for (size_t i = 0; i < input.size(); ++i) {
+            input[i] = std::sin(0.3f * i) + 0.1f * i;
+        }
+        std::vector<float> inputCopy = input;
+        std::vector<float> expected(fftLen);
+        std::vector<float> output(fftLen);
+
+        arm::app::math::FftInstance fftInstance;
+        arm::app::math::MathUtils::FftInitF32(fftLen, fftInstance);
+        arm::app::math::MathUtils::FftF32(input, expected, fftInstance);
+        arm::app::math::MathUtils::FftF32(inputCopy.data(), inputCopy.size(),
+                                          output.data(), output.size(), fftInstance);
+        for (size_t i = 0; i < fftLen; ++i) {
+            CHECK(output[i] == Approx(expected[i]));
+        }
+
+        /* Output too small: nothing is written. */
+        std::vector<float> small(fftLen / 2, -1.f);
+        arm::app::math::MathUtils::FftF32(inputCopy.data(), inputCopy.size(),
+                                          small.data(), small.size(), fftInstance);
+        CHECK(small[0] == -1.f);
+    }
+}
+
+TEST_CASE("Test vectorised exp, log, sigmoid and tanh")
+{
+    /* Sweep of the inputs the use cases see, compared with the standard library in double. */
+    const size_t len = 4001;
+
+    SECTION("VecExpF32") {
+        std::vector<float> input(len);
+        std::vector<float> output(len);
+        for (size_t i = 0; i < len; ++i) {
+            input[i] = -80.f + 160.f * i / (len - 1);
+        }
+        arm::app::math::MathUtils::VecExpF32(input.data(), output.data(), len);
+        for (size_t i = 0; i < len; ++i) {
+            const double expected = std::exp(static_cast<double>(input[i]));
+            REQUIRE(std::fabs(output[i] - expected) <= 3e-7 * expected);
+        }
+
+        /* Underflows to 0, saturates instead of overflowing, propagates NaN. */
+        std::vector<float> extremes { -200.f, 200.f, std::numeric_limits<float>::quiet_NaN() };
+        arm::app::math::MathUtils::VecExpF32(extremes.data(), extremes.data(), extremes.size());
+        CHECK(extremes[0] == 0);
+        CHECK(std::isfinite(extremes[1]));
+        CHECK(std::isnan(extremes[2]));
+    }
+
+    SECTION("VecLogarithmF32") {
+        std::vector<float> input(len);
+        std::vector<float> output(len);
+        for (size_t i = 0; i < len; ++i) {
+            input[i] = std::pow(10.f, -30.f + 60.f * i / (len - 1));
+        }
+        arm::app::math::MathUtils::VecLogarithmF32(input.data(), output.data(), len);
+        for (size_t i = 0; i < len; ++i) {
+            const double expected = std::log(static_cast<double>(input[i]));
+            REQUIRE(std::fabs(output[i] - expected) <= 2e-7 * std::max(1.0, std::fabs(expected)));
+        }
+
+        std::vector<float> special { 0.f, -1.f };
+        arm::app::math::MathUtils::VecLogarithmF32(special.data(), special.data(), special.size());
+        CHECK(std::isinf(special[0]));
+        CHECK(special[0] < 0);
+        CHECK(std::isnan(special[1]));
+    }
+
+    SECTION("VecSigmoidF32 and VecTanhF32 in place") {
+        std::vector<float> input(len);
+        for (size_t i = 0; i < len; ++i) {
+            input[i] = -20.f + 40.f * i / (len - 1);
+        }
+        std::vector<float> sigmoid = input;
+        std::vector<float> tanh = input;
+        arm::app::math::MathUtils::VecSigmoidF32(sigmoid.data(), sigmoid.data(), len);
+        arm::app::math::MathUtils::VecTanhF32(tanh.data(), tanh.data(), len);
+        for (size_t i = 0; i < len; ++i) {
+            const double x = input[i];
+            REQUIRE(std::fabs(sigmoid[i] - 1.0 / (1.0 + std::exp(-x))) <= 1e-7);
+            REQUIRE(std::fabs(tanh[i] - std::tanh(x)) <= 3e-7);
+            REQUIRE(sigmoid[i] == Approx(arm::app::math::MathUtils::SigmoidF32(input[i])));
+        }
+    }
+}
+
+TEST_CASE("Test FFT32 real and complex transforms agree")
+{
+    const uint16_t fftLen = 64;
+    std::vector<float> input(fftLen);
+    std::vector<float> complexInput(fftLen * 2, 0);
+    for (size_t i = 0; i < fftLen; ++i) {
+        input[i] = std::cos(2 * M_PI * 3 * i / fftLen) + 0.25f * std::sin(0.7f * i) + 0.01f * i;
+        complexInput[2 * i] = input[i];
+    }
+
+    arm::app::math::FftInstance realInstance;
+    arm::app::math::FftInstance complexInstance;
+    arm::app::math::MathUtils::FftInitF32(fftLen, realInstance, arm::app::math::FftType::real);
+    arm::app::math::MathUtils::FftInitF32(fftLen, complexInstance, arm::app::math::FftType::complex);
+
+    std::vector<float> realOutput(fftLen);
+    std::vector<float> complexOutput(fftLen * 2);
+    arm::app::math::MathUtils::FftF32(input, realOutput, realInstance);
+    arm::app::math::MathUtils::FftF32(complexInput, complexOutput, complexInstance);
+
+    /* Real output is [real0, realN/2, real1, im1, ...]. */
+    CHECK(realOutput[0] == Approx(complexOutput[0]).margin(1e-4));
+    CHECK(realOutput[1] == Approx(complexOutput[fftLen]).margin(1e-4));
+    for (size_t k = 1; k < fftLen / 2; ++k) {
+        CHECK(realOutput[2 * k] == Approx(complexOutput[2 * k]).margin(1e-4));
+        CHECK(realOutput[2 * k + 1] == Approx(complexOutput[2 * k + 1]).margin(1e-4));
+    }
+    CHECK(realOutput[6] == Approx(fftLen / 2).margin(0.5));
+}
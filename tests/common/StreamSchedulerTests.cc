@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "StreamScheduler.hpp"
+
+#include <catch.hpp>
+#include <vector>
+
+using arm::app::StreamScheduler;
+
+TEST_CASE("Common: Stream scheduler")
+{
+    /* Simulated clock: each frame of stream i takes costs[i] us. */
+    uint64_t now = 0;
+    std::vector<uint64_t> costs = {30, 20, 10};
+    std::vector<size_t> order;
+    auto processFrame = [&](size_t stream) {
+        order.push_back(stream);
+        now += costs[stream];
+        return true;
+    };
+
+    StreamScheduler scheduler(costs.size(), 50, [&now]() { return now; });
+    REQUIRE(scheduler.GetNumStreams() == 3);
+
+    SECTION("Round robin, starting from the next stream each round")
+    {
+        for (int round = 0; round < 3; ++round) {
+            REQUIRE(scheduler.RunRound(processFrame));
+        }
+        REQUIRE(order == std::vector<size_t>{0, 1, 2, 1, 2, 0, 2, 0, 1});
+        REQUIRE(scheduler.GetRounds() == 3);
+    }
+
+    SECTION("Latency runs from the start of the round")
+    {
+        REQUIRE(scheduler.RunRound(processFrame));
+        REQUIRE(scheduler.GetLatency(0).m_maxUs == 30);
+        REQUIRE(scheduler.GetLatency(1).m_maxUs == 50);
+        REQUIRE(scheduler.GetLatency(2).m_maxUs == 60);
+
+        /* Only the last stream is over the 50 us period. */
+        REQUIRE(scheduler.GetLatency(0).m_misses == 0);
+        REQUIRE(scheduler.GetLatency(1).m_misses == 0);
+        REQUIRE(scheduler.GetLatency(2).m_misses == 1);
+        REQUIRE(scheduler.GetRoundMisses() == 1);
+
+        /* Second round: 1 (20 us), 2 (30 us), 0 (60 us). */
+        REQUIRE(scheduler.RunRound(processFrame));
+        REQUIRE(scheduler.GetLatency(0).m_frames == 2);
+        REQUIRE(scheduler.GetLatency(0).MeanUs() == Approx(45));
+        REQUIRE(scheduler.GetLatency(0).m_misses == 1);
+        REQUIRE(scheduler.GetLatency(1).MeanUs() == Approx(35));
+        REQUIRE(scheduler.GetLatency(2).m_maxUs == 60);
+        REQUIRE(scheduler.GetRoundMisses() == 2);
+    }
+
+    SECTION("Fast enough streams meet every deadline")
+    {
+        costs = {10, 10, 10};
+        for (int round = 0; round < 10; ++round) {
+            REQUIRE(scheduler.RunRound(processFrame));
+        }
+        for (size_t i = 0; i < costs.size(); ++i) {
+            REQUIRE(scheduler.GetLatency(i).m_frames == 10);
+            REQUIRE(scheduler.GetLatency(i).m_misses == 0);
+            REQUIRE(scheduler.GetLatency(i).m_maxUs == 30);
+        }
+        REQUIRE(scheduler.GetRoundMisses() == 0);
+    }
+
+    SECTION("A failed frame stops the round")
+    {
+        REQUIRE_FALSE(scheduler.RunRound([&](size_t stream) {
+            order.push_back(stream);
+            return stream != 1;
+        }));
+        REQUIRE(order == std::vector<size_t>{0, 1});
+        REQUIRE(scheduler.GetLatency(0).m_frames == 1);
+        REQUIRE(scheduler.GetLatency(1).m_frames == 0);
+        REQUIRE(scheduler.GetRounds() == 0);
+    }
+}
@@ -0,0 +1,199 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AdDetector.hpp"
+#include "AdModel.hpp"
+#include "AdProcessing.hpp"
+#include "AudioUtils.hpp"
+#include "BufAttributes.hpp"
+#include "DataPack.hpp"
+#include "EvalHarness.hpp"
+#include "hal.h"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdlib>
+
+namespace arm {
+namespace app {
+    static uint8_t tensorArena[ACTIVATION_BUF_SZ] ACTIVATION_BUF_ATTRIBUTE;
+    namespace ad {
+        extern uint8_t* GetModelPointer();
+        extern size_t GetModelLen();
+    } /* namespace ad */
+} /* namespace app */
+} /* namespace arm */
+
+using namespace arm::app;
+
+/**
+ * @brief       Gets the model output for the machine of a clip, as the use
+ *              case does: names are like anomaly_id_02_00000000.wav.
+ * @return      Output index, -1 if the name holds no known machine id.
+ **/
+static int OutputIndexFromFileName(const std::string& name)
+{
+    const size_t idStart = name.find("_id_");
+    if (idStart == std::string::npos) {
+        return -1;
+    }
+    const int machineId = std::atoi(name.c_str() + idStart + 4);
+    switch (machineId) {
+        case 0: return 0;
+        case 2: return 1;
+        case 4: return 2;
+        case 6: return 3;
+        default: return -1;
+    }
+}
+
+/*
+ * Anomaly detection over a pack of machine sound clips. Clips are labelled
+ * "anomaly" or "normal"; unlabelled clips use the start of their file name,
+ * as in the data set the model was trained on.
+ * The streaming decision engine is run along: the early_exit_* metrics give
+ * the share of inferences it would save by deciding as soon as the score is
+ * conclusive, and the accuracy of these early decisions.
+ */
+int main(int argc, char** argv)
+{
+    eval::EvalOptions options;
+    if (!eval::ParseOptions(argc, argv, options) || !hal_platform_init()) {
+        return 1;
+    }
+
+    DataPack dataPack;
+    if (!dataPack.Open(options.dataPath.c_str())) {
+        return 1;
+    }
+
+    AdModel model;
+    if (!model.Init(tensorArena, sizeof(tensorArena), ad::GetModelPointer(), ad::GetModelLen())) {
+        printf_err("Failed to initialise model\n");
+        return 1;
+    }
+
+    TfLiteTensor* inputTensor  = model.GetInputTensor(0);
+    TfLiteTensor* outputTensor = model.GetOutputTensor(0);
+
+    AdPreProcess preProcess{inputTensor, static_cast<uint32_t>(ad::g_FrameLength),
+                            static_cast<uint32_t>(ad::g_FrameStride), ad::g_TrainingMean};
+    AdPostProcess postProcess{outputTensor};
+
+    eval::EvalReport report("ad", options.dataPath);
+    uint32_t numCorrect = 0;
+    uint32_t numEarlyCorrect = 0;
+    uint32_t numEarlyAgreeing = 0;
+    uint32_t numWindows = 0;
+    uint32_t numEarlyWindows = 0;
+    std::vector<float> scores;
+
+    ad::AdDetectorParams detectorParams;
+    detectorParams.m_threshold = ad::g_ScoreThreshold;
+    ad::AdDetector detector{detectorParams};
+    std::vector<bool> positives;
+
+    const uint32_t count = options.limit ? std::min(options.limit, dataPack.GetCount()) : dataPack.GetCount();
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        const std::string name = dataPack.GetFilename(idx);
+        const int16_t* clip = dataPack.GetAudioArray(idx);
+        const int outputIdx = OutputIndexFromFileName(name);
+        if (!clip || outputIdx < 0) {
+            printf_err("Entry %" PRIu32 " (%s) is not a machine sound clip\n", idx, name.c_str());
+            report.CountEntry(false);
+            continue;
+        }
+
+        auto audioDataSlider = audio::SlidingWindow<const int16_t>(
+            clip, dataPack.GetAudioArraySize(idx),
+            preProcess.GetAudioWindowSize(), preProcess.GetAudioDataStride());
+
+        /* Score is the average over the clip's inferences. */
+        bool ok = true;
+        float score = 0;
+        detector.Reset();
+        uint32_t earlyWindows = 0;
+        bool earlyAnomaly = false;
+        while (ok && audioDataSlider.HasNext()) {
+            const int16_t* inferenceWindow = audioDataSlider.Next();
+
+            report.StartStage();
+            preProcess.SetAudioWindowIndex(audioDataSlider.Index());
+            ok = preProcess.DoPreProcess(inferenceWindow, preProcess.GetAudioWindowSize());
+            report.StopStage("pre_process");
+
+            report.StartStage();
+            ok = ok && model.RunInference();
+            report.StopStage("inference");
+
+            report.StartStage();
+            ok = ok && postProcess.DoPostProcess();
+            report.StopStage("post_process");
+
+            const float windowScore = ok ? 0 - postProcess.GetOutputValue(outputIdx) : 0;
+            score += windowScore;
+
+            /* Where the streaming mode would have stopped. */
+            if (earlyWindows == 0) {
+                detector.Update(windowScore, 0);
+                if (detector.GetDecision() != ad::AdDecision::undecided) {
+                    earlyWindows = detector.GetWindowCount();
+                    earlyAnomaly = detector.GetDecision() == ad::AdDecision::anomalous;
+                }
+            }
+        }
+        score /= (audioDataSlider.TotalStrides() + 1);
+        if (earlyWindows == 0) {
+            /* Inconclusive to the end: decided on the mean, as the whole clip. */
+            earlyWindows = audioDataSlider.TotalStrides() + 1;
+            earlyAnomaly = score > ad::g_ScoreThreshold;
+        }
+
+        report.CountEntry(ok);
+        if (!ok) {
+            printf_err("Failed to process %s\n", name.c_str());
+            continue;
+        }
+
+        std::string label = dataPack.GetLabel(idx);
+        if (label.empty()) {
+            label = name.substr(0, name.find('_'));
+        }
+        const bool isAnomaly = (label == "anomaly" || label == "1");
+        numCorrect += ((score > ad::g_ScoreThreshold) == isAnomaly);
+        numEarlyCorrect += (earlyAnomaly == isAnomaly);
+        numEarlyAgreeing += (earlyAnomaly == (score > ad::g_ScoreThreshold));
+        numWindows += audioDataSlider.TotalStrides() + 1;
+        numEarlyWindows += earlyWindows;
+        scores.push_back(score);
+        positives.push_back(isAnomaly);
+    }
+
+    if (!scores.empty()) {
+        report.SetMetric("accuracy_at_threshold", static_cast<double>(numCorrect) / scores.size());
+        report.SetMetric("roc_auc", eval::RocAuc(scores, positives));
+        report.SetMetric("early_exit_accuracy_at_threshold", static_cast<double>(numEarlyCorrect) / scores.size());
+        report.SetMetric("early_exit_agreement", static_cast<double>(numEarlyAgreeing) / scores.size());
+        report.SetMetric("early_exit_inferences_saved", 1.0 - static_cast<double>(numEarlyWindows) / numWindows);
+    }
+
+    report.Print();
+    if (!options.outputPath.empty() && !report.WriteJson(options.outputPath)) {
+        return 1;
+    }
+    return 0;
+}
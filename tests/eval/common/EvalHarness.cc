@@ -0,0 +1,354 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "EvalHarness.hpp"
+#include "hal.h"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+
+namespace arm {
+namespace app {
+namespace eval {
+
+    /* Reads the first PMU counter; its name and unit are returned if asked for. */
+    static uint64_t ReadCounter(std::string* name = nullptr, std::string* unit = nullptr)
+    {
+        pmu_counters counters{};
+        hal_pmu_get_counters(&counters);
+        if (counters.num_counters == 0) {
+            return 0;
+        }
+        if (name && counters.counters[0].name) {
+            *name = counters.counters[0].name;
+        }
+        if (unit && counters.counters[0].unit) {
+            *unit = counters.counters[0].unit;
+        }
+        return counters.counters[0].value;
+    }
+
+    /* Writes a JSON string, escaping what needs to be. */
+    static void WriteJsonString(FILE* file, const std::string& str)
+    {
+        std::fputc('"', file);
+        for (const char c : str) {
+            if (c == '"' || c == '\\') {
+                std::fprintf(file, "\\%c", c);
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                std::fprintf(file, "\\u%04x", c);
+            } else {
+                std::fputc(c, file);
+            }
+        }
+        std::fputc('"', file);
+    }
+
+    bool ParseOptions(int argc, char** argv, EvalOptions& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const bool hasValue = i + 1 < argc;
+            if (0 == std::strcmp(argv[i], "--data") && hasValue) {
+                options.dataPath = argv[++i];
+            } else if (0 == std::strcmp(argv[i], "--output") && hasValue) {
+                options.outputPath = argv[++i];
+            } else if (0 == std::strcmp(argv[i], "--limit") && hasValue) {
+                options.limit = std::strtoul(argv[++i], nullptr, 0);
+            } else {
+                options.dataPath.clear();
+                break;
+            }
+        }
+
+        if (options.dataPath.empty()) {
+            printf_err("Usage: %s --data <pack> [--output <summary.json>] [--limit <entries>]\n",
+                       argc > 0 ? argv[0] : "eval");
+            return false;
+        }
+        return true;
+    }
+
+    bool MatchesLabel(const std::string& resultLabel, uint32_t resultIdx, const std::string& label)
+    {
+        return resultLabel == label || std::to_string(resultIdx) == label;
+    }
+
+    void LatencyStats::Add(uint64_t value)
+    {
+        this->m_samples.push_back(value);
+        this->m_sorted = false;
+    }
+
+    size_t LatencyStats::Count() const
+    {
+        return this->m_samples.size();
+    }
+
+    double LatencyStats::Mean() const
+    {
+        if (this->m_samples.empty()) {
+            return 0;
+        }
+        const double sum = std::accumulate(this->m_samples.begin(), this->m_samples.end(), 0.0);
+        return sum / this->m_samples.size();
+    }
+
+    uint64_t LatencyStats::Percentile(double percent) const
+    {
+        if (this->m_samples.empty()) {
+            return 0;
+        }
+        if (!this->m_sorted) {
+            std::sort(this->m_samples.begin(), this->m_samples.end());
+            this->m_sorted = true;
+        }
+        const double rank = std::ceil(percent / 100.0 * this->m_samples.size());
+        const size_t idx = rank < 1 ? 0 : static_cast<size_t>(rank) - 1;
+        return this->m_samples[std::min(idx, this->m_samples.size() - 1)];
+    }
+
+    EvalReport::EvalReport(const char* useCase, const std::string& dataPath)
+    :   m_useCase(useCase),
+        m_dataPath(dataPath)
+    {
+        hal_pmu_init();
+        ReadCounter(&this->m_counterName, &this->m_counterUnit);
+    }
+
+    void EvalReport::StartStage()
+    {
+        this->m_stageStart = ReadCounter();
+    }
+
+    void EvalReport::StopStage(const char* stage)
+    {
+        this->m_stages[stage].Add(ReadCounter() - this->m_stageStart);
+    }
+
+    void EvalReport::CountEntry(bool ok)
+    {
+        ++this->m_entries;
+        if (!ok) {
+            ++this->m_failed;
+        }
+    }
+
+    void EvalReport::SetMetric(const char* name, double value)
+    {
+        this->m_metrics[name] = value;
+    }
+
+    void EvalReport::Print() const
+    {
+        info("%s: %" PRIu32 " entries evaluated, %" PRIu32 " failed\n",
+             this->m_useCase.c_str(), this->m_entries, this->m_failed);
+        for (const auto& metric : this->m_metrics) {
+            info("%s: %f\n", metric.first.c_str(), metric.second);
+        }
+        for (const auto& stage : this->m_stages) {
+            info("%s (%s %s): mean %.1f, p50 %" PRIu64 ", p90 %" PRIu64 ", p99 %" PRIu64 ", max %" PRIu64 "\n",
+                 stage.first.c_str(), this->m_counterName.c_str(), this->m_counterUnit.c_str(),
+                 stage.second.Mean(), stage.second.Percentile(50), stage.second.Percentile(90),
+                 stage.second.Percentile(99), stage.second.Percentile(100));
+        }
+    }
+
+    bool EvalReport::WriteJson(const std::string& path) const
+    {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            printf_err("Failed to open %s\n", path.c_str());
+            return false;
+        }
+
+        std::fprintf(file, "{\n  \"use_case\": ");
+        WriteJsonString(file, this->m_useCase);
+        std::fprintf(file, ",\n  \"data\": ");
+        WriteJsonString(file, this->m_dataPath);
+        std::fprintf(file, ",\n  \"entries\": %" PRIu32 ",\n  \"failed\": %" PRIu32 ",\n",
+                     this->m_entries, this->m_failed);
+
+        std::fprintf(file, "  \"metrics\": {");
+        const char* sep = "\n";
+        for (const auto& metric : this->m_metrics) {
+            std::fprintf(file, "%s    ", sep);
+            WriteJsonString(file, metric.first);
+            std::fprintf(file, ": %.6f", metric.second);
+            sep = ",\n";
+        }
+        std::fprintf(file, "\n  },\n  \"latency\": {\n    \"counter\": ");
+        WriteJsonString(file, this->m_counterName);
+        std::fprintf(file, ",\n    \"unit\": ");
+        WriteJsonString(file, this->m_counterUnit);
+        std::fprintf(file, ",\n    \"stages\": {");
+        sep = "\n";
+        for (const auto& stage : this->m_stages) {
+            std::fprintf(file, "%s      ", sep);
+            WriteJsonString(file, stage.first);
+            std::fprintf(file, ": {\"count\": %zu, \"mean\": %.1f, \"p50\": %" PRIu64 ", \"p90\": %" PRIu64
+                         ", \"p99\": %" PRIu64 ", \"max\": %" PRIu64 "}",
+                         stage.second.Count(), stage.second.Mean(), stage.second.Percentile(50),
+                         stage.second.Percentile(90), stage.second.Percentile(99),
+                         stage.second.Percentile(100));
+            sep = ",\n";
+        }
+        std::fprintf(file, "\n    }\n  }\n}\n");
+
+        const bool ok = 0 == std::fclose(file);
+        if (ok) {
+            info("Summary written to %s\n", path.c_str());
+        }
+        return ok;
+    }
+
+    double RocAuc(const std::vector<float>& scores, const std::vector<bool>& positives)
+    {
+        const size_t n = std::min(scores.size(), positives.size());
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&scores](size_t a, size_t b) { return scores[a] < scores[b]; });
+
+        /* Mann-Whitney U: sum of the positives' ranks, ties getting their mean rank. */
+        double positiveRankSum = 0;
+        size_t numPositives = 0;
+        for (size_t i = 0; i < n;) {
+            size_t j = i;
+            while (j < n && scores[order[j]] == scores[order[i]]) {
+                ++j;
+            }
+            const double meanRank = (i + 1 + j) / 2.0;
+            for (size_t k = i; k < j; ++k) {
+                if (positives[order[k]]) {
+                    positiveRankSum += meanRank;
+                    ++numPositives;
+                }
+            }
+            i = j;
+        }
+
+        const size_t numNegatives = n - numPositives;
+        if (numPositives == 0 || numNegatives == 0) {
+            return 0.5;
+        }
+        const double u = positiveRankSum - numPositives * (numPositives + 1) / 2.0;
+        return u / (static_cast<double>(numPositives) * numNegatives);
+    }
+
+    float Iou(const Box& a, const Box& b)
+    {
+        const float w = std::min(a.x0 + a.w, b.x0 + b.w) - std::max(a.x0, b.x0);
+        const float h = std::min(a.y0 + a.h, b.y0 + b.h) - std::max(a.y0, b.y0);
+        if (w <= 0 || h <= 0) {
+            return 0;
+        }
+        const float intersection = w * h;
+        return intersection / (a.w * a.h + b.w * b.h - intersection);
+    }
+
+    double AveragePrecision(const std::vector<ScoredBox>& detections,
+                            const std::vector<std::vector<Box>>& groundTruth,
+                            float iouThreshold)
+    {
+        size_t numTruths = 0;
+        std::vector<std::vector<bool>> matched(groundTruth.size());
+        for (size_t i = 0; i < groundTruth.size(); ++i) {
+            numTruths += groundTruth[i].size();
+            matched[i].resize(groundTruth[i].size(), false);
+        }
+        if (numTruths == 0) {
+            return detections.empty() ? 1 : 0;
+        }
+
+        std::vector<ScoredBox> sorted = detections;
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const ScoredBox& a, const ScoredBox& b) { return a.score > b.score; });
+
+        /* Precision/recall at each detection, in decreasing confidence. */
+        std::vector<double> precision;
+        std::vector<double> recall;
+        size_t truePositives = 0;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            const ScoredBox& det = sorted[i];
+            if (det.image < groundTruth.size()) {
+                float bestIou = iouThreshold;
+                int best = -1;
+                for (size_t j = 0; j < groundTruth[det.image].size(); ++j) {
+                    const float iou = Iou(det.box, groundTruth[det.image][j]);
+                    if (!matched[det.image][j] && iou >= bestIou) {
+                        bestIou = iou;
+                        best = static_cast<int>(j);
+                    }
+                }
+                if (best >= 0) {
+                    matched[det.image][best] = true;
+                    ++truePositives;
+                }
+            }
+            precision.push_back(static_cast<double>(truePositives) / (i + 1));
+            recall.push_back(static_cast<double>(truePositives) / numTruths);
+        }
+
+        /* Area under the precision envelope. */
+        double ap = 0;
+        double maxPrecision = 0;
+        for (size_t i = sorted.size(); i-- > 0;) {
+            maxPrecision = std::max(maxPrecision, precision[i]);
+            const double prevRecall = i > 0 ? recall[i - 1] : 0;
+            ap += (recall[i] - prevRecall) * maxPrecision;
+        }
+        return ap;
+    }
+
+    bool ParseBoxes(const char* label, std::vector<Box>& boxes)
+    {
+        boxes.clear();
+        if (!label) {
+            return false;
+        }
+
+        const char* str = label;
+        while (*str) {
+            Box box{};
+            int consumed = 0;
+            if (std::sscanf(str, " %f %f %f %f %n", &box.x0, &box.y0, &box.w, &box.h, &consumed) != 4 ||
+                    box.w <= 0 || box.h <= 0) {
+                printf_err("Invalid boxes label: %s\n", label);
+                boxes.clear();
+                return false;
+            }
+            boxes.push_back(box);
+            str += consumed;
+            if (*str == ';') {
+                ++str;
+            } else if (*str) {
+                printf_err("Invalid boxes label: %s\n", label);
+                boxes.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+} /* namespace eval */
+} /* namespace app */
+} /* namespace arm */
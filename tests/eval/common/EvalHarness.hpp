@@ -0,0 +1,179 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVAL_HARNESS_HPP
+#define EVAL_HARNESS_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace arm {
+namespace app {
+namespace eval {
+
+    /** @brief  Command line options shared by the evaluation harnesses. */
+    struct EvalOptions {
+        std::string dataPath;       /* Data pack to evaluate (see scripts/py/gen_data_pack.py). */
+        std::string outputPath;     /* JSON summary to write, none if empty. */
+        uint32_t    limit{0};       /* Maximum number of entries to evaluate, 0 for all. */
+    };
+
+    /**
+     * @brief       Parses "--data <pack> [--output <json>] [--limit <n>]".
+     * @param[in]   argc      Argument count.
+     * @param[in]   argv      Arguments.
+     * @param[out]  options   Options parsed.
+     * @return      true if the arguments are valid, false otherwise (usage is printed).
+     **/
+    bool ParseOptions(int argc, char** argv, EvalOptions& options);
+
+    /**
+     * @brief       Checks a classification against a data pack label, which
+     *              can either be the model's label or its index.
+     * @param[in]   resultLabel   Label of the class found.
+     * @param[in]   resultIdx     Index of the class found.
+     * @param[in]   label         Expected label.
+     * @return      true if they match.
+     **/
+    bool MatchesLabel(const std::string& resultLabel, uint32_t resultIdx, const std::string& label);
+
+    /** @brief  Samples of one pipeline stage's latency. */
+    class LatencyStats {
+    public:
+        /** @brief  Adds a sample. */
+        void Add(uint64_t value);
+
+        /** @brief  Gets the number of samples. */
+        size_t Count() const;
+
+        /** @brief  Gets the mean of the samples, 0 if none. */
+        double Mean() const;
+
+        /**
+         * @brief       Gets a percentile of the samples (nearest rank).
+         * @param[in]   percent   Percentile, in [0, 100].
+         * @return      The percentile, 0 if there are no samples.
+         **/
+        uint64_t Percentile(double percent) const;
+
+    private:
+        mutable std::vector<uint64_t>   m_samples;          /* Samples, sorted on demand. */
+        mutable bool                    m_sorted{true};     /* Whether m_samples is sorted. */
+    };
+
+    /**
+     * @brief   Accuracy and per-stage latency of a use case over a data set.
+     *          Stages are timed with the first platform PMU counter: time on
+     *          the native platform, cycles on targets.
+     */
+    class EvalReport {
+    public:
+        /**
+         * @brief       Constructor.
+         * @param[in]   useCase     Name of the use case evaluated.
+         * @param[in]   dataPath    Data set evaluated.
+         **/
+        EvalReport(const char* useCase, const std::string& dataPath);
+
+        /** @brief  Starts timing a stage. */
+        void StartStage();
+
+        /** @brief  Stops timing the stage started last and records it under the given name. */
+        void StopStage(const char* stage);
+
+        /** @brief  Counts an evaluated entry; failed entries are left out of the metrics. */
+        void CountEntry(bool ok);
+
+        /** @brief  Sets an accuracy metric. */
+        void SetMetric(const char* name, double value);
+
+        /** @brief  Logs the summary. */
+        void Print() const;
+
+        /**
+         * @brief       Writes the summary as JSON, with keys in a stable order
+         *              so that summaries can be diffed between commits.
+         * @param[in]   path    File to write.
+         * @return      true if written, false otherwise.
+         **/
+        bool WriteJson(const std::string& path) const;
+
+    private:
+        std::string                         m_useCase;
+        std::string                         m_dataPath;
+        std::map<std::string, double>       m_metrics;
+        std::map<std::string, LatencyStats> m_stages;
+        uint64_t                            m_stageStart{0};
+        std::string                         m_counterName{"none"};
+        std::string                         m_counterUnit{"none"};
+        uint32_t                            m_entries{0};
+        uint32_t                            m_failed{0};
+    };
+
+    /**
+     * @brief       Computes the area under the ROC curve, ties counting half.
+     * @param[in]   scores      Scores, higher meaning more likely positive.
+     * @param[in]   positives   Ground truth for each score.
+     * @return      The AUC in [0, 1], 0.5 if either class is missing.
+     **/
+    double RocAuc(const std::vector<float>& scores, const std::vector<bool>& positives);
+
+    /** @brief  Axis aligned box, in pixels. */
+    struct Box {
+        float x0;
+        float y0;
+        float w;
+        float h;
+    };
+
+    /** @brief  Detection of an image in a data set. */
+    struct ScoredBox {
+        uint32_t    image;      /* Index of the image. */
+        float       score;      /* Confidence. */
+        Box         box;
+    };
+
+    /** @brief  Gets the intersection over union of two boxes. */
+    float Iou(const Box& a, const Box& b);
+
+    /**
+     * @brief       Computes the (all points interpolated) average precision of
+     *              single class detections.
+     * @param[in]   detections    Detections over all images, any order.
+     * @param[in]   groundTruth   Ground truth boxes of each image.
+     * @param[in]   iouThreshold  Overlap needed to match a ground truth box.
+     * @return      The average precision in [0, 1].
+     **/
+    double AveragePrecision(const std::vector<ScoredBox>& detections,
+                            const std::vector<std::vector<Box>>& groundTruth,
+                            float iouThreshold);
+
+    /**
+     * @brief       Parses ground truth boxes from a data pack label, formatted
+     *              as "x0 y0 w h;x0 y0 w h;...". An empty label has no boxes.
+     * @param[in]   label   Label to parse.
+     * @param[out]  boxes   Boxes parsed.
+     * @return      true if the label is well formed, false otherwise.
+     **/
+    bool ParseBoxes(const char* label, std::vector<Box>& boxes);
+
+} /* namespace eval */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* EVAL_HARNESS_HPP */
@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AudioUtils.hpp"
+#include "BufAttributes.hpp"
+#include "DataPack.hpp"
+#include "EvalHarness.hpp"
+#include "KwsClassifier.hpp"
+#include "KwsProcessing.hpp"
+#include "Labels.hpp"
+#include "MicroNetKwsModel.hpp"
+#include "hal.h"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace arm {
+namespace app {
+    static uint8_t tensorArena[ACTIVATION_BUF_SZ] ACTIVATION_BUF_ATTRIBUTE;
+    namespace kws {
+        extern uint8_t* GetModelPointer();
+        extern size_t GetModelLen();
+        extern const int g_FrameLength;
+        extern const int g_FrameStride;
+        extern const float g_ScoreThreshold;
+        extern const int g_AudioStride;
+    } /* namespace kws */
+} /* namespace app */
+} /* namespace arm */
+
+using namespace arm::app;
+
+/*
+ * Keyword spotting over a labelled pack of audio clips. Each clip is
+ * classified by the inference window whose top keyword scores highest, and
+ * a hit anywhere in that window's top 5 counts for the top-5 accuracy.
+ * Labels are the model's labels (eg "yes", "_unknown_") or their indices.
+ */
+int main(int argc, char** argv)
+{
+    eval::EvalOptions options;
+    if (!eval::ParseOptions(argc, argv, options) || !hal_platform_init()) {
+        return 1;
+    }
+
+    DataPack dataPack;
+    if (!dataPack.Open(options.dataPath.c_str())) {
+        return 1;
+    }
+
+    MicroNetKwsModel model;
+    if (!model.Init(tensorArena, sizeof(tensorArena), kws::GetModelPointer(), kws::GetModelLen())) {
+        printf_err("Failed to initialise model\n");
+        return 1;
+    }
+
+    TfLiteTensor* inputTensor  = model.GetInputTensor(0);
+    TfLiteTensor* outputTensor = model.GetOutputTensor(0);
+    TfLiteIntArray* inputShape = model.GetInputShape(0);
+    const uint32_t numMfccFeatures = inputShape->data[MicroNetKwsModel::ms_inputColsIdx];
+    const uint32_t numMfccFrames   = inputShape->data[MicroNetKwsModel::ms_inputRowsIdx];
+
+    std::vector<std::string> labels;
+    GetLabelsVector(labels);
+
+    KwsClassifier classifier;
+    std::vector<ClassificationResult> singleInfResult;
+    KwsPostProcess postProcess(outputTensor, classifier, labels, singleInfResult, 1, 5);
+
+    eval::EvalReport report("kws", options.dataPath);
+    uint32_t numLabelled = 0;
+    uint32_t numTop1 = 0;
+    uint32_t numTop1AboveThreshold = 0;
+    uint32_t numTop5 = 0;
+
+    const uint32_t count = options.limit ? std::min(options.limit, dataPack.GetCount()) : dataPack.GetCount();
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        const int16_t* clip = dataPack.GetAudioArray(idx);
+        if (!clip) {
+            printf_err("Entry %" PRIu32 " (%s) is not an audio clip\n", idx, dataPack.GetFilename(idx));
+            report.CountEntry(false);
+            continue;
+        }
+
+        /* Pre-processing reuses features across the windows of a clip only. */
+        KwsPreProcess preProcess(inputTensor, numMfccFeatures, numMfccFrames,
+                                 kws::g_FrameLength, kws::g_FrameStride, kws::g_AudioStride);
+        auto audioDataSlider = audio::SlidingWindow<const int16_t>(
+            clip, dataPack.GetAudioArraySize(idx),
+            preProcess.m_audioDataWindowSize, preProcess.m_audioDataStride);
+
+        bool ok = true;
+        std::vector<ClassificationResult> best(1);
+        while (ok && audioDataSlider.HasNext()) {
+            const int16_t* inferenceWindow = audioDataSlider.Next();
+
+            report.StartStage();
+            ok = preProcess.DoPreProcess(inferenceWindow, audioDataSlider.Index());
+            report.StopStage("pre_process");
+
+            report.StartStage();
+            ok = ok && model.RunInference();
+            report.StopStage("inference");
+
+            report.StartStage();
+            ok = ok && postProcess.DoPostProcess();
+            report.StopStage("post_process");
+
+            if (ok && !singleInfResult.empty() &&
+                    singleInfResult[0].m_normalisedVal > best[0].m_normalisedVal) {
+                best = singleInfResult;
+            }
+        }
+        report.CountEntry(ok);
+        if (!ok) {
+            printf_err("Failed to process %s\n", dataPack.GetFilename(idx));
+            continue;
+        }
+
+        const std::string label = dataPack.GetLabel(idx);
+        if (!label.empty()) {
+            ++numLabelled;
+            for (size_t i = 0; i < best.size(); ++i) {
+                if (eval::MatchesLabel(best[i].m_label, best[i].m_labelIdx, label)) {
+                    numTop1 += (i == 0);
+                    numTop1AboveThreshold += (i == 0 && best[i].m_normalisedVal >= kws::g_ScoreThreshold);
+                    ++numTop5;
+                    break;
+                }
+            }
+        }
+        debug("%s: %s (%f), expected %s\n", dataPack.GetFilename(idx),
+              best[0].m_label.c_str(), best[0].m_normalisedVal, label.c_str());
+    }
+
+    if (numLabelled) {
+        report.SetMetric("top1_accuracy", static_cast<double>(numTop1) / numLabelled);
+        report.SetMetric("top1_accuracy_above_threshold",
+                         static_cast<double>(numTop1AboveThreshold) / numLabelled);
+        report.SetMetric("top5_accuracy", static_cast<double>(numTop5) / numLabelled);
+    }
+
+    report.Print();
+    if (!options.outputPath.empty() && !report.WriteJson(options.outputPath)) {
+        return 1;
+    }
+    return 0;
+}
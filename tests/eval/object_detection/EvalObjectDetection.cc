@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BufAttributes.hpp"
+#include "DataPack.hpp"
+#include "DetectorPostProcessing.hpp"
+#include "DetectorPreProcessing.hpp"
+#include "EvalHarness.hpp"
+#include "YoloFastestModel.hpp"
+#include "hal.h"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <iterator>
+
+namespace arm {
+namespace app {
+    static uint8_t tensorArena[ACTIVATION_BUF_SZ] ACTIVATION_BUF_ATTRIBUTE;
+    namespace object_detection {
+        extern uint8_t* GetModelPointer();
+        extern size_t GetModelLen();
+    } /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
+
+using namespace arm::app;
+
+/* Confidence kept for the precision/recall curve; the use case itself keeps 0.5 and above. */
+static constexpr float ms_apThreshold = 0.05f;
+static constexpr float ms_useCaseThreshold = 0.5f;
+static constexpr float ms_iouThreshold = 0.5f;
+
+/*
+ * Object detection over a pack of RGB images, already resized to the model
+ * input. Each label holds the ground truth boxes as "x0 y0 w h;..." in the
+ * coordinates of the original image size the use case is configured with.
+ */
+int main(int argc, char** argv)
+{
+    eval::EvalOptions options;
+    if (!eval::ParseOptions(argc, argv, options) || !hal_platform_init()) {
+        return 1;
+    }
+
+    DataPack dataPack;
+    if (!dataPack.Open(options.dataPath.c_str())) {
+        return 1;
+    }
+
+    YoloFastestModel model;
+    if (!model.Init(tensorArena, sizeof(tensorArena),
+                    object_detection::GetModelPointer(), object_detection::GetModelLen())) {
+        printf_err("Failed to initialise model\n");
+        return 1;
+    }
+
+    TfLiteTensor* inputTensor   = model.GetInputTensor(0);
+    TfLiteTensor* outputTensor0 = model.GetOutputTensor(0);
+    TfLiteTensor* outputTensor1 = model.GetOutputTensor(1);
+    TfLiteIntArray* inputShape  = model.GetInputShape(0);
+    const int inputImgRows = inputShape->data[YoloFastestModel::ms_inputRowsIdx];
+    const int inputImgCols = inputShape->data[YoloFastestModel::ms_inputColsIdx];
+
+    DetectorPreProcess preProcess(inputTensor, true, model.IsDataSigned());
+
+    std::vector<object_detection::DetectionResult> results;
+    object_detection::PostProcessParams postProcessParams{
+        inputImgRows,
+        inputImgCols,
+        object_detection::originalImageSize,
+        object_detection::anchor1,
+        object_detection::anchor2};
+    postProcessParams.threshold = ms_apThreshold;
+    DetectorPostProcess postProcess(outputTensor0, outputTensor1, results, postProcessParams);
+
+    eval::EvalReport report("object_detection", options.dataPath);
+    std::vector<eval::ScoredBox> detections;
+    std::vector<std::vector<eval::Box>> groundTruth;
+
+    const uint32_t count = options.limit ? std::min(options.limit, dataPack.GetCount()) : dataPack.GetCount();
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        const uint8_t* image = dataPack.GetImgArray(idx);
+        const DataPackEntry* entry = dataPack.GetEntry(idx);
+        std::vector<eval::Box> truth;
+        if (!image || entry->m_dims[0] != static_cast<uint32_t>(inputImgRows) ||
+                entry->m_dims[1] != static_cast<uint32_t>(inputImgCols) || entry->m_dims[2] != 3 ||
+                !eval::ParseBoxes(dataPack.GetLabel(idx), truth)) {
+            printf_err("Entry %" PRIu32 " (%s) is not a %dx%d RGB image with boxes\n",
+                       idx, dataPack.GetFilename(idx), inputImgCols, inputImgRows);
+            report.CountEntry(false);
+            continue;
+        }
+
+        results.clear();
+
+        report.StartStage();
+        bool ok = preProcess.DoPreProcess(image, std::min<size_t>(inputTensor->bytes, entry->m_size));
+        report.StopStage("pre_process");
+
+        report.StartStage();
+        ok = ok && model.RunInference();
+        report.StopStage("inference");
+
+        report.StartStage();
+        ok = ok && postProcess.DoPostProcess();
+        report.StopStage("post_process");
+
+        report.CountEntry(ok);
+        if (!ok) {
+            printf_err("Failed to process %s\n", dataPack.GetFilename(idx));
+            continue;
+        }
+
+        const auto imageIdx = static_cast<uint32_t>(groundTruth.size());
+        for (const auto& result : results) {
+            detections.push_back({imageIdx, static_cast<float>(result.m_normalisedVal),
+                                  {static_cast<float>(result.m_x0), static_cast<float>(result.m_y0),
+                                   static_cast<float>(result.m_w), static_cast<float>(result.m_h)}});
+        }
+        groundTruth.push_back(std::move(truth));
+    }
+
+    if (!groundTruth.empty()) {
+        report.SetMetric("map_50", eval::AveragePrecision(detections, groundTruth, ms_iouThreshold));
+
+        /* Precision and recall of what the use case reports. */
+        std::vector<eval::ScoredBox> kept;
+        std::copy_if(detections.begin(), detections.end(), std::back_inserter(kept),
+                     [](const eval::ScoredBox& det) { return det.score >= ms_useCaseThreshold; });
+        size_t numTruths = 0;
+        size_t numMatched = 0;
+        for (size_t i = 0; i < groundTruth.size(); ++i) {
+            numTruths += groundTruth[i].size();
+            std::vector<bool> used(groundTruth[i].size(), false);
+            for (const auto& det : kept) {
+                for (size_t j = 0; det.image == i && j < groundTruth[i].size(); ++j) {
+                    if (!used[j] && eval::Iou(det.box, groundTruth[i][j]) >= ms_iouThreshold) {
+                        used[j] = true;
+                        ++numMatched;
+                        break;
+                    }
+                }
+            }
+        }
+        report.SetMetric("precision_at_threshold", kept.empty() ? 0 : static_cast<double>(numMatched) / kept.size());
+        report.SetMetric("recall_at_threshold", numTruths ? static_cast<double>(numMatched) / numTruths : 0);
+    }
+
+    report.Print();
+    if (!options.outputPath.empty() && !report.WriteJson(options.outputPath)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BufAttributes.hpp"
+#include "Classifier.hpp"
+#include "DataPack.hpp"
+#include "EvalHarness.hpp"
+#include "Labels.hpp"
+#include "VisualWakeWordModel.hpp"
+#include "VisualWakeWordProcessing.hpp"
+#include "hal.h"
+#include "log_macros.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace arm {
+namespace app {
+    static uint8_t tensorArena[ACTIVATION_BUF_SZ] ACTIVATION_BUF_ATTRIBUTE;
+    namespace vww {
+        extern uint8_t* GetModelPointer();
+        extern size_t GetModelLen();
+    } /* namespace vww */
+} /* namespace app */
+} /* namespace arm */
+
+using namespace arm::app;
+
+/*
+ * Visual wake word over a labelled pack of RGB images, already resized to
+ * the model input. Labels are the model's labels or their indices; the
+ * second class (person detected) is the positive one for the ROC AUC.
+ */
+int main(int argc, char** argv)
+{
+    eval::EvalOptions options;
+    if (!eval::ParseOptions(argc, argv, options) || !hal_platform_init()) {
+        return 1;
+    }
+
+    DataPack dataPack;
+    if (!dataPack.Open(options.dataPath.c_str())) {
+        return 1;
+    }
+
+    VisualWakeWordModel model;
+    if (!model.Init(tensorArena, sizeof(tensorArena), vww::GetModelPointer(), vww::GetModelLen())) {
+        printf_err("Failed to initialise model\n");
+        return 1;
+    }
+
+    TfLiteTensor* inputTensor  = model.GetInputTensor(0);
+    TfLiteTensor* outputTensor = model.GetOutputTensor(0);
+    TfLiteIntArray* inputShape = model.GetInputShape(0);
+    const uint32_t nRows = inputShape->data[VisualWakeWordModel::ms_inputRowsIdx];
+    const uint32_t nCols = inputShape->data[VisualWakeWordModel::ms_inputColsIdx];
+
+    std::vector<std::string> labels;
+    GetLabelsVector(labels);
+    constexpr uint32_t positiveIdx = 1;
+
+    Classifier classifier;
+    std::vector<ClassificationResult> results;
+    VisualWakeWordPreProcess preProcess(inputTensor);
+    VisualWakeWordPostProcess postProcess(outputTensor, classifier, labels, results);
+
+    eval::EvalReport report("vww", options.dataPath);
+    uint32_t numCorrect = 0;
+    std::vector<float> scores;
+    std::vector<bool> positives;
+
+    const uint32_t count = options.limit ? std::min(options.limit, dataPack.GetCount()) : dataPack.GetCount();
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        const uint8_t* image = dataPack.GetImgArray(idx);
+        const DataPackEntry* entry = dataPack.GetEntry(idx);
+        if (!image || entry->m_dims[0] != nRows || entry->m_dims[1] != nCols || entry->m_dims[2] != 3) {
+            printf_err("Entry %" PRIu32 " (%s) is not a %" PRIu32 "x%" PRIu32 " RGB image\n",
+                       idx, dataPack.GetFilename(idx), nCols, nRows);
+            report.CountEntry(false);
+            continue;
+        }
+
+        report.StartStage();
+        bool ok = preProcess.DoPreProcess(image, std::min<size_t>(inputTensor->bytes, entry->m_size));
+        report.StopStage("pre_process");
+
+        report.StartStage();
+        ok = ok && model.RunInference();
+        report.StopStage("inference");
+
+        report.StartStage();
+        ok = ok && postProcess.DoPostProcess() && !results.empty();
+        report.StopStage("post_process");
+
+        report.CountEntry(ok);
+        if (!ok) {
+            printf_err("Failed to process %s\n", dataPack.GetFilename(idx));
+            continue;
+        }
+
+        const std::string label = dataPack.GetLabel(idx);
+        if (!label.empty()) {
+            numCorrect += eval::MatchesLabel(results[0].m_label, results[0].m_labelIdx, label);
+
+            /* Softmax over two classes: the other class has the remaining probability. */
+            const double top = results[0].m_normalisedVal;
+            scores.push_back(results[0].m_labelIdx == positiveIdx ? top : 1 - top);
+            positives.push_back(eval::MatchesLabel(labels[positiveIdx], positiveIdx, label));
+        }
+    }
+
+    if (!scores.empty()) {
+        report.SetMetric("top1_accuracy", static_cast<double>(numCorrect) / scores.size());
+        report.SetMetric("roc_auc", eval::RocAuc(scores, positives));
+    }
+
+    report.Print();
+    if (!options.outputPath.empty() && !report.WriteJson(options.outputPath)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AdDetector.hpp"
+
+#include <catch.hpp>
+
+using arm::app::ad::AdDecision;
+using arm::app::ad::AdDetector;
+using arm::app::ad::AdDetectorParams;
+
+TEST_CASE("AD detector smoothing")
+{
+    AdDetectorParams params;
+    params.m_threshold = -0.8f;
+    params.m_smoothing = 0.5f;
+    params.m_minWindows = 1;
+    AdDetector detector{params};
+
+    /* The first window starts the average. */
+    REQUIRE_FALSE(detector.Update(-1.f, 2.f));
+    REQUIRE(detector.GetSmoothedScore() == Approx(-1.f));
+
+    REQUIRE_FALSE(detector.Update(-0.6f, 2.5f));
+    REQUIRE(detector.GetSmoothedScore() == Approx(-0.8f));
+    REQUIRE(detector.GetMeanScore() == Approx(-0.8f));
+    REQUIRE(detector.GetWindowCount() == 2);
+}
+
+TEST_CASE("AD detector mean window")
+{
+    AdDetectorParams params;
+    params.m_minWindows = 1;
+    params.m_meanWindowLen = 2;
+    AdDetector detector{params};
+
+    detector.Update(-1.f, 0.f);
+    detector.Update(-0.6f, 0.5f);
+    REQUIRE(detector.GetMeanScore() == Approx(-0.8f));
+
+    /* The mean restarts with the next window, the window count and smoothing do not. */
+    detector.Update(-0.5f, 1.f);
+    REQUIRE(detector.GetMeanScore() == Approx(-0.5f));
+    detector.Update(-0.7f, 1.5f);
+    REQUIRE(detector.GetMeanScore() == Approx(-0.6f));
+    REQUIRE(detector.GetWindowCount() == 4);
+
+    detector.Reset();
+    REQUIRE(detector.GetMeanScore() == 0.f);
+}
+
+TEST_CASE("AD detector early decisions")
+{
+    AdDetectorParams params;
+    params.m_threshold = -0.8f;
+    params.m_margin = 0.1f;
+
+    SECTION("Not before the minimum number of windows")
+    {
+        params.m_smoothing = 0.5f;
+        params.m_minWindows = 3;
+        AdDetector detector{params};
+        detector.Update(-1.f, 0.f);
+        REQUIRE(detector.GetDecision() == AdDecision::undecided);
+        detector.Update(-1.f, 0.5f);
+        REQUIRE(detector.GetDecision() == AdDecision::undecided);
+        detector.Update(-1.f, 1.f);
+        REQUIRE(detector.GetDecision() == AdDecision::normal);
+    }
+
+    SECTION("Not within the margin of the threshold")
+    {
+        params.m_smoothing = 1.f;
+        params.m_minWindows = 1;
+        AdDetector detector{params};
+        detector.Update(-0.75f, 0.f);
+        REQUIRE(detector.GetDecision() == AdDecision::undecided);
+        detector.Update(-0.65f, 0.5f);
+        REQUIRE(detector.GetDecision() == AdDecision::anomalous);
+        detector.Update(-0.95f, 1.f);
+        REQUIRE(detector.GetDecision() == AdDecision::normal);
+    }
+}
+
+TEST_CASE("AD detector events")
+{
+    AdDetectorParams params;
+    params.m_threshold = -0.8f;
+    params.m_smoothing = 1.f;
+    params.m_margin = 0.1f;
+    params.m_minWindows = 1;
+    params.m_eventHistoryLen = 2;
+    AdDetector detector{params};
+
+    /* Normal to start with: no event. */
+    REQUIRE_FALSE(detector.Update(-1.f, 0.f));
+
+    REQUIRE(detector.Update(-0.5f, 0.5f));
+    REQUIRE(detector.GetLastEvent().m_anomalous);
+    REQUIRE(detector.GetLastEvent().m_timeStamp == Approx(0.5f));
+    REQUIRE(detector.GetLastEvent().m_windowNumber == 1);
+
+    /* Hovering around the threshold keeps the state. */
+    REQUIRE_FALSE(detector.Update(-0.85f, 1.f));
+    REQUIRE_FALSE(detector.Update(-0.75f, 1.5f));
+    REQUIRE_FALSE(detector.Update(-0.5f, 2.f));
+
+    REQUIRE(detector.Update(-1.f, 2.5f));
+    REQUIRE_FALSE(detector.GetLastEvent().m_anomalous);
+    REQUIRE(detector.GetLastEvent().m_score == Approx(-1.f));
+
+    /* Only the two most recent events are kept, oldest first. */
+    REQUIRE(detector.Update(-0.5f, 3.f));
+    REQUIRE(detector.GetEventCount() == 2);
+    REQUIRE(detector.GetEvent(0).m_timeStamp == Approx(2.5f));
+    REQUIRE(detector.GetEvent(1).m_timeStamp == Approx(3.f));
+
+    detector.Reset();
+    REQUIRE(detector.GetEventCount() == 0);
+    REQUIRE(detector.GetWindowCount() == 0);
+    REQUIRE(detector.GetDecision() == AdDecision::undecided);
+}
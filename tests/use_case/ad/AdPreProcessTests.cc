@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AdModel.hpp"
+#include "AdProcessing.hpp"
+#include "AudioUtils.hpp"
+#include "BufAttributes.hpp"
+#include "InputFiles.hpp"
+#include "TensorFlowLiteMicro.hpp"
+
+#include <catch.hpp>
+#include <cstring>
+#include <vector>
+
+namespace arm {
+namespace app {
+    static uint8_t tensorArena[ACTIVATION_BUF_SZ] ACTIVATION_BUF_ATTRIBUTE;
+    namespace ad {
+        extern uint8_t* GetModelPointer();
+        extern size_t GetModelLen();
+    } /* namespace ad */
+} /* namespace app */
+} /* namespace arm */
+
+/**
+ * @brief       Pre-processes every window of a clip, as the use case does.
+ * @param[in]   reuse   Whether features are reused from the previous window.
+ * @param[in]   check   Called with the window index once the input tensor is populated.
+ * @return      Number of windows.
+ **/
+template<typename Fn>
+static size_t PreProcessClip(arm::app::AdPreProcess& preProcess, uint32_t clipIdx, bool reuse, Fn check)
+{
+    auto audioDataSlider = arm::app::audio::SlidingWindow<const int16_t>(
+            GetAudioArray(clipIdx), GetAudioArraySize(clipIdx),
+            preProcess.GetAudioWindowSize(), preProcess.GetAudioDataStride());
+
+    while (audioDataSlider.HasNext()) {
+        const int16_t* inferenceWindow = audioDataSlider.Next();
+        preProcess.SetAudioWindowIndex(reuse ? audioDataSlider.Index() : 0);
+        REQUIRE(preProcess.DoPreProcess(inferenceWindow, preProcess.GetAudioWindowSize()));
+        check(audioDataSlider.Index());
+    }
+    return audioDataSlider.Index() + 1;
+}
+
+TEST_CASE("Incremental AD features match full recompute", "[AD]")
+{
+    arm::app::AdModel model;
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::ad::GetModelPointer(),
+                       arm::app::ad::GetModelLen()));
+    TfLiteTensor* inputTensor = model.GetInputTensor(0);
+
+    arm::app::AdPreProcess incremental{inputTensor, static_cast<uint32_t>(arm::app::ad::g_FrameLength),
+                                       static_cast<uint32_t>(arm::app::ad::g_FrameStride),
+                                       arm::app::ad::g_TrainingMean};
+    arm::app::AdPreProcess full{inputTensor, static_cast<uint32_t>(arm::app::ad::g_FrameLength),
+                                static_cast<uint32_t>(arm::app::ad::g_FrameStride),
+                                arm::app::ad::g_TrainingMean};
+
+    for (uint32_t clipIdx = 0; clipIdx < NUMBER_OF_FILES; ++clipIdx) {
+        std::vector<std::vector<uint8_t>> expected;
+        PreProcessClip(full, clipIdx, false, [&](size_t) {
+            expected.emplace_back(inputTensor->data.uint8, inputTensor->data.uint8 + inputTensor->bytes);
+        });
+
+        PreProcessClip(incremental, clipIdx, true, [&](size_t idx) {
+            REQUIRE(0 == std::memcmp(expected[idx].data(), inputTensor->data.data, inputTensor->bytes));
+        });
+    }
+}
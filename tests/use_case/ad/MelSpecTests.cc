@@ -16,6 +16,7 @@
  */
 
 #include "AdMelSpectrogram.hpp"
+#include "AudioFrontEnd.hpp"
 #include <limits>
 #include <algorithm>
 #include <catch.hpp>
@@ -215,3 +216,51 @@ TEST_CASE("Mel Spec calculation") {
         TestQuntisedMelSpec<int16_t>();
     }
 }
+
+TEST_CASE("Audio front end matches the mel spectrograms")
+{
+    using arm::app::audio::AdMelSpectrogram;
+    arm::app::audio::AudioFrontEndParams params;
+    params.m_samplingFreq = AdMelSpectrogram::ms_defaultSamplingFreq;
+    params.m_frameLen = testWav1.size();
+    params.m_numMelBins = AdMelSpectrogram::ms_defaultNumFbankBins;
+    params.m_melLoFreq = AdMelSpectrogram::ms_defaultMelLoFreq;
+    params.m_melHiFreq = AdMelSpectrogram::ms_defaultMelHiFreq;
+    params.m_useHtkMethod = AdMelSpectrogram::ms_defaultUseHtkMethod;
+    params.m_mean = -30;
+    params.m_quantScale = 0.1410219967365265;
+    params.m_quantOffset = 11;
+    std::vector<arm::app::audio::FeatureStage> stages;
+    std::vector<float> melSpec(params.m_numMelBins);
+
+    SECTION("AD log mel spectrogram")
+    {
+        params.m_slaneyNorm = true;
+        REQUIRE(arm::app::audio::AudioFrontEnd::ParseStages(
+            "frame,window,fft,power,mel,decibel,normalise,quantise", stages));
+        arm::app::audio::AudioFrontEnd frontEnd(stages, params);
+        REQUIRE(frontEnd.IsValid());
+
+        REQUIRE(frontEnd.ComputeFrame(testWav1.data(), testWav1.size(), melSpec.data()));
+        CHECK(melSpec == GetMelSpecInstance().ComputeMelSpec(testWav1, params.m_mean));
+
+        std::vector<int8_t> melSpecQuant(params.m_numMelBins);
+        REQUIRE(frontEnd.ComputeFrame(testWav1.data(), testWav1.size(), melSpecQuant.data()));
+        CHECK(melSpecQuant == GetMelSpecInstance().MelSpecComputeQuant<int8_t>(
+            testWav1.data(), testWav1.size(), params.m_quantScale, params.m_quantOffset, params.m_mean));
+    }
+
+    SECTION("Base mel spectrogram")
+    {
+        REQUIRE(arm::app::audio::AudioFrontEnd::ParseStages(
+            "frame,window,fft,magnitude,mel,log,normalise", stages));
+        arm::app::audio::AudioFrontEnd frontEnd(stages, params);
+        REQUIRE(frontEnd.IsValid());
+
+        arm::app::audio::MelSpectrogram baseMelSpec(arm::app::audio::MelSpecParams(
+            params.m_samplingFreq, params.m_numMelBins, params.m_melLoFreq, params.m_melHiFreq,
+            params.m_frameLen, params.m_useHtkMethod));
+        REQUIRE(frontEnd.ComputeFrame(testWav1.data(), testWav1.size(), melSpec.data()));
+        CHECK(melSpec == baseMelSpec.ComputeMelSpec(testWav1, params.m_mean));
+    }
+}
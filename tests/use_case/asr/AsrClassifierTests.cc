@@ -15,8 +15,10 @@
  * limitations under the License.
  */
 #include "AsrClassifier.hpp"
+#include "OutputDecode.hpp"
 #include "Wav2LetterModel.hpp"
 
+#include <algorithm>
 #include <catch.hpp>
 
 TEST_CASE("Test invalid classifier")
@@ -96,3 +98,61 @@ TEST_CASE("Get classification results") {
     REQUIRE(resultVec[8].m_labelIdx == 11);
     REQUIRE(resultVec[9].m_labelIdx == 1);
 }
+
+TEST_CASE("Classification results label every row")
+{
+    /* Runs of letters and blanks, as CTC output has; "$" is the blank. */
+    std::vector<std::string> labels;
+    for (char c = 'a'; c <= 'z'; ++c) {
+        labels.emplace_back(1, c);
+    }
+    labels.insert(labels.end(), {"'", " ", "$"});
+
+    const int rows = 148;
+    const int cols = 29;
+    int dimArray[] = {4, 1, 1, rows, cols};
+    TfLiteIntArray* dims = tflite::testing::IntArrayFromInts(dimArray);
+    arm::app::AsrClassifier classifier;
+
+    std::vector<arm::app::ClassificationResult> combined;
+    std::vector<arm::app::ClassificationResult> combinedExpected;
+    uint32_t state = 3;
+    uint32_t top = cols - 1;
+
+    /* Runs carry over from one window to the next. */
+    for (int window = 0; window < 4; ++window) {
+        std::vector<int8_t> outputVec(rows * cols);
+        for (int r = 0; r < rows; ++r) {
+            state = state * 1664525u + 1013904223u;
+            if ((state >> 28) < 5) {
+                top = (state >> 28) < 2 ? cols - 1 : (state >> 8) % cols;
+            }
+            for (int c = 0; c < cols; ++c) {
+                outputVec[r * cols + c] = static_cast<int8_t>(((state >> (c % 24)) & 63) - 100);
+            }
+            outputVec[r * cols + top] = 10;
+        }
+        TfLiteTensor tfTensor = tflite::testing::CreateQuantizedTensor(outputVec.data(), dims, 1, 0);
+
+        std::vector<arm::app::ClassificationResult> resultVec;
+        REQUIRE(classifier.GetClassificationResults(&tfTensor, resultVec, labels, 1));
+        REQUIRE(resultVec.size() == rows);
+
+        std::vector<arm::app::ClassificationResult> expected(rows);
+        for (int r = 0; r < rows; ++r) {
+            const int8_t* row = outputVec.data() + r * cols;
+            expected[r].m_labelIdx = std::max_element(row, row + cols) - row;
+            expected[r].m_label = labels[expected[r].m_labelIdx];
+            REQUIRE(resultVec[r].m_labelIdx == expected[r].m_labelIdx);
+            REQUIRE(resultVec[r].m_label == expected[r].m_label);
+            REQUIRE(resultVec[r].m_normalisedVal == 10);
+        }
+
+        CHECK(arm::app::audio::asr::DecodeOutput(resultVec) == arm::app::audio::asr::DecodeOutput(expected));
+        combined.insert(combined.end(), resultVec.begin(), resultVec.end());
+        combinedExpected.insert(combinedExpected.end(), expected.begin(), expected.end());
+    }
+
+    /* Results of consecutive inferences are decoded together too. */
+    CHECK(arm::app::audio::asr::DecodeOutput(combined) == arm::app::audio::asr::DecodeOutput(combinedExpected));
+}
@@ -20,6 +20,7 @@
 
 #include "log_macros.h"
 
+#include <algorithm>
 #include <catch.hpp>
 #include <random>
 
@@ -138,3 +139,71 @@ TEST_CASE("Floating point asr features calculation", "[ASR]")
         checker(norm1, goldenNorm1);
     }
 }
+
+/* The deltas over frame-major buffers, each frame's features contiguous: the
+ * features of an output frame are convolved at once, accumulating in registers. */
+static void ComputeDeltasFrameMajor(arm::app::Array2d<float, arm::app::Array2dLayout::colMajor>& mfcc,
+                                    arm::app::Array2d<float, arm::app::Array2dLayout::colMajor>& delta1,
+                                    arm::app::Array2d<float, arm::app::Array2dLayout::colMajor>& delta2)
+{
+    const float delta1Coeffs[] =
+        {6.66666667e-02,  5.00000000e-02,  3.33333333e-02,
+         1.66666667e-02, -3.46944695e-18, -1.66666667e-02,
+        -3.33333333e-02, -5.00000000e-02, -6.66666667e-02};
+    const float delta2Coeffs[] =
+        {0.06060606,      0.01515152,     -0.01731602,
+        -0.03679654,     -0.04329004,     -0.03679654,
+        -0.01731602,      0.01515152,      0.06060606};
+    constexpr size_t blockLen = 16;
+    const size_t numFeatures = mfcc.size(0);
+
+    for (size_t j = 4; j < mfcc.size(1) - 4; ++j) {
+        const float* window = mfcc.col(j - 4).data();
+        for (size_t i = 0; i < numFeatures; i += blockLen) {
+            const size_t len = std::min(blockLen, numFeatures - i);
+            float sum1[blockLen] = {0};
+            float sum2[blockLen] = {0};
+            const float* tap = window + i;
+            for (size_t k = 0, m = 8; k < 9; ++k, --m, tap += numFeatures) {
+                for (size_t n = 0; n < len; ++n) {
+                    sum1[n] += tap[n] * delta1Coeffs[m];
+                    sum2[n] += tap[n] * delta2Coeffs[m];
+                }
+            }
+            std::copy(sum1, sum1 + len, delta1.col(j).data() + i);
+            std::copy(sum2, sum2 + len, delta2.col(j).data() + i);
+        }
+    }
+}
+
+TEST_CASE("ASR deltas do not depend on the buffer layout", "[ASR]")
+{
+    using FrameMajor = arm::app::Array2d<float, arm::app::Array2dLayout::colMajor>;
+    constexpr uint32_t numMfccFeats = 13;
+    constexpr uint32_t numFeatVectors = 296;
+
+    arm::app::Array2d<float> mfcc(numMfccFeats, numFeatVectors);
+    arm::app::Array2d<float> delta1(numMfccFeats, numFeatVectors);
+    arm::app::Array2d<float> delta2(numMfccFeats, numFeatVectors);
+    FrameMajor mfccFrames(numMfccFeats, numFeatVectors);
+    FrameMajor delta1Frames(numMfccFeats, numFeatVectors);
+    FrameMajor delta2Frames(numMfccFeats, numFeatVectors);
+
+    std::minstd_rand generator(1);
+    std::uniform_real_distribution<float> distribution(-20, 20);
+    for (size_t i = 0; i < numMfccFeats; ++i) {
+        for (size_t j = 0; j < numFeatVectors; ++j) {
+            mfcc(i, j) = mfccFrames(i, j) = distribution(generator);
+        }
+    }
+
+    TestPreprocess::ComputeDeltas(mfcc, delta1, delta2);
+    ComputeDeltasFrameMajor(mfccFrames, delta1Frames, delta2Frames);
+
+    for (size_t i = 0; i < numMfccFeats; ++i) {
+        for (size_t j = 4; j < numFeatVectors - 4; ++j) {
+            REQUIRE(delta1(i, j) == delta1Frames(i, j));
+            REQUIRE(delta2(i, j) == delta2Frames(i, j));
+        }
+    }
+}
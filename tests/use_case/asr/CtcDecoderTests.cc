@@ -0,0 +1,234 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CtcDecoder.hpp"
+#include "OutputDecode.hpp"
+#include "TensorFlowLiteMicro.hpp"
+
+#include <catch.hpp>
+
+/* Wav2Letter labels: a-z, apostrophe, space and the blank token. */
+static std::vector<std::string> GetTestLabels()
+{
+    std::vector<std::string> labels;
+    for (char c = 'a'; c <= 'z'; ++c) {
+        labels.emplace_back(1, c);
+    }
+    labels.emplace_back("'");
+    labels.emplace_back(" ");
+    labels.emplace_back("$");
+    return labels;
+}
+
+static constexpr uint32_t blankTokenIdx = 28;
+static constexpr uint32_t numCols = 29;
+
+/* Unlikely labels; with a scale of 0.1 their probability is negligible. */
+static constexpr int8_t lowLogit = -128;
+
+static uint32_t LabelIdx(char c)
+{
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a';
+    }
+    return (c == '\'') ? 26 : (c == ' ') ? 27 : blankTokenIdx;
+}
+
+/**
+ * @brief   Test output tensor with Wav2Letter layout {1, 1, rows, cols}.
+ **/
+class TestOutput {
+public:
+    explicit TestOutput(size_t numRows)
+    :   m_data(numRows * numCols, lowLogit)
+    {
+        m_shape = {4, 1, 1, static_cast<int>(numRows), numCols};
+        TfLiteIntArray* dims = tflite::testing::IntArrayFromInts(m_shape.data());
+        m_tensor = tflite::testing::CreateQuantizedTensor(m_data.data(), dims, 0.1f, 0, "test-tensor");
+    }
+
+    /* Sets the logits, in units of the 0.1 scale, of a row. */
+    void SetRow(size_t row, char c, int8_t logit = 0)
+    {
+        m_data[row * numCols + LabelIdx(c)] = logit;
+    }
+
+    /* One row per character, each one certain. */
+    void SetText(size_t firstRow, const std::string& text)
+    {
+        for (size_t i = 0; i < text.size(); ++i) {
+            SetRow(firstRow + i, text[i]);
+        }
+    }
+
+    TfLiteTensor* Get()
+    {
+        return &m_tensor;
+    }
+
+private:
+    std::vector<int>    m_shape;
+    std::vector<int8_t> m_data;
+    TfLiteTensor        m_tensor;
+};
+
+TEST_CASE("Greedy CTC decoding matches OutputDecode")
+{
+    const auto labels = GetTestLabels();
+    const std::string testText[] = {
+        "abcdefggg hhi  jk''l",
+        "abcdefggo$ohi  jk''l",
+        "a$adefggo$ohi  jkl$l",
+        "$abdefggo$ohi  jkl$$",
+    };
+
+    for (const auto& text : testText) {
+        TestOutput output(text.size());
+        output.SetText(0, text);
+
+        std::vector<arm::app::ClassificationResult> results(text.size());
+        for (size_t i = 0; i < text.size(); ++i) {
+            results[i].m_label = std::string(1, text[i]);
+        }
+
+        arm::app::audio::asr::CtcDecoder decoder(labels, blankTokenIdx);
+        REQUIRE(decoder.DecodeRows(output.Get(), 0, text.size()));
+        decoder.Flush();
+        REQUIRE(decoder.GetStableText() == arm::app::audio::asr::DecodeOutput(results));
+    }
+}
+
+TEST_CASE("CTC decoding across windows")
+{
+    const auto labels = GetTestLabels();
+    constexpr uint32_t ctxLen = 2;
+
+    SECTION("Context rows are skipped")
+    {
+        /* Only the rows kept by AsrPostProcess carry text; context rows carry "x" and "y". */
+        TestOutput output(2 * ctxLen + 3);
+        output.SetText(0, "xyabcyx");
+
+        arm::app::audio::asr::CtcDecoder first(labels, blankTokenIdx);
+        REQUIRE(first.DecodeWindow(output.Get(), ctxLen, true, false));
+        REQUIRE(first.GetStableText() == "xyabc");
+
+        arm::app::audio::asr::CtcDecoder middle(labels, blankTokenIdx);
+        REQUIRE(middle.DecodeWindow(output.Get(), ctxLen, false, false));
+        REQUIRE(middle.GetStableText() == "abc");
+
+        arm::app::audio::asr::CtcDecoder last(labels, blankTokenIdx);
+        REQUIRE(last.DecodeWindow(output.Get(), ctxLen, false, true));
+        REQUIRE(last.GetStableText() == "abcyx");
+    }
+
+    SECTION("Repeats are collapsed across windows")
+    {
+        TestOutput output1(4);
+        output1.SetText(0, "$hel");
+        TestOutput output2(4);
+        output2.SetText(0, "l$lo");
+
+        for (uint32_t beamWidth : {1, 4}) {
+            arm::app::audio::asr::CtcDecoder decoder(labels, blankTokenIdx, beamWidth);
+            REQUIRE(decoder.DecodeRows(output1.Get(), 0, 4));
+            REQUIRE(decoder.GetBestText() == "hel");
+            REQUIRE(decoder.DecodeRows(output2.Get(), 0, 4));
+            decoder.Flush();
+            REQUIRE(decoder.GetStableText() == "hello");
+        }
+    }
+
+    SECTION("Invalid output")
+    {
+        arm::app::audio::asr::CtcDecoder decoder(labels, blankTokenIdx);
+        REQUIRE_FALSE(decoder.DecodeWindow(nullptr, ctxLen, true, true));
+
+        TestOutput output(2 * ctxLen);
+        REQUIRE_FALSE(decoder.DecodeWindow(output.Get(), ctxLen, true, true));
+        REQUIRE_FALSE(decoder.DecodeRows(output.Get(), 0, 2 * ctxLen + 1));
+
+        const std::vector<std::string> shortLabels = {"a", "b", "$"};
+        arm::app::audio::asr::CtcDecoder shortDecoder(shortLabels, 2);
+        REQUIRE_FALSE(shortDecoder.DecodeRows(output.Get(), 0, 1));
+    }
+}
+
+TEST_CASE("CTC beam search")
+{
+    const auto labels = GetTestLabels();
+
+    SECTION("Stable text grows with certain input")
+    {
+        const std::string text = "yes no go";
+        TestOutput output(text.size());
+        output.SetText(0, text);
+
+        arm::app::audio::asr::CtcDecoder decoder(labels, blankTokenIdx, 4);
+        for (size_t i = 0; i < text.size(); ++i) {
+            REQUIRE(decoder.DecodeRows(output.Get(), i, i + 1));
+            REQUIRE(decoder.GetStableText() == text.substr(0, i + 1));
+        }
+    }
+
+    SECTION("Paths are merged")
+    {
+        /* Each row: "a" 0.4, blank 0.6. Greedy gives nothing while the
+         * paths "aa", "a$" and "$a" give "a" a probability of 0.64. */
+        TestOutput output(2);
+        for (size_t row = 0; row < 2; ++row) {
+            output.SetRow(row, 'a', -9);
+            output.SetRow(row, '$', -5);
+        }
+
+        arm::app::audio::asr::CtcDecoder greedy(labels, blankTokenIdx, 1);
+        REQUIRE(greedy.DecodeRows(output.Get(), 0, 2));
+        greedy.Flush();
+        REQUIRE(greedy.GetStableText().empty());
+
+        arm::app::audio::asr::CtcDecoder beam(labels, blankTokenIdx, 4);
+        REQUIRE(beam.DecodeRows(output.Get(), 0, 2));
+        beam.Flush();
+        REQUIRE(beam.GetStableText() == "a");
+    }
+
+    SECTION("Lexicon boost")
+    {
+        /* Second row: "a" 0.45, "o" 0.55. */
+        TestOutput output(4);
+        output.SetRow(0, 'c');
+        output.SetRow(1, 'a', -8);
+        output.SetRow(1, 'o', -6);
+        output.SetText(2, "t ");
+
+        arm::app::audio::asr::CtcDecoder plain(labels, blankTokenIdx, 4);
+        REQUIRE(plain.DecodeRows(output.Get(), 0, 4));
+        plain.Flush();
+        REQUIRE(plain.GetStableText() == "cot ");
+
+        arm::app::audio::asr::CtcDecoder boosted(labels, blankTokenIdx, 4);
+        boosted.SetLexicon({"cat", "dog"}, 1.f);
+        REQUIRE(boosted.DecodeRows(output.Get(), 0, 4));
+        boosted.Flush();
+        REQUIRE(boosted.GetStableText() == "cat ");
+
+        /* The last word of the transcript is boosted on Flush(). */
+        boosted.Reset();
+        REQUIRE(boosted.DecodeRows(output.Get(), 0, 3));
+        boosted.Flush();
+        REQUIRE(boosted.GetStableText() == "cat");
+    }
+}
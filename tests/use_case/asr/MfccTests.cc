@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "Wav2LetterMfcc.hpp"
+#include "AudioFrontEnd.hpp"
 
 #include <algorithm>
 #include <catch.hpp>
@@ -159,3 +160,32 @@ TEST_CASE("MFCC calculation")
         TestQuantisedMFCC<int16_t>();
     }
 }
+
+TEST_CASE("Audio front end matches Wav2Letter MFCC")
+{
+    using arm::app::audio::Wav2LetterMFCC;
+    arm::app::audio::AudioFrontEndParams params;
+    params.m_samplingFreq = Wav2LetterMFCC::ms_defaultSamplingFreq;
+    params.m_frameLen = testWav1.size();
+    params.m_numMelBins = Wav2LetterMFCC::ms_defaultNumFbankBins;
+    params.m_melLoFreq = Wav2LetterMFCC::ms_defaultMelLoFreq;
+    params.m_melHiFreq = Wav2LetterMFCC::ms_defaultMelHiFreq;
+    params.m_useHtkMethod = Wav2LetterMFCC::ms_defaultUseHtkMethod;
+    params.m_slaneyNorm = true;
+    params.m_melFloor = 1e-10;
+    params.m_topDb = 80;
+    params.m_numDctCoeffs = golden_mfcc_output_testWav1.size();
+    params.m_orthonormalDct = true;
+
+    std::vector<arm::app::audio::FeatureStage> stages;
+    REQUIRE(arm::app::audio::AudioFrontEnd::ParseStages("frame,window,fft,power,mel,decibel,dct", stages));
+    arm::app::audio::AudioFrontEnd frontEnd(stages, params);
+    REQUIRE(frontEnd.IsValid());
+
+    std::vector<float> mfcc(frontEnd.GetNumFeatures());
+    REQUIRE(frontEnd.ComputeFrame(testWav1.data(), testWav1.size(), mfcc.data()));
+    CHECK(mfcc == GetMFCCInstance().MfccCompute(testWav1));
+
+    REQUIRE(frontEnd.ComputeFrame(testWav2.data(), testWav2.size(), mfcc.data()));
+    CHECK(mfcc == GetMFCCInstance().MfccCompute(testWav2));
+}
@@ -15,8 +15,11 @@
  * limitations under the License.
  */
 #include "Wav2LetterPreprocess.hpp"
+#include "AudioFrontEnd.hpp"
 
+#include <cmath>
 #include <limits>
+#include <random>
 #include <catch.hpp>
 
 constexpr uint32_t numMfccFeatures = 13;
@@ -133,3 +136,158 @@ TEST_CASE("Preprocessing calculation INT8")
         }
     }
 }
+
+TEST_CASE("Audio front end matches the pre-processing")
+{
+    const uint32_t  mfccWindowLen      = 512;
+    const uint32_t  mfccWindowStride   = 160;
+    int             dimArray[]         = {3, 1, numMfccFeatures * 3, numMfccVectors};
+    const float     quantScale         = 0.1410219967365265;
+    const int       quantOffset        = -11;
+
+    std::vector<int16_t> testWav((mfccWindowStride * numMfccVectors) +
+                                  (mfccWindowLen - mfccWindowStride));
+    PopulateTestWavVector(testWav);
+
+    std::vector<int8_t> tensorVec(dimArray[1]*dimArray[2]*dimArray[3]);
+    TfLiteIntArray* dims= tflite::testing::IntArrayFromInts(dimArray);
+    TfLiteTensor inputTensor = tflite::testing::CreateQuantizedTensor(
+            tensorVec.data(), dims, quantScale, quantOffset, "preprocessedInput");
+    arm::app::AsrPreProcess prep{&inputTensor,
+                                 numMfccFeatures, numMfccVectors, mfccWindowLen, mfccWindowStride};
+    REQUIRE(prep.DoPreProcess(testWav.data(), testWav.size()));
+
+    using arm::app::audio::Wav2LetterMFCC;
+    arm::app::audio::AudioFrontEndParams params;
+    params.m_samplingFreq = Wav2LetterMFCC::ms_defaultSamplingFreq;
+    params.m_frameLen = mfccWindowLen;
+    params.m_frameStride = mfccWindowStride;
+    params.m_numFrames = numMfccVectors;
+    params.m_numMelBins = Wav2LetterMFCC::ms_defaultNumFbankBins;
+    params.m_melLoFreq = Wav2LetterMFCC::ms_defaultMelLoFreq;
+    params.m_melHiFreq = Wav2LetterMFCC::ms_defaultMelHiFreq;
+    params.m_useHtkMethod = Wav2LetterMFCC::ms_defaultUseHtkMethod;
+    params.m_slaneyNorm = true;
+    params.m_melFloor = 1e-10;
+    params.m_topDb = 80;
+    params.m_numDctCoeffs = numMfccFeatures;
+    params.m_orthonormalDct = true;
+    params.m_quantScale = quantScale;
+    params.m_quantOffset = quantOffset;
+
+    std::vector<arm::app::audio::FeatureStage> stages;
+    REQUIRE(arm::app::audio::AudioFrontEnd::ParseStages(
+        "frame,window,fft,power,mel,decibel,dct,deltas,standardise,quantise", stages));
+    arm::app::audio::AudioFrontEnd frontEnd(stages, params);
+    REQUIRE(frontEnd.IsValid());
+    REQUIRE(frontEnd.GetNumBlockFeatures() == numMfccFeatures * 3);
+
+    std::vector<int8_t> features(tensorVec.size());
+    REQUIRE(frontEnd.ComputeBlock(testWav.data(), testWav.size(), features.data(), features.size()));
+    CHECK(features == tensorVec);
+
+    /* Short audio, the missing frames being padded with those of silence. */
+    const size_t shortLen = testWav.size() / 2;
+    REQUIRE(prep.DoPreProcess(testWav.data(), shortLen));
+    REQUIRE(frontEnd.ComputeBlock(testWav.data(), shortLen, features.data(), features.size()));
+    CHECK(features == tensorVec);
+}
+
+/* Exposes the unfused steps, to reproduce the pre-processing as it was before its fused pass. */
+class ReferencePreProcess : public arm::app::AsrPreProcess {
+public:
+    using AsrPreProcess::AsrPreProcess;
+
+    static std::vector<int8_t> Compute(const std::vector<int16_t>& audio, uint32_t numFrames,
+                                       uint32_t windowLen, uint32_t windowStride,
+                                       float quantScale, int quantOffset)
+    {
+        arm::app::audio::Wav2LetterMFCC mfcc(numMfccFeatures, windowLen);
+        mfcc.Init();
+
+        arm::app::Array2d<float> mfccBuf(numMfccFeatures, numFrames);
+        arm::app::Array2d<float> delta1Buf(numMfccFeatures, numFrames);
+        arm::app::Array2d<float> delta2Buf(numMfccFeatures, numFrames);
+        std::fill(delta1Buf.begin(), delta1Buf.end(), 0.f);
+        std::fill(delta2Buf.begin(), delta2Buf.end(), 0.f);
+
+        const std::vector<int16_t> silence(windowLen, 0);
+        for (uint32_t j = 0; j < numFrames; ++j) {
+            const bool full = j * windowStride + windowLen <= audio.size();
+            const std::vector<float> features = full ?
+                mfcc.MfccCompute(audio.data() + j * windowStride, windowLen) : mfcc.MfccCompute(silence);
+            for (uint32_t i = 0; i < numMfccFeatures; ++i) {
+                mfccBuf(i, j) = features[i];
+            }
+        }
+
+        AsrPreProcess::ComputeDeltas(mfccBuf, delta1Buf, delta2Buf);
+        AsrPreProcess::StandardizeVecF32(mfccBuf);
+        AsrPreProcess::StandardizeVecF32(delta1Buf);
+        AsrPreProcess::StandardizeVecF32(delta2Buf);
+
+        std::vector<int8_t> output;
+        for (uint32_t j = 0; j < numFrames; ++j) {
+            for (auto* buf : {&mfccBuf, &delta1Buf, &delta2Buf}) {
+                for (uint32_t i = 0; i < numMfccFeatures; ++i) {
+                    const float val = std::round(((*buf)(i, j) / quantScale) + quantOffset);
+                    output.push_back(static_cast<int8_t>(std::min<float>(std::max<float>(val, -128), 127)));
+                }
+            }
+        }
+        return output;
+    }
+};
+
+TEST_CASE("Fused standardisation and quantisation is bit exact")
+{
+    const uint32_t  mfccWindowLen      = 512;
+    const uint32_t  mfccWindowStride   = 160;
+    const uint32_t  numFrames          = 296;
+    int             dimArray[]         = {3, 1, numMfccFeatures * 3, numFrames};
+    const float     quantScale         = 0.1410219967365265;
+    const int       quantOffset        = -11;
+
+    std::vector<int8_t> tensorVec(numFrames * numMfccFeatures * 3);
+    TfLiteIntArray* dims= tflite::testing::IntArrayFromInts(dimArray);
+    TfLiteTensor inputTensor = tflite::testing::CreateQuantizedTensor(
+            tensorVec.data(), dims, quantScale, quantOffset, "preprocessedInput");
+    arm::app::AsrPreProcess prep{&inputTensor,
+                                 numMfccFeatures, numFrames, mfccWindowLen, mfccWindowStride};
+
+    const size_t audioLen = mfccWindowStride * numFrames + (mfccWindowLen - mfccWindowStride);
+    std::vector<int16_t> squares(audioLen);
+    PopulateTestWavVector(squares);
+
+    std::minstd_rand generator(1);
+    std::normal_distribution<float> noise(0, 2000);
+    std::vector<int16_t> chirp(audioLen);
+    for (size_t i = 0; i < audioLen; ++i) {
+        const float t = static_cast<float>(i) / 16000;
+        chirp[i] = static_cast<int16_t>(std::max(-32768.f, std::min(32767.f,
+            8000 * std::sin(2 * static_cast<float>(M_PI) * (100 + 1500 * t) * t) + noise(generator))));
+    }
+
+    for (const auto* audio : {&squares, &chirp}) {
+        /* The whole window, and short audio padded with silence. */
+        for (const size_t len : {audio->size(), audio->size() / 3}) {
+            const std::vector<int16_t> clip(audio->begin(), audio->begin() + len);
+            REQUIRE(prep.DoPreProcess(clip.data(), clip.size()));
+            CHECK(tensorVec == ReferencePreProcess::Compute(clip, numFrames, mfccWindowLen, mfccWindowStride,
+                                                            quantScale, quantOffset));
+        }
+    }
+
+    /* Noise of varying level: statistics computed any other way than the reference's
+     * move the odd element by a quantisation step over clips like these. */
+    std::vector<int16_t> noisy(audioLen);
+    for (int clip = 0; clip < 100; ++clip) {
+        std::normal_distribution<float> level(0, 100.f * (1 + clip % 8) * (1 + clip / 8));
+        for (auto& sample : noisy) {
+            sample = static_cast<int16_t>(std::max(-32768.f, std::min(32767.f, level(generator))));
+        }
+        REQUIRE(prep.DoPreProcess(noisy.data(), noisy.size()));
+        REQUIRE(tensorVec == ReferencePreProcess::Compute(noisy, numFrames, mfccWindowLen, mfccWindowStride,
+                                                          quantScale, quantOffset));
+    }
+}
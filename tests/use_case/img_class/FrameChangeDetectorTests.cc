@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ImageUtils.hpp"
+
+#include <catch.hpp>
+#include <cstring>
+
+static constexpr uint32_t frameCols = 224;
+static constexpr uint32_t frameRows = 224;
+static constexpr uint32_t frameChannels = 3;
+static constexpr size_t frameSz = frameCols * frameRows * frameChannels;
+
+TEST_CASE("Sum of absolute differences")
+{
+    std::vector<uint8_t> a(37);
+    std::vector<uint8_t> b(37);
+    uint32_t expected = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<uint8_t>(i * 7);
+        b[i] = static_cast<uint8_t>(255 - i * 3);
+        expected += std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i]));
+    }
+    REQUIRE(expected == arm::app::image::SumAbsDiffU8(a.data(), b.data(), a.size()));
+    REQUIRE(0 == arm::app::image::SumAbsDiffU8(a.data(), a.data(), a.size()));
+}
+
+TEST_CASE("Frame change detection")
+{
+    std::vector<uint8_t> frame(frameSz, 100);
+
+    SECTION("First frame is always changed, identical frames are not")
+    {
+        arm::app::image::FrameChangeDetector detector{
+            frameCols, frameRows, frameChannels, 4.f, 0};
+        REQUIRE(detector.HasChanged(frame.data()));
+        for (int i = 1; i <= 10; ++i) {
+            REQUIRE_FALSE(detector.HasChanged(frame.data()));
+            REQUIRE(detector.GetSkippedFrames() == static_cast<uint32_t>(i));
+        }
+    }
+
+    SECTION("Sensor noise and small objects are below threshold, scene change is not")
+    {
+        arm::app::image::FrameChangeDetector detector{
+            frameCols, frameRows, frameChannels, 4.f, 0};
+        REQUIRE(detector.HasChanged(frame.data()));
+
+        std::vector<uint8_t> noisy(frame);
+        for (size_t i = 0; i < noisy.size(); ++i) {
+            noisy[i] += (i % 5) - 2;
+        }
+        REQUIRE_FALSE(detector.HasChanged(noisy.data()));
+
+        std::vector<uint8_t> changed(frame);
+        std::memset(changed.data(), 200, changed.size() / 2);
+        REQUIRE(detector.HasChanged(changed.data()));
+        REQUIRE(detector.GetLastDifference() > 4.f);
+
+        /* The changed frame is now the reference. */
+        REQUIRE_FALSE(detector.HasChanged(changed.data()));
+    }
+
+    SECTION("Maximum skip interval forces a change")
+    {
+        const uint32_t maxSkip = 3;
+        arm::app::image::FrameChangeDetector detector{
+            frameCols, frameRows, frameChannels, 4.f, maxSkip};
+        REQUIRE(detector.HasChanged(frame.data()));
+        for (uint32_t i = 0; i < maxSkip; ++i) {
+            REQUIRE_FALSE(detector.HasChanged(frame.data()));
+        }
+        REQUIRE(detector.HasChanged(frame.data()));
+        REQUIRE(detector.GetSkippedFrames() == 0);
+    }
+
+    SECTION("Zero threshold disables gating")
+    {
+        arm::app::image::FrameChangeDetector detector{
+            frameCols, frameRows, frameChannels, 0.f, 0};
+        REQUIRE(detector.HasChanged(frame.data()));
+        REQUIRE(detector.HasChanged(frame.data()));
+    }
+
+    SECTION("Reset forgets the reference frame")
+    {
+        arm::app::image::FrameChangeDetector detector{
+            frameCols, frameRows, frameChannels, 4.f, 0};
+        REQUIRE(detector.HasChanged(frame.data()));
+        detector.Reset();
+        REQUIRE(detector.HasChanged(frame.data()));
+    }
+}
@@ -122,4 +122,34 @@ TEST_CASE("Test valid classifier int8, average=0")
 
     std::vector<std::vector<float>> expectedHistory = {};
     REQUIRE(resultHistory == expectedHistory);
-}
\ No newline at end of file
+}
+TEST_CASE("Test quantised top N against the dequantised one")
+{
+    int dimArray[] = {1, 12};
+    std::vector<std::string> labels(12);
+    std::vector<int8_t> outputVec = {-128, -90, 17, -3, 100, -128, 56, 2, -60, 99, -7, 30};
+    TfLiteIntArray* dims= tflite::testing::IntArrayFromInts(dimArray);
+    TfLiteTensor tfTensor = tflite::testing::CreateQuantizedTensor(
+            outputVec.data(), dims, 0.0390625, -128);
+    TfLiteTensor* outputTensor = &tfTensor;
+    std::vector<std::vector<float>> resultHistory = {};
+    arm::app::KwsClassifier classifier;
+
+    for (const bool useSoftmax : {false, true}) {
+        std::vector<arm::app::ClassificationResult> resultVec;
+        std::vector<arm::app::ClassificationResult> expectedVec;
+
+        /* The base class dequantises the whole output first. */
+        REQUIRE(classifier.GetClassificationResults(outputTensor, resultVec, labels, 3, useSoftmax, resultHistory));
+        REQUIRE(classifier.Classifier::GetClassificationResults(outputTensor, expectedVec, labels, 3, useSoftmax));
+
+        REQUIRE(resultVec.size() == 3);
+        for (size_t i = 0; i < resultVec.size(); ++i) {
+            REQUIRE(resultVec[i].m_labelIdx == expectedVec[i].m_labelIdx);
+            REQUIRE(resultVec[i].m_normalisedVal == expectedVec[i].m_normalisedVal);
+        }
+        REQUIRE(resultVec[0].m_labelIdx == 4);
+        REQUIRE(resultVec[1].m_labelIdx == 9);
+        REQUIRE(resultVec[2].m_labelIdx == 6);
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "KwsDetector.hpp"
+
+#include <catch.hpp>
+
+/* Classes used by the tests: two keywords and a disabled background class. */
+static constexpr size_t numClasses = 3;
+static constexpr uint32_t keywordA = 0;
+static constexpr uint32_t keywordB = 1;
+static constexpr uint32_t background = 2;
+
+static std::vector<float> Posterior(uint32_t labelIdx, float score)
+{
+    std::vector<float> posterior(numClasses, (1.f - score) / (numClasses - 1));
+    posterior[labelIdx] = score;
+    return posterior;
+}
+
+static arm::app::kws::KwsDetector MakeDetector(size_t smoothingWindowLen, uint32_t refractoryStrides)
+{
+    arm::app::kws::KwsDetectorParams params;
+    params.m_smoothingWindowLen = smoothingWindowLen;
+    params.m_refractoryStrides = refractoryStrides;
+    params.m_defaultThreshold = 0.6f;
+    params.m_eventHistoryLen = 2;
+    arm::app::kws::KwsDetector detector{numClasses, params};
+    detector.SetThreshold(background, 2.f);
+    return detector;
+}
+
+TEST_CASE("KWS detector smoothing")
+{
+    auto detector = MakeDetector(2, 0);
+
+    /* A single confident result is averaged with the previous background one. */
+    REQUIRE_FALSE(detector.Update(Posterior(background, 1.f).data(), 0.f));
+    REQUIRE_FALSE(detector.Update(Posterior(keywordA, 0.9f).data(), 0.5f));
+    REQUIRE(detector.GetSmoothedScore(keywordA) == Approx(0.45f));
+
+    REQUIRE(detector.Update(Posterior(keywordA, 0.9f).data(), 1.f));
+    const auto& event = detector.GetLastEvent();
+    REQUIRE(event.m_labelIdx == keywordA);
+    REQUIRE(event.m_score == Approx(0.9f));
+    REQUIRE(event.m_timeStamp == Approx(1.f));
+    REQUIRE(event.m_inferenceNumber == 2);
+}
+
+TEST_CASE("KWS detector disabled classes never trigger")
+{
+    auto detector = MakeDetector(1, 0);
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE_FALSE(detector.Update(Posterior(background, 1.f).data(), i * 0.5f));
+    }
+    REQUIRE(detector.GetEventCount() == 0);
+}
+
+TEST_CASE("KWS detector suppression")
+{
+    SECTION("One utterance over overlapping windows gives one event")
+    {
+        auto detector = MakeDetector(1, 0);
+        REQUIRE(detector.Update(Posterior(keywordA, 0.9f).data(), 0.f));
+        REQUIRE_FALSE(detector.Update(Posterior(keywordA, 0.9f).data(), 0.5f));
+        REQUIRE_FALSE(detector.Update(Posterior(keywordA, 0.8f).data(), 1.f));
+
+        /* Re-armed once the score drops below the threshold. */
+        REQUIRE_FALSE(detector.Update(Posterior(background, 0.9f).data(), 1.5f));
+        REQUIRE(detector.Update(Posterior(keywordA, 0.9f).data(), 2.f));
+        REQUIRE(detector.GetEventCount() == 2);
+    }
+
+    SECTION("Refractory window holds back other keywords")
+    {
+        auto detector = MakeDetector(1, 2);
+        REQUIRE(detector.Update(Posterior(keywordA, 0.9f).data(), 0.f));
+        REQUIRE_FALSE(detector.Update(Posterior(keywordB, 0.9f).data(), 0.5f));
+        REQUIRE_FALSE(detector.Update(Posterior(keywordB, 0.9f).data(), 1.f));
+        REQUIRE(detector.Update(Posterior(keywordB, 0.9f).data(), 1.5f));
+        REQUIRE(detector.GetLastEvent().m_labelIdx == keywordB);
+    }
+
+    SECTION("Per keyword thresholds")
+    {
+        auto detector = MakeDetector(1, 0);
+        detector.SetThreshold(keywordB, 0.95f);
+        REQUIRE_FALSE(detector.Update(Posterior(keywordB, 0.9f).data(), 0.f));
+        REQUIRE(detector.Update(Posterior(keywordB, 0.96f).data(), 0.5f));
+    }
+}
+
+TEST_CASE("KWS detector event history")
+{
+    auto detector = MakeDetector(1, 0);
+    const uint32_t sequence[] = {keywordA, keywordB, keywordA};
+    float timeStamp = 0.f;
+    for (auto labelIdx : sequence) {
+        REQUIRE(detector.Update(Posterior(labelIdx, 0.9f).data(), timeStamp));
+        timeStamp += 0.5f;
+    }
+
+    /* Only the two most recent events are kept, oldest first. */
+    REQUIRE(detector.GetEventCount() == 2);
+    REQUIRE(detector.GetEvent(0).m_labelIdx == keywordB);
+    REQUIRE(detector.GetEvent(1).m_labelIdx == keywordA);
+    REQUIRE(detector.GetEvent(1).m_timeStamp == Approx(1.f));
+
+    detector.Reset();
+    REQUIRE(detector.GetEventCount() == 0);
+    REQUIRE(detector.Update(Posterior(keywordA, 0.9f).data(), 0.f));
+}
@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BufAttributes.hpp"
+#include "InputFiles.hpp"
+#include "KwsDetector.hpp"
+#include "KwsProcessing.hpp"
+#include "Labels.hpp"
+#include "MicroNetKwsModel.hpp"
+#include "TensorFlowLiteMicro.hpp"
+
+#include <catch.hpp>
+#include <cstring>
+
+namespace arm {
+namespace app {
+    static uint8_t tensorArena[ACTIVATION_BUF_SZ] ACTIVATION_BUF_ATTRIBUTE;
+    namespace kws {
+        extern uint8_t* GetModelPointer();
+        extern size_t GetModelLen();
+    } /* namespace kws */
+} /* namespace app */
+} /* namespace arm */
+
+static constexpr size_t audioRate = 16000;
+
+/* Audio strides to compare, from the default half window down to one MFCC frame stride. */
+static const size_t strides[] = {8000, 3840, 1600, 640, 320};
+
+TEST_CASE("Incremental KWS features match full recompute", "[MicroNetKws]")
+{
+    arm::app::MicroNetKwsModel model;
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::kws::GetModelPointer(),
+                       arm::app::kws::GetModelLen()));
+
+    TfLiteTensor* inputTensor = model.GetInputTensor(0);
+    TfLiteIntArray* inputShape = model.GetInputShape(0);
+    const uint32_t numMfccFeatures = inputShape->data[arm::app::MicroNetKwsModel::ms_inputColsIdx];
+    const uint32_t numMfccFrames = inputShape->data[arm::app::MicroNetKwsModel::ms_inputRowsIdx];
+
+    /* The longest clip gives the most windows. */
+    const int16_t* clip = GetAudioArray(3);
+    const size_t clipLen = GetAudioArraySize(3);
+
+    for (size_t stride : strides) {
+        arm::app::KwsPreProcess incremental{inputTensor, numMfccFeatures, numMfccFrames,
+                                            arm::app::kws::g_FrameLength,
+                                            arm::app::kws::g_FrameStride, stride};
+        arm::app::KwsPreProcess full{inputTensor, numMfccFeatures, numMfccFrames,
+                                     arm::app::kws::g_FrameLength,
+                                     arm::app::kws::g_FrameStride, stride};
+        REQUIRE(incremental.m_audioDataStride == stride);
+
+        std::vector<uint8_t> expected(inputTensor->bytes);
+        for (size_t idx = 0; idx * stride + full.m_audioDataWindowSize <= clipLen; ++idx) {
+            REQUIRE(full.DoPreProcess(clip + idx * stride, 0));
+            std::memcpy(expected.data(), inputTensor->data.data, inputTensor->bytes);
+
+            REQUIRE(incremental.DoPreProcess(clip + idx * stride, idx));
+            REQUIRE(0 == std::memcmp(expected.data(), inputTensor->data.data, inputTensor->bytes));
+        }
+    }
+}
+
+TEST_CASE("KWS detection latency versus audio stride", "[MicroNetKws]")
+{
+    arm::app::MicroNetKwsModel model;
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::kws::GetModelPointer(),
+                       arm::app::kws::GetModelLen()));
+
+    TfLiteTensor* inputTensor = model.GetInputTensor(0);
+    TfLiteTensor* outputTensor = model.GetOutputTensor(0);
+    TfLiteIntArray* inputShape = model.GetInputShape(0);
+    const uint32_t numMfccFeatures = inputShape->data[arm::app::MicroNetKwsModel::ms_inputColsIdx];
+    const uint32_t numMfccFrames = inputShape->data[arm::app::MicroNetKwsModel::ms_inputRowsIdx];
+
+    std::vector<std::string> labels;
+    GetLabelsVector(labels);
+
+    /* Each clip is followed by one second of silence so the last keyword can be detected. */
+    std::vector<int16_t> stream;
+    std::vector<size_t> clipStarts;
+    for (uint32_t i = 0; i < NUMBER_OF_FILES; ++i) {
+        clipStarts.emplace_back(stream.size());
+        stream.insert(stream.end(), GetAudioArray(i), GetAudioArray(i) + GetAudioArraySize(i));
+        stream.insert(stream.end(), audioRate, 0);
+    }
+
+    float defaultLatency = 0.f;
+    float finestLatency = 0.f;
+    for (size_t stride : strides) {
+        arm::app::KwsPreProcess preProcess{inputTensor, numMfccFeatures, numMfccFrames,
+                                           arm::app::kws::g_FrameLength,
+                                           arm::app::kws::g_FrameStride, stride};
+
+        arm::app::kws::KwsDetectorParams params;
+        params.m_smoothingWindowLen = 1;
+        params.m_refractoryStrides = 0;
+        arm::app::kws::KwsDetector detector{labels.size(), params};
+        for (size_t i = 0; i < labels.size(); ++i) {
+            if (labels[i] == "_silence_" || labels[i] == "_unknown_") {
+                detector.SetThreshold(i, 2.f);
+            }
+        }
+
+        std::vector<float> firstDetection(NUMBER_OF_FILES, -1.f);
+
+        for (size_t idx = 0; idx * stride + preProcess.m_audioDataWindowSize <= stream.size(); ++idx) {
+            REQUIRE(preProcess.DoPreProcess(stream.data() + idx * stride, idx));
+            REQUIRE(model.RunInference());
+
+            /* Time the detection is available: end of the audio window. */
+            const float windowEnd = static_cast<float>(idx * stride + preProcess.m_audioDataWindowSize) / audioRate;
+            bool event = false;
+            REQUIRE(detector.Update(outputTensor, windowEnd, true, event));
+            if (!event) {
+                continue;
+            }
+
+            /* Attribute the event to the latest clip started before the window end. */
+            for (size_t clip = NUMBER_OF_FILES; clip-- > 0;) {
+                const float clipStart = static_cast<float>(clipStarts[clip]) / audioRate;
+                if (clipStart < windowEnd) {
+                    if (firstDetection[clip] < 0.f) {
+                        firstDetection[clip] = windowEnd - clipStart;
+                    }
+                    break;
+                }
+            }
+        }
+
+        float latency = 0.f;
+        for (float first : firstDetection) {
+            REQUIRE(first >= 0.f);
+            latency += first;
+        }
+        latency /= NUMBER_OF_FILES;
+
+        if (stride == strides[0]) {
+            defaultLatency = latency;
+        }
+        finestLatency = latency;
+    }
+
+    REQUIRE(finestLatency <= defaultLatency);
+}
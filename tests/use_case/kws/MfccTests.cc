@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "MicroNetKwsMfcc.hpp"
+#include "AudioFrontEnd.hpp"
 
 #include <algorithm>
 #include <catch.hpp>
@@ -144,4 +145,32 @@ TEST_CASE("MFCC calculation test") {
     {
         TestQuantisedMFCC<int16_t>();
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Audio front end matches MicroNet MFCC")
+{
+    using arm::app::audio::MicroNetKwsMFCC;
+    arm::app::audio::AudioFrontEndParams params;
+    params.m_samplingFreq = MicroNetKwsMFCC::ms_defaultSamplingFreq;
+    params.m_frameLen = testWav.size();
+    params.m_numMelBins = MicroNetKwsMFCC::ms_defaultNumFbankBins;
+    params.m_melLoFreq = MicroNetKwsMFCC::ms_defaultMelLoFreq;
+    params.m_melHiFreq = MicroNetKwsMFCC::ms_defaultMelHiFreq;
+    params.m_useHtkMethod = MicroNetKwsMFCC::ms_defaultUseHtkMethod;
+    params.m_numDctCoeffs = testWavMfcc.size();
+    params.m_quantScale = 1.1088106632232666;
+    params.m_quantOffset = 95;
+
+    std::vector<arm::app::audio::FeatureStage> stages;
+    REQUIRE(arm::app::audio::AudioFrontEnd::ParseStages("frame,window,fft,magnitude,mel,log,dct,quantise", stages));
+    arm::app::audio::AudioFrontEnd frontEnd(stages, params);
+    REQUIRE(frontEnd.IsValid());
+
+    std::vector<float> mfcc(frontEnd.GetNumFeatures());
+    REQUIRE(frontEnd.ComputeFrame(testWav.data(), testWav.size(), mfcc.data()));
+    CHECK(mfcc == GetMFCCInstance().MfccCompute(testWav));
+
+    std::vector<int8_t> mfccQuant(frontEnd.GetNumFeatures());
+    REQUIRE(frontEnd.ComputeFrame(testWav.data(), testWav.size(), mfccQuant.data()));
+    CHECK(mfccQuant == GetMFCCInstance().MfccComputeQuant<int8_t>(testWav, params.m_quantScale, params.m_quantOffset));
+}
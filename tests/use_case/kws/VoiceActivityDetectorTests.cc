@@ -0,0 +1,216 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2022 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BufAttributes.hpp"
+#include "InputFiles.hpp"
+#include "KwsClassifier.hpp"
+#include "KwsProcessing.hpp"
+#include "Labels.hpp"
+#include "MicroNetKwsModel.hpp"
+#include "TensorFlowLiteMicro.hpp"
+#include "VoiceActivityDetector.hpp"
+
+#include <algorithm>
+#include <catch.hpp>
+#include <cmath>
+#include <random>
+
+namespace arm {
+namespace app {
+    static uint8_t tensorArena[ACTIVATION_BUF_SZ] ACTIVATION_BUF_ATTRIBUTE;
+    namespace kws {
+        extern uint8_t* GetModelPointer();
+        extern size_t GetModelLen();
+    } /* namespace kws */
+} /* namespace app */
+} /* namespace arm */
+
+static constexpr size_t audioWindow = 16000;    /* 1 second at 16 kHz. */
+static constexpr size_t audioStride = 8000;     /* 0.5 seconds. */
+static constexpr float noiseStdDev = 30.f;      /* Background noise, about -60 dBFS. */
+
+/* Builds a stream of all the clips, each one surrounded by background noise. */
+static std::vector<int16_t> BuildStream()
+{
+    std::mt19937 gen{42};
+    std::normal_distribution<float> noise{0.f, noiseStdDev};
+    auto appendNoise = [&](std::vector<int16_t>& stream, size_t len) {
+        for (size_t i = 0; i < len; ++i) {
+            stream.emplace_back(static_cast<int16_t>(noise(gen)));
+        }
+    };
+
+    std::vector<int16_t> stream;
+    appendNoise(stream, 2 * audioWindow);
+    for (uint32_t i = 0; i < NUMBER_OF_FILES; ++i) {
+        const int16_t* clip = GetAudioArray(i);
+        for (uint32_t j = 0; j < GetAudioArraySize(i); ++j) {
+            stream.emplace_back(clip[j] + static_cast<int16_t>(noise(gen)));
+        }
+        appendNoise(stream, 2 * audioWindow);
+    }
+    return stream;
+}
+
+TEST_CASE("Voice activity detector on background noise")
+{
+    arm::app::audio::VadParams params;
+    arm::app::audio::VoiceActivityDetector vad{params};
+
+    std::mt19937 gen{1};
+    std::normal_distribution<float> noise{0.f, noiseStdDev};
+    std::vector<int16_t> silence(audioStride);
+    std::generate(silence.begin(), silence.end(),
+                  [&]() { return static_cast<int16_t>(noise(gen)); });
+
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE_FALSE(vad.IsVoiceActive(silence.data(), silence.size()));
+    }
+    REQUIRE(vad.GetNoiseFloorDb() < params.m_minEnergyDb);
+
+    /* A loud tone in the speech band opens the gate, which then holds for the hangover. */
+    std::vector<int16_t> tone(params.m_frameLen);
+    for (size_t i = 0; i < tone.size(); ++i) {
+        tone[i] = static_cast<int16_t>(8000 * sinf(2 * M_PI * 500 * i / params.m_samplingFreq));
+    }
+    REQUIRE(vad.ProcessFrame(tone.data()));
+    for (uint32_t i = 0; i < params.m_hangoverFrames; ++i) {
+        REQUIRE(vad.ProcessFrame(silence.data()));
+    }
+    REQUIRE_FALSE(vad.ProcessFrame(silence.data()));
+
+    vad.Reset();
+    REQUIRE(vad.GetNoiseFloorDb() == params.m_minEnergyDb);
+}
+
+TEST_CASE("Voice activity detector with strides that are not whole frames")
+{
+    arm::app::audio::VadParams params;
+    params.m_hangoverFrames = 0;
+    arm::app::audio::VoiceActivityDetector vad{params};
+    constexpr size_t stride = 320;
+
+    std::mt19937 gen{1};
+    std::normal_distribution<float> noise{0.f, noiseStdDev};
+    std::vector<int16_t> silence(stride);
+    std::generate(silence.begin(), silence.end(),
+                  [&]() { return static_cast<int16_t>(noise(gen)); });
+
+    /* Every sample is used: what does not fill a frame waits for the next stride. */
+    size_t numSamples = 0;
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE_FALSE(vad.IsVoiceActive(silence.data(), stride));
+        numSamples += stride;
+        REQUIRE(vad.GetNumPendingSamples() == numSamples % params.m_frameLen);
+    }
+
+    /* A tone past the first whole frame of a stride is detected with the next one. */
+    std::vector<int16_t> toneTail{silence};
+    for (size_t i = params.m_frameLen; i < stride; ++i) {
+        toneTail[i] = static_cast<int16_t>(8000 * sinf(2 * M_PI * 500 * i / params.m_samplingFreq));
+    }
+    REQUIRE_FALSE(vad.IsVoiceActive(toneTail.data(), stride));
+    REQUIRE(vad.IsVoiceActive(silence.data(), stride));
+
+    vad.Reset();
+    REQUIRE(vad.GetNumPendingSamples() == 0);
+}
+
+TEST_CASE("Voice activity gate in front of keyword spotting", "[MicroNetKws]")
+{
+    arm::app::MicroNetKwsModel model;
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::kws::GetModelPointer(),
+                       arm::app::kws::GetModelLen()));
+
+    TfLiteTensor* inputTensor = model.GetInputTensor(0);
+    TfLiteTensor* outputTensor = model.GetOutputTensor(0);
+    TfLiteIntArray* inputShape = model.GetInputShape(0);
+    const uint32_t numMfccFeatures = inputShape->data[arm::app::MicroNetKwsModel::ms_inputColsIdx];
+    const uint32_t numMfccFrames = inputShape->data[arm::app::MicroNetKwsModel::ms_inputRowsIdx];
+
+    std::vector<std::string> labels;
+    GetLabelsVector(labels);
+    arm::app::KwsClassifier classifier;
+    const float scoreThreshold = 0.5f;
+    const size_t numKeywords = 10;      /* Labels past this are silence and unknown. */
+
+    const std::vector<int16_t> stream = BuildStream();
+    const size_t numStrides = (stream.size() - audioWindow) / audioStride + 1;
+
+    /* Runs the KWS stride loop and returns the keyword detected per stride (-1 for none). */
+    auto runLoop = [&](arm::app::audio::VoiceActivityDetector* vad, size_t& numInferences) {
+        arm::app::KwsPreProcess preProcess{inputTensor, numMfccFeatures, numMfccFrames,
+                                           arm::app::kws::g_FrameLength,
+                                           arm::app::kws::g_FrameStride};
+        std::vector<arm::app::ClassificationResult> singleInfResult;
+        arm::app::KwsPostProcess postProcess{outputTensor, classifier, labels, singleInfResult};
+        REQUIRE(preProcess.m_audioDataWindowSize == audioWindow);
+        REQUIRE(preProcess.m_audioDataStride == audioStride);
+
+        std::vector<int> detections(numStrides, -1);
+        bool featuresCached = false;
+        numInferences = 0;
+
+        for (size_t idx = 0; idx < numStrides; ++idx) {
+            const int16_t* window = stream.data() + idx * audioStride;
+            if (vad && !vad->IsVoiceActive(window + audioWindow - audioStride, audioStride)) {
+                featuresCached = false;
+                continue;
+            }
+
+            REQUIRE(preProcess.DoPreProcess(window, featuresCached ? idx : 0));
+            REQUIRE(model.RunInference());
+            REQUIRE(postProcess.DoPostProcess());
+            featuresCached = true;
+            ++numInferences;
+
+            if (!singleInfResult.empty() &&
+                singleInfResult[0].m_labelIdx < numKeywords &&
+                singleInfResult[0].m_normalisedVal >= scoreThreshold) {
+                detections[idx] = singleInfResult[0].m_labelIdx;
+            }
+        }
+        return detections;
+    };
+
+    size_t baselineInferences = 0;
+    const auto baseline = runLoop(nullptr, baselineInferences);
+    REQUIRE(baselineInferences == numStrides);
+
+    arm::app::audio::VadParams params;
+    params.m_hangoverFrames = static_cast<uint32_t>(params.m_samplingFreq) / params.m_frameLen; /* 1 s. */
+    arm::app::audio::VoiceActivityDetector vad{params};
+    size_t gatedInferences = 0;
+    const auto gated = runLoop(&vad, gatedInferences);
+
+    size_t numDetections = 0;
+    size_t numRetained = 0;
+    for (size_t i = 0; i < numStrides; ++i) {
+        if (baseline[i] >= 0) {
+            ++numDetections;
+            numRetained += gated[i] == baseline[i];
+        }
+    }
+
+    const float skipped = 1.f - static_cast<float>(gatedInferences) / baselineInferences;
+    const float recall = numDetections ? static_cast<float>(numRetained) / numDetections : 1.f;
+
+    REQUIRE(numDetections >= NUMBER_OF_FILES);
+    REQUIRE(skipped >= 0.3f);
+    REQUIRE(recall >= 0.9f);
+}
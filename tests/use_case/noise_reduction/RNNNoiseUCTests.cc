@@ -19,10 +19,15 @@
 #include "Profiler.hpp"
 #include "RNNUCTestCaseData.hpp"
 #include "RNNoiseModel.hpp"
+#include "RNNoiseStream.hpp"
 #include "UseCaseHandler.hpp"
+#include "WavFile.hpp"
 #include "hal.h"
 
 #include <catch.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 
 namespace arm {
 namespace app {
@@ -224,3 +229,133 @@ TEST_CASE("Inference by index - several inferences", "[RNNoise]")
     std::vector<uint32_t> numberOfInferences = {1, 2, totalInferences};
     testInfByIndex(numberOfInferences);
 }
+
+TEST_CASE("Streaming matches clip processing", "[RNNoise]")
+{
+    PLATFORM
+
+    arm::app::RNNoiseModel model;
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::rnn::GetModelPointer(),
+                       arm::app::rnn::GetModelLen()));
+
+    const size_t frameSize = arm::app::RNNoiseStream::ms_frameSize;
+    const int16_t* clip    = GetAudioArray(1); /* p232_208.wav, as in the clip tests. */
+
+    arm::app::audio::AudioRingBuffer output(2 * frameSize);
+    arm::app::RNNoiseStream stream(model, output);
+    std::vector<int16_t> denoised(frameSize);
+
+    /* Each stream starts from a reset GRU state, like each clip. */
+    for (int run = 0; run < 2; ++run) {
+        for (size_t inf = 0; inf < 2; ++inf) {
+            REQUIRE(stream.ProcessFrame(clip + inf * frameSize));
+            REQUIRE(output.Read(denoised.data(), frameSize) == frameSize);
+
+            std::vector<int16_t> golden(ofms[inf], ofms[inf] + frameSize);
+            REQUIRE_THAT(golden, Catch::Matchers::Approx(denoised).margin(43));
+        }
+        REQUIRE(stream.GetFrameCount() == 2);
+        stream.Reset();
+    }
+    REQUIRE(output.GetOverrunCount() == 0);
+}
+
+TEST_CASE("Stream WAV in to WAV out", "[RNNoise]")
+{
+    PLATFORM
+
+    arm::app::RNNoiseModel model;
+
+    CONTEXT
+
+    caseContext.Set<uint32_t>("clipIndex", 1); /* p232_208.wav, as in the clip tests. */
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::rnn::GetModelPointer(),
+                       arm::app::rnn::GetModelLen()));
+
+    const char* inputPath  = "nr_stream_test_in.wav";
+    const char* outputPath = "nr_stream_test_out.wav";
+    const uint32_t numSamples = GetAudioArraySize(1);
+    REQUIRE(arm::app::audio::WriteWav(inputPath, GetAudioArray(1), numSamples,
+                                      arm::app::RNNoiseStream::ms_sampleRate));
+    setenv("NR_STREAM_INPUT", inputPath, 1);
+    setenv("NR_STREAM_OUTPUT", outputPath, 1);
+
+    REQUIRE(arm::app::NoiseReductionStreamHandler(caseContext));
+
+    std::vector<int16_t> denoised;
+    uint32_t sampleRate = 0;
+    REQUIRE(arm::app::audio::ReadWav(outputPath, denoised, sampleRate));
+    REQUIRE(sampleRate == arm::app::RNNoiseStream::ms_sampleRate);
+    REQUIRE(denoised.size() == numSamples);
+
+    /* The last full frame matches the one of the clip processing. */
+    const size_t frameSize = arm::app::rnn::g_FrameLength;
+    const size_t lastFrame = numSamples / frameSize - 1;
+    std::vector<int16_t> golden(ofms[2], ofms[2] + frameSize);
+    std::vector<int16_t> runtime(denoised.begin() + lastFrame * frameSize,
+                                 denoised.begin() + (lastFrame + 1) * frameSize);
+    REQUIRE_THAT(golden, Catch::Matchers::Approx(runtime).margin(43));
+
+    unsetenv("NR_STREAM_INPUT");
+    unsetenv("NR_STREAM_OUTPUT");
+    std::remove(inputPath);
+    std::remove(outputPath);
+}
+
+TEST_CASE("Stream several WAVs through one model", "[RNNoise]")
+{
+    PLATFORM
+
+    arm::app::RNNoiseModel model;
+
+    CONTEXT
+
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::rnn::GetModelPointer(),
+                       arm::app::rnn::GetModelLen()));
+
+    /* Clips of different lengths, one of them twice. */
+    const std::vector<uint32_t> clips = {0, 1, 0};
+    std::vector<std::string> inputPaths;
+    std::vector<std::string> outputPaths;
+    for (size_t i = 0; i < clips.size(); ++i) {
+        inputPaths.push_back("nr_multi_test_in_" + std::to_string(i) + ".wav");
+        outputPaths.push_back("nr_multi_test_out_" + std::to_string(i) + ".wav");
+        REQUIRE(arm::app::audio::WriteWav(inputPaths[i].c_str(), GetAudioArray(clips[i]),
+                                          GetAudioArraySize(clips[i]),
+                                          arm::app::RNNoiseStream::ms_sampleRate));
+    }
+    const char* singlePath = "nr_multi_test_single.wav";
+
+    /* Each stream is denoised exactly as if it had the model to itself. */
+    setenv("NR_STREAM_INPUT", (inputPaths[0] + "," + inputPaths[1] + "," + inputPaths[2]).c_str(), 1);
+    setenv("NR_STREAM_OUTPUT", (outputPaths[0] + "," + outputPaths[1] + "," + outputPaths[2]).c_str(), 1);
+    REQUIRE(arm::app::NoiseReductionStreamHandler(caseContext));
+
+    for (size_t i = 0; i < clips.size(); ++i) {
+        setenv("NR_STREAM_INPUT", inputPaths[i].c_str(), 1);
+        setenv("NR_STREAM_OUTPUT", singlePath, 1);
+        REQUIRE(arm::app::NoiseReductionStreamHandler(caseContext));
+
+        std::vector<int16_t> single;
+        std::vector<int16_t> multi;
+        uint32_t sampleRate = 0;
+        REQUIRE(arm::app::audio::ReadWav(singlePath, single, sampleRate));
+        REQUIRE(arm::app::audio::ReadWav(outputPaths[i].c_str(), multi, sampleRate));
+        REQUIRE(multi.size() == GetAudioArraySize(clips[i]));
+        REQUIRE(multi == single);
+    }
+
+    unsetenv("NR_STREAM_INPUT");
+    unsetenv("NR_STREAM_OUTPUT");
+    std::remove(singlePath);
+    for (size_t i = 0; i < clips.size(); ++i) {
+        std::remove(inputPaths[i].c_str());
+        std::remove(outputPaths[i].c_str());
+    }
+}
@@ -183,3 +183,114 @@ TEST_CASE("Test GRU state copy", "[RNNoise]")
     }
 
 }
+
+/* GRU state copy as it was done before the states were carried over without allocating. */
+static void ReferenceCopyGruStates(TestRNNoiseModel& model)
+{
+    std::vector<std::pair<size_t, std::vector<int8_t>>> tempOutGruStates;
+    for (auto& mapping: model.GetStateMap()) {
+        TfLiteTensor* gruOut = model.GetOutputTensor(mapping.first);
+        auto* outGruState = tflite::GetTensorData<int8_t>(gruOut);
+        tempOutGruStates.emplace_back(mapping.second,
+                                      std::vector<int8_t>(outGruState, outGruState + gruOut->bytes));
+    }
+    for (auto& state: tempOutGruStates) {
+        TfLiteTensor* gruIn = model.GetInputTensor(state.first);
+        memcpy(tflite::GetTensorData<int8_t>(gruIn), state.second.data(), gruIn->bytes);
+    }
+}
+
+/* Runs a sequence of frames, carrying the GRU states over, and gets all the outputs of each. */
+template <typename CopyFn>
+static std::vector<std::vector<int8_t>> RunSequence(TestRNNoiseModel& model,
+                                                    const std::vector<std::vector<int8_t>>& frames,
+                                                    CopyFn copyGruStates)
+{
+    std::vector<std::vector<int8_t>> outputs;
+    model.ResetGruState();
+    for (size_t i = 0; i < frames.size(); ++i) {
+        TfLiteTensor* inputTensor = model.GetInputTensor(0);
+        memcpy(inputTensor->data.data, frames[i].data(), inputTensor->bytes);
+        if (i > 0) {
+            copyGruStates();
+        }
+        REQUIRE(model.RunInference());
+
+        std::vector<int8_t> output;
+        for (size_t j = 0; j < model.GetNumOutputs(); ++j) {
+            TfLiteTensor* outputTensor = model.GetOutputTensor(j);
+            auto* data = tflite::GetTensorData<int8_t>(outputTensor);
+            output.insert(output.end(), data, data + outputTensor->bytes);
+        }
+        outputs.push_back(output);
+    }
+    return outputs;
+}
+
+TEST_CASE("Test GRU state carry-over gives unchanged outputs", "[RNNoise]")
+{
+    TestRNNoiseModel model{};
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::rnn::GetModelPointer(),
+                       arm::app::rnn::GetModelLen()));
+
+    std::vector<std::vector<int8_t>> frames(20);
+    for (auto& frame: frames) {
+        genRandom(model.GetInputTensor(0)->bytes, frame);
+    }
+
+    const auto expected = RunSequence(model, frames, [&model]() { ReferenceCopyGruStates(model); });
+    const auto actual = RunSequence(model, frames, [&model]() { REQUIRE(model.CopyGruStatesTest()); });
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("Test GRU state snapshots interleave streams", "[RNNoise]")
+{
+    TestRNNoiseModel model{};
+    REQUIRE(model.Init(arm::app::tensorArena,
+                       sizeof(arm::app::tensorArena),
+                       arm::app::rnn::GetModelPointer(),
+                       arm::app::rnn::GetModelLen()));
+    REQUIRE(model.GetStateBindings().size() == model.GetStateMap().size());
+
+    const size_t numStreams = 2;
+    std::vector<std::vector<std::vector<int8_t>>> frames(numStreams, std::vector<std::vector<int8_t>>(10));
+    for (auto& stream: frames) {
+        for (auto& frame: stream) {
+            genRandom(model.GetInputTensor(0)->bytes, frame);
+        }
+    }
+
+    /* Each stream on its own. */
+    std::vector<std::vector<std::vector<int8_t>>> expected;
+    for (auto& stream: frames) {
+        expected.push_back(RunSequence(model, stream, [&model]() { REQUIRE(model.CarryStates()); }));
+    }
+
+    /* Streams taking turns on the model, each with its own snapshot of the states. */
+    std::vector<std::vector<uint8_t>> snapshots(numStreams, std::vector<uint8_t>(model.GetStateSize()));
+    std::vector<std::vector<std::vector<int8_t>>> actual(numStreams);
+    for (size_t i = 0; i < frames[0].size(); ++i) {
+        for (size_t s = 0; s < numStreams; ++s) {
+            TfLiteTensor* inputTensor = model.GetInputTensor(0);
+            memcpy(inputTensor->data.data, frames[s][i].data(), inputTensor->bytes);
+            if (i == 0) {
+                model.ResetStates();
+            } else {
+                REQUIRE(model.RestoreStates(snapshots[s].data(), snapshots[s].size()));
+            }
+            REQUIRE(model.RunInference());
+            REQUIRE(model.SaveStates(snapshots[s].data(), snapshots[s].size()));
+
+            std::vector<int8_t> output;
+            for (size_t j = 0; j < model.GetNumOutputs(); ++j) {
+                TfLiteTensor* outputTensor = model.GetOutputTensor(j);
+                auto* data = tflite::GetTensorData<int8_t>(outputTensor);
+                output.insert(output.end(), data, data + outputTensor->bytes);
+            }
+            actual[s].push_back(output);
+        }
+    }
+    REQUIRE(actual == expected);
+}
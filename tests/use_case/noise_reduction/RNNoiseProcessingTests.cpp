@@ -212,12 +212,31 @@ TEST_CASE("RNNoise preprocessing calculation test",  "[RNNoise]")
         arm::app::rnn::FrameFeatures features;
 
         rnnoiseProcessor.PreprocessFrame(testWav0.data(), testWav0.size(), features);
-        REQUIRE_THAT( features.m_featuresVec,
+        REQUIRE_THAT( std::vector<float>(features.m_featuresVec.begin(), features.m_featuresVec.end()),
             Catch::Approx( RNNoisePreProcessGolden0 ).margin(0.1));
         rnnoiseProcessor.PreprocessFrame(testWav1.data(), testWav1.size(), features);
-        REQUIRE_THAT( features.m_featuresVec,
+        REQUIRE_THAT( std::vector<float>(features.m_featuresVec.begin(), features.m_featuresVec.end()),
             Catch::Approx( RNNoisePreProcessGolden1 ).margin(0.1));
     }
+
+    SECTION("INT16 input and reset")
+    {
+        arm::app::rnn::RNNoiseFeatureProcessor rnnoiseProcessor;
+        arm::app::rnn::FrameFeatures features;
+        std::vector<int16_t> wav0(testWav0.begin(), testWav0.end());
+        std::vector<int16_t> wav1(testWav1.begin(), testWav1.end());
+
+        rnnoiseProcessor.PreprocessFrame(wav0.data(), wav0.size(), features);
+        rnnoiseProcessor.PreprocessFrame(wav1.data(), wav1.size(), features);
+        REQUIRE_THAT( std::vector<float>(features.m_featuresVec.begin(), features.m_featuresVec.end()),
+            Catch::Approx( RNNoisePreProcessGolden1 ).margin(0.1));
+
+        /* After a reset, the first frame gives the same features as with a new processor. */
+        rnnoiseProcessor.Reset();
+        rnnoiseProcessor.PreprocessFrame(wav0.data(), wav0.size(), features);
+        REQUIRE_THAT( std::vector<float>(features.m_featuresVec.begin(), features.m_featuresVec.end()),
+            Catch::Approx( RNNoisePreProcessGolden0 ).margin(0.1));
+    }
 }
 
 
@@ -237,4 +256,4 @@ TEST_CASE("RNNoise postprocessing test", "[RNNoise]")
     }
 
     REQUIRE_THAT( denoisedRoundedInt, Catch::Approx( RNNoisePostProcessDenoiseGolden0 ).margin(1));
-}
\ No newline at end of file
+}